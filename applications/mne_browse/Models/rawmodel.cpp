@@ -381,6 +381,12 @@ bool RawModel::loadFiffData(QFile* qFile)
     MatrixXd t_data,t_times; //type is later on (when append to m_data) casted into MatrixXdR (Row-Major)
     QSharedPointer<DataPackage> newDataPackage;
 
+    //Share decoded raw buffers between the reloads of the scroll windows, drop stale buffers of a previous load
+    FiffRawBufferCache::SPtr rawCache = FiffRawBufferCache::globalCache();
+    if(rawCache->maxBytes() == 0)
+        rawCache->setMaxBytes(MODEL_RAW_CACHE_SIZE);
+    rawCache->remove(QFileInfo(*qFile).absoluteFilePath());
+
     m_pfiffIO = QSharedPointer<FiffIO>(new FiffIO(*qFile));
     if(!m_pfiffIO->m_qlistRaw.empty()) {
         m_iAbsFiffCursor = m_pfiffIO->m_qlistRaw[0]->first_samp; //Set cursor somewhere into fiff file [in samples]
@@ -412,7 +418,11 @@ bool RawModel::loadFiffData(QFile* qFile)
 
     endResetModel();
 
-    qFile->close();
+    //Keep the file memory mapped for fast scrolling, fall back to regular reads otherwise
+    if(!m_pfiffIO->m_qlistRaw[0]->file->map_file())
+        qFile->close();
+
+    m_pRawReader = FiffRawReader::SPtr(new FiffRawReader(m_pfiffIO->m_qlistRaw[0]));
 
     emit fileLoaded(m_pFiffInfo);
     emit assignedOperatorsChanged(m_assignedOperators);
@@ -425,9 +435,10 @@ bool RawModel::loadFiffData(QFile* qFile)
 
 bool RawModel::writeFiffData(QIODevice *p_IODevice)
 {
+    if(!m_pRawReader)
+        return false;
+
     RowVectorXd cals;
-    SparseMatrix<double> mult;
-    RowVectorXi sel;
 
 //    std::cout << "Writing file " << QFile(&p_IODevice).fileName().toUtf8() << std::endl;
     FiffStream::SPtr outfid = FiffStream::start_writing_raw(*p_IODevice,*m_pFiffInfo,cals);
@@ -455,7 +466,8 @@ bool RawModel::writeFiffData(QIODevice *p_IODevice)
         if (last > to)
             last = to;
 
-        if (!m_pfiffIO->m_qlistRaw[0]->read_raw_segment(data,times,mult,first,last,sel)) {
+        //Read through the reader which serializes the file access with its prefetch
+        if (!m_pRawReader->read_raw_segment(data,times,first,last)) {
             qDebug("error during read_raw_segment\n");
             return false;
         }
@@ -466,7 +478,7 @@ bool RawModel::writeFiffData(QIODevice *p_IODevice)
                outfid->write_int(FIFF_FIRST_SAMPLE,&first);
            first_buffer = false;
         }
-        outfid->write_raw_buffer(data,mult);
+        outfid->write_raw_buffer(data,cals);
         qDebug("[done]\n");
 
         emit writeProgressChanged(first);
@@ -497,6 +509,7 @@ void RawModel::loadFiffInfos()
 void RawModel::clearModel()
 {
     //FiffIO object
+    m_pRawReader.clear();
     m_pfiffIO.clear();
     m_chInfolist.clear();
 
@@ -542,7 +555,7 @@ void RawModel::resetPosition(qint32 position)
     int end = start + m_iWindowSize - 1;
 
     m_Mutex.lock();
-    if(!m_pfiffIO->m_qlistRaw[0]->read_raw_segment(t_data, t_times, start, end))
+    if(!m_pRawReader->read_raw_segment(t_data, t_times, start, end))
         qDebug() << "RawModel: Error resetting position of Fiff file!";
     m_Mutex.unlock();
 
@@ -609,8 +622,8 @@ void RawModel::reloadFiffData(bool before)
 
     m_bReloading = true;
 
-    //read data with respect to start and end point
-    QFuture<QPair<MatrixXd,MatrixXd> > future = QtConcurrent::run(this,&RawModel::readSegment,start,end);
+    //read data with respect to start and end point, the reader already prefetches the following block
+    QFuture<QPair<MatrixXd,MatrixXd> > future = m_pRawReader->read_raw_segment_async(start,end);
 
     //Wait for thread reloading is finished, then insert reloaded data
     //future.waitForFinished();
@@ -620,23 +633,6 @@ void RawModel::reloadFiffData(bool before)
 }
 
 
-//*************************************************************************************************************
-
-QPair<MatrixXd,MatrixXd> RawModel::readSegment(fiff_int_t from, fiff_int_t to)
-{
-    QPair<MatrixXd,MatrixXd> datatime;
-
-    m_Mutex.lock();
-    if(!m_pfiffIO->m_qlistRaw[0]->read_raw_segment(datatime.first, datatime.second, from, to)) {
-        printf("RawModel: Error when reading raw data!");
-        return datatime;
-    }
-    m_Mutex.unlock();
-
-    return datatime;
-}
-
-
 //*************************************************************************************************************
 //public SLOTS
 void RawModel::updateScrollPos(int value)
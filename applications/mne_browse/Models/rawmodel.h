@@ -50,7 +50,7 @@
 *
 *           In order to not freeze the GUI when reloading new data or filtering data, the RawModel class makes heavy use
 *           of the QtConcurrent features. [2]
-*           Therefore, the methods updateOperatorsConcurrently() and readSegment() is run in a background-thread. Once the results
+*           Therefore, the method updateOperatorsConcurrently() and the FiffRawReader run in background-threads. Once the results
 *           are ready the m_operatorFutureWatcher and m_reloadFutureWatcher emits a signal that is connect to the slots
 *           insertProcessedData() and insertReloadedData(), respectively.
 *
@@ -89,6 +89,7 @@
 #include <QPalette>
 #include <QtConcurrent>
 #include <QProgressDialog>
+#include <QFileInfo>
 
 
 //*************************************************************************************************************
@@ -107,6 +108,8 @@
 
 #include <fiff/fiff.h>
 #include <fiff/fiff_io.h>
+#include <fiff/fiff_raw_reader.h>
+#include <fiff/fiff_raw_buffer_cache.h>
 #include <mne/mne.h>
 #include <utils/filterTools/parksmcclellan.h>
 
@@ -222,16 +225,6 @@ private:
     */
     void reloadFiffData(bool before);
 
-    //=========================================================================================================
-    /**
-    * @brief readSegment is the wrapper method to read a segment from the raw fiff file
-    *
-    * @param from the start point to read from the file
-    * @param to the end point to read from the file
-    * @return the data and times matrices
-    */
-    QPair<MatrixXd,MatrixXd> readSegment(fiff_int_t from, fiff_int_t to);
-
     //VARIABLES
     //Reload control
     bool                                    m_bStartReached;            /**< signals, whether the start of the fiff data file is reached. */
@@ -240,6 +233,7 @@ private:
 
     //Concurrent reloading
     QFutureWatcher<QPair<MatrixXd,MatrixXd> > m_reloadFutureWatcher;    /**< QFutureWatcher for watching process of reloading fiff data. */
+    FIFFLIB::FiffRawReader::SPtr            m_pRawReader;               /**< Reads the fiff data in parallel and prefetches the next block in scroll direction. */
     bool                                    m_bReloading;               /**< signals when the reloading is ongoing. */
 
     //Concurrent processing
@@ -82,6 +82,7 @@
 #define MODEL_MAX_WINDOWS 3 //number of windows that are at maximum remained in m_data
 #define MODEL_NUM_FILTER_TAPS 80 //number of filter taps, required to take into account because of FFT convolution (zero padding)
 #define MODEL_MAX_NUM_FILTER_TAPS 0 //number of maximal filter taps
+#define MODEL_RAW_CACHE_SIZE 268435456 //memory budget of the cache of decoded raw buffers, allows scrolling back without decoding again [in bytes]
 
 //RawDelegate
 //Look
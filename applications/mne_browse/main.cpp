@@ -45,6 +45,14 @@
 #include "Utils/info.h"
 
 
+//*************************************************************************************************************
+//=============================================================================================================
+// MNE INCLUDES
+//=============================================================================================================
+
+#include <fiff/fiff_index.h>
+
+
 //*************************************************************************************************************
 //=============================================================================================================
 // Qt INCLUDES
@@ -63,6 +71,7 @@
 //=============================================================================================================
 
 using namespace MNEBROWSE;
+using namespace FIFFLIB;
 
 
 //*************************************************************************************************************
@@ -117,6 +126,9 @@ int main(int argc, char *argv[])
     QCoreApplication::setOrganizationName(CInfo::OrganizationName());
     QCoreApplication::setApplicationName(CInfo::AppNameShort());
 
+    //keep tag directories in index sidecars only when asked to (--index)
+    FiffIndex::setEnabled(a.arguments().contains("--index"));
+
     //show splash screen for 1 second
     QPixmap pixmap(":/Resources/Images/splashscreen_mne_browse.png");
     QSplashScreen splash(pixmap);
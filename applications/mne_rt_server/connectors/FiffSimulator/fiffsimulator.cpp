@@ -58,6 +58,7 @@
 
 #include <fiff/fiff.h>
 #include <fiff/fiff_types.h>
+#include <fiff/fiff_index.h>
 
 
 //*************************************************************************************************************
@@ -326,9 +327,19 @@ void FiffSimulator::init()
     {
         QTextStream in(&t_qFile);
         QString key = "simFile = ";
+        QString keyIndex = "fiffIndex = ";
         while (!in.atEnd()) {
             QString line = in.readLine();
-            if(line.contains(key, Qt::CaseInsensitive))
+            if(line.contains(keyIndex, Qt::CaseInsensitive))
+            {
+                //The simulation file is reopened on every (re)start, optionally keep its tag directory in a .fidx
+                //index sidecar next to it. Note that this enables the index for all files opened by the process.
+                qint32 idx = line.indexOf(keyIndex, 0, Qt::CaseInsensitive) + keyIndex.size();
+                bool bIndex = line.mid(idx).trimmed().compare("true", Qt::CaseInsensitive) == 0;
+                FiffIndex::setEnabled(bIndex);
+                std::cout << "	Fiff tag directory index sidecar: " << (bIndex ? "enabled" : "disabled") << std::endl;
+            }
+            else if(line.contains(key, Qt::CaseInsensitive))
             {
                 qint32 idx = line.indexOf(key);
                 idx += key.size();
@@ -68,7 +68,7 @@ RealTimeMultiSampleArrayModel::RealTimeMultiSampleArrayModel(QObject *parent)
 , m_iCurrentSample(0)
 , m_bIsFreezed(false)
 , m_sFilterChannelType("MEG")
-, m_iMaxFilterLength(128)
+, m_iFilterDelay(0)
 , m_iCurrentBlockSize(1024)
 , m_iResidual(0)
 , m_bDrawFilterFront(true)
@@ -78,6 +78,7 @@ RealTimeMultiSampleArrayModel::RealTimeMultiSampleArrayModel(QObject *parent)
 , m_iDetectedTriggers(0)
 , m_iCurrentSampleFreeze(0)
 , m_iCurrentTriggerChIndex(0)
+, m_pRtFilter(REALTIMELIB::RtFilter::SPtr(new REALTIMELIB::RtFilter()))
 {
     init();
 }
@@ -331,8 +332,6 @@ void RealTimeMultiSampleArrayModel::setFiffInfo(FiffInfo::SPtr& p_pFiffInfo)
         m_vecLastBlockFirstValuesRaw.conservativeResize(m_pFiffInfo->chs.size());
         m_vecLastBlockFirstValuesRaw.setZero();
 
-        m_matOverlap.conservativeResize(m_pFiffInfo->chs.size(), m_iMaxFilterLength);
-
         m_matSparseProjMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
         m_matSparseCompMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
         m_matSparseSpharaMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
@@ -515,13 +514,13 @@ void RealTimeMultiSampleArrayModel::addData(const QList<MatrixXd> &data)
 
             //Perform SPHARA on filtered data after actual filtering - SPHARA should be applied on the best possible data
             if(doSphara) {
-                if(m_iCurrentSample-m_iMaxFilterLength/2 >= 0) {
-                    m_matDataFiltered.block(0, m_iCurrentSample-m_iMaxFilterLength/2, nRow, nCol) = m_matSparseSpharaMult * m_matDataFiltered.block(0, m_iCurrentSample-m_iMaxFilterLength/2, nRow, nCol);
+                if(m_iCurrentSample-m_iFilterDelay >= 0) {
+                    m_matDataFiltered.block(0, m_iCurrentSample-m_iFilterDelay, nRow, nCol) = m_matSparseSpharaMult * m_matDataFiltered.block(0, m_iCurrentSample-m_iFilterDelay, nRow, nCol);
                 }
                 else {
-                    if(m_iCurrentSample-m_iMaxFilterLength/2 < 0) {
+                    if(m_iCurrentSample-m_iFilterDelay < 0) {
                         m_matDataFiltered.block(0, 0, nRow, nCol) = m_matSparseSpharaMult * m_matDataFiltered.block(0, 0, nRow, nCol);
-                        int iResidual = m_iResidual+m_iMaxFilterLength/2;
+                        int iResidual = m_iResidual+m_iFilterDelay;
                         m_matDataFiltered.block(0, m_matDataFiltered.cols()-iResidual, nRow, iResidual) = m_matSparseSpharaMult * m_matDataFiltered.block(0, m_matDataFiltered.cols()-iResidual, nRow, iResidual);
                     }
                 }
@@ -906,20 +905,10 @@ void RealTimeMultiSampleArrayModel::filterChanged(QList<FilterData> filterData)
 {
     m_filterData = filterData;
 
-    m_iMaxFilterLength = 1;
-    for(int i=0; i<filterData.size(); ++i) {
-        if(m_iMaxFilterLength<filterData.at(i).m_iFilterOrder) {
-            m_iMaxFilterLength = filterData.at(i).m_iFilterOrder;
-        }
-    }
-
-    m_matOverlap.conservativeResize(m_pFiffInfo->chs.size(), m_iMaxFilterLength);
-    m_matOverlap.setZero();
+    //The delays of the cascaded FIR filters add up, IIR filters do not delay the data by half their length
+    m_iFilterDelay = REALTIMELIB::RtFilter::getGroupDelay(filterData);
 
     m_bDrawFilterFront = false;
-
-    //Filter all visible data channels at once
-    //filterChannelsConcurrently();
 }
 
 
@@ -927,11 +916,7 @@ void RealTimeMultiSampleArrayModel::filterChanged(QList<FilterData> filterData)
 
 void RealTimeMultiSampleArrayModel::filterActivated(bool state)
 {
-    //Filter all visible data channels at once
-    if(state) {
- //       m_bDrawFilterFront = false;
-        //filterChannelsConcurrently();
-    }
+    Q_UNUSED(state);
 }
 
 
@@ -969,9 +954,6 @@ void RealTimeMultiSampleArrayModel::setFilterChannelType(QString channelType)
 //    }
 
 //    m_bDrawFilterFront = false;
-
-    //Filter all visible data channels at once
-    //filterChannelsConcurrently();
 }
 
 
@@ -1011,9 +993,6 @@ void RealTimeMultiSampleArrayModel::createFilterChannelList(QStringList channelN
 
 //    for(int i = 0; i<m_filterChannelList.size(); ++i)
 //        std::cout<<m_filterChannelList.at(i).toStdString()<<std::endl;
-
-    //Filter all visible data channels at once
-    //filterChannelsConcurrently();
 }
 
 
@@ -1119,186 +1098,51 @@ void RealTimeMultiSampleArrayModel::markChBad(QModelIndexList chlist, bool statu
 }
 
 
-//*************************************************************************************************************
-
-void doFilterPerChannelRTMSA(QPair<QList<FilterData>,QPair<int,RowVectorXd> > &channelDataTime)
-{
-    for(int i = 0; i < channelDataTime.first.size(); ++i)
-        //channelDataTime.second.second = channelDataTime.first.at(i).applyConvFilter(channelDataTime.second.second, true, FilterData::ZeroPad);
-        channelDataTime.second.second = channelDataTime.first.at(i).applyFFTFilter(channelDataTime.second.second, true, FilterData::ZeroPad); //FFT Convolution for rt is not suitable. FFT make the signal filtering non causal.
-}
-
-
-//*************************************************************************************************************
-
-void RealTimeMultiSampleArrayModel::filterChannelsConcurrently()
-{
-    //std::cout<<"START RealTimeMultiSampleArrayModel::filterChannelsConcurrently"<<std::endl;
-
-    if(m_filterData.isEmpty())
-        return;
-
-    //Create temporary filters with higher fft length because we are going to filter all available data at once for one time
-    QList<FilterData> tempFilterList;
-
-    int fftLength = m_matDataRaw.row(0).cols() + 4 * m_iMaxFilterLength;
-    int exp = ceil(MNEMath::log2(fftLength));
-    fftLength = pow(2, exp) < 512 ? 512 : pow(2, exp);
-
-    for(int i = 0; i<m_filterData.size(); ++i) {
-        FilterData tempFilter(m_filterData.at(i).m_sName,
-                              m_filterData.at(i).m_Type,
-                              m_filterData.at(i).m_iFilterOrder,
-                              m_filterData.at(i).m_dCenterFreq,
-                              m_filterData.at(i).m_dBandwidth,
-                              m_filterData.at(i).m_dParksWidth,
-                              m_filterData.at(i).m_sFreq,
-                              fftLength,
-                              m_filterData.at(i).m_designMethod);
-
-        tempFilterList.append(tempFilter);
-    }
-
-    //Generate QList structure which can be handled by the QConcurrent framework
-    QList<QPair<QList<FilterData>,QPair<int,RowVectorXd> > > timeData;
-    QList<int> notFilterChannelIndex;
-
-    //Also append mirrored data in front and back to get rid of edge effects
-    for(qint32 i=0; i<m_matDataRaw.rows(); ++i) {
-        if(m_filterChannelList.contains(m_pFiffInfo->chs.at(i).ch_name)) {
-            RowVectorXd datTemp(m_matDataRaw.row(i).cols() + 2 * m_iMaxFilterLength);
-            datTemp << m_matDataRaw.row(i).head(m_iMaxFilterLength).reverse(), m_matDataRaw.row(i), m_matDataRaw.row(i).tail(m_iMaxFilterLength).reverse();
-            timeData.append(QPair<QList<FilterData>,QPair<int,RowVectorXd> >(tempFilterList,QPair<int,RowVectorXd>(i,datTemp)));
-        }
-        else
-            notFilterChannelIndex.append(i);
-    }
-
-    //Do the concurrent filtering
-    if(!timeData.isEmpty()) {
-        QFuture<void> future = QtConcurrent::map(timeData,
-                                             doFilterPerChannelRTMSA);
-
-        future.waitForFinished();
-
-        for(int r = 0; r < timeData.size(); ++r) {
-            m_matDataFiltered.row(timeData.at(r).second.first) = timeData.at(r).second.second.segment(m_iMaxFilterLength+m_iMaxFilterLength/2, m_matDataRaw.cols());
-            m_matOverlap.row(timeData.at(r).second.first) = timeData.at(r).second.second.tail(m_iMaxFilterLength);
-        }
-    }
-
-    //Fill filtered data with raw data if the channel was not filtered
-    for(int i = 0; i < notFilterChannelIndex.size(); ++i)
-        m_matDataFiltered.row(notFilterChannelIndex.at(i)) = m_matDataRaw.row(notFilterChannelIndex.at(i));
-
-    if(!m_bIsFreezed) {
-        m_vecLastBlockFirstValuesFiltered = m_matDataFiltered.col(0);
-    }
-
-    //std::cout<<"END RealTimeMultiSampleArrayModel::filterChannelsConcurrently"<<std::endl;
-}
-
-
 //*************************************************************************************************************
 
 void RealTimeMultiSampleArrayModel::filterChannelsConcurrently(const MatrixXd &data, int iDataIndex)
 {
     //std::cout<<"START RealTimeMultiSampleArrayModel::filterChannelsConcurrently"<<std::endl;
 
-    if(iDataIndex >= m_matDataFiltered.cols() || data.cols() < m_iMaxFilterLength)
+    if(iDataIndex >= m_matDataFiltered.cols() || data.cols() < m_iFilterDelay)
         return;
 
-    //Generate QList structure which can be handled by the QConcurrent framework
-    QList<QPair<QList<FilterData>,QPair<int,RowVectorXd> > > timeData;
+    QVector<int> vecFilterRows;
     QList<int> notFilterChannelIndex;
 
     for(qint32 i = 0; i < data.rows(); ++i) {
         if(m_filterChannelList.contains(m_pFiffInfo->chs.at(i).ch_name))
-            timeData.append(QPair<QList<FilterData>,QPair<int,RowVectorXd> >(m_filterData,QPair<int,RowVectorXd>(i,data.row(i))));
+            vecFilterRows.append(i);
         else
             notFilterChannelIndex.append(i);
     }
 
-    //Do the concurrent filtering
-    if(!timeData.isEmpty()) {
-        QFuture<void> future = QtConcurrent::map(timeData,
-                                             doFilterPerChannelRTMSA);
-
-        future.waitForFinished();
+    //Do the concurrent filtering. The filter keeps the overlap between the blocks and resets itself when the filters change.
+    if(!vecFilterRows.isEmpty()) {
+        MatrixXd matFiltered = data;
+        m_pRtFilter->filterChannelsInPlace(matFiltered, false, vecFilterRows, m_filterData);
 
-        //Do the overlap add method and store in m_matDataFiltered
-        int iFilterDelay = m_iMaxFilterLength/2;
-        int iFilteredNumberCols = timeData.at(0).second.second.cols();
+        //The filtered data is delayed by the group delay of the filter cascade -> write it to where it belongs in time
+        int iFilterDelay = m_iFilterDelay;
+        int iNumberCols = matFiltered.cols();
 
-        for(int r = 0; r<timeData.size(); ++r) {
-            if(iDataIndex+2*data.cols() > m_matDataRaw.cols()) {
-                //Handle last data block
-                //std::cout<<"Handle last data block"<<std::endl;
+        for(int r = 0; r < vecFilterRows.size(); ++r) {
+            int iRow = vecFilterRows.at(r);
 
-                if(m_bDrawFilterFront) {
-                    //Get the currently filtered data. This data has a delay of filterLength/2 in front and back.
-                    RowVectorXd tempData = timeData.at(r).second.second;
-
-                    //Perform the actual overlap add by adding the last filterlength data to the newly filtered one
-                    tempData.head(m_iMaxFilterLength) += m_matOverlap.row(timeData.at(r).second.first);
-
-                    //Write the newly calulated filtered data to the filter data matrix. Keep in mind that the current block also effect last part of the last block (begin at dataIndex-iFilterDelay).
-                    int start = iDataIndex-iFilterDelay < 0 ? 0 : iDataIndex-iFilterDelay;
-                    m_matDataFiltered.row(timeData.at(r).second.first).segment(start,iFilteredNumberCols-m_iMaxFilterLength) = tempData.head(iFilteredNumberCols-m_iMaxFilterLength);
-                } else {
-                    //Perform this else case everytime the filter was changed. Do not begin to plot from dataIndex-iFilterDelay because the impsulse response and m_matOverlap do not match with the new filter anymore.
-                    m_matDataFiltered.row(timeData.at(r).second.first).segment(iDataIndex-iFilterDelay,m_iMaxFilterLength) = timeData.at(r).second.second.segment(m_iMaxFilterLength,m_iMaxFilterLength);
-                    m_matDataFiltered.row(timeData.at(r).second.first).segment(iDataIndex+iFilterDelay,iFilteredNumberCols-2*m_iMaxFilterLength) = timeData.at(r).second.second.segment(m_iMaxFilterLength,iFilteredNumberCols-2*m_iMaxFilterLength);
-                }
-
-                //Refresh the m_matOverlap with the new calculated filtered data.
-                m_matOverlap.row(timeData.at(r).second.first) = timeData.at(r).second.second.tail(m_iMaxFilterLength);
+            if(!m_bDrawFilterFront) {
+                //Perform this case everytime the filter was changed. Do not begin to plot from dataIndex-iFilterDelay because the last block was filtered with the old filter.
+                m_matDataFiltered.row(iRow).segment(iDataIndex, iNumberCols-iFilterDelay) = matFiltered.row(iRow).segment(iFilterDelay, iNumberCols-iFilterDelay);
             } else if(iDataIndex == 0) {
-                //Handle first data block
-                //std::cout<<"Handle first data block"<<std::endl;
-
-                if(m_bDrawFilterFront) {
-                    //Get the currently filtered data. This data has a delay of filterLength/2 in front and back.
-                    RowVectorXd tempData = timeData.at(r).second.second;
-
-                    //Add newly calculate data to the tail of the current filter data matrix
-                    m_matDataFiltered.row(timeData.at(r).second.first).segment(m_matDataFiltered.cols()-iFilterDelay-m_iResidual, iFilterDelay) = tempData.head(iFilterDelay) + m_matOverlap.row(timeData.at(r).second.first).head(iFilterDelay);
-
-                    //Perform the actual overlap add by adding the last filterlength data to the newly filtered one
-                    tempData.head(m_iMaxFilterLength) += m_matOverlap.row(timeData.at(r).second.first);
-                    m_matDataFiltered.row(timeData.at(r).second.first).head(iFilteredNumberCols-m_iMaxFilterLength-iFilterDelay) = tempData.segment(iFilterDelay,iFilteredNumberCols-m_iMaxFilterLength-iFilterDelay);
+                //Handle first data block. The front belongs to the end of the last pass.
+                m_matDataFiltered.row(iRow).segment(m_matDataFiltered.cols()-iFilterDelay-m_iResidual, iFilterDelay) = matFiltered.row(iRow).head(iFilterDelay);
+                m_matDataFiltered.row(iRow).head(iNumberCols-iFilterDelay) = matFiltered.row(iRow).segment(iFilterDelay, iNumberCols-iFilterDelay);
 
-                    //Copy residual data from the front to the back. The residual is != 0 if the chosen block size cannot be evenly fit into the matrix size
-                    m_matDataFiltered.row(timeData.at(r).second.first).tail(m_iResidual) = m_matDataFiltered.row(timeData.at(r).second.first).head(m_iResidual);
-                } else {
-                    //Perform this else case everytime the filter was changed. Do not begin to plot from dataIndex-iFilterDelay because the impsulse response and m_matOverlap do not match with the new filter anymore.
-                    m_matDataFiltered.row(timeData.at(r).second.first).head(m_iMaxFilterLength) = timeData.at(r).second.second.segment(m_iMaxFilterLength,m_iMaxFilterLength);
-                    m_matDataFiltered.row(timeData.at(r).second.first).segment(iFilterDelay,iFilteredNumberCols-2*m_iMaxFilterLength) = timeData.at(r).second.second.segment(m_iMaxFilterLength,iFilteredNumberCols-2*m_iMaxFilterLength);
-                }
-
-                //Refresh the m_matOverlap with the new calculated filtered data.
-                m_matOverlap.row(timeData.at(r).second.first) = timeData.at(r).second.second.tail(m_iMaxFilterLength);
+                //Copy residual data from the front to the back. The residual is != 0 if the chosen block size cannot be evenly fit into the matrix size
+                m_matDataFiltered.row(iRow).tail(m_iResidual) = m_matDataFiltered.row(iRow).head(m_iResidual);
             } else {
-                //Handle middle data blocks
-                //std::cout<<"Handle middle data block"<<std::endl;
-
-                if(m_bDrawFilterFront) {
-                    //Get the currently filtered data. This data has a delay of filterLength/2 in front and back.
-                    RowVectorXd tempData = timeData.at(r).second.second;
-
-                    //Perform the actual overlap add by adding the last filterlength data to the newly filtered one
-                    tempData.head(m_iMaxFilterLength) += m_matOverlap.row(timeData.at(r).second.first);
-
-                    //Write the newly calulated filtered data to the filter data matrix. Keep in mind that the current block also effect last part of the last block (begin at dataIndex-iFilterDelay).
-                    m_matDataFiltered.row(timeData.at(r).second.first).segment(iDataIndex-iFilterDelay,iFilteredNumberCols-m_iMaxFilterLength) = tempData.head(iFilteredNumberCols-m_iMaxFilterLength);
-                } else {
-                    //Perform this else case everytime the filter was changed. Do not begin to plot from dataIndex-iFilterDelay because the impsulse response and m_matOverlap do not match with the new filter anymore.
-                    m_matDataFiltered.row(timeData.at(r).second.first).segment(iDataIndex-iFilterDelay,m_iMaxFilterLength).setZero();// = timeData.at(r).second.second.segment(m_iMaxFilterLength,m_iMaxFilterLength);
-                    m_matDataFiltered.row(timeData.at(r).second.first).segment(iDataIndex+iFilterDelay,iFilteredNumberCols-2*m_iMaxFilterLength) = timeData.at(r).second.second.segment(m_iMaxFilterLength,iFilteredNumberCols-2*m_iMaxFilterLength);
-                }
-
-                //Refresh the m_matOverlap with the new calculated filtered data.
-                m_matOverlap.row(timeData.at(r).second.first) = timeData.at(r).second.second.tail(m_iMaxFilterLength);
+                //Handle middle and last data blocks. Keep in mind that the current block also effects the last part of the last block (begin at dataIndex-iFilterDelay).
+                int start = iDataIndex-iFilterDelay < 0 ? 0 : iDataIndex-iFilterDelay;
+                m_matDataFiltered.row(iRow).segment(start, iNumberCols) = matFiltered.row(iRow);
             }
         }
     }
@@ -1326,7 +1170,10 @@ void RealTimeMultiSampleArrayModel::clearModel()
     m_matDataFilteredFreeze.setZero();
     m_vecLastBlockFirstValuesFiltered.setZero();
     m_vecLastBlockFirstValuesRaw.setZero();
-    m_matOverlap.setZero();
+
+    //Drop the filter state of the last blocks so the next data does not continue the old signal
+    m_pRtFilter->reset();
+    m_bDrawFilterFront = false;
 
     endResetModel();
 
@@ -52,6 +52,8 @@
 #include <utils/ioutils.h>
 #include <utils/filterTools/sphara.h>
 
+#include <realtime/rtProcessing/rtfilter.h>
+
 
 //*************************************************************************************************************
 //=============================================================================================================
@@ -519,12 +521,6 @@ private:
     */
     void initSphara();
 
-    //=========================================================================================================
-    /**
-    * Calculates the filtered version of the channels in m_matDataRaw
-    */
-    void filterChannelsConcurrently();
-
     //=========================================================================================================
     /**
     * Calculates the filtered version of the raw input data
@@ -553,7 +549,7 @@ private:
     qint32                              m_iMaxSamples;                              /**< Max samples per window */
     qint32                              m_iCurrentSample;                           /**< Current sample which holds the current position in the data matrix */
     qint32                              m_iCurrentSampleFreeze;                     /**< Current sample which holds the current position in the data matrix when freezing tool is active */
-    qint32                              m_iMaxFilterLength;                         /**< Max order of the current filters */
+    qint32                              m_iFilterDelay;                             /**< Group delay of the current FIR filters in samples */
     qint32                              m_iCurrentBlockSize;                        /**< Current block size */
     qint32                              m_iResidual;                                /**< Current amount of samples which were to size */
     int                                 m_iCurrentTriggerChIndex;                   /**< The index of the current trigger channel */
@@ -573,7 +569,6 @@ private:
     MatrixXdR                           m_matDataFiltered;                          /**< The filtered data */
     MatrixXdR                           m_matDataRawFreeze;                         /**< The raw data in freeze mode */
     MatrixXdR                           m_matDataFilteredFreeze;                    /**< The raw filtered data in freeze mode */
-    MatrixXd                            m_matOverlap;                               /**< Last overlap block for the back */
 
     Eigen::VectorXi                     m_vecIndicesFirstVV;                        /**< The indices of the channels to pick for the first SPHARA operator in case of a VectorView system.*/
     Eigen::VectorXi                     m_vecIndicesSecondVV;                       /**< The indices of the channels to pick for the second SPHARA operator in case of a VectorView system.*/
@@ -603,6 +598,7 @@ private:
     QMap<int,QList<QPair<int,double> > >m_qMapDetectedTriggerOldFreeze;             /**< Old detected trigger for each trigger channel while display is freezed. */
     QMap<qint32,float>                  m_qMapChScaling;                            /**< Channel scaling map. */
     QList<FilterData>                   m_filterData;                               /**< List of currently active filters. */
+    REALTIMELIB::RtFilter::SPtr         m_pRtFilter;                                /**< Real time filter object. */
     QList<RealTimeSampleArrayChInfo>    m_qListChInfo;                              /**< Channel info list. ToDo: Obsolete*/
     QStringList                         m_filterChannelList;                        /**< List of channels which are to be filtered.*/
     QStringList                         m_visibleChannelList;                       /**< List of currently visible channels in the view.*/
@@ -653,9 +649,9 @@ inline qint32 RealTimeMultiSampleArrayModel::getCurrentSampleIndex() const
 
     if(!m_filterData.isEmpty()/* || !m_bDrawFilterFront*/) {
 //        if(!m_bDrawFilterFront)
-//            return m_iCurrentSample+m_iMaxFilterLength/2;
+//            return m_iCurrentSample+m_iFilterDelay;
 //        else
-            return m_iCurrentSample-m_iMaxFilterLength/2;
+            return m_iCurrentSample-m_iFilterDelay;
     }
 
     return m_iCurrentSample;
@@ -801,7 +797,7 @@ inline bool RealTimeMultiSampleArrayModel::triggerDetectionActive() const
 inline int RealTimeMultiSampleArrayModel::getCurrentOverlapAddDelay() const
 {
     if(!m_filterData.isEmpty())
-        return m_iMaxFilterLength/2;
+        return m_iFilterDelay;
     else
         return 0;
 }
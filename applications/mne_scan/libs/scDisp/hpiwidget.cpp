@@ -459,7 +459,8 @@ void HPIWidget::onBtnDoSingleFit()
 
     //Generate/Update current dev/head transfomration. We do not need to make use of rtHPI plugin here since the fitting is only needed once here.
     //rt head motion correction will be performed using the rtHPI plugin.
-    if(m_pFiffInfo) {
+    //In continuous mode every block is already fitted, appending it twice would break the lock-in demodulation.
+    if(m_pFiffInfo && !ui->m_checkBox_continousHPI->isChecked()) {
         m_pRtHPI->append(m_matValue);
     }
 }
@@ -530,6 +531,8 @@ void HPIWidget::onDoContinousHPI()
        return;
     }
 
+    m_pRtHPI->setContinuousMode(ui->m_checkBox_continousHPI->isChecked());
+
     emit continousHPIToggled(ui->m_checkBox_continousHPI->isChecked());
 }
 
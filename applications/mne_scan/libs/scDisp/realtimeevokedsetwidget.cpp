@@ -198,6 +198,7 @@ RealTimeEvokedSetWidget::~RealTimeEvokedSetWidget()
             settings.setValue(QString("RTESW/%1/filterOrder").arg(t_sRTESWName), filter.m_iFilterOrder);
             settings.setValue(QString("RTESW/%1/filterType").arg(t_sRTESWName), (int)filter.m_Type);
             settings.setValue(QString("RTESW/%1/filterDesignMethod").arg(t_sRTESWName), (int)filter.m_designMethod);
+            settings.setValue(QString("RTESW/%1/filterIIROrder").arg(t_sRTESWName), filter.m_iIIROrder);
             settings.setValue(QString("RTESW/%1/filterTransition").arg(t_sRTESWName), filter.m_dParksWidth*(filter.m_sFreq/2));
             settings.setValue(QString("RTESW/%1/filterUserDesignActive").arg(t_sRTESWName), m_pFilterWindow->userDesignedFiltersIsActive());
             settings.setValue(QString("RTESW/%1/filterChannelType").arg(t_sRTESWName), m_pFilterWindow->getChannelType());
@@ -456,6 +457,7 @@ void RealTimeEvokedSetWidget::init()
                                                 settings.value(QString("RTESW/%1/filterOrder").arg(t_sRTESWName), 128).toInt(),
                                                 settings.value(QString("RTESW/%1/filterType").arg(t_sRTESWName), 2).toInt(),
                                                 settings.value(QString("RTESW/%1/filterDesignMethod").arg(t_sRTESWName), 0).toInt(),
+                                                settings.value(QString("RTESW/%1/filterIIROrder").arg(t_sRTESWName), 4).toInt(),
                                                 settings.value(QString("RTESW/%1/filterTransition").arg(t_sRTESWName), 5.0).toDouble(),
                                                 settings.value(QString("RTESW/%1/filterUserDesignActive").arg(t_sRTESWName), false).toBool(),
                                                 settings.value(QString("RTESW/%1/filterChannelType").arg(t_sRTESWName), "MEG").toString());
@@ -47,6 +47,8 @@
 #include <disp3D/engine/control/control3dwidget.h>
 #include <disp3D/engine/model/data3Dtreemodel.h>
 
+#include <scMeas/latencymonitor.h>
+
 #include <mne/mne_bem.h>
 
 
@@ -94,6 +96,7 @@ RealTimeMultiSampleArrayWidget::RealTimeMultiSampleArrayWidget(QSharedPointer<Ne
 , m_pChInfoModel(Q_NULLPTR)
 , m_pSelectionManagerWindow(Q_NULLPTR)
 , m_pFilterWindow(Q_NULLPTR)
+, m_pLatencyHistogram(Q_NULLPTR)
 , m_pRtEEGSensorDataItem(Q_NULLPTR)
 , m_pRtMEGSensorDataItem(Q_NULLPTR)
 , m_bVisualize3DSensorData(false)
@@ -217,6 +220,7 @@ RealTimeMultiSampleArrayWidget::~RealTimeMultiSampleArrayWidget()
             settings.setValue(QString("RTMSAW/%1/filterOrder").arg(t_sRTMSAWName), filter.m_iFilterOrder);
             settings.setValue(QString("RTMSAW/%1/filterType").arg(t_sRTMSAWName), (int)filter.m_Type);
             settings.setValue(QString("RTMSAW/%1/filterDesignMethod").arg(t_sRTMSAWName), (int)filter.m_designMethod);
+            settings.setValue(QString("RTMSAW/%1/filterIIROrder").arg(t_sRTMSAWName), filter.m_iIIROrder);
             settings.setValue(QString("RTMSAW/%1/filterTransition").arg(t_sRTMSAWName), filter.m_dParksWidth*(filter.m_sFreq/2));
             settings.setValue(QString("RTMSAW/%1/filterUserDesignActive").arg(t_sRTMSAWName), m_pFilterWindow->userDesignedFiltersIsActive());
             settings.setValue(QString("RTMSAW/%1/filterChannelType").arg(t_sRTMSAWName), m_pFilterWindow->getChannelType());
@@ -259,8 +263,13 @@ void RealTimeMultiSampleArrayWidget::broadcastScaling(QMap<qint32,float> scaleMa
 
 //*************************************************************************************************************
 
-void RealTimeMultiSampleArrayWidget::update(SCMEASLIB::NewMeasurement::SPtr)
+void RealTimeMultiSampleArrayWidget::update(SCMEASLIB::NewMeasurement::SPtr pMeasurement)
 {
+    //The samples travel with the data block, the measurement of the output connector is already empty again
+    NewRealTimeMultiSampleArray::SPtr pRTMSA = pMeasurement.dynamicCast<NewRealTimeMultiSampleArray>();
+    if(!pRTMSA)
+        pRTMSA = m_pRTMSA;
+
     if(!m_bInitialized)
     {
         if(m_pRTMSA->isChInit())
@@ -272,7 +281,7 @@ void RealTimeMultiSampleArrayWidget::update(SCMEASLIB::NewMeasurement::SPtr)
 
             m_fSamplingRate = m_pRTMSA->getSamplingRate();
 
-            m_iMaxFilterTapSize = m_pRTMSA->getMultiSampleArray().at(m_pRTMSA->getMultiSampleArray().size()-1).cols();
+            m_iMaxFilterTapSize = pRTMSA->getMultiSampleArray().at(pRTMSA->getMultiSampleArray().size()-1).cols();
 
             //Check what modalities are there for 3D sensor interpolation
             if(m_bVisualize3DSensorData) {
@@ -303,7 +312,7 @@ void RealTimeMultiSampleArrayWidget::update(SCMEASLIB::NewMeasurement::SPtr)
         }
     } else {
         //Add data to table view
-        m_pRTMSAModel->addData(m_pRTMSA->getMultiSampleArray());
+        m_pRTMSAModel->addData(pRTMSA->getMultiSampleArray());
 
         //Add data to 3D interpolation
         if(m_bVisualize3DSensorData) {
@@ -339,8 +348,8 @@ void RealTimeMultiSampleArrayWidget::update(SCMEASLIB::NewMeasurement::SPtr)
                     m_pRtEEGSensorDataItem->setSFreq(m_pRTMSA->info()->sfreq);
                 }
 
-                for(int i = 1; i < m_pRTMSA->getMultiSampleArray().size(); ++i) {
-                    m_pRtEEGSensorDataItem->addData(m_pRTMSA->getMultiSampleArray().at(i));
+                for(int i = 1; i < pRTMSA->getMultiSampleArray().size(); ++i) {
+                    m_pRtEEGSensorDataItem->addData(pRTMSA->getMultiSampleArray().at(i));
                 }
             } else if (m_pRtEEGSensorDataItem && m_slAvailableModalities.contains("EEG"))  {
                 m_pRtEEGSensorDataItem->addData(data);
@@ -368,13 +377,16 @@ void RealTimeMultiSampleArrayWidget::update(SCMEASLIB::NewMeasurement::SPtr)
                     m_pRtMEGSensorDataItem->setSFreq(m_pRTMSA->info()->sfreq);
                 }
 
-                for(int i = 1; i < m_pRTMSA->getMultiSampleArray().size(); ++i) {
-                    m_pRtMEGSensorDataItem->addData(m_pRTMSA->getMultiSampleArray().at(i));
+                for(int i = 1; i < pRTMSA->getMultiSampleArray().size(); ++i) {
+                    m_pRtMEGSensorDataItem->addData(pRTMSA->getMultiSampleArray().at(i));
                 }
             } else if (m_pRtMEGSensorDataItem && m_slAvailableModalities.contains("MEG")) {
                 m_pRtMEGSensorDataItem->addData(data);
             }
         }
+
+        if(m_pLatencyHistogram && pRTMSA->getTimestamp() > 0)
+            LatencyMonitor::instance()->record(m_pLatencyHistogram, LatencyMonitor::now() - pRTMSA->getTimestamp());
     }
 }
 
@@ -388,6 +400,8 @@ void RealTimeMultiSampleArrayWidget::init()
         QSettings settings;
         QString t_sRTMSAWName = m_pRTMSA->getName();
 
+        m_pLatencyHistogram = LatencyMonitor::instance()->histogram(QString("Display %1: end-to-end").arg(t_sRTMSAWName));
+
         //Init the model
         m_pRTMSAModel = RealTimeMultiSampleArrayModel::SPtr(new RealTimeMultiSampleArrayModel(this));
 
@@ -542,6 +556,7 @@ void RealTimeMultiSampleArrayWidget::init()
                                                 settings.value(QString("RTMSAW/%1/filterOrder").arg(t_sRTMSAWName), 128).toInt(),
                                                 settings.value(QString("RTMSAW/%1/filterType").arg(t_sRTMSAWName), 2).toInt(),
                                                 settings.value(QString("RTMSAW/%1/filterDesignMethod").arg(t_sRTMSAWName), 0).toInt(),
+                                                settings.value(QString("RTMSAW/%1/filterIIROrder").arg(t_sRTMSAWName), 4).toInt(),
                                                 settings.value(QString("RTMSAW/%1/filterTransition").arg(t_sRTMSAWName), 5.0).toDouble(),
                                                 settings.value(QString("RTMSAW/%1/filterUserDesignActive").arg(t_sRTMSAWName), false).toBool(),
                                                 settings.value(QString("RTMSAW/%1/filterChannelType").arg(t_sRTMSAWName), "MEG").toString());
@@ -115,7 +115,7 @@ namespace MNELIB {
     class MNEBem;
 }
 
-namespace SCMEASLIB{class NewRealTimeMultiSampleArray;}
+namespace SCMEASLIB{class NewRealTimeMultiSampleArray; class LatencyHistogram;}
 
 
 //*************************************************************************************************************
@@ -423,6 +423,7 @@ private:
     NewRealTimeMultiSampleArray::SPtr           m_pRTMSA;                       /**< The real-time sample array measurement. */
     SelectionManagerWindow::SPtr                m_pSelectionManagerWindow;      /**< SelectionManagerWindow. */
     FilterWindow::SPtr                          m_pFilterWindow;                /**< Filter window. */
+    SCMEASLIB::LatencyHistogram*                m_pLatencyHistogram;            /**< End-to-end latency histogram of this display, resolved in init. */
 
     bool                                        m_bInitialized;                 /**< Is Initialized */
     bool                                        m_bHideBadChannels;             /**< hide bad channels flag. */
@@ -43,6 +43,7 @@
 #include "realtimesourceestimatewidget.h"
 
 #include <scMeas/realtimesourceestimate.h>
+#include <scMeas/latencymonitor.h>
 
 #include <disp3D/engine/model/items/sourceactivity/mneestimatetreeitem.h>
 #include <disp3D/engine/view/view3D.h>
@@ -104,6 +105,7 @@ RealTimeSourceEstimateWidget::RealTimeSourceEstimateWidget(QSharedPointer<RealTi
 , m_pRTSE(pRTSE)
 , m_bInitialized(false)
 , m_pRtItem(Q_NULLPTR)
+, m_pLatencyHistogram(LatencyMonitor::instance()->histogram(QString("Display %1: end-to-end").arg(pRTSE->getName())))
 {
     m_pAction3DControl = new QAction(QIcon(":/images/3DControl.png"), tr("Shows the 3D control widget (F9)"),this);
     m_pAction3DControl->setShortcut(tr("F9"));
@@ -148,9 +150,12 @@ RealTimeSourceEstimateWidget::~RealTimeSourceEstimateWidget()
 
 //*************************************************************************************************************
 
-void RealTimeSourceEstimateWidget::update(SCMEASLIB::NewMeasurement::SPtr)
+void RealTimeSourceEstimateWidget::update(SCMEASLIB::NewMeasurement::SPtr pMeasurement)
 {
     getData();
+
+    if(pMeasurement && pMeasurement->getTimestamp() > 0)
+        LatencyMonitor::instance()->record(m_pLatencyHistogram, LatencyMonitor::now() - pMeasurement->getTimestamp());
 }
 
 
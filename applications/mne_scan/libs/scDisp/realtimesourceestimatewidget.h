@@ -80,6 +80,7 @@ namespace DISP3DLIB {
 
 namespace SCMEASLIB {
     class RealTimeSourceEstimate;
+    class LatencyHistogram;
 }
 
 
@@ -187,6 +188,8 @@ private:
 
     QAction*                                            m_pAction3DControl; /**< Show 3D View control widget */
 
+    SCMEASLIB::LatencyHistogram*                        m_pLatencyHistogram; /**< End-to-end latency histogram of this display. */
+
 signals:
     void startInit();
 };
@@ -0,0 +1,383 @@
+//=============================================================================================================
+/**
+* @file     latencymonitor.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    Contains the implementation of the LatencyMonitor class.
+*
+*/
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "latencymonitor.h"
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// Qt INCLUDES
+//=============================================================================================================
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QDebug>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <cmath>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace SCMEASLIB;
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINES
+//=============================================================================================================
+
+#define BINS_PER_OCTAVE 8
+#define NUM_BINS        (40*BINS_PER_OCTAVE)    // covers 1 ns up to about 18 min
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// STATIC HELPERS
+//=============================================================================================================
+
+static QElapsedTimer startedTimer()
+{
+    QElapsedTimer timer;
+    timer.start();
+    return timer;
+}
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+LatencyHistogram::LatencyHistogram()
+: m_qVecBins(NUM_BINS, 0)
+, m_iCount(0)
+, m_iSum(0)
+, m_iMax(0)
+{
+}
+
+
+//*************************************************************************************************************
+
+void LatencyHistogram::record(qint64 iNsecs)
+{
+    if(iNsecs < 1)
+        iNsecs = 1;
+
+    int iBin = (int)(std::log2((double)iNsecs) * BINS_PER_OCTAVE);
+    if(iBin >= NUM_BINS)
+        iBin = NUM_BINS - 1;
+
+    ++m_qVecBins[iBin];
+    ++m_iCount;
+    m_iSum += iNsecs;
+    if(iNsecs > m_iMax)
+        m_iMax = iNsecs;
+}
+
+
+//*************************************************************************************************************
+
+qint64 LatencyHistogram::percentile(double dFraction) const
+{
+    if(m_iCount == 0)
+        return 0;
+
+    qint64 iRank = (qint64)std::ceil(dFraction * m_iCount);
+    if(iRank < 1)
+        iRank = 1;
+
+    qint64 iSeen = 0;
+    for(int i = 0; i < NUM_BINS; ++i) {
+        iSeen += m_qVecBins[i];
+        if(iSeen >= iRank) {
+            //Upper edge of the bin, but never beyond the exact maximum
+            qint64 iUpper = (qint64)std::pow(2.0, (double)(i + 1) / BINS_PER_OCTAVE);
+            return iUpper < m_iMax ? iUpper : m_iMax;
+        }
+    }
+
+    return m_iMax;
+}
+
+
+//*************************************************************************************************************
+
+void LatencyHistogram::clear()
+{
+    m_qVecBins.fill(0);
+    m_iCount = 0;
+    m_iSum = 0;
+    m_iMax = 0;
+}
+
+
+//*************************************************************************************************************
+
+LatencyMonitor::LatencyMonitor()
+: m_iEnabled(1)
+{
+}
+
+
+//*************************************************************************************************************
+
+LatencyMonitor::~LatencyMonitor()
+{
+    qDeleteAll(m_qMapHistograms);
+}
+
+
+//*************************************************************************************************************
+
+LatencyMonitor* LatencyMonitor::instance()
+{
+    static LatencyMonitor s_monitor;
+    return &s_monitor;
+}
+
+
+//*************************************************************************************************************
+
+qint64 LatencyMonitor::now()
+{
+    static const QElapsedTimer s_timer = startedTimer();
+
+    //Offset by one so that 0 can mark blocks with unknown origin
+    return s_timer.nsecsElapsed() + 1;
+}
+
+
+//*************************************************************************************************************
+
+void LatencyMonitor::setEnabled(bool bEnabled)
+{
+    m_iEnabled.storeRelease(bEnabled ? 1 : 0);
+}
+
+
+//*************************************************************************************************************
+
+void LatencyMonitor::record(const QString &sName, qint64 iNsecs)
+{
+    if(!isEnabled())
+        return;
+
+    QMutexLocker locker(&m_qMutex);
+    histogramLocked(sName)->record(iNsecs);
+}
+
+
+//*************************************************************************************************************
+
+void LatencyMonitor::record(LatencyHistogram *pHistogram, qint64 iNsecs)
+{
+    if(!isEnabled())
+        return;
+
+    QMutexLocker locker(&m_qMutex);
+    pHistogram->record(iNsecs);
+}
+
+
+//*************************************************************************************************************
+
+LatencyHistogram* LatencyMonitor::histogram(const QString &sName)
+{
+    QMutexLocker locker(&m_qMutex);
+    return histogramLocked(sName);
+}
+
+
+//*************************************************************************************************************
+
+void LatencyMonitor::inputArrived(const void *pPlugin, qint64 iOrigin)
+{
+    if(!isEnabled())
+        return;
+
+    qint64 iNow = now();
+
+    QMutexLocker locker(&m_qMutex);
+
+    QHash<const void*, InstanceState>::iterator it = m_qHashInstances.find(pPlugin);
+    if(it == m_qHashInstances.end()) {
+        InstanceState state;
+        state.pCompute = 0;
+        state.pEndToEnd = 0;
+        it = m_qHashInstances.insert(pPlugin, state);
+    }
+
+    it->iOrigin = iOrigin;
+    it->iArrival = iNow;
+}
+
+
+//*************************************************************************************************************
+
+qint64 LatencyMonitor::outputEmitted(const void *pPlugin, const QString &sPlugin)
+{
+    qint64 iNow = now();
+
+    if(!isEnabled())
+        return iNow;
+
+    QMutexLocker locker(&m_qMutex);
+
+    //Sources have no inputs, their blocks originate here
+    QHash<const void*, InstanceState>::iterator it = m_qHashInstances.find(pPlugin);
+    if(it == m_qHashInstances.end())
+        return iNow;
+
+    if(!it->pCompute) {
+        it->pCompute = histogramLocked(sPlugin + QLatin1String(": compute"));
+        it->pEndToEnd = histogramLocked(sPlugin + QLatin1String(": end-to-end"));
+    }
+
+    it->pCompute->record(iNow - it->iArrival);
+
+    if(it->iOrigin > 0) {
+        it->pEndToEnd->record(iNow - it->iOrigin);
+        return it->iOrigin;
+    }
+
+    return iNow;
+}
+
+
+//*************************************************************************************************************
+
+void LatencyMonitor::removeInstance(const void *pPlugin)
+{
+    QMutexLocker locker(&m_qMutex);
+    m_qHashInstances.remove(pPlugin);
+}
+
+
+//*************************************************************************************************************
+
+QList<LatencyMonitor::Statistics> LatencyMonitor::getStatistics() const
+{
+    QList<Statistics> qListStatistics;
+
+    QMutexLocker locker(&m_qMutex);
+
+    QMap<QString, LatencyHistogram*>::const_iterator it;
+    for(it = m_qMapHistograms.constBegin(); it != m_qMapHistograms.constEnd(); ++it) {
+        const LatencyHistogram* pHistogram = it.value();
+        if(pHistogram->count() == 0)
+            continue;
+
+        Statistics stats;
+        stats.sName = it.key();
+        stats.iCount = pHistogram->count();
+        stats.dMean = pHistogram->mean() / 1.0e6;
+        stats.dP50 = pHistogram->percentile(0.5) / 1.0e6;
+        stats.dP99 = pHistogram->percentile(0.99) / 1.0e6;
+        stats.dMax = pHistogram->max() / 1.0e6;
+        qListStatistics.append(stats);
+    }
+
+    return qListStatistics;
+}
+
+
+//*************************************************************************************************************
+
+bool LatencyMonitor::exportToFile(const QString &sFileName) const
+{
+    QFile file(sFileName);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning() << "LatencyMonitor::exportToFile - Could not open" << sFileName;
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << "name\tcount\tmean_ms\tp50_ms\tp99_ms\tmax_ms\n";
+
+    QList<Statistics> qListStatistics = getStatistics();
+    for(int i = 0; i < qListStatistics.size(); ++i) {
+        const Statistics &stats = qListStatistics[i];
+        out << stats.sName << "\t" << stats.iCount << "\t"
+            << QString::number(stats.dMean, 'f', 3) << "\t"
+            << QString::number(stats.dP50, 'f', 3) << "\t"
+            << QString::number(stats.dP99, 'f', 3) << "\t"
+            << QString::number(stats.dMax, 'f', 3) << "\n";
+    }
+
+    return true;
+}
+
+
+//*************************************************************************************************************
+
+void LatencyMonitor::clear()
+{
+    QMutexLocker locker(&m_qMutex);
+
+    //Reset instead of removing, the histograms are referenced by their users
+    QMap<QString, LatencyHistogram*>::iterator it;
+    for(it = m_qMapHistograms.begin(); it != m_qMapHistograms.end(); ++it)
+        it.value()->clear();
+
+    m_qHashInstances.clear();
+}
+
+
+//*************************************************************************************************************
+
+LatencyHistogram* LatencyMonitor::histogramLocked(const QString &sName)
+{
+    LatencyHistogram*& pHistogram = m_qMapHistograms[sName];
+    if(!pHistogram)
+        pHistogram = new LatencyHistogram();
+
+    return pHistogram;
+}
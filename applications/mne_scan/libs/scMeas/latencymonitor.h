@@ -0,0 +1,339 @@
+//=============================================================================================================
+/**
+* @file     latencymonitor.h
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    Contains the declaration of the LatencyMonitor class.
+*
+*/
+
+#ifndef LATENCYMONITOR_H
+#define LATENCYMONITOR_H
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "scmeas_global.h"
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// Qt INCLUDES
+//=============================================================================================================
+
+#include <QString>
+#include <QVector>
+#include <QList>
+#include <QMap>
+#include <QHash>
+#include <QMutex>
+#include <QAtomicInt>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE NAMESPACE SCMEASLIB
+//=============================================================================================================
+
+namespace SCMEASLIB
+{
+
+
+//=============================================================================================================
+/**
+* Log-scale latency histogram with 8 bins per octave, i.e. the percentiles are accurate to about 9%.
+* The maximum is tracked exactly.
+*
+* @brief Latency histogram
+*/
+class SCMEASSHARED_EXPORT LatencyHistogram
+{
+public:
+    //=========================================================================================================
+    /**
+    * Constructs an empty LatencyHistogram.
+    */
+    LatencyHistogram();
+
+    //=========================================================================================================
+    /**
+    * Adds a latency to the histogram.
+    *
+    * @param[in] iNsecs     the latency in nanoseconds.
+    */
+    void record(qint64 iNsecs);
+
+    //=========================================================================================================
+    /**
+    * Returns the latency below which the given fraction of all recorded latencies lie.
+    *
+    * @param[in] dFraction  the fraction, e.g. 0.5 for the median or 0.99 for the 99th percentile.
+    *
+    * @return the percentile in nanoseconds.
+    */
+    qint64 percentile(double dFraction) const;
+
+    //=========================================================================================================
+    /**
+    * Resets the histogram.
+    */
+    void clear();
+
+    inline qint64 count() const;
+    inline qint64 max() const;
+    inline qint64 mean() const;
+
+private:
+    QVector<qint64> m_qVecBins; /**< Log-scale bins */
+    qint64  m_iCount;           /**< Number of recorded latencies */
+    qint64  m_iSum;             /**< Sum of all recorded latencies in ns */
+    qint64  m_iMax;             /**< Largest recorded latency in ns */
+};
+
+
+//=============================================================================================================
+/**
+* Collects the latencies of the mne_scan pipeline. Every block carries the time stamp of the acquisition it
+* originates from (NewMeasurement::getTimestamp), the plugin connectors report when a block arrives at and leaves a
+* plugin and the connector queues report how long a block waited. All latencies are gathered in histograms,
+* one per plugin stage and connection, which can be inspected while the pipeline is running or exported to a file.
+*
+* Histogram names follow the scheme "<plugin>: compute", "<plugin>: end-to-end", "<plugin>: queue wait" and
+* "<sender>:<output> -> <receiver>:<input>: queue wait".
+*
+* @brief Pipeline latency statistics
+*/
+class SCMEASSHARED_EXPORT LatencyMonitor
+{
+public:
+    //=========================================================================================================
+    /**
+    * Summary of one histogram, latencies are in milliseconds.
+    */
+    struct Statistics {
+        QString sName;      /**< Name of the histogram */
+        qint64  iCount;     /**< Number of recorded blocks */
+        double  dMean;      /**< Mean latency */
+        double  dP50;       /**< Median latency */
+        double  dP99;       /**< 99th percentile */
+        double  dMax;       /**< Maximal latency */
+    };
+
+    //=========================================================================================================
+    /**
+    * Returns the process wide latency monitor.
+    *
+    * @return the latency monitor.
+    */
+    static LatencyMonitor* instance();
+
+    //=========================================================================================================
+    /**
+    * Returns the current time of a monotonic clock. All time stamps of the pipeline refer to this clock.
+    *
+    * @return the current time in nanoseconds.
+    */
+    static qint64 now();
+
+    //=========================================================================================================
+    /**
+    * Enables or disables the monitoring. When disabled all record calls return immediately.
+    *
+    * @param[in] bEnabled   whether latencies should be recorded.
+    */
+    void setEnabled(bool bEnabled);
+
+    inline bool isEnabled() const;
+
+    //=========================================================================================================
+    /**
+    * Adds a latency to the named histogram, the histogram is created on first use.
+    *
+    * @param[in] sName      name of the histogram.
+    * @param[in] iNsecs     the latency in nanoseconds.
+    */
+    void record(const QString &sName, qint64 iNsecs);
+
+    //=========================================================================================================
+    /**
+    * Adds a latency to a histogram returned by histogram(). Callers which record for every block should resolve
+    * the histogram once and use this overload.
+    *
+    * @param[in] pHistogram the histogram.
+    * @param[in] iNsecs     the latency in nanoseconds.
+    */
+    void record(LatencyHistogram *pHistogram, qint64 iNsecs);
+
+    //=========================================================================================================
+    /**
+    * Returns the named histogram, the histogram is created on first use. The pointer stays valid for the lifetime
+    * of the monitor, clear() only resets the histograms.
+    *
+    * @param[in] sName      name of the histogram.
+    *
+    * @return the histogram.
+    */
+    LatencyHistogram* histogram(const QString &sName);
+
+    //=========================================================================================================
+    /**
+    * Called when a block arrives at a plugin. Remembers the origin of the block and the time of arrival to
+    * attribute the next output of the same plugin instance.
+    *
+    * @param[in] pPlugin    the receiving plugin instance.
+    * @param[in] iOrigin    acquisition time stamp of the block, 0 if unknown.
+    */
+    void inputArrived(const void *pPlugin, qint64 iOrigin);
+
+    //=========================================================================================================
+    /**
+    * Called when a plugin emits a block. Records the compute time since the last input arrived and the
+    * end-to-end latency since the acquisition of that input. Plugins without inputs (sensors) start a new block.
+    * Several instances of the same plugin are tracked separately but share the histograms of the plugin name.
+    *
+    * @param[in] pPlugin    the emitting plugin instance.
+    * @param[in] sPlugin    name of the emitting plugin.
+    *
+    * @return the acquisition time stamp the emitted block has to carry.
+    */
+    qint64 outputEmitted(const void *pPlugin, const QString &sPlugin);
+
+    //=========================================================================================================
+    /**
+    * Forgets a plugin instance. Has to be called when the instance is destroyed, otherwise a new instance at the
+    * same address would inherit its state.
+    *
+    * @param[in] pPlugin    the plugin instance.
+    */
+    void removeInstance(const void *pPlugin);
+
+    //=========================================================================================================
+    /**
+    * Returns the summaries of all histograms sorted by name. Histograms without recorded latencies are omitted.
+    *
+    * @return the statistics.
+    */
+    QList<Statistics> getStatistics() const;
+
+    //=========================================================================================================
+    /**
+    * Writes the statistics as tab separated table to a file.
+    *
+    * @param[in] sFileName  the file to write.
+    *
+    * @return true if succeeded, false otherwise.
+    */
+    bool exportToFile(const QString &sFileName) const;
+
+    //=========================================================================================================
+    /**
+    * Resets all histograms, e.g. when a new measurement is started.
+    */
+    void clear();
+
+private:
+    //=========================================================================================================
+    /**
+    * Constructs the LatencyMonitor, use instance().
+    */
+    LatencyMonitor();
+
+    //=========================================================================================================
+    /**
+    * Destroys the LatencyMonitor.
+    */
+    ~LatencyMonitor();
+
+    //=========================================================================================================
+    /**
+    * Latency bookkeeping of one plugin instance.
+    */
+    struct InstanceState {
+        qint64              iOrigin;    /**< Acquisition time stamp of the newest input, 0 if unknown */
+        qint64              iArrival;   /**< Arrival time of the newest input */
+        LatencyHistogram*   pCompute;   /**< The compute histogram of the plugin, resolved on the first output */
+        LatencyHistogram*   pEndToEnd;  /**< The end-to-end histogram of the plugin, resolved on the first output */
+    };
+
+    //=========================================================================================================
+    /**
+    * Returns the named histogram, m_qMutex has to be locked.
+    *
+    * @param[in] sName      name of the histogram.
+    *
+    * @return the histogram.
+    */
+    LatencyHistogram* histogramLocked(const QString &sName);
+
+    mutable QMutex                              m_qMutex;           /**< Guards histograms and inputs */
+    QAtomicInt                                  m_iEnabled;         /**< Whether latencies are recorded (0 or 1) */
+    QMap<QString, LatencyHistogram*>            m_qMapHistograms;   /**< Histograms by name, owned by the monitor */
+    QHash<const void*, InstanceState>           m_qHashInstances;   /**< Plugin instance -> its newest input and histograms */
+};
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline qint64 LatencyHistogram::count() const
+{
+    return m_iCount;
+}
+
+
+//*************************************************************************************************************
+
+inline qint64 LatencyHistogram::max() const
+{
+    return m_iMax;
+}
+
+
+//*************************************************************************************************************
+
+inline qint64 LatencyHistogram::mean() const
+{
+    return m_iCount > 0 ? m_iSum / m_iCount : 0;
+}
+
+
+//*************************************************************************************************************
+
+inline bool LatencyMonitor::isEnabled() const
+{
+    return m_iEnabled.loadAcquire() != 0;
+}
+
+} // NAMESPACE
+
+#endif // LATENCYMONITOR_H
@@ -58,6 +58,7 @@ NewMeasurement::NewMeasurement(int type, QObject *parent)
 : QObject(parent)
 , m_iMetaTypeId(type)
 , m_bVisibility(true)
+, m_iTimestamp(0)
 {
 //    qWarning() << "QMetaType" << type;
 }
@@ -69,3 +70,11 @@ NewMeasurement::~NewMeasurement()
 {
 
 }
+
+
+//*************************************************************************************************************
+
+NewMeasurement::SPtr NewMeasurement::takeSnapshot()
+{
+    return NewMeasurement::SPtr();
+}
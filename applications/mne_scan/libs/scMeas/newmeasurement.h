@@ -125,6 +125,33 @@ public:
     */
     inline int type() const;
 
+    //=========================================================================================================
+    /**
+    * Returns the acquisition time stamp of the current data block, see LatencyMonitor::now().
+    *
+    * @return the time stamp in nanoseconds, 0 if unknown.
+    */
+    inline qint64 getTimestamp() const;
+
+    //=========================================================================================================
+    /**
+    * Sets the acquisition time stamp of the current data block. The plugin connectors set it on every emitted
+    * block, so it travels with the data through the pipeline.
+    *
+    * @param[in] iTimestamp     the time stamp in nanoseconds.
+    */
+    inline void setTimestamp(qint64 iTimestamp);
+
+    //=========================================================================================================
+    /**
+    * Hands the data gathered since the last notify() over to a new measurement of the same type. The returned
+    * block is not changed afterwards, so all receivers can share it and read it from their own threads.
+    * Measurements which do not support this return a null pointer and are delivered as they are.
+    *
+    * @return the data block, or a null pointer if not supported.
+    */
+    virtual SPtr takeSnapshot();
+
 signals:
     void notify();
 
@@ -142,6 +169,7 @@ private:
     int     m_iMetaTypeId;      /**< QMetaType id of the Measurement */
     QString m_qString_Name;     /**< Name of the Measurement */
     bool    m_bVisibility;      /**< Visibility status */
+    qint64  m_iTimestamp;       /**< Acquisition time stamp of the current block in ns */
 };
 
 
@@ -201,6 +229,24 @@ inline int NewMeasurement::type() const
     return m_iMetaTypeId;
 }
 
+
+//*************************************************************************************************************
+
+inline qint64 NewMeasurement::getTimestamp() const
+{
+    QMutexLocker locker(&m_qMutex);
+    return m_iTimestamp;
+}
+
+
+//*************************************************************************************************************
+
+inline void NewMeasurement::setTimestamp(qint64 iTimestamp)
+{
+    QMutexLocker locker(&m_qMutex);
+    m_iTimestamp = iTimestamp;
+}
+
 } //NAMESPACE
 
 Q_DECLARE_METATYPE(SCMEASLIB::NewMeasurement::SPtr)
@@ -270,6 +270,29 @@ void NewRealTimeMultiSampleArray::setValue(const MatrixXd& mat)
 }
 
 
+//*************************************************************************************************************
+
+NewMeasurement::SPtr NewRealTimeMultiSampleArray::takeSnapshot()
+{
+    NewRealTimeMultiSampleArray::SPtr pBlock(new NewRealTimeMultiSampleArray);
+
+    pBlock->setName(getName());
+    pBlock->setVisibility(isVisible());
+
+    QMutexLocker locker(&m_qMutex);
+    pBlock->m_pFiffInfo_orig = m_pFiffInfo_orig;
+    pBlock->m_slDisplayFlag = m_slDisplayFlag;
+    pBlock->m_sXMLLayoutFile = m_sXMLLayoutFile;
+    pBlock->m_dSamplingRate = m_dSamplingRate;
+    pBlock->m_iMultiArraySize = m_iMultiArraySize;
+    pBlock->m_qListChInfo = m_qListChInfo;
+    pBlock->m_bChInfoIsInit = m_bChInfoIsInit;
+    pBlock->m_matSamples.swap(m_matSamples);
+
+    return pBlock;
+}
+
+
 //*************************************************************************************************************
 
 //void NewRealTimeMultiSampleArray::setValue(MatrixXd& v)
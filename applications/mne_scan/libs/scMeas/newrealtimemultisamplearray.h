@@ -237,6 +237,15 @@ public:
     */
     virtual void setValue(const MatrixXd& mat);
 
+    //=========================================================================================================
+    /**
+    * Moves the gathered multi sample array into a new NewRealTimeMultiSampleArray which shares the channel
+    * and Fiff info. No sample data is copied.
+    *
+    * @return the data block.
+    */
+    virtual NewMeasurement::SPtr takeSnapshot();
+
     //=========================================================================================================
     /**
     * Attaches a value to the sample array vector.
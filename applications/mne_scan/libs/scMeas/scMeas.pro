@@ -88,7 +88,8 @@ SOURCES += \
     realtimeevoked.cpp \
     realtimeevokedset.cpp \
     realtimecov.cpp \
-    frequencyspectrum.cpp
+    frequencyspectrum.cpp \
+    latencymonitor.cpp
 
 
 HEADERS += \
@@ -104,7 +105,8 @@ HEADERS += \
     realtimeevoked.h \
     realtimeevokedset.h \
     realtimecov.h \
-    frequencyspectrum.h
+    frequencyspectrum.h \
+    latencymonitor.h
 
 
 INCLUDEPATH += $${EIGEN_INCLUDE_DIR}
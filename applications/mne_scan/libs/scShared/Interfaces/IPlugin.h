@@ -46,6 +46,8 @@
 #include "../Management/pluginoutputdata.h"
 #include "../Management/plugininputdata.h"
 
+#include <scMeas/latencymonitor.h>
+
 
 //*************************************************************************************************************
 //=============================================================================================================
@@ -115,7 +117,7 @@ public:
     /**
     * Destroys the IPlugin.
     */
-    virtual ~IPlugin() {}
+    virtual ~IPlugin() { SCMEASLIB::LatencyMonitor::instance()->removeInstance(this); }
 
     //=========================================================================================================
     /**
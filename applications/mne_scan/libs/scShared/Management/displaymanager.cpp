@@ -39,6 +39,7 @@
 //=============================================================================================================
 
 #include "displaymanager.h"
+#include "pluginconnectorqueue.h"
 
 
 #include <scDisp/realtimesamplearraywidget.h>
@@ -126,6 +127,8 @@ QWidget* DisplayManager::show(IPlugin::OutputConnectorList &outputConnectorList,
 
     qListActions.clear();
 
+    //Multi sample arrays are handed out as immutable blocks and are queued, so the producer does not wait for the
+    //GUI thread. All other measurements share one object with the producer and need a blocking connection.
     foreach (QSharedPointer< PluginOutputConnector > pPluginOutputConnector, outputConnectorList)
     {
         if(pPluginOutputConnector.dynamicCast< PluginOutputData<NewRealTimeSampleArray> >())
@@ -150,8 +153,19 @@ QWidget* DisplayManager::show(IPlugin::OutputConnectorList &outputConnectorList,
             qListActions.append(rtmsaWidget->getDisplayActions());
             qListWidgets.append(rtmsaWidget->getDisplayWidgets());
 
-            connect(pPluginOutputConnector.data(), &PluginOutputConnector::notify,
-                    rtmsaWidget, &RealTimeMultiSampleArrayWidget::update, Qt::BlockingQueuedConnection);
+            //The producer enqueues from its own thread -> the queue must outlive the widget, it is stopped and
+            //disconnected when the widget is destroyed and deleted in its own thread.
+            QString sName = QString("%1:%2 -> Display").arg(pPluginOutputConnector->getPluginName()).arg(pPluginOutputConnector->getName());
+            PluginConnectorQueue::SPtr pQueue(new PluginConnectorQueue(sName, QString("Display"), rtmsaWidget), &QObject::deleteLater);
+
+            connect(pQueue.data(), &PluginConnectorQueue::delivered,
+                    rtmsaWidget, &RealTimeMultiSampleArrayWidget::update, Qt::DirectConnection);
+            m_qHashQueueConnections.insert(rtmsaWidget, connect(pPluginOutputConnector.data(), &PluginOutputConnector::notify,
+                                                                pQueue.data(), &PluginConnectorQueue::enqueue, Qt::DirectConnection));
+            m_qHashQueues.insert(rtmsaWidget, pQueue);
+
+            connect(rtmsaWidget, &QObject::destroyed,
+                    this, &DisplayManager::onDisplayWidgetDestroyed);
 
             vboxLayout->addWidget(rtmsaWidget);
             rtmsaWidget->init();
@@ -273,5 +287,25 @@ QWidget* DisplayManager::show(IPlugin::OutputConnectorList &outputConnectorList,
 void DisplayManager::clean()
 {
     qDebug() << "DisplayManager::clean()";
+
+    foreach(QMetaObject::Connection connection, m_qHashQueueConnections)
+        disconnect(connection);
+    m_qHashQueueConnections.clear();
+
+    foreach(PluginConnectorQueue::SPtr pQueue, m_qHashQueues)
+        pQueue->stop();
+    m_qHashQueues.clear();
+}
+
+
+//*************************************************************************************************************
+
+void DisplayManager::onDisplayWidgetDestroyed(QObject* pWidget)
+{
+    if(m_qHashQueueConnections.contains(pWidget))
+        disconnect(m_qHashQueueConnections.take(pWidget));
+
+    if(m_qHashQueues.contains(pWidget))
+        m_qHashQueues.take(pWidget)->stop();
 }
 
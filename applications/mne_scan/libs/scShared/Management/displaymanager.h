@@ -44,6 +44,7 @@
 
 #include "../scshared_global.h"
 #include "../Interfaces/IPlugin.h"
+#include "pluginconnectorqueue.h"
 
 
 //*************************************************************************************************************
@@ -121,8 +122,19 @@ public:
     void clean();
 
 private:
+    //=========================================================================================================
+    /**
+    * Stops the queue which feeds a display widget and disconnects it from the producer.
+    *
+    * @param [in] pWidget   the destroyed display widget
+    */
+    void onDisplayWidgetDestroyed(QObject* pWidget);
+
     QList<QMetaObject::Connection>   m_pListWidgetConnections;       /**< all widget connections.*/
 
+    QHash<QObject*, PluginConnectorQueue::SPtr>     m_qHashQueues;              /**< The queues which feed the display widgets, owned here since the producers enqueue from their own threads.*/
+    QHash<QObject*, QMetaObject::Connection>        m_qHashQueueConnections;    /**< The producer connections of the queues.*/
+
 };
 
 } // NAMESPACE
@@ -62,3 +62,11 @@ PluginConnector::PluginConnector(IPlugin *parent, const QString &name, const QSt
 , m_sDescription(descr)
 {
 }
+
+
+//*************************************************************************************************************
+
+QString PluginConnector::getPluginName() const
+{
+    return m_pPlugin ? m_pPlugin->getName() : QString();
+}
@@ -125,6 +125,14 @@ public:
      */
     inline QString getName() const;
 
+    //=========================================================================================================
+    /**
+     * Returns the name of the plugin the connector belongs to.
+     *
+     * @return the plugin name
+     */
+    QString getPluginName() const;
+
 signals:
 
 
@@ -68,6 +68,8 @@ PluginConnectorConnection::PluginConnectorConnection(IPlugin::SPtr sender, IPlug
 : QObject(parent)
 , m_pSender(sender)
 , m_pReceiver(receiver)
+, m_queuePolicy(PluginConnectorQueue::Block)
+, m_iMaxQueueSize(32)
 {
     createConnection();
 }
@@ -90,6 +92,36 @@ void PluginConnectorConnection::clearConnection()
         disconnect(it.value());
 
     m_qHashConnections.clear();
+
+    foreach(PluginConnectorQueue::SPtr pQueue, m_qHashQueues)
+        pQueue->stop();
+
+    m_qHashQueues.clear();
+}
+
+
+//*************************************************************************************************************
+
+void PluginConnectorConnection::setQueuePolicy(PluginConnectorQueue::QueuePolicy policy, qint32 iMaxQueueSize)
+{
+    m_queuePolicy = policy;
+    m_iMaxQueueSize = iMaxQueueSize;
+
+    foreach(PluginConnectorQueue::SPtr pQueue, m_qHashQueues)
+        pQueue->setQueuePolicy(policy, iMaxQueueSize);
+}
+
+
+//*************************************************************************************************************
+
+qint64 PluginConnectorConnection::getDroppedBlocks() const
+{
+    qint64 iDropped = 0;
+
+    foreach(PluginConnectorQueue::SPtr pQueue, m_qHashQueues)
+        iDropped += pQueue->getDroppedBlocks();
+
+    return iDropped;
 }
 
 
@@ -116,8 +148,8 @@ bool PluginConnectorConnection::createConnection()
             QSharedPointer< PluginInputData<NewRealTimeSampleArray> > receiverRTSA = m_pReceiver->getInputConnectors()[j].dynamicCast< PluginInputData<NewRealTimeSampleArray> >();
             if(senderRTSA && receiverRTSA)
             {
-                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(), m_pReceiver->getInputConnectors()[j]->getName()), connect(m_pSender->getOutputConnectors()[i].data(), &PluginOutputConnector::notify,
-                        m_pReceiver->getInputConnectors()[j].data(), &PluginInputConnector::update, Qt::BlockingQueuedConnection));
+                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(), m_pReceiver->getInputConnectors()[j]->getName()),
+                                          connectConnectors(m_pSender->getOutputConnectors()[i], m_pReceiver->getInputConnectors()[j]));
                 bConnected = true;
                 break;
             }
@@ -127,8 +159,8 @@ bool PluginConnectorConnection::createConnection()
             QSharedPointer< PluginInputData<NewRealTimeMultiSampleArray> > receiverRTMSA = m_pReceiver->getInputConnectors()[j].dynamicCast< PluginInputData<NewRealTimeMultiSampleArray> >();
             if(senderRTMSA && receiverRTMSA)
             {
-                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(), m_pReceiver->getInputConnectors()[j]->getName()), connect(m_pSender->getOutputConnectors()[i].data(), &PluginOutputConnector::notify,
-                        m_pReceiver->getInputConnectors()[j].data(), &PluginInputConnector::update, Qt::BlockingQueuedConnection));
+                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(), m_pReceiver->getInputConnectors()[j]->getName()),
+                                          connectConnectors(m_pSender->getOutputConnectors()[i], m_pReceiver->getInputConnectors()[j]));
                 bConnected = true;
                 break;
             }
@@ -138,8 +170,8 @@ bool PluginConnectorConnection::createConnection()
             QSharedPointer< PluginInputData<RealTimeEvoked> > receiverRTE = m_pReceiver->getInputConnectors()[j].dynamicCast< PluginInputData<RealTimeEvoked> >();
             if(senderRTE && receiverRTE)
             {
-                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(), m_pReceiver->getInputConnectors()[j]->getName()), connect(m_pSender->getOutputConnectors()[i].data(), &PluginOutputConnector::notify,
-                        m_pReceiver->getInputConnectors()[j].data(), &PluginInputConnector::update, Qt::BlockingQueuedConnection));
+                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(), m_pReceiver->getInputConnectors()[j]->getName()),
+                                          connectConnectors(m_pSender->getOutputConnectors()[i], m_pReceiver->getInputConnectors()[j]));
                 bConnected = true;
                 break;
             }
@@ -149,8 +181,8 @@ bool PluginConnectorConnection::createConnection()
             QSharedPointer< PluginInputData<RealTimeEvokedSet> > receiverRTESet = m_pReceiver->getInputConnectors()[j].dynamicCast< PluginInputData<RealTimeEvokedSet> >();
             if(senderRTESet && receiverRTESet)
             {
-                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(), m_pReceiver->getInputConnectors()[j]->getName()), connect(m_pSender->getOutputConnectors()[i].data(), &PluginOutputConnector::notify,
-                        m_pReceiver->getInputConnectors()[j].data(), &PluginInputConnector::update, Qt::BlockingQueuedConnection));
+                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(), m_pReceiver->getInputConnectors()[j]->getName()),
+                                          connectConnectors(m_pSender->getOutputConnectors()[i], m_pReceiver->getInputConnectors()[j]));
                 bConnected = true;
                 break;
             }
@@ -160,8 +192,8 @@ bool PluginConnectorConnection::createConnection()
             QSharedPointer< PluginInputData<RealTimeCov> > receiverRTC = m_pReceiver->getInputConnectors()[j].dynamicCast< PluginInputData<RealTimeCov> >();
             if(senderRTC && receiverRTC)
             {
-                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(), m_pReceiver->getInputConnectors()[j]->getName()), connect(m_pSender->getOutputConnectors()[i].data(), &PluginOutputConnector::notify,
-                        m_pReceiver->getInputConnectors()[j].data(), &PluginInputConnector::update, Qt::BlockingQueuedConnection));
+                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(), m_pReceiver->getInputConnectors()[j]->getName()),
+                                          connectConnectors(m_pSender->getOutputConnectors()[i], m_pReceiver->getInputConnectors()[j]));
                 bConnected = true;
                 break;
             }
@@ -171,8 +203,8 @@ bool PluginConnectorConnection::createConnection()
             QSharedPointer< PluginInputData<RealTimeSourceEstimate> > receiverRTSE = m_pReceiver->getInputConnectors()[j].dynamicCast< PluginInputData<RealTimeSourceEstimate> >();
             if(senderRTSE && receiverRTSE)
             {
-                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(), m_pReceiver->getInputConnectors()[j]->getName()), connect(m_pSender->getOutputConnectors()[i].data(), &PluginOutputConnector::notify,
-                        m_pReceiver->getInputConnectors()[j].data(), &PluginInputConnector::update, Qt::BlockingQueuedConnection));
+                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(), m_pReceiver->getInputConnectors()[j]->getName()),
+                                          connectConnectors(m_pSender->getOutputConnectors()[i], m_pReceiver->getInputConnectors()[j]));
                 bConnected = true;
                 break;
             }
@@ -192,6 +224,40 @@ bool PluginConnectorConnection::createConnection()
 }
 
 
+//*************************************************************************************************************
+
+QMetaObject::Connection PluginConnectorConnection::connectConnectors(PluginOutputConnector::SPtr pOutput, PluginInputConnector::SPtr pInput)
+{
+    //Multi sample arrays are handed out as immutable blocks -> queue them without blocking the producer
+    if(getDataType(pOutput) == ConnectorDataType::_RTMSA) {
+        QString sName = QString("%1:%2 -> %3:%4").arg(pOutput->getPluginName()).arg(pOutput->getName()).arg(pInput->getPluginName()).arg(pInput->getName());
+        PluginConnectorQueue::SPtr pQueue(new PluginConnectorQueue(sName, pInput, m_queuePolicy, m_iMaxQueueSize), &QObject::deleteLater);
+        m_qHashQueues.insert(QPair<QString,QString>(pOutput->getName(), pInput->getName()), pQueue);
+
+        return connect(pOutput.data(), &PluginOutputConnector::notify,
+                       pQueue.data(), &PluginConnectorQueue::enqueue, Qt::DirectConnection);
+    }
+
+    //The other measurements are shared with the producer, which changes them right after notify -> the producer has to wait
+    return connect(pOutput.data(), &PluginOutputConnector::notify,
+                   pInput.data(), &PluginInputConnector::update, Qt::BlockingQueuedConnection);
+}
+
+
+//*************************************************************************************************************
+
+void PluginConnectorConnection::disconnectConnectors(const QPair<QString, QString>& pair)
+{
+    disconnect(m_qHashConnections[pair]);
+    m_qHashConnections.remove(pair);
+
+    if(m_qHashQueues.contains(pair)) {
+        m_qHashQueues[pair]->stop();
+        m_qHashQueues.remove(pair);
+    }
+}
+
+
 //*************************************************************************************************************
 
 ConnectorDataType PluginConnectorConnection::getDataType(QSharedPointer<PluginConnector> pPluginConnector)
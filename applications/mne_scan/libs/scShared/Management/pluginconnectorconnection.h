@@ -46,6 +46,7 @@
 
 #include "plugininputconnector.h"
 #include "pluginoutputconnector.h"
+#include "pluginconnectorqueue.h"
 
 
 //*************************************************************************************************************
@@ -84,7 +85,10 @@ enum ConnectorDataType
 
 //=============================================================================================================
 /**
-* Class implements plug-in connector connections.
+* Class implements plug-in connector connections. Multi sample arrays are delivered through a bounded
+* PluginConnectorQueue with the selected back-pressure policy. All other data types are not handed out as
+* immutable blocks, the producer keeps changing the shared measurement, so they are still connected with a
+* BlockingQueuedConnection and the producer waits for the receiver.
 *
 * @brief The PluginConnectorConnection class holds connector connections
 */
@@ -126,6 +130,40 @@ public:
 
     inline bool isConnected();
 
+    //=========================================================================================================
+    /**
+    * Sets the back-pressure policy of the queues which deliver multi sample array blocks to the receiver. The
+    * other data types are always delivered blocking.
+    *
+    * @param[in] policy         the back-pressure policy
+    * @param[in] iMaxQueueSize  the maximal number of queued blocks per connection
+    */
+    void setQueuePolicy(PluginConnectorQueue::QueuePolicy policy, qint32 iMaxQueueSize);
+
+    //=========================================================================================================
+    /**
+    * Returns the back-pressure policy of the queues.
+    *
+    * @return the back-pressure policy
+    */
+    inline PluginConnectorQueue::QueuePolicy getQueuePolicy() const;
+
+    //=========================================================================================================
+    /**
+    * Returns the maximal number of queued blocks per connection.
+    *
+    * @return the maximal queue size
+    */
+    inline qint32 getMaxQueueSize() const;
+
+    //=========================================================================================================
+    /**
+    * Returns the number of blocks which were dropped by the queues of this connection.
+    *
+    * @return the number of dropped blocks
+    */
+    qint64 getDroppedBlocks() const;
+
     //=========================================================================================================
     /**
     * The connector connection setup widget
@@ -143,10 +181,34 @@ private:
     */
     bool createConnection();
 
+    //=========================================================================================================
+    /**
+    * Connects an output to an input connector. Immutable data blocks are delivered through a bounded queue,
+    * all other measurements through a blocking queued connection.
+    *
+    * @param[in] pOutput    the output connector of the sender
+    * @param[in] pInput     the input connector of the receiver
+    *
+    * @return the connection
+    */
+    QMetaObject::Connection connectConnectors(PluginOutputConnector::SPtr pOutput, PluginInputConnector::SPtr pInput);
+
+    //=========================================================================================================
+    /**
+    * Removes the connection and the queue between the given connectors.
+    *
+    * @param[in] pair   the names of the output and the input connector
+    */
+    void disconnectConnectors(const QPair<QString, QString>& pair);
+
     IPlugin::SPtr m_pSender;
     IPlugin::SPtr m_pReceiver;
 
     QHash<QPair<QString, QString>, QMetaObject::Connection> m_qHashConnections; /**< QHash which holds the connections between sender and receiver QHash<QPair<Sender,Receiver>, Connection>. */
+    QHash<QPair<QString, QString>, PluginConnectorQueue::SPtr> m_qHashQueues;   /**< The delivery queues of the connections which hand out data blocks. */
+
+    PluginConnectorQueue::QueuePolicy   m_queuePolicy;      /**< Back-pressure policy of new queues. */
+    qint32                              m_iMaxQueueSize;    /**< Queue size of new queues. */
 };
 
 //*************************************************************************************************************
@@ -184,6 +246,22 @@ inline bool PluginConnectorConnection::isConnected()
     return m_qHashConnections.size() > 0 ? true : false;
 }
 
+
+//*************************************************************************************************************
+
+inline PluginConnectorQueue::QueuePolicy PluginConnectorConnection::getQueuePolicy() const
+{
+    return m_queuePolicy;
+}
+
+
+//*************************************************************************************************************
+
+inline qint32 PluginConnectorConnection::getMaxQueueSize() const
+{
+    return m_iMaxQueueSize;
+}
+
 } // NAMESPACE
 
 #endif // PLUGINCONNECTORCONNECTION_H
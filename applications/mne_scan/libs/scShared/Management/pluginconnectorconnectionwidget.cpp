@@ -128,6 +128,30 @@ PluginConnectorConnectionWidget::PluginConnectorConnectionWidget(PluginConnector
     foreach(QComboBox* m_pComboBox, m_qMapSenderToReceiverConnections)
         connect(m_pComboBox, static_cast<void (QComboBox::*)(const QString &)>(&QComboBox::currentIndexChanged), this, &PluginConnectorConnectionWidget::updateReceiver);
 
+    //Back-pressure of the queued multi sample array blocks
+    m_pComboBoxQueuePolicy = new QComboBox(this);
+    m_pComboBoxQueuePolicy->addItem(tr("Block"), PluginConnectorQueue::Block);
+    m_pComboBoxQueuePolicy->addItem(tr("Drop oldest"), PluginConnectorQueue::DropOldest);
+    m_pComboBoxQueuePolicy->addItem(tr("Coalesce"), PluginConnectorQueue::Coalesce);
+    m_pComboBoxQueuePolicy->setCurrentIndex(m_pComboBoxQueuePolicy->findData(m_pPluginConnectorConnection->getQueuePolicy()));
+    m_pComboBoxQueuePolicy->setToolTip(tr("What happens when a multi sample array block arrives at a full queue"));
+
+    m_pSpinBoxQueueSize = new QSpinBox(this);
+    m_pSpinBoxQueueSize->setRange(1, 1024);
+    m_pSpinBoxQueueSize->setValue(m_pPluginConnectorConnection->getMaxQueueSize());
+
+    layout->addWidget(new QLabel(tr("Queue policy"), this),curRow,0);
+    layout->addWidget(m_pComboBoxQueuePolicy,curRow,1);
+    ++curRow;
+    layout->addWidget(new QLabel(tr("Queue size"), this),curRow,0);
+    layout->addWidget(m_pSpinBoxQueueSize,curRow,1);
+    ++curRow;
+
+    connect(m_pComboBoxQueuePolicy, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
+            this, &PluginConnectorConnectionWidget::updateQueuePolicy);
+    connect(m_pSpinBoxQueueSize, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged),
+            this, &PluginConnectorConnectionWidget::updateQueuePolicy);
+
     layout->addWidget(bottomFiller,curRow,0);
     ++curRow;
 
@@ -177,8 +201,8 @@ void PluginConnectorConnectionWidget::updateReceiver(const QString &p_sCurrentRe
 
             m_pPluginConnectorConnection->m_qHashConnections.insert(QPair<QString,QString>(m_pPluginConnectorConnection->m_pSender->getOutputConnectors()[i]->getName(),
                                                                                            m_pPluginConnectorConnection->m_pReceiver->getInputConnectors()[j]->getName()),
-                                                                    connect(m_pPluginConnectorConnection->m_pSender->getOutputConnectors()[i].data(), &PluginOutputConnector::notify,
-                                                                            m_pPluginConnectorConnection->m_pReceiver->getInputConnectors()[j].data(), &PluginInputConnector::update, Qt::BlockingQueuedConnection));
+                                                                    m_pPluginConnectorConnection->connectConnectors(m_pPluginConnectorConnection->m_pSender->getOutputConnectors()[i],
+                                                                                                                    m_pPluginConnectorConnection->m_pReceiver->getInputConnectors()[j]));
         }
     }
 
@@ -188,9 +212,17 @@ void PluginConnectorConnectionWidget::updateReceiver(const QString &p_sCurrentRe
         if(it.value() != t_qComboBox && it.value()->currentText() == p_sCurrentReceiver)
         {
             QPair<QString, QString> t_qPair(it.key(),it.value()->currentText());
-            disconnect(m_pPluginConnectorConnection->m_qHashConnections[t_qPair]);
-            m_pPluginConnectorConnection->m_qHashConnections.remove(t_qPair);
+            m_pPluginConnectorConnection->disconnectConnectors(t_qPair);
             it.value()->setCurrentIndex(0);
         }
     }
 }
+
+
+//*************************************************************************************************************
+
+void PluginConnectorConnectionWidget::updateQueuePolicy()
+{
+    m_pPluginConnectorConnection->setQueuePolicy((PluginConnectorQueue::QueuePolicy) m_pComboBoxQueuePolicy->currentData().toInt(),
+                                                 m_pSpinBoxQueueSize->value());
+}
@@ -51,6 +51,7 @@
 #include <QLabel>
 #include <QWidget>
 #include <QComboBox>
+#include <QSpinBox>
 
 
 //*************************************************************************************************************
@@ -105,6 +106,12 @@ public:
     */
     void updateReceiver(const QString &p_sCurrentReceiver);
 
+    //=========================================================================================================
+    /**
+    * Applies the selected back-pressure policy and queue size to the connection.
+    */
+    void updateQueuePolicy();
+
 signals:
 
 public slots:
@@ -117,6 +124,9 @@ private:
 
     QMap<QString, QComboBox*> m_qMapSenderToReceiverConnections;/**< To each output a possible list of inputs. */
 
+    QComboBox*  m_pComboBoxQueuePolicy;                         /**< Back-pressure policy of the multi sample array queues. */
+    QSpinBox*   m_pSpinBoxQueueSize;                            /**< Maximal number of queued blocks. */
+
 };
 
 } // NAMESPACE
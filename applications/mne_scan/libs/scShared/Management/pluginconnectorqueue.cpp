@@ -0,0 +1,253 @@
+//=============================================================================================================
+/**
+* @file     pluginconnectorqueue.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    Contains the implementation of the PluginConnectorQueue class.
+*
+*/
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "pluginconnectorqueue.h"
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// Qt INCLUDES
+//=============================================================================================================
+
+#include <QMetaObject>
+#include <QMutexLocker>
+#include <QThread>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace SCSHAREDLIB;
+using namespace SCMEASLIB;
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+PluginConnectorQueue::PluginConnectorQueue(const QString &sName, PluginInputConnector::SPtr pReceiver, QueuePolicy policy, qint32 iMaxQueueSize)
+: QObject()
+, m_sName(sName)
+, m_pConnectionWait(LatencyMonitor::instance()->histogram(sName + QLatin1String(": queue wait")))
+, m_pReceiverWait(LatencyMonitor::instance()->histogram(pReceiver->getPluginName() + QLatin1String(": queue wait")))
+, m_pReceiver(pReceiver)
+, m_queuePolicy(policy)
+, m_iMaxQueueSize(qMax(iMaxQueueSize, 1))
+, m_iDroppedBlocks(0)
+, m_bDeliveryPending(false)
+, m_bStopped(false)
+{
+    //Deliver in the thread the input connector was used from so far
+    this->moveToThread(m_pReceiver->thread());
+}
+
+
+//*************************************************************************************************************
+
+PluginConnectorQueue::PluginConnectorQueue(const QString &sName, const QString &sReceiverName, QObject *pReceiver, QueuePolicy policy, qint32 iMaxQueueSize)
+: QObject()
+, m_sName(sName)
+, m_pConnectionWait(LatencyMonitor::instance()->histogram(sName + QLatin1String(": queue wait")))
+, m_pReceiverWait(LatencyMonitor::instance()->histogram(sReceiverName + QLatin1String(": queue wait")))
+, m_queuePolicy(policy)
+, m_iMaxQueueSize(qMax(iMaxQueueSize, 1))
+, m_iDroppedBlocks(0)
+, m_bDeliveryPending(false)
+, m_bStopped(false)
+{
+    this->moveToThread(pReceiver->thread());
+}
+
+
+//*************************************************************************************************************
+
+PluginConnectorQueue::~PluginConnectorQueue()
+{
+    stop();
+}
+
+
+//*************************************************************************************************************
+
+void PluginConnectorQueue::enqueue(NewMeasurement::SPtr pMeasurement)
+{
+    //A producer in the receiving thread would wait for itself -> deliver right away
+    if(QThread::currentThread() == this->thread()) {
+        handOver(pMeasurement);
+        return;
+    }
+
+    QMutexLocker locker(&m_qMutex);
+
+    if(m_bStopped)
+        return;
+
+    switch(m_queuePolicy) {
+        case DropOldest:
+            while(m_qQueueBlocks.size() >= m_iMaxQueueSize) {
+                m_qQueueBlocks.dequeue();
+                m_qQueueEnqueueTimes.dequeue();
+                ++m_iDroppedBlocks;
+            }
+            break;
+
+        case Block:
+            while(m_qQueueBlocks.size() >= m_iMaxQueueSize && !m_bStopped)
+                m_qQueueNotFull.wait(&m_qMutex);
+
+            if(m_bStopped)
+                return;
+            break;
+
+        case Coalesce:
+            m_iDroppedBlocks += m_qQueueBlocks.size();
+            m_qQueueBlocks.clear();
+            m_qQueueEnqueueTimes.clear();
+            break;
+    }
+
+    m_qQueueBlocks.enqueue(pMeasurement);
+    m_qQueueEnqueueTimes.enqueue(LatencyMonitor::now());
+
+    if(!m_bDeliveryPending) {
+        m_bDeliveryPending = true;
+        QMetaObject::invokeMethod(this, "deliver", Qt::QueuedConnection);
+    }
+}
+
+
+//*************************************************************************************************************
+
+void PluginConnectorQueue::setQueuePolicy(QueuePolicy policy, qint32 iMaxQueueSize)
+{
+    QMutexLocker locker(&m_qMutex);
+    m_queuePolicy = policy;
+    m_iMaxQueueSize = qMax(iMaxQueueSize, 1);
+    m_qQueueNotFull.wakeAll();
+}
+
+
+//*************************************************************************************************************
+
+void PluginConnectorQueue::stop()
+{
+    QMutexLocker locker(&m_qMutex);
+    m_bStopped = true;
+    m_qQueueBlocks.clear();
+    m_qQueueEnqueueTimes.clear();
+    m_qQueueNotFull.wakeAll();
+}
+
+
+//*************************************************************************************************************
+
+PluginConnectorQueue::QueuePolicy PluginConnectorQueue::getQueuePolicy() const
+{
+    QMutexLocker locker(&m_qMutex);
+    return m_queuePolicy;
+}
+
+
+//*************************************************************************************************************
+
+qint32 PluginConnectorQueue::getMaxQueueSize() const
+{
+    QMutexLocker locker(&m_qMutex);
+    return m_iMaxQueueSize;
+}
+
+
+//*************************************************************************************************************
+
+qint32 PluginConnectorQueue::getQueueSize() const
+{
+    QMutexLocker locker(&m_qMutex);
+    return m_qQueueBlocks.size();
+}
+
+
+//*************************************************************************************************************
+
+qint64 PluginConnectorQueue::getDroppedBlocks() const
+{
+    QMutexLocker locker(&m_qMutex);
+    return m_iDroppedBlocks;
+}
+
+
+//*************************************************************************************************************
+
+void PluginConnectorQueue::deliver()
+{
+    QQueue<NewMeasurement::SPtr> t_qQueueBlocks;
+    QQueue<qint64> t_qQueueEnqueueTimes;
+
+    {
+        QMutexLocker locker(&m_qMutex);
+        t_qQueueBlocks.swap(m_qQueueBlocks);
+        t_qQueueEnqueueTimes.swap(m_qQueueEnqueueTimes);
+        m_bDeliveryPending = false;
+        m_qQueueNotFull.wakeAll();
+    }
+
+    LatencyMonitor* pMonitor = LatencyMonitor::instance();
+
+    while(!t_qQueueBlocks.isEmpty()) {
+        qint64 iWait = LatencyMonitor::now() - t_qQueueEnqueueTimes.dequeue();
+        pMonitor->record(m_pConnectionWait, iWait);
+        pMonitor->record(m_pReceiverWait, iWait);
+
+        handOver(t_qQueueBlocks.dequeue());
+    }
+}
+
+
+//*************************************************************************************************************
+
+void PluginConnectorQueue::handOver(NewMeasurement::SPtr pMeasurement)
+{
+    if(m_pReceiver)
+        m_pReceiver->update(pMeasurement);
+    else
+        emit delivered(pMeasurement);
+}
@@ -0,0 +1,234 @@
+//=============================================================================================================
+/**
+* @file     pluginconnectorqueue.h
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    Contains the declaration of the PluginConnectorQueue class.
+*
+*/
+
+
+#ifndef PLUGINCONNECTORQUEUE_H
+#define PLUGINCONNECTORQUEUE_H
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "../scshared_global.h"
+
+#include "plugininputconnector.h"
+
+#include <scMeas/newmeasurement.h>
+#include <scMeas/latencymonitor.h>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// Qt INCLUDES
+//=============================================================================================================
+
+#include <QObject>
+#include <QMutex>
+#include <QQueue>
+#include <QSharedPointer>
+#include <QWaitCondition>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE NAMESPACE SCSHAREDLIB
+//=============================================================================================================
+
+namespace SCSHAREDLIB
+{
+
+
+//=============================================================================================================
+/**
+* Bounded queue between one output connector and one receiver, either an input connector or a display widget.
+* The producer only enqueues the shared data block and returns; the blocks are handed to the receiver in the
+* thread of the receiver. When the queue is full, the back-pressure policy decides whether the oldest block is
+* dropped, the producer waits or only the newest block is kept.
+*
+* Only measurements which hand out immutable blocks (NewMeasurement::takeSnapshot(), so far the
+* NewRealTimeMultiSampleArray) can be queued. All other measurements share one object which the producer keeps
+* changing, they are still delivered with a blocking queued connection.
+*
+* @brief Non-blocking delivery of measurement blocks to one receiver
+*/
+class SCSHAREDSHARED_EXPORT PluginConnectorQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef QSharedPointer<PluginConnectorQueue> SPtr;             /**< Shared pointer type for PluginConnectorQueue. */
+    typedef QSharedPointer<const PluginConnectorQueue> ConstSPtr;  /**< Const shared pointer type for PluginConnectorQueue. */
+
+    //=========================================================================================================
+    /**
+    * What happens when a block arrives at a full queue.
+    */
+    enum QueuePolicy
+    {
+        DropOldest,     /**< The oldest queued block is dropped. */
+        Block,          /**< The producer waits until the receiver took the queued blocks. */
+        Coalesce        /**< Only the newest block is kept. */
+    };
+
+    //=========================================================================================================
+    /**
+    * Constructs a PluginConnectorQueue which lives in the thread of the receiving input connector.
+    *
+    * @param[in] sName          name of the connection, used for the latency statistics
+    * @param[in] pReceiver      the input connector the blocks are delivered to
+    * @param[in] policy         the back-pressure policy
+    * @param[in] iMaxQueueSize  the maximal number of queued blocks
+    */
+    PluginConnectorQueue(const QString &sName, PluginInputConnector::SPtr pReceiver, QueuePolicy policy = Block, qint32 iMaxQueueSize = 32);
+
+    //=========================================================================================================
+    /**
+    * Constructs a PluginConnectorQueue which lives in the thread of the receiving object, e.g. a display widget.
+    * The blocks are handed out with the delivered() signal.
+    *
+    * @param[in] sName          name of the connection, used for the latency statistics
+    * @param[in] sReceiverName  name of the receiver, used for the latency statistics
+    * @param[in] pReceiver      the object in whose thread the blocks are delivered
+    * @param[in] policy         the back-pressure policy
+    * @param[in] iMaxQueueSize  the maximal number of queued blocks
+    */
+    PluginConnectorQueue(const QString &sName, const QString &sReceiverName, QObject *pReceiver, QueuePolicy policy = DropOldest, qint32 iMaxQueueSize = 32);
+
+    //=========================================================================================================
+    /**
+    * Destructor
+    */
+    virtual ~PluginConnectorQueue();
+
+    //=========================================================================================================
+    /**
+    * Queues a block, called in the thread of the producer.
+    *
+    * @param[in] pMeasurement   the data block
+    */
+    void enqueue(SCMEASLIB::NewMeasurement::SPtr pMeasurement);
+
+    //=========================================================================================================
+    /**
+    * Sets the back-pressure policy and the queue size.
+    *
+    * @param[in] policy         the back-pressure policy
+    * @param[in] iMaxQueueSize  the maximal number of queued blocks
+    */
+    void setQueuePolicy(QueuePolicy policy, qint32 iMaxQueueSize);
+
+    //=========================================================================================================
+    /**
+    * Drops all queued blocks and releases a waiting producer. No further blocks are accepted.
+    */
+    void stop();
+
+    //=========================================================================================================
+    /**
+    * Returns the back-pressure policy.
+    *
+    * @return the back-pressure policy
+    */
+    QueuePolicy getQueuePolicy() const;
+
+    //=========================================================================================================
+    /**
+    * Returns the maximal number of queued blocks.
+    *
+    * @return the maximal queue size
+    */
+    qint32 getMaxQueueSize() const;
+
+    //=========================================================================================================
+    /**
+    * Returns the number of blocks which wait for delivery.
+    *
+    * @return the current queue size
+    */
+    qint32 getQueueSize() const;
+
+    //=========================================================================================================
+    /**
+    * Returns the number of blocks which were dropped or replaced by a newer block.
+    *
+    * @return the number of dropped blocks
+    */
+    qint64 getDroppedBlocks() const;
+
+signals:
+    //=========================================================================================================
+    /**
+    * Emitted in the thread of the receiver for every block if no input connector is set.
+    *
+    * @param[in] pMeasurement   the data block
+    */
+    void delivered(SCMEASLIB::NewMeasurement::SPtr pMeasurement);
+
+private slots:
+    //=========================================================================================================
+    /**
+    * Hands all queued blocks to the receiver, runs in the thread of the receiver.
+    */
+    void deliver();
+
+private:
+    //=========================================================================================================
+    /**
+    * Hands one block to the input connector or emits delivered().
+    *
+    * @param[in] pMeasurement   the data block
+    */
+    void handOver(SCMEASLIB::NewMeasurement::SPtr pMeasurement);
+
+    QString                                     m_sName;                /**< Name of the connection. */
+    SCMEASLIB::LatencyHistogram*                m_pConnectionWait;      /**< Queue wait histogram of the connection. */
+    SCMEASLIB::LatencyHistogram*                m_pReceiverWait;        /**< Queue wait histogram of the receiving plugin or display. */
+    PluginInputConnector::SPtr                  m_pReceiver;            /**< The input connector the blocks are delivered to, null for other receivers. */
+
+    mutable QMutex                              m_qMutex;               /**< Guards the queue and the settings. */
+    QWaitCondition                              m_qQueueNotFull;        /**< Signaled when the queued blocks were taken. */
+    QQueue<SCMEASLIB::NewMeasurement::SPtr>     m_qQueueBlocks;         /**< The blocks which wait for delivery. */
+    QQueue<qint64>                              m_qQueueEnqueueTimes;   /**< Time stamps when the queued blocks arrived. */
+    QueuePolicy                                 m_queuePolicy;          /**< The back-pressure policy. */
+    qint32                                      m_iMaxQueueSize;        /**< The maximal number of queued blocks. */
+    qint64                                      m_iDroppedBlocks;       /**< Number of dropped blocks. */
+    bool                                        m_bDeliveryPending;     /**< Whether a deliver() call is already posted. */
+    bool                                        m_bStopped;             /**< Whether the queue accepts blocks. */
+};
+
+} // NAMESPACE
+
+#endif // PLUGINCONNECTORQUEUE_H
@@ -41,6 +41,8 @@
 #include "plugininputconnector.h"
 #include "../Interfaces/IPlugin.h"
 
+#include <scMeas/latencymonitor.h>
+
 
 //*************************************************************************************************************
 //=============================================================================================================
@@ -81,5 +83,8 @@ bool PluginInputConnector::isOutputConnector() const
 
 void PluginInputConnector::update(SCMEASLIB::NewMeasurement::SPtr pMeasurement)
 {
+    if(pMeasurement)
+        SCMEASLIB::LatencyMonitor::instance()->inputArrived(m_pPlugin, pMeasurement->getTimestamp());
+
     emit notify(pMeasurement);
 }
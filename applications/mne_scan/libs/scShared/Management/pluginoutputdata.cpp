@@ -45,6 +45,7 @@
 #include "pluginoutputdata.h"
 
 #include <scMeas/newmeasurement.h>
+#include <scMeas/latencymonitor.h>
 
 #include <QDebug>
 #include <QSharedPointer>
@@ -90,7 +91,19 @@ PluginOutputData<T>::PluginOutputData(IPlugin *parent, const QString &name, cons
 template <class T>
 void PluginOutputData<T>::update()
 {
-    emit notify(qSharedPointerDynamicCast<SCMEASLIB::NewMeasurement>(m_pMeasurement));
+    //The block carries the acquisition time stamp of the input it was computed from
+    qint64 iTimestamp = SCMEASLIB::LatencyMonitor::instance()->outputEmitted(m_pPlugin, getPluginName());
+
+    //Hand out an immutable data block if the measurement supports it, so receivers need not block the producer
+    SCMEASLIB::NewMeasurement::SPtr pBlock = m_pMeasurement->takeSnapshot();
+    if(pBlock) {
+        pBlock->setTimestamp(iTimestamp);
+        emit notify(pBlock);
+    }
+    else {
+        m_pMeasurement->setTimestamp(iTimestamp);
+        emit notify(qSharedPointerDynamicCast<SCMEASLIB::NewMeasurement>(m_pMeasurement));
+    }
 }
 
 }//Namespace
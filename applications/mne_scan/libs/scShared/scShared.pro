@@ -87,6 +87,7 @@ SOURCES += \
     Management/pluginoutputdata.cpp \
     Management/pluginconnectorconnection.cpp \
     Management/pluginconnectorconnectionwidget.cpp \
+    Management/pluginconnectorqueue.cpp \
     Management/pluginscenemanager.cpp \
     Management/displaymanager.cpp
 
@@ -104,6 +105,7 @@ HEADERS += \
     Management/pluginoutputdata.h \
     Management/pluginconnectorconnection.h \
     Management/pluginconnectorconnectionwidget.h \
+    Management/pluginconnectorqueue.h \
     Management/pluginscenemanager.h \
     Management/displaymanager.h
 
@@ -42,6 +42,8 @@
 #include <scShared/Management/pluginscenemanager.h>
 #include <scShared/Management/displaymanager.h>
 
+#include <scMeas/latencymonitor.h>
+
 //GUI
 #include "mainwindow.h"
 #include "runwidget.h"
@@ -125,6 +127,7 @@ MainWindow::MainWindow(QWidget *parent)
     createToolBars();
     createPluginDockWindow();
     createLogDockWindow();
+    createLatencyDockWindow();
 
 //    //ToDo Debug Startup
 //    writeToLog(tr("Test normal message, Max"), _LogKndMessage, _LogLvMax);
@@ -218,6 +221,92 @@ void MainWindow::saveConfiguration()
 }
 
 
+//*************************************************************************************************************
+
+void MainWindow::exportLatencyStatistics()
+{
+    writeToLog(tr("Invoked <b>File|ExportLatencyStatistics</b>"), _LogKndMessage, _LogLvMin);
+
+    QString path = QFileDialog::getSaveFileName(
+                this,
+                "Export MNE Scan Latency Statistics",
+                QStandardPaths::writableLocation(QStandardPaths::DataLocation),
+                 tr("Tab separated values (*.tsv)"));
+
+    if(path.isEmpty())
+        return;
+
+    if(SCMEASLIB::LatencyMonitor::instance()->exportToFile(path))
+        writeToLog(tr("Latency statistics written to %1").arg(path), _LogKndMessage, _LogLvNormal);
+    else
+        writeToLog(tr("Could not write latency statistics to %1").arg(path), _LogKndError, _LogLvMin);
+}
+
+
+//*************************************************************************************************************
+
+void MainWindow::logLatencyStatistics()
+{
+    QList<SCMEASLIB::LatencyMonitor::Statistics> qListStatistics = SCMEASLIB::LatencyMonitor::instance()->getStatistics();
+
+    for(int i = 0; i < qListStatistics.size(); ++i) {
+        const SCMEASLIB::LatencyMonitor::Statistics &stats = qListStatistics[i];
+        writeToLog(tr("%1 - p50 %2 ms, p99 %3 ms, max %4 ms (%5 blocks)")
+                   .arg(stats.sName)
+                   .arg(stats.dP50, 0, 'f', 2)
+                   .arg(stats.dP99, 0, 'f', 2)
+                   .arg(stats.dMax, 0, 'f', 2)
+                   .arg(stats.iCount), _LogKndMessage, _LogLvNormal);
+    }
+}
+
+
+//*************************************************************************************************************
+
+void MainWindow::updateLatencyStatistics()
+{
+    QList<SCMEASLIB::LatencyMonitor::Statistics> qListStatistics = SCMEASLIB::LatencyMonitor::instance()->getStatistics();
+
+    m_pTableWidget_Latency->setRowCount(qListStatistics.size());
+
+    for(int i = 0; i < qListStatistics.size(); ++i) {
+        const SCMEASLIB::LatencyMonitor::Statistics &stats = qListStatistics[i];
+
+        QStringList qListCells;
+        qListCells << stats.sName
+                   << QString::number(stats.dP50, 'f', 2)
+                   << QString::number(stats.dP99, 'f', 2)
+                   << QString::number(stats.dMax, 'f', 2)
+                   << QString::number(stats.iCount);
+
+        for(int j = 0; j < qListCells.size(); ++j) {
+            QTableWidgetItem* pItem = m_pTableWidget_Latency->item(i, j);
+            if(!pItem) {
+                pItem = new QTableWidgetItem();
+                if(j > 0)
+                    pItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+                m_pTableWidget_Latency->setItem(i, j, pItem);
+            }
+            pItem->setText(qListCells[j]);
+        }
+    }
+}
+
+
+//*************************************************************************************************************
+
+void MainWindow::latencyDockVisibilityChanged(bool bVisible)
+{
+    if(bVisible) {
+        updateLatencyStatistics();
+        m_pTimer_Latency->start();
+    }
+    else {
+        m_pTimer_Latency->stop();
+    }
+}
+
+
 //*************************************************************************************************************
 //Help QMenu
 void MainWindow::helpContents()
@@ -365,6 +454,10 @@ void MainWindow::createActions()
     m_pActionSaveConfig->setStatusTip(tr("Save the current configuration"));
     connect(m_pActionSaveConfig, &QAction::triggered, this, &MainWindow::saveConfiguration);
 
+    m_pActionExportLatency = new QAction(tr("Export &latency statistics..."), this);
+    m_pActionExportLatency->setStatusTip(tr("Export the latency statistics of the current measurement"));
+    connect(m_pActionExportLatency, &QAction::triggered, this, &MainWindow::exportLatencyStatistics);
+
     m_pActionExit = new QAction(tr("E&xit"), this);
     m_pActionExit->setShortcuts(QKeySequence::Quit);
     m_pActionExit->setStatusTip(tr("Exit the application"));
@@ -452,6 +545,8 @@ void MainWindow::createMenus()
     m_pMenuFile->addAction(m_pActionOpenConfig);
     m_pMenuFile->addAction(m_pActionSaveConfig);
     m_pMenuFile->addSeparator();
+    m_pMenuFile->addAction(m_pActionExportLatency);
+    m_pMenuFile->addSeparator();
     m_pMenuFile->addAction(m_pActionExit);
 
     m_pMenuView = menuBar()->addMenu(tr("&View"));
@@ -587,6 +682,40 @@ void MainWindow::createLogDockWindow()
 }
 
 
+//*************************************************************************************************************
+
+void MainWindow::createLatencyDockWindow()
+{
+    //Latency statistics per plugin and connection, polled from the latency monitor
+    m_pDockWidget_Latency = new QDockWidget(tr("Latency"), this);
+
+    m_pTableWidget_Latency = new QTableWidget(0, 5, m_pDockWidget_Latency);
+    m_pTableWidget_Latency->setHorizontalHeaderLabels(QStringList() << tr("Stage") << tr("p50 [ms]") << tr("p99 [ms]") << tr("max [ms]") << tr("Blocks"));
+    m_pTableWidget_Latency->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    m_pTableWidget_Latency->verticalHeader()->hide();
+    m_pTableWidget_Latency->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_pTableWidget_Latency->setSelectionMode(QAbstractItemView::NoSelection);
+
+    m_pDockWidget_Latency->setWidget(m_pTableWidget_Latency);
+
+    m_pDockWidget_Latency->setAllowedAreas(Qt::BottomDockWidgetArea | Qt::RightDockWidgetArea);
+    addDockWidget(Qt::BottomDockWidgetArea, m_pDockWidget_Latency);
+
+    m_pDockWidget_Latency->hide();
+
+    //Only poll while the table is shown
+    m_pTimer_Latency = new QTimer(this);
+    m_pTimer_Latency->setInterval(500);
+    connect(m_pTimer_Latency, &QTimer::timeout,
+            this, &MainWindow::updateLatencyStatistics);
+
+    connect(m_pDockWidget_Latency, &QDockWidget::visibilityChanged,
+            this, &MainWindow::latencyDockVisibilityChanged);
+
+    m_pMenuView->addAction(m_pDockWidget_Latency->toggleViewAction());
+}
+
+
 //*************************************************************************************************************
 //Plugin stuff
 void MainWindow::updatePluginWidget(SCSHAREDLIB::IPlugin::SPtr pPlugin)
@@ -690,6 +819,8 @@ void MainWindow::startMeasurement()
 {
     writeToLog(tr("Starting real-time measurement..."), _LogKndMessage, _LogLvMin);
 
+    SCMEASLIB::LatencyMonitor::instance()->clear();
+
     if(!m_pPluginSceneManager->startPlugins())
     {
         QMessageBox::information(0, tr("MNE Scan - Start"), QString(QObject::tr("Not able to start at least one sensor plugin!")), QMessageBox::Ok);
@@ -715,6 +846,8 @@ void MainWindow::stopMeasurement()
     m_pPluginSceneManager->stopPlugins();
     m_pDisplayManager->clean();
 
+    logLatencyStatistics();
+
 
     m_pPluginGui->uiSetupRunningState(false);
     uiSetupRunningState(false);
@@ -75,6 +75,7 @@ class QTimer;
 class QTime;
 class QDockWidget;
 class QTextBrowser;
+class QTableWidget;
 QT_END_NAMESPACE
 
 namespace SCSHAREDLIB
@@ -207,6 +208,7 @@ private:
     QAction*                            m_pActionNewConfig;         /**< new configuration */
     QAction*                            m_pActionOpenConfig;        /**< open configuration */
     QAction*                            m_pActionSaveConfig;        /**< save configuration */
+    QAction*                            m_pActionExportLatency;     /**< export latency statistics */
     QAction*                            m_pActionExit;              /**< exit application */
 
     QActionGroup*                       m_pActionGroupLgLv;         /**< group log level */
@@ -247,6 +249,7 @@ private:
 
     void createPluginDockWindow();                          /**< Creates plugin dock widget.*/
     void createLogDockWindow();                             /**< Creates log dock widget.*/
+    void createLatencyDockWindow();                         /**< Creates latency dock widget.*/
 
     //Plugin Management
     QDockWidget*                        m_pPluginGuiDockWidget;         /**< Dock widget which holds the plugin gui. */
@@ -258,6 +261,11 @@ private:
     QDockWidget*                        m_pDockWidget_Log;              /**< Holds the dock widget containing the log.*/
     QTextBrowser*                       m_pTextBrowser_Log;             /**< Holds the text browser for the log.*/
 
+    //Latency
+    QDockWidget*                        m_pDockWidget_Latency;          /**< Holds the dock widget containing the latency statistics.*/
+    QTableWidget*                       m_pTableWidget_Latency;         /**< Holds the table of the latency statistics.*/
+    QTimer*                             m_pTimer_Latency;               /**< Refreshes the latency table while the dock is visible.*/
+
     LogLevel                            m_eLogLevelCurrent;             /**< Holds the current log level.*/
 
     QSharedPointer<QWidget>             m_pAboutWindow;                 /**< Holds the widget containing the about information.*/
@@ -271,6 +279,10 @@ private:
     void newConfiguration();            /**< Implements new configuration tasks.*/
     void openConfiguration();           /**< Implements open configuration tasks.*/
     void saveConfiguration();           /**< Implements save configuration tasks.*/
+    void exportLatencyStatistics();     /**< Writes the latency statistics of the pipeline to a file.*/
+    void logLatencyStatistics();        /**< Writes the latency statistics of the pipeline to the log.*/
+    void updateLatencyStatistics();     /**< Refreshes the latency table with the current statistics.*/
+    void latencyDockVisibilityChanged(bool bVisible);  /**< Starts or stops refreshing the latency table.*/
 
     void helpContents();                /**< Implements help contents action.*/
 
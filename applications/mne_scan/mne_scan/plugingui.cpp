@@ -277,6 +277,10 @@ void PluginGui::loadConfig(const QString& sPath, const QString& sFileName)
 
                     SCSHAREDLIB::PluginConnectorConnection::SPtr pConnection = SCSHAREDLIB::PluginConnectorConnection::create(startItem->plugin(), endItem->plugin());
 
+                    if(e.hasAttribute("queue_policy"))
+                        pConnection->setQueuePolicy((SCSHAREDLIB::PluginConnectorQueue::QueuePolicy) e.attribute("queue_policy").toInt(),
+                                                    e.attribute("queue_size", "32").toInt());
+
                     if(pConnection->isConnected())
                     {
                         Arrow *arrow = new Arrow(startItem, endItem, pConnection);
@@ -340,6 +344,8 @@ void PluginGui::saveConfig(const QString& sPath, const QString& sFileName)
             QDomElement connection = doc.createElement("Connection");
             connection.setAttribute("sender",pConnection->getSender()->getName());
             connection.setAttribute("receiver",pConnection->getReceiver()->getName());
+            connection.setAttribute("queue_policy",(int) pConnection->getQueuePolicy());
+            connection.setAttribute("queue_size",pConnection->getMaxQueueSize());
             connections.appendChild(connection);
         }
     }
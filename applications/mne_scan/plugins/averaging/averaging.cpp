@@ -91,7 +91,7 @@ using namespace REALTIMELIB;
 Averaging::Averaging()
 : m_pAveragingInput(NULL)
 //, m_pAveragingOutput(NULL)
-, m_pAveragingBuffer(CircularMatrixBuffer<double>::SPtr())
+, m_pAveragingBuffer(RingMatrixBuffer<double>::SPtr())
 , m_bIsRunning(false)
 , m_bProcessData(false)
 , m_iPreStimSeconds(100)
@@ -268,7 +268,7 @@ void Averaging::update(SCMEASLIB::NewMeasurement::SPtr pMeasurement)
     if(pRTMSA) {
         //Check if buffer initialized
         if(!m_pAveragingBuffer) {
-            m_pAveragingBuffer = CircularMatrixBuffer<double>::SPtr(new CircularMatrixBuffer<double>(64, pRTMSA->getNumChannels(), pRTMSA->getMultiSampleArray()[0].cols()));
+            m_pAveragingBuffer = RingMatrixBuffer<double>::SPtr(new RingMatrixBuffer<double>(64, pRTMSA->getNumChannels(), pRTMSA->getMultiSampleArray()[0].cols()));
         }
 
         //Fiff information
@@ -315,7 +315,7 @@ void Averaging::update(SCMEASLIB::NewMeasurement::SPtr pMeasurement)
                 }
                 ++m_iTestCount;
 #endif
-                m_pAveragingBuffer->push(&t_mat);
+                m_pAveragingBuffer->pushSwap(t_mat);
             }
         }
     }
@@ -368,7 +368,7 @@ void Averaging::init()
 
     //Delete Buffer - will be initialized with first incoming data
     if(!m_pAveragingBuffer.isNull())
-        m_pAveragingBuffer = CircularMatrixBuffer<double>::SPtr();
+        m_pAveragingBuffer = RingMatrixBuffer<double>::SPtr();
 }
 
 
@@ -651,6 +651,8 @@ void Averaging::run()
 
     m_pRtAve->start();
 
+    MatrixXd rawSegment;
+
     while(true)
     {
         {
@@ -667,10 +669,11 @@ void Averaging::run()
 
         if(doProcessing)
         {
-            /* Dispatch the inputs */
-            MatrixXd rawSegment = m_pAveragingBuffer->pop();
-
-            m_pRtAve->append(rawSegment);
+            /* Dispatch the inputs. A paused or released buffer returns at once, do not spin on it. */
+            if(m_pAveragingBuffer->pop(rawSegment))
+                m_pRtAve->append(rawSegment);
+            else
+                msleep(10);
 
             m_qMutex.lock();
             if(m_qVecEvokedData.size() > 0)
@@ -45,7 +45,7 @@
 #include "averaging_global.h"
 
 #include <scShared/Interfaces/IAlgorithm.h>
-#include <utils/generics/circularmatrixbuffer.h>
+#include <utils/generics/ringmatrixbuffer.h>
 #include <realtime/rtProcessing/rtave.h>
 
 
@@ -276,7 +276,7 @@ private:
     SCSHAREDLIB::PluginInputData<SCMEASLIB::NewRealTimeMultiSampleArray>::SPtr  m_pAveragingInput;      /**< The RealTimeSampleArray of the Averaging input.*/
     SCSHAREDLIB::PluginOutputData<SCMEASLIB::RealTimeEvokedSet>::SPtr           m_pAveragingOutput;     /**< The RealTimeEvoked of the Averaging output.*/
 
-    IOBUFFER::CircularMatrixBuffer<double>::SPtr    m_pAveragingBuffer;                 /**< Holds incoming data.*/
+    IOBUFFER::RingMatrixBuffer<double>::SPtr        m_pAveragingBuffer;                 /**< Holds incoming data.*/
 
     QSharedPointer<AveragingSettingsWidget>         m_pAveragingWidget;                 /**< Holds averaging settings widget.*/
 
@@ -345,6 +345,7 @@ void BabyMEG::run()
 {
     MatrixXf matValue;
     qint32 size = 0;
+    qint64 iWriteErrors = 0;
 
     while(m_bIsRunning) {
         if(m_pRawMatrixBuffer) {
@@ -362,21 +363,31 @@ void BabyMEG::run()
             //Create digital trigger information
             createDigTrig(matValue);
 
-            //Write raw data to fif file
-            if(m_bWriteToFile) {
+            //Write raw data to fif file. The recording can be stopped from the GUI thread at any time, check it under the lock.
+            //Splitting only switches the writers, the files are finished and opened on the writer threads.
+            m_mutex.lock();
+            if(m_bWriteToFile && m_pRawWriter) {
                 size += matValue.rows()*matValue.cols() * 4;
 
                 if(size > MAX_DATA_LEN) {
                     size = 0;
+                    iWriteErrors = 0;
                     this->splitRecordingFile();
                 }
 
-                m_mutex.lock();
-                m_pOutfid->write_raw_buffer(matValue.cast<double>());
-                m_mutex.unlock();
+                if(!m_pRawWriter->write_raw_buffer(matValue)) {
+                    qWarning() << "BabyMEG::run - Raw writer queue is full, the buffer is written as skip. Dropped buffers:" << m_pRawWriter->droppedBuffers();
+                }
+
+                if(m_pRawWriter->writeErrors() > iWriteErrors) {
+                    iWriteErrors = m_pRawWriter->writeErrors();
+                    qWarning() << "BabyMEG::run - Raw writer could not write to" << m_sRecordFile << "Write errors:" << iWriteErrors;
+                }
             } else {
                 size = 0;
+                iWriteErrors = 0;
             }
+            m_mutex.unlock();
 
             if(m_pRTMSABabyMEG) {
                 m_pRTMSABabyMEG->data()->setValue(this->calibrate(matValue));
@@ -750,29 +761,64 @@ void BabyMEG::showSqdCtrlDialog()
 void BabyMEG::splitRecordingFile()
 {
     //qDebug() << "Split recording file";
+    //The caller holds m_mutex, so the recording cannot be stopped while the files are switched
     ++m_iSplitCount;
     QString nextFileName = m_sRecordFile.remove("_raw.fif");
     nextFileName += QString("-%1_raw.fif").arg(m_iSplitCount);
+    qint32 iSplitCount = m_iSplitCount;
+
+    //Write the link to the next file and finish the current file on its writer thread
+    m_pRawWriter->finish_writing_raw_async([nextFileName, iSplitCount](const FiffStream::SPtr& pOutfid) {
+        qint32 data;
+        pOutfid->start_block(FIFFB_REF);
+        data = FIFFV_ROLE_NEXT_FILE;
+        pOutfid->write_int(FIFF_REF_ROLE,&data);
+        pOutfid->write_string(FIFF_REF_FILE_NAME, nextFileName);
+        pOutfid->write_id(FIFF_REF_FILE_ID);//ToDo meas_id
+        data = iSplitCount - 1;
+        pOutfid->write_int(FIFF_REF_FILE_NUM, &data);
+        pOutfid->end_block(FIFFB_REF);
+    });
+    m_lFinishingRawWriters.append(m_pRawWriter);
+
+    //start next file
+    m_pRawWriter = createRawWriter(nextFileName);
 
-    //Write the link to the next file
-    qint32 data;
-    m_pOutfid->start_block(FIFFB_REF);
-    data = FIFFV_ROLE_NEXT_FILE;
-    m_pOutfid->write_int(FIFF_REF_ROLE,&data);
-    m_pOutfid->write_string(FIFF_REF_FILE_NAME, nextFileName);
-    m_pOutfid->write_id(FIFF_REF_FILE_ID);//ToDo meas_id
-    data = m_iSplitCount - 1;
-    m_pOutfid->write_int(FIFF_REF_FILE_NUM, &data);
-    m_pOutfid->end_block(FIFFB_REF);
+    releaseFinishedRawWriters();
+}
 
-    //finish file
-    m_pOutfid->finish_writing_raw();
 
-    //start next file
-    m_qFileOut.setFileName(nextFileName);
-    m_pOutfid = FiffStream::start_writing_raw(m_qFileOut, *m_pFiffInfo, m_cals, defaultMatrixXi, false);
-    fiff_int_t first = 0;
-    m_pOutfid->write_int(FIFF_FIRST_SAMPLE, &first);
+//*************************************************************************************************************
+
+FiffRawWriter::SPtr BabyMEG::createRawWriter(const QString& sFileName)
+{
+    //The writer keeps the file alive, the stream only refers to it
+    QSharedPointer<QFile> pFileOut(new QFile(sFileName));
+    FiffInfo info = *m_pFiffInfo;
+    RowVectorXd cals = m_cals;
+
+    return FiffRawWriter::SPtr(new FiffRawWriter([pFileOut, info, cals]() mutable {
+        FiffStream::SPtr pOutfid = FiffStream::start_writing_raw(*pFileOut, info, cals, defaultMatrixXi, false);
+        fiff_int_t first = 0;
+        pOutfid->write_int(FIFF_FIRST_SAMPLE, &first);
+        return pOutfid;
+    }));
+}
+
+
+//*************************************************************************************************************
+
+void BabyMEG::releaseFinishedRawWriters()
+{
+    for(int i = m_lFinishingRawWriters.size() - 1; i >= 0; --i) {
+        if(m_lFinishingRawWriters.at(i)->isFinished()) {
+            qDebug() << "BabyMEG::releaseFinishedRawWriters - Written buffers:" << m_lFinishingRawWriters.at(i)->writtenBuffers()
+                    << "Dropped buffers:" << m_lFinishingRawWriters.at(i)->droppedBuffers()
+                    << "Write errors:" << m_lFinishingRawWriters.at(i)->writeErrors()
+                    << "Max queue depth:" << m_lFinishingRawWriters.at(i)->maxQueueDepth();
+            m_lFinishingRawWriters.removeAt(i);
+        }
+    }
 }
 
 
@@ -783,11 +829,17 @@ void BabyMEG::toggleRecordingFile()
     //Setup writing to file
     if(m_bWriteToFile) {
         m_mutex.lock();
-        m_pOutfid->finish_writing_raw();
-        m_mutex.unlock();
-
         m_bWriteToFile = false;
+        if(m_pRawWriter) {
+            //The writer thread writes the remaining buffers and skips and finishes the file
+            m_pRawWriter->finish_writing_raw_async();
+            m_lFinishingRawWriters.append(m_pRawWriter);
+            m_pRawWriter.clear();
+        }
+        releaseFinishedRawWriters();
         m_iSplitCount = 0;
+        m_mutex.unlock();
+
 
         //Stop record timer
         m_pRecordTimer->stop();
@@ -807,8 +859,7 @@ void BabyMEG::toggleRecordingFile()
 
         //Initiate the stream for writing to the fif file
         m_sRecordFile = getFilePath(true);
-        m_qFileOut.setFileName(m_sRecordFile);
-        if(m_qFileOut.exists()) {
+        if(QFile::exists(m_sRecordFile)) {
             QMessageBox msgBox;
             msgBox.setText("The file you want to write already exists.");
             msgBox.setInformativeText("Do you want to overwrite this file?");
@@ -826,12 +877,9 @@ void BabyMEG::toggleRecordingFile()
 
         //Start/Prepare writing process. Actual writing is done in run() method.
         m_mutex.lock();
-        m_pOutfid = FiffStream::start_writing_raw(m_qFileOut, *m_pFiffInfo, m_cals, defaultMatrixXi, false);
-        fiff_int_t first = 0;
-        m_pOutfid->write_int(FIFF_FIRST_SAMPLE, &first);
-        m_mutex.unlock();
-
+        m_pRawWriter = createRawWriter(m_sRecordFile);
         m_bWriteToFile = true;
+        m_mutex.unlock();
 
         //Start timers for record button blinking, recording timer and updating the elapsed time in the proj widget
         m_pBlinkingRecordButtonTimer->start(500);
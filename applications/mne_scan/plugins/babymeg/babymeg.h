@@ -47,6 +47,7 @@
 
 #include <fiff/fiff_info.h>
 #include <fiff/fiff_stream.h>
+#include <fiff/fiff_raw_writer.h>
 
 #include <scShared/Interfaces/ISensor.h>
 #include <utils/generics/circularmatrixbuffer.h>
@@ -337,10 +338,27 @@ protected:
 
     //=========================================================================================================
     /**
-    * Determines current file. And starts a new one.
+    * Determines current file. And starts a new one. Must be called with m_mutex locked. The current file is
+    * finished and the next one is opened on the writer threads, so no file I/O happens under the lock.
     */
     void splitRecordingFile();
 
+    //=========================================================================================================
+    /**
+    * Creates a raw writer which opens the file and writes the measurement info on its own thread.
+    *
+    * @param[in] sFileName  The file to record to.
+    *
+    * @return the raw writer.
+    */
+    FIFFLIB::FiffRawWriter::SPtr createRawWriter(const QString& sFileName);
+
+    //=========================================================================================================
+    /**
+    * Reports and releases the raw writers which finished their files. Must be called with m_mutex locked.
+    */
+    void releaseFinishedRawWriters();
+
     //=========================================================================================================
     /**
     * Starts or stops a file recording depending on the current recording state.
@@ -417,7 +435,8 @@ protected:
     QList<int>                              m_lTriggerChannelIndices;       /**< List of all trigger channel indices. */
 
     FIFFLIB::FiffInfo::SPtr                 m_pFiffInfo;                    /**< Fiff measurement info.*/
-    FIFFLIB::FiffStream::SPtr               m_pOutfid;                      /**< FiffStream to write to.*/
+    FIFFLIB::FiffRawWriter::SPtr            m_pRawWriter;                   /**< Writes the raw buffers to the current file on a background thread.*/
+    QList<FIFFLIB::FiffRawWriter::SPtr>     m_lFinishingRawWriters;         /**< Raw writers which still finish their files.*/
 
     qint16                                  m_iBlinkStatus;                 /**< The blink status of the recording button.*/
     qint32                                  m_iBufferSize;                  /**< The raw data buffer size.*/
@@ -437,7 +456,6 @@ protected:
     QString                                 m_sFiffCompensators;            /**< Fiff compensator information */
     QString                                 m_sBadChannels;                 /**< Filename which contains a list of bad channels */
 
-    QFile                                   m_qFileOut;                     /**< QFile for writing to fif file.*/
     QMutex                                  m_mutex;                        /**< Mutex to guarantee thread safety.*/
     QTime                                   m_recordingStartedTime;         /**< The time when the recording started.*/
 
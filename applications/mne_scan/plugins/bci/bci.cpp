@@ -104,6 +104,10 @@ void BCI::init()
 {
     m_bIsRunning = false;
     m_bTriggerActivated = false;
+    m_bTriggerDetected = false;
+
+    // Capacitive touch triggers are held for at least 2 samples with a value of 254, "beep" triggers are only 1 sample wide
+    m_triggerDetector.setTriggerChannels(QList<int>() << 0, 0.5, -1, DetectTrigger::Rising, 2);
 
     // Inputs - Source estimates and sensor level
     m_pRTSEInput = PluginInputData<RealTimeSourceEstimate>::create(this, "BCIInSource", "BCI source input data");
@@ -213,6 +217,10 @@ bool BCI::start()
     m_iTBWIndexSensor = 0;
     m_iNumberOfCalculatedFeatures = 0;
 
+    // Reset trigger detection
+    m_bTriggerDetected = false;
+    m_triggerDetector.reset();
+
     // BCIFeatureWindow show and init
     if(m_bDisplayFeatures)
     {
@@ -574,10 +582,13 @@ bool BCI::hasThresholdArtefact(const QList< QPair<int,RowVectorXd> > &data)
 
 bool BCI::lookForTrigger(const MatrixXd &data)
 {
-    // Check if capacitive touch trigger signal was received - Note that there can also be "beep" triggers in the received data, which are only 1 sample wide -> therefore look for 2 samples with a value of 254 each
-    for(int i = 0; i<data.cols()-1; i++)
+    // Check if capacitive touch trigger signal was received - Note that there can also be "beep" triggers in the received data, which are only 1 sample wide -> the detector only reports codes held for 2 samples
+    // The detector keeps its state between the blocks, so every trigger is found exactly once even if it lies on a block boundary
+    const QVector<DetectTrigger::TriggerEvent>& vEvents = m_triggerDetector.detectTriggerEvents(data);
+
+    for(int i = 0; i < vEvents.size(); i++)
     {
-        if(data(0,i) == 254 && data(0,i+1) == 254) // data - corresponds with channel 136 which is the trigger channel
+        if(vEvents.at(i).iValue == 254)
             return true;
     }
 
@@ -627,6 +638,9 @@ void BCI::BCIOnSensorLevel()
 
             m_matStimChannelSensor.block(0, m_iTBWIndexSensor, 1, t_mat.cols()) = t_mat.block(136, 0, 1, t_mat.cols());
 
+            if(lookForTrigger(t_mat.block(136, 0, 1, t_mat.cols())))
+                m_bTriggerDetected = true;
+
             m_iTBWIndexSensor = m_iTBWIndexSensor + t_mat.cols();
         }
         else // m_matSlidingWindowSensor is full for the first time
@@ -649,6 +663,9 @@ void BCI::BCIOnSensorLevel()
 
             m_matTimeBetweenWindowsStimSensor.block(0, m_iTBWIndexSensor, 1, t_mat.cols()) = t_mat.block(136, 0, 1, t_mat.cols());
 
+            if(lookForTrigger(t_mat.block(136, 0, 1, t_mat.cols())))
+                m_bTriggerDetected = true;
+
             m_iTBWIndexSensor = m_iTBWIndexSensor + t_mat.cols();
         }
         else // Recalculate m_matSlidingWindowSensor -> Calculate features, classify and store results
@@ -702,10 +719,14 @@ void BCI::BCIOnSensorLevel()
 
             // ----4---- Do simple threshold artefact reduction
             //cout<<"----4----"<<endl;
+            // A trigger only counts for the window in whose new samples it was found, also if the window has artefacts
+            bool bTriggerDetected = m_bTriggerDetected;
+            m_bTriggerDetected = false;
+
             if(hasThresholdArtefact(qlMatrixRows) == false)
             {
                 // Look for trigger flag
-                if(lookForTrigger(m_matStimChannelSensor) && !m_bTriggerActivated)
+                if(bTriggerDetected && !m_bTriggerActivated)
                 {
                     // cout << "Trigger activated" << endl;
                     //QFuture<void> future = QtConcurrent::run(Beep, 450, 700);
@@ -52,6 +52,7 @@
 #include <scMeas/realtimesourceestimate.h>
 
 #include <utils/filterTools/filterdata.h>
+#include <utils/detecttrigger.h>
 
 #include <fstream>
 
@@ -230,7 +231,7 @@ protected:
 
     //=========================================================================================================
     /**
-    * Look for trigger in stim channel
+    * Look for trigger in the newly received samples of the stim channel
     *
     */
     bool lookForTrigger(const MatrixXd &data);
@@ -283,6 +284,8 @@ private:
     QString                 m_qStringResourcePath;              /**< The path to the BCI resource directory.*/
     bool                    m_bProcessData;                     /**< Whether BCI is to get data out of the continous input data stream, i.e. the EEG data from sensor level.*/
     bool                    m_bTriggerActivated;                /**< Whether the trigger was activated.*/
+    bool                    m_bTriggerDetected;                 /**< Whether a trigger was detected in the samples which were received since the last window was classified.*/
+    UTILSLIB::DetectTrigger m_triggerDetector;                  /**< Streaming trigger detector for the stim channel.*/
     QMutex                  m_qMutex;                           /**< QMutex to guarantee thread safety.*/
 
     // Sensor level
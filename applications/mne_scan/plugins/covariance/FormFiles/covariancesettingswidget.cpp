@@ -40,6 +40,18 @@ CovarianceSettingsWidget::CovarianceSettingsWidget(Covariance *toolbox, QWidget
     m_pSpinBoxNumSamples->setValue(toolbox->m_iEstimationSamples);
     connect(m_pSpinBoxNumSamples, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), m_pCovarianceToolbox, &Covariance::changeSamples);
     t_pGridLayout->addWidget(m_pSpinBoxNumSamples,0,1,1,1);
+
+    QLabel* t_pLabelMode = new QLabel;
+    t_pLabelMode->setText("Estimation Mode");
+    t_pGridLayout->addWidget(t_pLabelMode,1,0,1,1);
+
+    m_pComboBoxMode = new QComboBox;
+    m_pComboBoxMode->insertItem(RtCov::Block, "Block");
+    m_pComboBoxMode->insertItem(RtCov::ExponentialForgetting, "Exponential Forgetting");
+    m_pComboBoxMode->insertItem(RtCov::SlidingWindow, "Sliding Window");
+    m_pComboBoxMode->setCurrentIndex(toolbox->m_iEstimationMode);
+    connect(m_pComboBoxMode, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), m_pCovarianceToolbox, &Covariance::changeEstimationMode);
+    t_pGridLayout->addWidget(m_pComboBoxMode,1,1,1,1);
 //    }
     this->setLayout(t_pGridLayout);
 }
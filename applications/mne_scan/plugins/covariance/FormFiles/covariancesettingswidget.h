@@ -55,6 +55,7 @@ public slots:
 private:
     Covariance* m_pCovarianceToolbox;
     QSpinBox* m_pSpinBoxNumSamples;
+    QComboBox* m_pComboBoxMode;
 };
 
 } // NAMESPACE
@@ -72,8 +72,9 @@ Covariance::Covariance()
 , m_bProcessData(false)
 , m_pCovarianceInput(NULL)
 , m_pCovarianceOutput(NULL)
-, m_pCovarianceBuffer(CircularMatrixBuffer<double>::SPtr())
+, m_pCovarianceBuffer(RingMatrixBuffer<double>::SPtr())
 , m_iEstimationSamples(5000)
+, m_iEstimationMode(RtCov::ExponentialForgetting)
 {
     m_pActionShowAdjustment = new QAction(QIcon(":/images/covadjustments.png"), tr("Covariance Adjustments"),this);
 //    m_pActionSetupProject->setShortcut(tr("F12"));
@@ -114,6 +115,7 @@ void Covariance::init()
     //
     QSettings settings;
     m_iEstimationSamples = settings.value(QString("Plugin/%1/estimationSamples").arg(this->getName()), 5000).toInt();
+    m_iEstimationMode = settings.value(QString("Plugin/%1/estimationMode").arg(this->getName()), RtCov::ExponentialForgetting).toInt();
 
     // Input
     m_pCovarianceInput = PluginInputData<NewRealTimeMultiSampleArray>::create(this, "CovarianceIn", "Covariance input data");
@@ -126,7 +128,7 @@ void Covariance::init()
 
     //Delete Buffer - will be initailzed with first incoming data
     if(!m_pCovarianceBuffer.isNull())
-        m_pCovarianceBuffer = CircularMatrixBuffer<double>::SPtr();
+        m_pCovarianceBuffer = RingMatrixBuffer<double>::SPtr();
 }
 
 
@@ -139,6 +141,7 @@ void Covariance::unload()
     //
     QSettings settings;
     settings.setValue(QString("Plugin/%1/estimationSamples").arg(this->getName()), m_iEstimationSamples);
+    settings.setValue(QString("Plugin/%1/estimationMode").arg(this->getName()), m_iEstimationMode);
 }
 
 
@@ -219,7 +222,7 @@ void Covariance::update(SCMEASLIB::NewMeasurement::SPtr pMeasurement)
     {
         //Check if buffer initialized
         if(!m_pCovarianceBuffer)
-            m_pCovarianceBuffer = CircularMatrixBuffer<double>::SPtr(new CircularMatrixBuffer<double>(64, pRTMSA->getNumChannels(), pRTMSA->getMultiSampleArray()[0].cols()));
+            m_pCovarianceBuffer = RingMatrixBuffer<double>::SPtr(new RingMatrixBuffer<double>(64, pRTMSA->getNumChannels(), pRTMSA->getMultiSampleArray()[0].cols()));
 
         //Fiff information
         if(!m_pFiffInfo)
@@ -236,7 +239,7 @@ void Covariance::update(SCMEASLIB::NewMeasurement::SPtr pMeasurement)
             for(qint32 i = 0; i < pRTMSA->getMultiArraySize(); ++i)
             {
                 t_mat = pRTMSA->getMultiSampleArray()[i];
-                m_pCovarianceBuffer->push(&t_mat);
+                m_pCovarianceBuffer->pushSwap(t_mat);
             }
         }
     }
@@ -263,6 +266,16 @@ void Covariance::changeSamples(qint32 samples)
 }
 
 
+//*************************************************************************************************************
+
+void Covariance::changeEstimationMode(int mode)
+{
+    m_iEstimationMode = mode;
+    if(m_pRtCov)
+        m_pRtCov->setEstimationMode((RtCov::EstimationMode)m_iEstimationMode);
+}
+
+
 //*************************************************************************************************************
 
 void Covariance::run()
@@ -284,6 +297,10 @@ void Covariance::run()
     m_pRtCov = RtCov::SPtr(new RtCov(m_iEstimationSamples, m_pFiffInfo));
     connect(m_pRtCov.data(), &RtCov::covCalculated, this, &Covariance::appendCovariance);
 
+    //Continuous estimators publish a fresh covariance every second
+    m_pRtCov->setEstimationMode((RtCov::EstimationMode)m_iEstimationMode);
+    m_pRtCov->setUpdateInterval((qint32)m_pFiffInfo->sfreq);
+
     //
     // Start the rt helpers
     //
@@ -294,15 +311,19 @@ void Covariance::run()
     //
     m_bProcessData = true;
 
+    MatrixXd t_mat;
+
     while (m_bIsRunning)
     {
         if(m_bProcessData)
         {
-            /* Dispatch the inputs */
-            MatrixXd t_mat = m_pCovarianceBuffer->pop();
-
-            //Add to covariance estimation
-            m_pRtCov->append(t_mat);
+            /* Dispatch the inputs. A paused or released buffer returns at once, do not spin on it. */
+            if(m_pCovarianceBuffer->pop(t_mat)) {
+                //Add to covariance estimation
+                m_pRtCov->append(t_mat);
+            } else {
+                msleep(10);
+            }
 
             if(m_qVecCovData.size() > 0)
             {
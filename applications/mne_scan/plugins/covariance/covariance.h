@@ -45,7 +45,7 @@
 #include "covariance_global.h"
 
 #include <scShared/Interfaces/IAlgorithm.h>
-#include <utils/generics/circularmatrixbuffer.h>
+#include <utils/generics/ringmatrixbuffer.h>
 #include <scMeas/newrealtimemultisamplearray.h>
 #include <scMeas/realtimecov.h>
 #include <realtime/rtProcessing/rtcov.h>
@@ -160,6 +160,8 @@ public:
 
     void changeSamples(qint32 samples);
 
+    void changeEstimationMode(int mode);
+
 signals:
     //=========================================================================================================
     /**
@@ -178,7 +180,7 @@ private:
 
     FiffInfo::SPtr  m_pFiffInfo;                                /**< Fiff measurement info.*/
 
-    CircularMatrixBuffer<double>::SPtr   m_pCovarianceBuffer;   /**< Holds incoming data.*/
+    RingMatrixBuffer<double>::SPtr       m_pCovarianceBuffer;   /**< Holds incoming data.*/
 
     RtCov::SPtr m_pRtCov;                       /**< Real-time covariance. */
 
@@ -188,6 +190,7 @@ private:
     bool m_bProcessData;                        /**< If data should be received for processing */
 
     qint32 m_iEstimationSamples;
+    qint32 m_iEstimationMode;                   /**< RtCov::EstimationMode used for the estimation. */
 
     QSharedPointer<CovarianceSettingsWidget> m_pCovarianceWidget;
 
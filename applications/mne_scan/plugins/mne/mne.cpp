@@ -364,7 +364,7 @@ void MNE::updateRTMSA(SCMEASLIB::NewMeasurement::SPtr pMeasurement)
     if(pRTMSA && m_bReceiveData) {
         //Check if buffer initialized
         if(!m_pMatrixDataBuffer)
-            m_pMatrixDataBuffer = CircularMatrixBuffer<double>::SPtr(new CircularMatrixBuffer<double>(64, pRTMSA->getNumChannels(), pRTMSA->getMultiSampleArray()[0].cols()));
+            m_pMatrixDataBuffer = RingMatrixBuffer<double>::SPtr(new RingMatrixBuffer<double>(64, pRTMSA->getNumChannels(), pRTMSA->getMultiSampleArray()[0].cols()));
 
         //Fiff Information of the evoked
         if(!m_pFiffInfoInput) {
@@ -379,7 +379,7 @@ void MNE::updateRTMSA(SCMEASLIB::NewMeasurement::SPtr pMeasurement)
             {
                 MatrixXd t_mat = pRTMSA->getMultiSampleArray()[i];
 
-                m_pMatrixDataBuffer->push(&t_mat);
+                m_pMatrixDataBuffer->pushSwap(t_mat);
             }
         }
     }
@@ -458,6 +458,7 @@ void MNE::updateInvOp(MNEInverseOperator::SPtr p_pInvOp)
     m_qMutex.lock();
 
     m_pMinimumNorm = MinimumNorm::SPtr(new MinimumNorm(*m_pInvOp.data(), lambda2, method));
+    m_pMinimumNorm->setFastApply(true);
 
     //
     //   Set up the inverse according to the parameters
@@ -514,6 +515,7 @@ void MNE::run()
     m_bProcessData = true;
 
     qint32 skip_count = 0;
+    MatrixXd rawSegment;
 
 //    //
 //    // TEMP INV LOADING START
@@ -564,7 +566,11 @@ void MNE::run()
             //qDebug()<<"MNE::run - Processing RTMSA data";
             if(m_pMinimumNorm && ((skip_count % m_iDownSample) == 0))
             {
-                MatrixXd rawSegment = m_pMatrixDataBuffer->pop();
+                //A paused or released buffer returns at once, do not spin on it. rawSegment keeps its memory, it is swapped with the slot.
+                if(!m_pMatrixDataBuffer->pop(rawSegment, 100)) {
+                    msleep(10);
+                    continue;
+                }
 
                 float tmin = 1 / m_pFiffInfo->sfreq;
                 float tstep = 1 / m_pFiffInfo->sfreq;
@@ -45,7 +45,7 @@
 #include "mne_global.h"
 #include <scShared/Interfaces/IAlgorithm.h>
 
-#include <utils/generics/circularmatrixbuffer.h>
+#include <utils/generics/ringmatrixbuffer.h>
 
 #include <fs/annotationset.h>
 #include <fs/surfaceset.h>
@@ -214,7 +214,7 @@ private:
 
     PluginOutputData<RealTimeSourceEstimate>::SPtr          m_pRTSEOutput;          /**< The RealTimeSourceEstimate output.*/
 
-    CircularMatrixBuffer<double>::SPtr                      m_pMatrixDataBuffer;    /**< Holds incoming RealTimeMultiSampleArray data.*/
+    RingMatrixBuffer<double>::SPtr                          m_pMatrixDataBuffer;    /**< Holds incoming RealTimeMultiSampleArray data.*/
 
     QMutex m_qMutex;
 
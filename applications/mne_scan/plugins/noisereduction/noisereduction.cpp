@@ -65,7 +65,7 @@ NoiseReduction::NoiseReduction()
 : m_bIsRunning(false)
 , m_pNoiseReductionInput(NULL)
 , m_pNoiseReductionOutput(NULL)
-, m_pNoiseReductionBuffer(CircularMatrixBuffer<double>::SPtr())
+, m_pNoiseReductionBuffer(RingMatrixBuffer<double>::SPtr())
 , m_iMaxFilterTapSize(0)
 , m_bSpharaActive(false)
 , m_bFilterActivated(false)
@@ -125,6 +125,7 @@ NoiseReduction::~NoiseReduction()
             settings.setValue(QString("RTNRW/%1/filterOrder").arg(t_sRTMSAName), filter.m_iFilterOrder);
             settings.setValue(QString("RTNRW/%1/filterType").arg(t_sRTMSAName), (int)filter.m_Type);
             settings.setValue(QString("RTNRW/%1/filterDesignMethod").arg(t_sRTMSAName), (int)filter.m_designMethod);
+            settings.setValue(QString("RTNRW/%1/filterIIROrder").arg(t_sRTMSAName), filter.m_iIIROrder);
             settings.setValue(QString("RTNRW/%1/filterTransition").arg(t_sRTMSAName), filter.m_dParksWidth*(filter.m_sFreq/2));
             settings.setValue(QString("RTNRW/%1/filterUserDesignActive").arg(t_sRTMSAName), m_pFilterWindow->userDesignedFiltersIsActive());
             settings.setValue(QString("RTNRW/%1/filterChannelType").arg(t_sRTMSAName), m_pFilterWindow->getChannelType());
@@ -162,7 +163,7 @@ void NoiseReduction::init()
 
     //Delete Buffer - will be initailzed with first incoming data
     if(!m_pNoiseReductionBuffer.isNull())
-        m_pNoiseReductionBuffer = CircularMatrixBuffer<double>::SPtr();
+        m_pNoiseReductionBuffer = RingMatrixBuffer<double>::SPtr();
 
     //Handle projections
     connect(m_pOptionsWidget.data(), &NoiseReductionOptionsWidget::projSelectionChanged,
@@ -250,7 +251,7 @@ void NoiseReduction::update(SCMEASLIB::NewMeasurement::SPtr pMeasurement)
     if(m_pRTMSA) {
         //Check if buffer initialized
         if(!m_pNoiseReductionBuffer) {
-            m_pNoiseReductionBuffer = CircularMatrixBuffer<double>::SPtr(new CircularMatrixBuffer<double>(64, m_pRTMSA->getNumChannels(), m_pRTMSA->getMultiSampleArray()[0].cols()));
+            m_pNoiseReductionBuffer = RingMatrixBuffer<double>::SPtr(new RingMatrixBuffer<double>(64, m_pRTMSA->getNumChannels(), m_pRTMSA->getMultiSampleArray()[0].cols()));
         }
 
         //Fiff information
@@ -286,7 +287,7 @@ void NoiseReduction::update(SCMEASLIB::NewMeasurement::SPtr pMeasurement)
 
         for(unsigned char i = 0; i < m_pRTMSA->getMultiArraySize(); ++i) {
             t_mat = m_pRTMSA->getMultiSampleArray()[i];
-            m_pNoiseReductionBuffer->push(&t_mat);
+            m_pNoiseReductionBuffer->pushSwap(t_mat);
         }
     }
 }
@@ -482,13 +483,6 @@ void NoiseReduction::setFilterChannelType(QString sType)
 void NoiseReduction::filterChanged(QList<FilterData> filterData)
 {
     m_filterData = filterData;
-
-    m_iMaxFilterLength = 1;
-    for(int i = 0; i < filterData.size(); ++i) {
-        if(m_iMaxFilterLength<filterData.at(i).m_iFilterOrder) {
-            m_iMaxFilterLength = filterData.at(i).m_iFilterOrder;
-        }
-    }
 }
 
 
@@ -607,6 +601,7 @@ void NoiseReduction::initFilter()
                                             settings.value(QString("RTNRW/%1/filterOrder").arg(t_sRTMSAName), 128).toInt(),
                                             settings.value(QString("RTNRW/%1/filterType").arg(t_sRTMSAName), 2).toInt(),
                                             settings.value(QString("RTNRW/%1/filterDesignMethod").arg(t_sRTMSAName), 0).toInt(),
+                                            settings.value(QString("RTNRW/%1/filterIIROrder").arg(t_sRTMSAName), 4).toInt(),
                                             settings.value(QString("RTNRW/%1/filterTransition").arg(t_sRTMSAName), 5.0).toDouble(),
                                             settings.value(QString("RTNRW/%1/filterUserDesignActive").arg(t_sRTMSAName), false).toBool(),
                                             settings.value(QString("RTNRW/%1/filterChannelType").arg(t_sRTMSAName), "MEG").toString());
@@ -730,10 +725,15 @@ void NoiseReduction::run()
     initSphara();
     createSpharaOperator();
 
+    MatrixXd t_mat;
+
     while(m_bIsRunning)
     {
-        //Dispatch the inputs
-        MatrixXd t_mat = m_pNoiseReductionBuffer->pop();
+        //Dispatch the inputs. A paused or released buffer returns at once, do not spin on it.
+        if(!m_pNoiseReductionBuffer->pop(t_mat)) {
+            msleep(10);
+            continue;
+        }
 
         m_mutex.lock();
 
@@ -757,7 +757,7 @@ void NoiseReduction::run()
 
         //Do temporal filtering here
         if(m_bFilterActivated) {
-            t_mat = m_pRtFilter->filterChannelsConcurrently(t_mat, m_iMaxFilterLength, m_lFilterChannelList, m_filterData);
+            m_pRtFilter->filterChannelsInPlace(t_mat, true, m_lFilterChannelList, m_filterData);
         }
 
 //        qDebug()<<"t_mat dim:"<<t_mat.rows()<<"x"<<t_mat.cols();
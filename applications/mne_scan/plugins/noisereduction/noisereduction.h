@@ -53,7 +53,7 @@
 
 #include <realtime/rtProcessing/rtfilter.h>
 
-#include <utils/generics/circularmatrixbuffer.h>
+#include <utils/generics/ringmatrixbuffer.h>
 
 #include <scMeas/newrealtimemultisamplearray.h>
 
@@ -266,7 +266,6 @@ private:
 
     int                             m_iNBaseFctsFirst;                          /**< The number of grad/inner base functions to use for calculating the sphara opreator.*/
     int                             m_iNBaseFctsSecond;                         /**< The number of grad/outer base functions to use for calculating the sphara opreator.*/
-    int                             m_iMaxFilterLength;                         /**< Max order of the current filters */
     int                             m_iMaxFilterTapSize;                        /**< maximum number of allowed filter taps. This number depends on the size of the receiving blocks. */
 
     QString                         m_sCurrentSystem;                           /**< The current acquisition system (EEG, babyMEG, VectorView).*/
@@ -297,7 +296,7 @@ private:
 
     FIFFLIB::FiffInfo::SPtr                         m_pFiffInfo;                /**< Fiff measurement info.*/
 
-    IOBUFFER::CircularMatrixBuffer<double>::SPtr    m_pNoiseReductionBuffer;    /**< Holds incoming data.*/
+    IOBUFFER::RingMatrixBuffer<double>::SPtr        m_pNoiseReductionBuffer;    /**< Holds incoming data.*/
 
     NoiseReductionOptionsWidget::SPtr               m_pOptionsWidget;           /**< The noise reduction option widget object.*/
     QAction*                                        m_pActionShowOptionsWidget; /**< The noise reduction option widget action.*/
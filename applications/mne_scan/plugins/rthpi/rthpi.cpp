@@ -77,7 +77,7 @@ RtHpi::RtHpi()
 , m_bProcessData(false)
 , m_pRTMSAInput(NULL)
 , m_pRTMSAOutput(NULL)
-, m_pRtHpiBuffer(CircularMatrixBuffer<double>::SPtr())
+, m_pRtHpiBuffer(RingMatrixBuffer<double>::SPtr())
 {
 }
 
@@ -125,7 +125,7 @@ void RtHpi::init()
 
     //Delete Buffer - will be initailzed with first incoming data
     if(!m_pRtHpiBuffer.isNull())
-        m_pRtHpiBuffer = CircularMatrixBuffer<double>::SPtr();
+        m_pRtHpiBuffer = RingMatrixBuffer<double>::SPtr();
 }
 
 
@@ -225,7 +225,7 @@ void RtHpi::update(SCMEASLIB::NewMeasurement::SPtr pMeasurement)
         m_qMutex.lock();
         //Check if buffer initialized
         if(!m_pRtHpiBuffer)
-            m_pRtHpiBuffer = CircularMatrixBuffer<double>::SPtr(new CircularMatrixBuffer<double>(8, pRTMSA->getNumChannels(), pRTMSA->getMultiSampleArray()[0].cols()));
+            m_pRtHpiBuffer = RingMatrixBuffer<double>::SPtr(new RingMatrixBuffer<double>(8, pRTMSA->getNumChannels(), pRTMSA->getMultiSampleArray()[0].cols()));
 
         //Fiff information
         if(!m_pFiffInfo)
@@ -242,7 +242,7 @@ void RtHpi::update(SCMEASLIB::NewMeasurement::SPtr pMeasurement)
             for(qint32 i = 0; i < pRTMSA->getMultiArraySize(); ++i)
             {
                 t_mat = pRTMSA->getMultiSampleArray()[i];
-                m_pRtHpiBuffer->push(&t_mat);
+                m_pRtHpiBuffer->pushSwap(t_mat);
             }
         }
     }
@@ -276,12 +276,16 @@ void RtHpi::run()
 
     m_pRtHPIS = RtHPIS::SPtr(new RtHPIS(m_pFiffInfo));
 
+    MatrixXd t_mat;
+
     while (m_bIsRunning) {
         if(m_bProcessData) {
-            MatrixXd t_mat = m_pRtHpiBuffer->pop();
-            m_pRtHPIS->append(t_mat);
+            //A paused or released buffer returns at once, do not spin on it
+            if(m_pRtHpiBuffer->pop(t_mat))
+                m_pRtHPIS->append(t_mat);
+            else
+                msleep(10);
         }
-        //msleep(1);
     }
     qDebug()<<"HPI estimation [Run] is done!";
 }
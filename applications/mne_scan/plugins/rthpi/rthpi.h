@@ -46,7 +46,7 @@
 #include "rthpi_global.h"
 
 #include <scShared/Interfaces/IAlgorithm.h>
-#include <utils/generics/circularmatrixbuffer.h>
+#include <utils/generics/ringmatrixbuffer.h>
 #include <scMeas/newrealtimemultisamplearray.h>
 #include <realtime/rtProcessing/rthpis.h>
 
@@ -166,7 +166,7 @@ private:
 
     FiffInfo::SPtr  m_pFiffInfo;                            /**< Fiff measurement info.*/
 
-    CircularMatrixBuffer<double>::SPtr   m_pRtHpiBuffer;    /**< Holds incoming data.*/
+    RingMatrixBuffer<double>::SPtr       m_pRtHpiBuffer;    /**< Holds incoming data.*/
 
     bool m_bIsRunning;      /**< If source lab is running */
     bool m_bProcessData;    /**< If data should be received for processing */
@@ -276,6 +276,11 @@ void RtSss::update(SCMEASLIB::NewMeasurement::SPtr pMeasurement)
         if(!m_pRtSssBuffer)
             m_pRtSssBuffer = CircularMatrixBuffer<double>::SPtr(new CircularMatrixBuffer<double>(32, pRTMSA->getNumChannels(), pRTMSA->getMultiSampleArray()[0].cols()));
 
+        //Copy the head position here, in the GUI thread in which the HPI fit updates the fiff info. run() only reads the copy.
+        m_qMutex.lock();
+        m_devHeadTrans = pRTMSA->info()->dev_head_t;
+        m_qMutex.unlock();
+
         //Fiff information
         if(!m_pFiffInfo)
             m_pFiffInfo = pRTMSA->info();
@@ -403,6 +408,21 @@ void RtSss::run()
 
     //qDebug() << "..finished !!";
 
+    // The SSS operator only depends on the head position. It is cached per expansion origin and only rebuilt in
+    // the background when the head moved.
+    m_operatorCache.reset(rsss);
+    Vector3d vecOrigin = m_operatorCache.currentOrigin();
+
+    // Keep the expansion origin fixed relative to the head
+    m_qMutex.lock();
+    FiffCoordTrans devHeadTrans = m_devHeadTrans;
+    m_qMutex.unlock();
+
+    bool bTrackHead = devHeadTrans.from == FIFFV_COORD_DEVICE && devHeadTrans.to == FIFFV_COORD_HEAD;
+    Vector3d vecOriginHead = vecOrigin;
+    if(bTrackHead)
+        vecOriginHead = devHeadTrans.trans.cast<double>().block<3,3>(0,0) * vecOrigin + devHeadTrans.trans.cast<double>().block<3,1>(0,3);
+
     // start processing data
     m_bProcessData = true;
     qint32 HEADMOV_COR_cnt = 15 ;
@@ -449,7 +469,18 @@ void RtSss::run()
 //                }
 //            in_mat_used = in_mat.block(0,0,nmegchanused,in_mat.cols());
 
-           in_mat_used = rt_sss(in_mat_used);
+            // Check for head movement
+            if(bTrackHead) {
+                m_qMutex.lock();
+                Matrix4d matHeadDev = m_devHeadTrans.invtrans.cast<double>();
+                m_qMutex.unlock();
+
+                Vector3d vecOriginDev = matHeadDev.block<3,3>(0,0) * vecOriginHead + matHeadDev.block<3,1>(0,3);
+
+                m_operatorCache.update(vecOriginDev);
+            }
+
+            in_mat_used = m_operatorCache.currentOperator() * in_mat_used;
 
             // Implement Concurrent mapreduced for parallel processing
             // divide the in_mat_used into 2 or 4 matrices, which renders 50ms or 25ms data
@@ -487,6 +518,8 @@ void RtSss::run()
         }
     }
 
+    m_operatorCache.waitForPending();
+
     m_bProcessData = false;
     m_bReceiveData = false;
     //qDebug() << "rtSSS stopped.";
@@ -43,6 +43,7 @@
 //=============================================================================================================
 
 #include "rtsss_global.h"
+#include "rtsssoperatorcache.h"
 
 #include <scShared/Interfaces/IAlgorithm.h>
 #include <utils/generics/circularbuffer.h>
@@ -170,11 +171,14 @@ private:
     bool m_bProcessData;    /**< If data should be received for processing */
 
     FiffInfo::SPtr              m_pFiffInfo;        /**< Fiff information. */
+    FiffCoordTrans              m_devHeadTrans;     /**< Copy of the dev head transformation of the input, guarded by m_qMutex. */
 
     CircularMatrixBuffer<double>::SPtr m_pRtSssBuffer;   /**< Holds incoming rt server data.*/
 
     int LinRR, LoutRR, Lin, Lout;
 
+    RtSssOperatorCache          m_operatorCache;        /**< SSS operators keyed by the head position. */
+
     QMutex m_qMutex;
 
     //    dBuffer::SPtr   m_pRtSssBuffer;      /**< Holds incoming data.*/
@@ -125,20 +125,7 @@ MatrixXd RtSssAlgo::buildLinearEqn()
     EqnA.resize(NumCoil, EqnIn.cols()+EqnOut.cols());
     EqnB.resize(NumCoil,1);
 
-    // Find out if coils are all gradiometers, all magnetometers, or both.
-    // When both gradiometers and magnetometers are used,
-    //      MagScale facor of 100 must be appiled to magnetomters.
-    float MagScale;
-    if ((0 < CoilGrad.sum()) && (CoilGrad.sum() < NumCoil))  MagScale = 100;
-    else MagScale = 1;
-
-    VectorXd CoilScale;
-    CoilScale.setOnes(NumCoil);
-    for(int i=0; i<NumCoil; i++)
-    {
-        if (CoilGrad(i) == 0) CoilScale(i) = MagScale;
-//        std::cout <<  "i=" << i << "CoilGrad: " << CoilGrad(i) << ",  CoilScale: " << CoilScale(i) << std::endl;
-    }
+    VectorXd CoilScale = getCoilScale();
 
     EqnARR << EqnInRR, EqnOutRR;
     EqnA << EqnIn, EqnOut;
@@ -177,6 +164,62 @@ MatrixXd RtSssAlgo::buildLinearEqn()
     return CoilScale.asDiagonal();
 }
 
+VectorXd RtSssAlgo::getCoilScale()
+{
+    // Find out if coils are all gradiometers, all magnetometers, or both.
+    // When both gradiometers and magnetometers are used,
+    //      MagScale facor of 100 must be appiled to magnetomters.
+    float MagScale;
+    if ((0 < CoilGrad.sum()) && (CoilGrad.sum() < NumCoil))  MagScale = 100;
+    else MagScale = 1;
+
+    VectorXd CoilScale;
+    CoilScale.setOnes(NumCoil);
+    for(int i=0; i<NumCoil; i++)
+    {
+        if (CoilGrad(i) == 0) CoilScale(i) = MagScale;
+//        std::cout <<  "i=" << i << "CoilGrad: " << CoilGrad(i) << ",  CoilScale: " << CoilScale(i) << std::endl;
+    }
+
+    return CoilScale;
+}
+
+void RtSssAlgo::setOrigin(const Vector3d &origin)
+{
+    Origin = origin;
+}
+
+Vector3d RtSssAlgo::getOrigin() const
+{
+    return Origin;
+}
+
+// The SSS operator only depends on the origin, the coil geometry and the expansion orders.
+// It is computed once per origin, the per block work is a single matrix product.
+MatrixXd RtSssAlgo::getSSSOperator(double dRegularization)
+{
+    QList<MatrixXd> Eqn = getSSSEqn(LInOLS, LOutOLS);
+    qint32 NumBIn = Eqn[0].cols();
+
+    VectorXd CoilScale = getCoilScale();
+
+    MatrixXd EqnAOLS(NumCoil, Eqn[0].cols()+Eqn[1].cols());
+    EqnAOLS << Eqn[0], Eqn[1];
+    EqnAOLS = CoilScale.asDiagonal() * EqnAOLS;
+
+//  regularized pseudo-inverse, only the rows of the internal coefficients are needed
+    JacobiSVD<MatrixXd> svd(EqnAOLS, ComputeThinU | ComputeThinV);
+    VectorXd sing = svd.singularValues();
+    VectorXd singInv = VectorXd::Zero(sing.size());
+    for(int i=0; i<sing.size(); i++)
+        if(sing(i) > dRegularization * sing(0))
+            singInv(i) = 1.0 / sing(i);
+
+    MatrixXd PinvIn = svd.matrixV().topRows(NumBIn) * singInv.asDiagonal() * svd.matrixU().transpose();
+
+    return Eqn[0] * PinvIn * CoilScale.asDiagonal();
+}
+
 void RtSssAlgo::setSSSParameter(QList<int> expansionOrder)
 {
 //    LInRR = 5;
@@ -116,7 +116,38 @@ public:
     qint32 getNumMEGBadChan();
     VectorXi getBadChan();
 
+    //=========================================================================================================
+    /**
+    * Sets the expansion origin in device coordinates. setMEGInfo resets it to the default origin.
+    *
+    * @param[in] origin     The expansion origin.
+    */
+    void setOrigin(const Vector3d &origin);
+
+    //=========================================================================================================
+    /**
+    * Returns the expansion origin in device coordinates.
+    *
+    * @return the expansion origin
+    */
+    Vector3d getOrigin() const;
+
+    //=========================================================================================================
+    /**
+    * Computes the linear SSS operator for the current origin and the OLS expansion orders. Applied to the raw data
+    * of the used channels it returns the internal signal, i.e. the same as getSSSOLS on the scaled data up to the
+    * regularization. The pseudo-inverse of the SSS equation is regularized by truncating singular values below
+    * dRegularization times the largest one.
+    *
+    * @param[in] dRegularization    Relative singular value cut off.
+    *
+    * @return the SSS operator (used channels x used channels)
+    */
+    MatrixXd getSSSOperator(double dRegularization = 1e-8);
+
 private:
+    VectorXd getCoilScale();
+
     void getCoilInfoVectorView();
     void getCoilInfoVectorView4Sim();
     void getCoilInfoBabyMEG4Sim();
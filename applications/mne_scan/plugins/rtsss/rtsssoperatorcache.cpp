@@ -0,0 +1,196 @@
+//=============================================================================================================
+/**
+* @file     rtsssoperatorcache.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    Contains the implementation of the RtSssOperatorCache class.
+*/
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "rtsssoperatorcache.h"
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtConcurrent/QtConcurrentRun>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace RtSssPlugin;
+using namespace Eigen;
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+RtSssOperatorCache::RtSssOperatorCache(double dMovementThreshold, int iMaxCachedOperators)
+: m_vecOrigin(Vector3d::Zero())
+, m_vecPendingOrigin(Vector3d::Zero())
+, m_bPending(false)
+, m_dMovementThreshold(dMovementThreshold)
+, m_iMaxCachedOperators(iMaxCachedOperators)
+{
+}
+
+
+//*************************************************************************************************************
+
+RtSssOperatorCache::~RtSssOperatorCache()
+{
+    if(m_bPending)
+        m_futureOperator.waitForFinished();
+}
+
+
+//*************************************************************************************************************
+
+void RtSssOperatorCache::reset(const RtSssAlgo &algo)
+{
+    if(m_bPending) {
+        m_futureOperator.waitForFinished();
+        m_bPending = false;
+    }
+
+    m_algo = algo;
+    m_vecOrigin = m_algo.getOrigin();
+    m_matOperator = m_algo.getSSSOperator();
+
+    m_qListOperators.clear();
+    m_qListOperators.append(qMakePair(m_vecOrigin, m_matOperator));
+}
+
+
+//*************************************************************************************************************
+
+const MatrixXd& RtSssOperatorCache::update(const Vector3d &vecOrigin)
+{
+    if(m_bPending && m_futureOperator.isFinished())
+        storePending();
+
+    if((vecOrigin - m_vecOrigin).norm() > m_dMovementThreshold) {
+        // Look for a cached operator close to the current head position
+        int iBest = -1;
+        double dBest = m_dMovementThreshold;
+        for(int i = 0; i < m_qListOperators.size(); ++i) {
+            double dDist = (m_qListOperators[i].first - vecOrigin).norm();
+            if(dDist <= dBest) {
+                dBest = dDist;
+                iBest = i;
+            }
+        }
+
+        if(iBest >= 0) {
+            m_vecOrigin = m_qListOperators[iBest].first;
+            m_matOperator = m_qListOperators[iBest].second;
+        } else if(!m_bPending) {
+            // Keep the current operator until the new one is available
+            m_vecPendingOrigin = vecOrigin;
+            m_futureOperator = QtConcurrent::run(&RtSssOperatorCache::computeOperator, m_algo, vecOrigin);
+            m_bPending = true;
+        }
+    }
+
+    return m_matOperator;
+}
+
+
+//*************************************************************************************************************
+
+void RtSssOperatorCache::waitForPending()
+{
+    if(m_bPending) {
+        m_futureOperator.waitForFinished();
+        storePending();
+    }
+}
+
+
+//*************************************************************************************************************
+
+const MatrixXd& RtSssOperatorCache::currentOperator() const
+{
+    return m_matOperator;
+}
+
+
+//*************************************************************************************************************
+
+Vector3d RtSssOperatorCache::currentOrigin() const
+{
+    return m_vecOrigin;
+}
+
+
+//*************************************************************************************************************
+
+bool RtSssOperatorCache::isPending() const
+{
+    return m_bPending;
+}
+
+
+//*************************************************************************************************************
+
+int RtSssOperatorCache::size() const
+{
+    return m_qListOperators.size();
+}
+
+
+//*************************************************************************************************************
+
+void RtSssOperatorCache::storePending()
+{
+    m_qListOperators.prepend(qMakePair(m_vecPendingOrigin, m_futureOperator.result()));
+    if(m_qListOperators.size() > m_iMaxCachedOperators)
+        m_qListOperators.removeLast();
+    m_bPending = false;
+}
+
+
+//*************************************************************************************************************
+
+MatrixXd RtSssOperatorCache::computeOperator(RtSssAlgo algo, const Vector3d &vecOrigin)
+{
+    algo.setOrigin(vecOrigin);
+    return algo.getSSSOperator();
+}
@@ -0,0 +1,182 @@
+//=============================================================================================================
+/**
+* @file     rtsssoperatorcache.h
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    Contains the declaration of the RtSssOperatorCache class.
+*/
+
+#ifndef RTSSSOPERATORCACHE_H
+#define RTSSSOPERATORCACHE_H
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "rtsssalgo.h"
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QFuture>
+#include <QList>
+#include <QPair>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE NAMESPACE RtSssPlugin
+//=============================================================================================================
+
+namespace RtSssPlugin
+{
+
+
+//=============================================================================================================
+/**
+* The SSS operator only depends on the coil geometry, the expansion orders and the expansion origin. The cache
+* keeps the operators of the recent origins in device coordinates. When the head moved by more than the movement
+* threshold it switches to a cached operator close to the new origin or builds one in the background, while the
+* current operator stays in use.
+*
+* @brief Head position keyed cache of SSS operators
+*/
+class RtSssOperatorCache
+{
+public:
+    //=========================================================================================================
+    /**
+    * Constructs an empty cache.
+    *
+    * @param[in] dMovementThreshold     Head movement in m after which the operator is exchanged (default = 0.002).
+    * @param[in] iMaxCachedOperators    Maximum number of cached operators (default = 16).
+    */
+    explicit RtSssOperatorCache(double dMovementThreshold = 0.002, int iMaxCachedOperators = 16);
+
+    //=========================================================================================================
+    /**
+    * Waits for an operator which is built in the background.
+    */
+    ~RtSssOperatorCache();
+
+    //=========================================================================================================
+    /**
+    * Clears the cache and builds the operator at the origin of the given algorithm. A copy of the algorithm is
+    * kept to build the operators of later head positions.
+    *
+    * @param[in] algo   The SSS algorithm with the coil geometry and the expansion orders set.
+    */
+    void reset(const RtSssAlgo &algo);
+
+    //=========================================================================================================
+    /**
+    * Returns the operator for the current expansion origin. A finished background operator is added to the
+    * cache first. If the origin moved by more than the movement threshold, the closest cached operator within
+    * the threshold is used, otherwise a new one is started in the background unless one is already pending.
+    *
+    * @param[in] vecOrigin  The current expansion origin in device coordinates.
+    *
+    * @return the SSS operator to apply.
+    */
+    const Eigen::MatrixXd& update(const Eigen::Vector3d &vecOrigin);
+
+    //=========================================================================================================
+    /**
+    * Waits until a pending background operator is finished and adds it to the cache.
+    */
+    void waitForPending();
+
+    //=========================================================================================================
+    /**
+    * Returns the operator in use.
+    *
+    * @return the SSS operator in use.
+    */
+    const Eigen::MatrixXd& currentOperator() const;
+
+    //=========================================================================================================
+    /**
+    * Returns the expansion origin of the operator in use.
+    *
+    * @return the expansion origin in device coordinates.
+    */
+    Eigen::Vector3d currentOrigin() const;
+
+    //=========================================================================================================
+    /**
+    * Returns whether an operator is built in the background.
+    *
+    * @return true if an operator is pending.
+    */
+    bool isPending() const;
+
+    //=========================================================================================================
+    /**
+    * Returns the number of cached operators.
+    *
+    * @return the number of cached operators.
+    */
+    int size() const;
+
+private:
+    //=========================================================================================================
+    /**
+    * Adds the finished background operator to the cache and drops the oldest one if the cache is full.
+    */
+    void storePending();
+
+    //=========================================================================================================
+    /**
+    * Builds the SSS operator of a copy of the algorithm at the given origin.
+    *
+    * @param[in] algo       The SSS algorithm.
+    * @param[in] vecOrigin  The expansion origin in device coordinates.
+    *
+    * @return the SSS operator.
+    */
+    static Eigen::MatrixXd computeOperator(RtSssAlgo algo, const Eigen::Vector3d &vecOrigin);
+
+    RtSssAlgo                   m_algo;                 /**< Copy of the algorithm the operators are built with. */
+    QList<QPair<Eigen::Vector3d, Eigen::MatrixXd> > m_qListOperators;  /**< Cached operators keyed by their expansion origin in device coordinates, newest first. */
+    Eigen::Vector3d             m_vecOrigin;            /**< Expansion origin of the operator in use. */
+    Eigen::MatrixXd             m_matOperator;          /**< The operator in use. */
+    QFuture<Eigen::MatrixXd>    m_futureOperator;       /**< Operator which is built in the background for a new head position. */
+    Eigen::Vector3d             m_vecPendingOrigin;     /**< Expansion origin of the operator built in the background. */
+    bool                        m_bPending;             /**< If an operator is built in the background. */
+    double                      m_dMovementThreshold;   /**< Head movement in m after which the operator is exchanged. */
+    int                         m_iMaxCachedOperators;  /**< Maximum number of cached operators. */
+};
+
+} // NAMESPACE
+
+#endif // RTSSSOPERATORCACHE_H
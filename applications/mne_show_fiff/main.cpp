@@ -43,6 +43,14 @@
 #include "mne_fiff_exp_set.h"
 
 
+//*************************************************************************************************************
+//=============================================================================================================
+// MNE INCLUDES
+//=============================================================================================================
+
+#include <fiff/fiff_index.h>
+
+
 //*************************************************************************************************************
 //=============================================================================================================
 // Qt INCLUDES
@@ -57,6 +65,7 @@
 //=============================================================================================================
 
 using namespace SHOWFIFF;
+using namespace FIFFLIB;
 
 
 //*************************************************************************************************************
@@ -78,6 +87,7 @@ int main(int argc, char *argv[])
     QCoreApplication app(argc, argv);
 
     MneShowFiffSettings settings(&argc,argv);
+    FiffIndex::setEnabled(settings.use_index);
     MneFiffExpSet expSet = MneFiffExpSet::read_fiff_explanations(QCoreApplication::applicationDirPath()+"/resources/general/explanations/fiff_explanations.txt");
     expSet.show_fiff_contents(stdout, settings);
 
@@ -71,6 +71,7 @@ MneShowFiffSettings::MneShowFiffSettings()
 , verbose(false)
 , long_strings(false)
 , blocks_only(false)
+, use_index(false)
 {
 
 }
@@ -83,6 +84,7 @@ MneShowFiffSettings::MneShowFiffSettings(int *argc,char **argv)
 , verbose(false)
 , long_strings(false)
 , blocks_only(false)
+, use_index(false)
 {
     if (!check_args(argc,argv))
         return;
@@ -123,6 +125,7 @@ void MneShowFiffSettings::usage(char *name)
     fprintf(stderr,"\t--indent no       Number of spaces to use in indentation (default %d in terse and 0 in verbose output)\n",indent);
     fprintf(stderr,"\t--tag no          Provide information about these tags (can have multiple of these).\n");
     fprintf(stderr,"\t--long            Print long strings in full?\n");
+    fprintf(stderr,"\t--index           Keep the tag directory in a .fidx sidecar next to the file.\n");
     fprintf(stderr,"\t--help            print this info.\n");
     fprintf(stderr,"\t--version         print version info.\n\n");
 }
@@ -218,6 +221,10 @@ bool MneShowFiffSettings::check_args (int *argc,char **argv)
             blocks_only = true;
             verbose     = false;
         }
+        else if (strcmp(argv[k],"--index") == 0) {
+            found     = 1;
+            use_index = true;
+        }
         if (found) {
             for (p = k; p < *argc-found; p++)
                 argv[p] = argv[p+found];
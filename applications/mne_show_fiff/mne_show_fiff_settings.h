@@ -120,6 +120,7 @@ public:
     QList<int>  tags;           /**< Provide information about these tags (can have multiple of these). */
     bool        long_strings;   /**< Print long strings in full? */
     bool        blocks_only;    /**< Only list the blocks (the tree structure). */
+    bool        use_index;      /**< Keep the tag directory in a .fidx sidecar next to the file. */
 
 private:
     void usage(char *name);
@@ -52,6 +52,7 @@
 #include <fiff/fiff.h>
 #include <mne/mne.h>
 
+#include <fiff/fiff_raw_buffer_cache.h>
 #include <mne/mne_epoch_data_list.h>
 
 
@@ -341,6 +342,12 @@ int main(int argc, char *argv[])
 
     MatrixXd times;
 
+    //
+    //   Overlapping epochs share their decoded raw buffers
+    //
+    FiffRawBufferCache::SPtr rawCache = FiffRawBufferCache::globalCache();
+    rawCache->setMaxBytes(128*1024*1024);
+
     for (p = 0; p < count; ++p)
     {
         //
@@ -374,6 +381,8 @@ int main(int argc, char *argv[])
         }
     }
 
+    printf("Raw buffer cache: %lld hits, %lld misses\n", (long long)rawCache->hits(), (long long)rawCache->misses());
+
     //Example for average_epochs
     data.average(raw.info,raw.first_samp,raw.last_samp);
 
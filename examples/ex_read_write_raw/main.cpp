@@ -148,9 +148,14 @@ int main(int argc, char *argv[])
     //quantum     = to - from + 1;
     //
     //
-    //   Read and write all the data
+    //   The first sample has to be written before the buffers are handed to the writer thread
     //
-    bool first_buffer = true;
+    if (from > 0)
+        outfid->write_int(FIFF_FIRST_SAMPLE,&from);
+    //
+    //   Read and write all the data, the buffers are written in the background (wait instead of dropping)
+    //
+    FiffRawWriter writer(outfid, 4, false);
 
     fiff_int_t first, last;
     MatrixXd data;
@@ -173,17 +178,13 @@ int main(int argc, char *argv[])
         //   You can add your own miracle here
         //
         printf("Writing...");
-        if (first_buffer)
-        {
-           if (first > 0)
-               outfid->write_int(FIFF_FIRST_SAMPLE,&first);
-           first_buffer = false;
-        }
-        outfid->write_raw_buffer(data,cals);
-        printf("[done]\n");
+        writer.write_raw_buffer(data,cals);
+        printf("[queued]\n");
     }
 
-    outfid->finish_writing_raw();
+    writer.finish_writing_raw();
+
+    printf("Written buffers %lld, maximal queue depth %d\n", (long long)writer.writtenBuffers(), writer.maxQueueDepth());
 
     printf("Finished\n");
 
@@ -172,7 +172,7 @@ void FilterWindow::setSamplingRate(double dSamplingRate)
 
 //*************************************************************************************************************
 
-void FilterWindow::setFilterParameters(double hp, double lp, int order, int type, int designMethod, double transition, bool activateFilter, const QString &sChannelType)
+void FilterWindow::setFilterParameters(double hp, double lp, int order, int type, int designMethod, int iirOrder, double transition, bool activateFilter, const QString &sChannelType)
 {
     ui->m_doubleSpinBox_highpass->setValue(lp);
     ui->m_doubleSpinBox_lowpass->setValue(hp);
@@ -191,6 +191,10 @@ void FilterWindow::setFilterParameters(double hp, double lp, int order, int type
         ui->m_comboBox_designMethod->setCurrentText("Tschebyscheff");
     if(designMethod == 1)
         ui->m_comboBox_designMethod->setCurrentText("Cosine");
+    if(designMethod == 3)
+        ui->m_comboBox_designMethod->setCurrentText("Butterworth");
+
+    ui->m_spinBox_iirOrder->setValue(iirOrder);
 
     ui->m_doubleSpinBox_transitionband->setValue(transition);
 
@@ -282,6 +286,9 @@ void FilterWindow::initSpinBoxes()
     connect(ui->m_spinBox_filterTaps,static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged),
                 this,&FilterWindow::filterParametersChanged);
 
+    connect(ui->m_spinBox_iirOrder,static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged),
+                this,&FilterWindow::filterParametersChanged);
+
     //Intercept events from the spin boxes to get control over key events
     ui->m_doubleSpinBox_lowpass->installEventFilter(this);
     ui->m_doubleSpinBox_highpass->installEventFilter(this);
@@ -324,6 +331,9 @@ void FilterWindow::initComboBoxes()
     ui->m_spinBox_filterTaps->setVisible(true);
     ui->m_label_filterTaps->setVisible(true);
 
+    ui->m_spinBox_iirOrder->setVisible(false);
+    ui->m_label_iirOrder->setVisible(false);
+
     connect(ui->m_comboBox_filterApplyTo, &QComboBox::currentTextChanged,
             this, &FilterWindow::onSpinBoxFilterChannelType);
 
@@ -547,11 +557,22 @@ void FilterWindow::changeStateSpinBoxes(int currentIndex)
 //            ui->m_label_filterTaps->setVisible(false);
             ui->m_spinBox_filterTaps->setVisible(true);
             ui->m_label_filterTaps->setVisible(true);
+            ui->m_spinBox_iirOrder->setVisible(false);
+            ui->m_label_iirOrder->setVisible(false);
             break;
 
         case 1: //Tschebyscheff
             ui->m_spinBox_filterTaps->setVisible(true);
             ui->m_label_filterTaps->setVisible(true);
+            ui->m_spinBox_iirOrder->setVisible(false);
+            ui->m_label_iirOrder->setVisible(false);
+            break;
+
+        case 2: //Butterworth - the taps are used for the zero-phase FIR version of offline filtering
+            ui->m_spinBox_filterTaps->setVisible(true);
+            ui->m_label_filterTaps->setVisible(true);
+            ui->m_spinBox_iirOrder->setVisible(true);
+            ui->m_label_iirOrder->setVisible(true);
             break;
     }
 
@@ -588,6 +609,18 @@ void FilterWindow::changeStateSpinBoxes(int currentIndex)
             ui->m_label_lowpass->setVisible(false);
             ui->m_doubleSpinBox_highpass->setEnabled(true);
             break;
+
+        case 3: //Notch - the band between both frequencies is removed
+            ui->m_doubleSpinBox_highpass->setVisible(true);
+            ui->m_label_highpass->setVisible(true);
+            ui->m_doubleSpinBox_lowpass->setVisible(true);
+            ui->m_label_lowpass->setText("Stop from (Hz):");
+
+            ui->m_label_lowpass->setVisible(true);
+            ui->m_doubleSpinBox_lowpass->setEnabled(true);
+            ui->m_doubleSpinBox_highpass->setEnabled(true);
+            ui->m_label_highpass->setText("Stop to (Hz):");
+            break;
     }
 
     filterParametersChanged();
@@ -629,7 +662,7 @@ void FilterWindow::filterParametersChanged()
     ui->m_doubleSpinBox_highpass->setMinimum(0);
     ui->m_doubleSpinBox_lowpass->setMinimum(0);
 
-    if(ui->m_comboBox_filterType->currentText() == "Bandpass") {
+    if(ui->m_comboBox_filterType->currentText() == "Bandpass" || ui->m_comboBox_filterType->currentText() == "Notch") {
         if((ui->m_doubleSpinBox_highpass->value() < ui->m_doubleSpinBox_lowpass->value())) {
             ui->m_doubleSpinBox_highpass->setValue(ui->m_doubleSpinBox_lowpass->value());
         }
@@ -645,6 +678,11 @@ void FilterWindow::filterParametersChanged()
     if(ui->m_comboBox_designMethod->currentText() == "Cosine")
         dMethod = FilterData::Cosine;
 
+    if(ui->m_comboBox_designMethod->currentText() == "Butterworth")
+        dMethod = FilterData::Butterworth;
+
+    int iIIROrder = ui->m_spinBox_iirOrder->value();
+
     //Generate filters
     QSharedPointer<FilterData> userDefinedFilterOperator;
 
@@ -660,7 +698,8 @@ void FilterWindow::filterParametersChanged()
                                                                (double)trans_width/nyquistFrequency,
                                                                samplingFrequency,
                                                                fftLength,
-                                                               dMethod));
+                                                               dMethod,
+                                                               iIIROrder));
     }
 
     if(ui->m_comboBox_filterType->currentText() == "Highpass") {
@@ -673,7 +712,8 @@ void FilterWindow::filterParametersChanged()
                                                         (double)trans_width/nyquistFrequency,
                                                         samplingFrequency,
                                                         fftLength,
-                                                        dMethod));
+                                                        dMethod,
+                                                        iIIROrder));
     }
 
     if(ui->m_comboBox_filterType->currentText() == "Bandpass") {
@@ -686,7 +726,23 @@ void FilterWindow::filterParametersChanged()
                                   (double)trans_width/nyquistFrequency,
                                   samplingFrequency,
                                   fftLength,
-                                  dMethod));
+                                  dMethod,
+                                  iIIROrder));
+    }
+
+    if(ui->m_comboBox_filterType->currentText() == "Notch") {
+        //The cosine design does not support notch filters
+        userDefinedFilterOperator = QSharedPointer<FilterData>(
+                   new FilterData("User Design",
+                                  FilterData::NOTCH,
+                                  m_iFilterTaps,
+                                  (double)center/nyquistFrequency,
+                                  (double)bw/nyquistFrequency,
+                                  (double)trans_width/nyquistFrequency,
+                                  samplingFrequency,
+                                  fftLength,
+                                  dMethod == FilterData::Cosine ? FilterData::Tschebyscheff : dMethod,
+                                  iIIROrder));
     }
 
     //Replace old with new filter operator
@@ -165,11 +165,12 @@ public:
     * @param[in] order              The order of the.
     * @param[in] type               The filter type.
     * @param[in] designMethod       The filter design method.
+    * @param[in] iirOrder           The order of the Butterworth design.
     * @param[in] transition         The transition frequency.
     * @param[in] activateFilter     The filter activation flag.
     * @param[in] channelType        the channel Type.
     */
-    void setFilterParameters(double hp, double lp, int order, int type, int designMethod, double transition, bool activateFilter, const QString &sChannelType);
+    void setFilterParameters(double hp, double lp, int order, int type, int designMethod, int iirOrder, double transition, bool activateFilter, const QString &sChannelType);
 
     //=========================================================================================================
     /**
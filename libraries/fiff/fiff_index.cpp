@@ -0,0 +1,487 @@
+//=============================================================================================================
+/**
+* @file     fiff_index.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    FiffIndex class definition.
+*
+*/
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_index.h"
+#include "fiff_tag.h"
+#include "fiff_file.h"
+#include "fiff_info.h"
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// Qt INCLUDES
+//=============================================================================================================
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+#define FIFF_INDEX_MAGIC        0x46494458  /**< "FIDX" */
+#define FIFF_INDEX_VERSION      2
+#define FIFF_INDEX_MAX_TAG_SIZE 1048576     /**< Larger tags are read from the file */
+
+static bool s_bIndexEnabled = false;
+
+
+//*************************************************************************************************************
+
+static qint64 file_modified_msecs(const QFileInfo& fileInfo)
+{
+    return fileInfo.lastModified().toMSecsSinceEpoch();
+}
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// SERIALIZATION OF THE MEASUREMENT INFO
+//=============================================================================================================
+
+namespace FIFFLIB
+{
+
+//The stream operators have to be found by the QList operators, hence they live in the namespace of the types
+
+template<typename T>
+static void write_matrix(QDataStream& out, const T& mat)
+{
+    out << (qint32)mat.rows() << (qint32)mat.cols();
+    for(qint32 c = 0; c < mat.cols(); ++c)
+        for(qint32 r = 0; r < mat.rows(); ++r)
+            out << mat(r,c);
+}
+
+
+//*************************************************************************************************************
+
+template<typename T>
+static void read_matrix(QDataStream& in, T& mat)
+{
+    qint32 rows, cols;
+    in >> rows >> cols;
+
+    //Fixed size matrices must match, dynamic ones are resized
+    if(in.status() != QDataStream::Ok || rows < 0 || cols < 0
+            || (T::RowsAtCompileTime != Eigen::Dynamic && rows != T::RowsAtCompileTime)
+            || (T::ColsAtCompileTime != Eigen::Dynamic && cols != T::ColsAtCompileTime)) {
+        in.setStatus(QDataStream::ReadCorruptData);
+        return;
+    }
+
+    mat.resize(rows, cols);
+    for(qint32 c = 0; c < cols; ++c)
+        for(qint32 r = 0; r < rows; ++r)
+            in >> mat(r,c);
+}
+
+
+//*************************************************************************************************************
+
+static QDataStream& operator<<(QDataStream& out, const FiffId& id)
+{
+    return out << id.version << id.machid[0] << id.machid[1] << id.time.secs << id.time.usecs;
+}
+
+
+//*************************************************************************************************************
+
+static QDataStream& operator>>(QDataStream& in, FiffId& id)
+{
+    return in >> id.version >> id.machid[0] >> id.machid[1] >> id.time.secs >> id.time.usecs;
+}
+
+
+//*************************************************************************************************************
+
+static QDataStream& operator<<(QDataStream& out, const FiffCoordTrans& trans)
+{
+    out << trans.from << trans.to;
+    write_matrix(out, trans.trans);
+    write_matrix(out, trans.invtrans);
+    return out;
+}
+
+
+//*************************************************************************************************************
+
+static QDataStream& operator>>(QDataStream& in, FiffCoordTrans& trans)
+{
+    in >> trans.from >> trans.to;
+    read_matrix(in, trans.trans);
+    read_matrix(in, trans.invtrans);
+    return in;
+}
+
+
+//*************************************************************************************************************
+
+static QDataStream& operator<<(QDataStream& out, const FiffChInfo& ch)
+{
+    out << ch.scanNo << ch.logNo << ch.kind << ch.range << ch.cal << ch.chpos.coil_type;
+    write_matrix(out, ch.chpos.r0);
+    write_matrix(out, ch.chpos.ex);
+    write_matrix(out, ch.chpos.ey);
+    write_matrix(out, ch.chpos.ez);
+    out << ch.unit << ch.unit_mul << ch.ch_name;
+    write_matrix(out, ch.coil_trans);
+    write_matrix(out, ch.eeg_loc);
+    out << ch.coord_frame;
+    return out;
+}
+
+
+//*************************************************************************************************************
+
+static QDataStream& operator>>(QDataStream& in, FiffChInfo& ch)
+{
+    in >> ch.scanNo >> ch.logNo >> ch.kind >> ch.range >> ch.cal >> ch.chpos.coil_type;
+    read_matrix(in, ch.chpos.r0);
+    read_matrix(in, ch.chpos.ex);
+    read_matrix(in, ch.chpos.ey);
+    read_matrix(in, ch.chpos.ez);
+    in >> ch.unit >> ch.unit_mul >> ch.ch_name;
+    read_matrix(in, ch.coil_trans);
+    read_matrix(in, ch.eeg_loc);
+    in >> ch.coord_frame;
+    return in;
+}
+
+
+//*************************************************************************************************************
+
+static QDataStream& operator<<(QDataStream& out, const FiffDigPoint& dig)
+{
+    return out << dig.kind << dig.ident << dig.r[0] << dig.r[1] << dig.r[2] << dig.coord_frame;
+}
+
+
+//*************************************************************************************************************
+
+static QDataStream& operator>>(QDataStream& in, FiffDigPoint& dig)
+{
+    return in >> dig.kind >> dig.ident >> dig.r[0] >> dig.r[1] >> dig.r[2] >> dig.coord_frame;
+}
+
+
+//*************************************************************************************************************
+
+static QDataStream& operator<<(QDataStream& out, const FiffNamedMatrix& mat)
+{
+    out << mat.nrow << mat.ncol << mat.row_names << mat.col_names;
+    write_matrix(out, mat.data);
+    return out;
+}
+
+
+//*************************************************************************************************************
+
+static QDataStream& operator>>(QDataStream& in, FiffNamedMatrix& mat)
+{
+    in >> mat.nrow >> mat.ncol >> mat.row_names >> mat.col_names;
+    read_matrix(in, mat.data);
+    return in;
+}
+
+
+//*************************************************************************************************************
+
+static QDataStream& operator<<(QDataStream& out, const FiffProj& proj)
+{
+    return out << proj.kind << proj.active << proj.desc << *proj.data;
+}
+
+
+//*************************************************************************************************************
+
+static QDataStream& operator>>(QDataStream& in, FiffProj& proj)
+{
+    return in >> proj.kind >> proj.active >> proj.desc >> *proj.data;
+}
+
+
+//*************************************************************************************************************
+
+static QDataStream& operator<<(QDataStream& out, const FiffCtfComp& comp)
+{
+    out << comp.ctfkind << comp.kind << comp.save_calibrated;
+    write_matrix(out, comp.rowcals);
+    write_matrix(out, comp.colcals);
+    return out << *comp.data;
+}
+
+
+//*************************************************************************************************************
+
+static QDataStream& operator>>(QDataStream& in, FiffCtfComp& comp)
+{
+    in >> comp.ctfkind >> comp.kind >> comp.save_calibrated;
+    read_matrix(in, comp.rowcals);
+    read_matrix(in, comp.colcals);
+    return in >> *comp.data;
+}
+
+
+//*************************************************************************************************************
+
+static void write_info(QDataStream& out, const FiffInfo& info)
+{
+    //The file name is not stored, it is set by the reader of the file
+    out << info.file_id << info.meas_id << info.meas_date[0] << info.meas_date[1]
+        << info.nchan << info.sfreq << info.highpass << info.lowpass
+        << info.bads << info.chs << info.ch_names
+        << info.dev_head_t << info.ctf_head_t << info.dev_ctf_t
+        << info.dig << info.dig_trans << info.projs << info.comps
+        << info.acq_pars << info.acq_stim;
+}
+
+
+//*************************************************************************************************************
+
+static void read_info(QDataStream& in, FiffInfo& info)
+{
+    in >> info.file_id >> info.meas_id >> info.meas_date[0] >> info.meas_date[1]
+       >> info.nchan >> info.sfreq >> info.highpass >> info.lowpass
+       >> info.bads >> info.chs >> info.ch_names
+       >> info.dev_head_t >> info.ctf_head_t >> info.dev_ctf_t
+       >> info.dig >> info.dig_trans >> info.projs >> info.comps
+       >> info.acq_pars >> info.acq_stim;
+}
+
+} // NAMESPACE
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+FiffIndex::FiffIndex()
+{
+
+}
+
+
+//*************************************************************************************************************
+
+void FiffIndex::setEnabled(bool p_bEnabled)
+{
+    s_bIndexEnabled = p_bEnabled;
+}
+
+
+//*************************************************************************************************************
+
+bool FiffIndex::isEnabled()
+{
+    return s_bIndexEnabled;
+}
+
+
+//*************************************************************************************************************
+
+QString FiffIndex::indexFileName(const QString& p_sFileName)
+{
+    return p_sFileName + ".fidx";
+}
+
+
+//*************************************************************************************************************
+
+bool FiffIndex::isIndexed(const FiffDirEntry::SPtr& p_pEnt)
+{
+    return p_pEnt->kind >= 0
+            && p_pEnt->pos >= 0
+            && p_pEnt->kind != FIFF_DATA_BUFFER
+            && p_pEnt->kind != FIFF_DIR
+            && p_pEnt->size >= 0
+            && p_pEnt->size <= FIFF_INDEX_MAX_TAG_SIZE;
+}
+
+
+//*************************************************************************************************************
+
+FiffIndex::SPtr FiffIndex::load(const QString& p_sFileName, const FiffId& p_id)
+{
+    QFileInfo t_fileInfo(p_sFileName);
+    QFile t_indexFile(indexFileName(p_sFileName));
+
+    if(!t_fileInfo.exists() || !t_indexFile.exists() || !t_indexFile.open(QIODevice::ReadOnly))
+        return FiffIndex::SPtr();
+
+    QDataStream t_stream(&t_indexFile);
+    t_stream.setVersion(QDataStream::Qt_5_0);
+
+    //
+    //   Validate against the current file
+    //
+    quint32 magic;
+    qint32 version;
+    qint64 fileSize, modified;
+    t_stream >> magic >> version >> fileSize >> modified;
+    if(magic != FIFF_INDEX_MAGIC || version != FIFF_INDEX_VERSION
+            || fileSize != t_fileInfo.size() || modified != file_modified_msecs(t_fileInfo))
+        return FiffIndex::SPtr();
+
+    FiffIndex::SPtr t_pIndex(new FiffIndex);
+    t_stream >> t_pIndex->id.version >> t_pIndex->id.machid[0] >> t_pIndex->id.machid[1]
+             >> t_pIndex->id.time.secs >> t_pIndex->id.time.usecs;
+    if(t_pIndex->id.version != p_id.version || t_pIndex->id.machid[0] != p_id.machid[0] || t_pIndex->id.machid[1] != p_id.machid[1]
+            || t_pIndex->id.time.secs != p_id.time.secs || t_pIndex->id.time.usecs != p_id.time.usecs)
+        return FiffIndex::SPtr();
+
+    //
+    //   Directory and tags
+    //
+    qint32 nent, ntag, k;
+    t_stream >> nent;
+    for(k = 0; k < nent && t_stream.status() == QDataStream::Ok; ++k) {
+        FiffDirEntry::SPtr t_pEnt(new FiffDirEntry);
+        t_stream >> t_pEnt->kind >> t_pEnt->type >> t_pEnt->size >> t_pEnt->pos;
+        t_pIndex->dir.append(t_pEnt);
+    }
+
+    t_stream >> ntag;
+    for(k = 0; k < ntag && t_stream.status() == QDataStream::Ok; ++k) {
+        qint64 pos;
+        FiffTag::SPtr t_pTag(new FiffTag);
+        QByteArray t_data;
+        t_stream >> pos >> t_pTag->kind >> t_pTag->type >> t_pTag->next >> t_data;
+        t_pTag->append(t_data);
+        t_pIndex->m_qMapTags.insert(pos, t_pTag);
+    }
+
+    //
+    //   Measurement info
+    //
+    bool t_bHasInfo = false;
+    t_stream >> t_bHasInfo;
+    if(t_bHasInfo && t_stream.status() == QDataStream::Ok) {
+        t_pIndex->info = QSharedPointer<FiffInfo>(new FiffInfo);
+        read_info(t_stream, *t_pIndex->info);
+    }
+
+    if(t_stream.status() != QDataStream::Ok || t_pIndex->dir.isEmpty()) {
+        printf("Fiff index %s is damaged and is ignored.\n", t_indexFile.fileName().toUtf8().constData());
+        return FiffIndex::SPtr();
+    }
+
+    return t_pIndex;
+}
+
+
+//*************************************************************************************************************
+
+bool FiffIndex::save(const QString& p_sFileName) const
+{
+    QFileInfo t_fileInfo(p_sFileName);
+
+    //
+    //   Write to a temporary file first, concurrent readers never see a partial index
+    //
+    QSaveFile t_indexFile(indexFileName(p_sFileName));
+    if(!t_fileInfo.exists() || !t_indexFile.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream t_stream(&t_indexFile);
+    t_stream.setVersion(QDataStream::Qt_5_0);
+
+    t_stream << (quint32)FIFF_INDEX_MAGIC << (qint32)FIFF_INDEX_VERSION << (qint64)t_fileInfo.size() << file_modified_msecs(t_fileInfo);
+    t_stream << id.version << id.machid[0] << id.machid[1] << id.time.secs << id.time.usecs;
+
+    t_stream << (qint32)dir.size();
+    for(qint32 k = 0; k < dir.size(); ++k)
+        t_stream << dir[k]->kind << dir[k]->type << dir[k]->size << dir[k]->pos;
+
+    t_stream << (qint32)m_qMapTags.size();
+    QMap<fiff_long_t, FiffTag::SPtr>::const_iterator it;
+    for(it = m_qMapTags.constBegin(); it != m_qMapTags.constEnd(); ++it) {
+        const FiffTag::SPtr& t_pTag = it.value();
+        t_stream << (qint64)it.key() << t_pTag->kind << t_pTag->type << t_pTag->next << (const QByteArray&)*t_pTag;
+    }
+
+    t_stream << !info.isNull();
+    if(info)
+        write_info(t_stream, *info);
+
+    if(t_stream.status() != QDataStream::Ok) {
+        t_indexFile.cancelWriting();
+        return false;
+    }
+
+    return t_indexFile.commit();
+}
+
+
+//*************************************************************************************************************
+
+void FiffIndex::add_tag(fiff_long_t pos, const FiffTag::SPtr& p_pTag)
+{
+    m_qMapTags.insert(pos, p_pTag);
+}
+
+
+//*************************************************************************************************************
+
+bool FiffIndex::find_tag(fiff_long_t pos, FiffTag::SPtr& p_pTag) const
+{
+    QMap<fiff_long_t, FiffTag::SPtr>::const_iterator it = m_qMapTags.constFind(pos);
+    if(it == m_qMapTags.constEnd())
+        return false;
+
+    p_pTag = FiffTag::SPtr(new FiffTag(it.value().data()));
+    FiffTag::convert_tag_data(p_pTag, FIFFV_BIG_ENDIAN, FIFFV_NATIVE_ENDIAN);
+
+    return true;
+}
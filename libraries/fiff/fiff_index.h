@@ -0,0 +1,185 @@
+//=============================================================================================================
+/**
+* @file     fiff_index.h
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    FiffIndex class declaration.
+*
+*/
+
+#ifndef FIFF_INDEX_H
+#define FIFF_INDEX_H
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_global.h"
+#include "fiff_types.h"
+#include "fiff_id.h"
+#include "fiff_dir_entry.h"
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// Qt INCLUDES
+//=============================================================================================================
+
+#include <QList>
+#include <QMap>
+#include <QSharedPointer>
+#include <QString>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE NAMESPACE FIFFLIB
+//=============================================================================================================
+
+namespace FIFFLIB
+{
+
+class FiffTag;
+class FiffInfo;
+
+
+//=============================================================================================================
+/**
+* The index is stored as sidecar file next to a FIFF file (<file name>.fidx). It holds the tag directory, the
+* decoded measurement info and the tags which are needed to set up the raw directory, i.e. all tags except data
+* buffers and large matrices. FiffStream::open uses an up to date index instead of reading or creating the
+* directory and serves these tags from memory, FiffStream::read_meas_info returns the stored measurement info,
+* so reopening a file costs a single read of the index. The index is validated by file size, modification time
+* and file id. Indexing is disabled by default.
+*
+* @brief FIFF tag directory and tag index sidecar
+*/
+class FIFFSHARED_EXPORT FiffIndex
+{
+public:
+    typedef QSharedPointer<FiffIndex> SPtr;             /**< Shared pointer type for FiffIndex. */
+    typedef QSharedPointer<const FiffIndex> ConstSPtr;  /**< Const shared pointer type for FiffIndex. */
+
+    //=========================================================================================================
+    /**
+    * Constructs an empty index.
+    */
+    FiffIndex();
+
+    //=========================================================================================================
+    /**
+    * Enables or disables the use and creation of index sidecars by FiffStream::open.
+    *
+    * @param[in] p_bEnabled     Whether index sidecars are used
+    */
+    static void setEnabled(bool p_bEnabled);
+
+    //=========================================================================================================
+    /**
+    * Returns whether index sidecars are used by FiffStream::open.
+    *
+    * @return true if enabled
+    */
+    static bool isEnabled();
+
+    //=========================================================================================================
+    /**
+    * Returns the name of the index sidecar of a FIFF file.
+    *
+    * @param[in] p_sFileName    Name of the FIFF file
+    *
+    * @return the name of the index file
+    */
+    static QString indexFileName(const QString& p_sFileName);
+
+    //=========================================================================================================
+    /**
+    * Checks whether a tag is stored in the index. Data buffers and tags larger than the size limit are
+    * read from the file.
+    *
+    * @param[in] p_pEnt     The directory entry of the tag
+    *
+    * @return true if the tag belongs into the index
+    */
+    static bool isIndexed(const FiffDirEntry::SPtr& p_pEnt);
+
+    //=========================================================================================================
+    /**
+    * Reads the index sidecar of a FIFF file.
+    *
+    * @param[in] p_sFileName    Name of the FIFF file
+    * @param[in] p_id           The file id read from the FIFF file
+    *
+    * @return the index, a null pointer if there is no index or it does not belong to the current file
+    */
+    static FiffIndex::SPtr load(const QString& p_sFileName, const FiffId& p_id);
+
+    //=========================================================================================================
+    /**
+    * Writes the index sidecar of a FIFF file. The size and modification time of the file are stored for
+    * the validation.
+    *
+    * @param[in] p_sFileName    Name of the FIFF file
+    *
+    * @return true if succeeded, false if the sidecar could not be written (e.g. read only directory)
+    */
+    bool save(const QString& p_sFileName) const;
+
+    //=========================================================================================================
+    /**
+    * Adds a tag which is still in file byte order.
+    *
+    * @param[in] pos        Position of the tag in the file
+    * @param[in] p_pTag     The tag, data in big endian byte order
+    */
+    void add_tag(fiff_long_t pos, const QSharedPointer<FiffTag>& p_pTag);
+
+    //=========================================================================================================
+    /**
+    * Looks up the tag at a file position and converts a copy of it to native byte order.
+    *
+    * @param[in] pos        Position of the tag in the file
+    * @param[out] p_pTag    The tag
+    *
+    * @return true if the tag is stored in the index
+    */
+    bool find_tag(fiff_long_t pos, QSharedPointer<FiffTag>& p_pTag) const;
+
+public:
+    FiffId                                  id;     /**< The file identifier. */
+    QList<FiffDirEntry::SPtr>               dir;    /**< The tag directory. */
+    QSharedPointer<FiffInfo>                info;   /**< The measurement info of the top level directory, NULL if the file has none. */
+
+private:
+    QMap<fiff_long_t, QSharedPointer<FiffTag> > m_qMapTags;   /**< Indexed tags in file byte order, keyed by file position. */
+};
+
+} // NAMESPACE
+
+#endif // FIFF_INDEX_H
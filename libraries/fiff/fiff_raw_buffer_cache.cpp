@@ -0,0 +1,249 @@
+//=============================================================================================================
+/**
+* @file     fiff_raw_buffer_cache.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    FiffRawBufferCache class definition.
+*
+*/
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_raw_buffer_cache.h"
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// Qt INCLUDES
+//=============================================================================================================
+
+#include <QFileInfo>
+#include <QDateTime>
+#include <QMutexLocker>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <climits>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace Eigen;
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+/**
+* QCache counts the cost as int, buffers are therefore accounted in kilobytes.
+*/
+static int cost_in_kbytes(qint64 bytes)
+{
+    qint64 kbytes = (bytes + 1023) / 1024;
+    return kbytes > INT_MAX ? INT_MAX : (int)kbytes;
+}
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+FiffRawBufferCache::FiffRawBufferCache(qint64 p_iMaxBytes)
+: m_iMaxBytes(p_iMaxBytes)
+, m_iHits(0)
+, m_iMisses(0)
+{
+    m_qCache.setMaxCost(cost_in_kbytes(p_iMaxBytes));
+}
+
+
+//*************************************************************************************************************
+
+FiffRawBufferCache::SPtr FiffRawBufferCache::globalCache()
+{
+    static FiffRawBufferCache::SPtr s_pGlobalCache(new FiffRawBufferCache());
+    return s_pGlobalCache;
+}
+
+
+//*************************************************************************************************************
+
+void FiffRawBufferCache::setMaxBytes(qint64 p_iMaxBytes)
+{
+    QMutexLocker locker(&m_qMutex);
+    m_iMaxBytes = p_iMaxBytes;
+    m_qCache.setMaxCost(cost_in_kbytes(p_iMaxBytes));
+}
+
+
+//*************************************************************************************************************
+
+qint64 FiffRawBufferCache::maxBytes() const
+{
+    QMutexLocker locker(&m_qMutex);
+    return m_iMaxBytes;
+}
+
+
+//*************************************************************************************************************
+
+qint64 FiffRawBufferCache::usedBytes() const
+{
+    QMutexLocker locker(&m_qMutex);
+    return (qint64)m_qCache.totalCost() * 1024;
+}
+
+
+//*************************************************************************************************************
+
+bool FiffRawBufferCache::isEnabled() const
+{
+    QMutexLocker locker(&m_qMutex);
+    return m_iMaxBytes > 0;
+}
+
+
+//*************************************************************************************************************
+
+FiffRawBufferCache::Source FiffRawBufferCache::source(const QString& p_sFileName, const RowVectorXd& p_vecCals)
+{
+    QFileInfo t_fileInfo(p_sFileName);
+
+    Source t_source;
+    t_source.fileName = t_fileInfo.absoluteFilePath();
+    t_source.size = t_fileInfo.size();
+    t_source.modified = t_fileInfo.lastModified().toMSecsSinceEpoch();
+    t_source.calsHash = qHashBits(p_vecCals.data(), p_vecCals.size() * sizeof(double));
+
+    return t_source;
+}
+
+
+//*************************************************************************************************************
+
+FiffRawBufferCache::BufferPtr FiffRawBufferCache::find(const Source& p_source, qint64 p_iPos)
+{
+    Key t_key = {p_source, p_iPos};
+
+    QMutexLocker locker(&m_qMutex);
+
+    BufferPtr* t_pBuffer = m_qCache.object(t_key);
+    if(t_pBuffer) {
+        ++m_iHits;
+        return *t_pBuffer;
+    }
+
+    ++m_iMisses;
+    return BufferPtr();
+}
+
+
+//*************************************************************************************************************
+
+void FiffRawBufferCache::insert(const Source& p_source, qint64 p_iPos, const BufferPtr& p_pBuffer)
+{
+    if(!p_pBuffer)
+        return;
+
+    Key t_key = {p_source, p_iPos};
+
+    QMutexLocker locker(&m_qMutex);
+
+    int cost = cost_in_kbytes((qint64)p_pBuffer->size() * sizeof(double));
+    if(m_iMaxBytes <= 0 || cost > m_qCache.maxCost())
+        return;
+
+    m_qCache.insert(t_key, new BufferPtr(p_pBuffer), cost);
+}
+
+
+//*************************************************************************************************************
+
+void FiffRawBufferCache::remove(const QString& p_sFileName)
+{
+    QString t_sFileName = QFileInfo(p_sFileName).absoluteFilePath();
+
+    QMutexLocker locker(&m_qMutex);
+
+    QList<Key> keys = m_qCache.keys();
+    for(int i = 0; i < keys.size(); ++i)
+        if(keys[i].source.fileName == t_sFileName)
+            m_qCache.remove(keys[i]);
+}
+
+
+//*************************************************************************************************************
+
+void FiffRawBufferCache::clear()
+{
+    QMutexLocker locker(&m_qMutex);
+    m_qCache.clear();
+}
+
+
+//*************************************************************************************************************
+
+qint64 FiffRawBufferCache::hits() const
+{
+    QMutexLocker locker(&m_qMutex);
+    return m_iHits;
+}
+
+
+//*************************************************************************************************************
+
+qint64 FiffRawBufferCache::misses() const
+{
+    QMutexLocker locker(&m_qMutex);
+    return m_iMisses;
+}
+
+
+//*************************************************************************************************************
+
+void FiffRawBufferCache::resetStatistics()
+{
+    QMutexLocker locker(&m_qMutex);
+    m_iHits = 0;
+    m_iMisses = 0;
+}
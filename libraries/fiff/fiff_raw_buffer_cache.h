@@ -0,0 +1,253 @@
+//=============================================================================================================
+/**
+* @file     fiff_raw_buffer_cache.h
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    FiffRawBufferCache class declaration.
+*
+*/
+
+#ifndef FIFF_RAW_BUFFER_CACHE_H
+#define FIFF_RAW_BUFFER_CACHE_H
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_global.h"
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// Eigen INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// Qt INCLUDES
+//=============================================================================================================
+
+#include <QCache>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE NAMESPACE FIFFLIB
+//=============================================================================================================
+
+namespace FIFFLIB
+{
+
+
+//=============================================================================================================
+/**
+* Bounded, thread safe least recently used cache of decoded raw data buffers. The buffers are stored calibrated
+* with all channels (channels x samples) and are keyed by their source, i.e. the absolute file name, its size and
+* modification time and the calibrations, and by the file position of their tag. Every reader of the same file with
+* the same calibrations shares them independent of selection, projection and compensation, while a rewritten file
+* or different calibrations never see stale buffers. The global cache is used by FiffRawData::read_raw_segment,
+* FiffRawReader and MneRawData. It is disabled (memory budget of 0) until a budget is set.
+*
+* @brief LRU cache of decoded raw data buffers
+*/
+class FIFFSHARED_EXPORT FiffRawBufferCache
+{
+public:
+    typedef QSharedPointer<FiffRawBufferCache> SPtr;                /**< Shared pointer type for FiffRawBufferCache. */
+    typedef QSharedPointer<const FiffRawBufferCache> ConstSPtr;     /**< Const shared pointer type for FiffRawBufferCache. */
+
+    typedef QSharedPointer<const Eigen::MatrixXd> BufferPtr;        /**< A decoded, calibrated buffer (channels x samples). */
+
+    /**
+    * Identifies the file and the calibrations buffers were decoded from.
+    */
+    struct Source {
+        QString fileName;   /**< Absolute file name. */
+        qint64  size;       /**< File size in bytes. */
+        qint64  modified;   /**< Last modification time in ms since the epoch. */
+        uint    calsHash;   /**< Hash of the calibrations applied while decoding. */
+
+        bool operator==(const Source& other) const
+        {
+            return fileName == other.fileName && size == other.size && modified == other.modified && calsHash == other.calsHash;
+        }
+    };
+
+    //=========================================================================================================
+    /**
+    * Constructs a cache with the given memory budget.
+    *
+    * @param[in] p_iMaxBytes    The memory budget in bytes, 0 disables the cache (default = 0)
+    */
+    explicit FiffRawBufferCache(qint64 p_iMaxBytes = 0);
+
+    //=========================================================================================================
+    /**
+    * Returns the cache which is shared by all raw data readers of the process.
+    *
+    * @return the global cache
+    */
+    static FiffRawBufferCache::SPtr globalCache();
+
+    //=========================================================================================================
+    /**
+    * Sets the memory budget. Least recently used buffers are dropped until the cache fits the new budget.
+    *
+    * @param[in] p_iMaxBytes    The memory budget in bytes, 0 disables the cache
+    */
+    void setMaxBytes(qint64 p_iMaxBytes);
+
+    //=========================================================================================================
+    /**
+    * Returns the memory budget.
+    *
+    * @return the memory budget in bytes
+    */
+    qint64 maxBytes() const;
+
+    //=========================================================================================================
+    /**
+    * Returns the memory currently held by cached buffers.
+    *
+    * @return the used memory in bytes
+    */
+    qint64 usedBytes() const;
+
+    //=========================================================================================================
+    /**
+    * Returns whether the cache is enabled, i.e. whether it has a memory budget.
+    *
+    * @return true if enabled
+    */
+    bool isEnabled() const;
+
+    //=========================================================================================================
+    /**
+    * Describes the current state of a file and the calibrations its buffers are decoded with.
+    *
+    * @param[in] p_sFileName    Name of the file
+    * @param[in] p_vecCals      The calibrations applied while decoding
+    *
+    * @return the source, keyed by the absolute file name
+    */
+    static Source source(const QString& p_sFileName, const Eigen::RowVectorXd& p_vecCals);
+
+    //=========================================================================================================
+    /**
+    * Looks up a buffer and marks it as most recently used. Counts a hit or a miss.
+    *
+    * @param[in] p_source       The source the buffer belongs to
+    * @param[in] p_iPos         File position of the buffer tag
+    *
+    * @return the buffer, a null pointer if it is not cached
+    */
+    BufferPtr find(const Source& p_source, qint64 p_iPos);
+
+    //=========================================================================================================
+    /**
+    * Inserts a buffer. Buffers which are larger than the memory budget are not cached.
+    *
+    * @param[in] p_source       The source the buffer belongs to
+    * @param[in] p_iPos         File position of the buffer tag
+    * @param[in] p_pBuffer      The decoded, calibrated buffer
+    */
+    void insert(const Source& p_source, qint64 p_iPos, const BufferPtr& p_pBuffer);
+
+    //=========================================================================================================
+    /**
+    * Removes all buffers of a file independent of its size, modification time and calibrations.
+    *
+    * @param[in] p_sFileName    Name of the file
+    */
+    void remove(const QString& p_sFileName);
+
+    //=========================================================================================================
+    /**
+    * Removes all buffers.
+    */
+    void clear();
+
+    //=========================================================================================================
+    /**
+    * Returns the number of lookups which found their buffer.
+    *
+    * @return the number of hits
+    */
+    qint64 hits() const;
+
+    //=========================================================================================================
+    /**
+    * Returns the number of lookups which did not find their buffer.
+    *
+    * @return the number of misses
+    */
+    qint64 misses() const;
+
+    //=========================================================================================================
+    /**
+    * Resets the hit and miss counters.
+    */
+    void resetStatistics();
+
+private:
+    /**
+    * Source and tag position of a buffer.
+    */
+    struct Key {
+        Source  source;
+        qint64  pos;
+
+        bool operator==(const Key& other) const
+        {
+            return pos == other.pos && source == other.source;
+        }
+
+        friend inline uint qHash(const Key& key, uint seed = 0)
+        {
+            return qHash(key.source.fileName, seed) ^ qHash(key.source.modified, seed) ^ key.source.calsHash ^ qHash(key.pos, seed);
+        }
+    };
+
+    mutable QMutex              m_qMutex;       /**< Guards all members. */
+    QCache<Key, BufferPtr>      m_qCache;       /**< The cached buffers, the cost is given in kilobytes. */
+    qint64                      m_iMaxBytes;    /**< The memory budget in bytes. */
+    qint64                      m_iHits;        /**< Number of lookups which found their buffer. */
+    qint64                      m_iMisses;      /**< Number of lookups which did not find their buffer. */
+};
+
+} // NAMESPACE
+
+#endif // FIFF_RAW_BUFFER_CACHE_H
@@ -43,7 +43,9 @@
 
 #include "fiff_global.h"
 #include "fiff_info.h"
+#include "fiff_raw_buffer_cache.h"
 #include "fiff_raw_dir.h"
+#include "fiff_raw_read_plan.h"
 #include "fiff_stream.h"
 
 
@@ -62,6 +64,7 @@
 //=============================================================================================================
 
 #include <QList>
+#include <QMutex>
 #include <QSharedPointer>
 
 
@@ -170,6 +173,9 @@ public:
     * @param[in] to         last sample to include. If omitted, defaults to the last sample in data (optional)
     * @param[in] sel        channel selection vector (optional)
     *
+    * Note: If the file was memory mapped with FiffStream::map_file(), the raw buffers are decoded straight
+    * from the mapping into data, without reading intermediate tags.
+    *
     * @return true if succeeded, false otherwise
     */
     bool read_raw_segment(MatrixXd& data, MatrixXd& times, SparseMatrix<double>& multSegment, fiff_int_t from = -1, fiff_int_t to = -1, const RowVectorXi& sel = defaultRowVectorXi, bool do_debug = false);
@@ -190,6 +196,46 @@ public:
     */
     bool read_raw_segment_times(MatrixXd& data, MatrixXd& times, float from, float to, const RowVectorXi& sel = defaultRowVectorXi);
 
+    //=========================================================================================================
+    /**
+    * Returns the read plan (calibration, compensation, projection and selection operator) for the given
+    * channel selection. The plan of the last selection is cached and only recompiled when the selection,
+    * the calibrations, the projector or the compensator changed.
+    *
+    * @param[in] sel        channel selection vector (optional)
+    *
+    * @return the read plan
+    */
+    FiffRawReadPlan::ConstSPtr read_plan(const RowVectorXi& sel = defaultRowVectorXi);
+
+    //=========================================================================================================
+    /**
+    * Describes the file and the calibrations for the global FiffRawBufferCache. Readers call this once per
+    * segment and pass the result to read_raw_buffer.
+    *
+    * @return the cache source, with an empty file name if the cache is disabled or the data is not read from a file
+    */
+    FiffRawBufferCache::Source cache_source() const;
+
+    //=========================================================================================================
+    /**
+    * Reads one raw data buffer and applies the read plan to the samples [first, first+picksamp-1]. Skips are
+    * translated to zeros. Buffers are looked up in and added to the global FiffRawBufferCache when cacheSource
+    * names a file, otherwise they are decoded straight from the memory mapping or the tag.
+    *
+    * @param[in] k          Index of the buffer in the raw directory
+    * @param[in] plan       The read plan to apply
+    * @param[in] cacheSource The cache source of the segment, see cache_source()
+    * @param[in] first      First sample of the buffer to pick
+    * @param[in] picksamp   Number of samples to pick
+    * @param[out] dst       The destination matrix, needs plan.nout() rows
+    * @param[in] dstCol     First destination column
+    * @param[in] pMutex     Mutex which serializes reads from the stream if buffers are decoded concurrently (optional)
+    *
+    * @return true if succeeded, false if the buffer could not be decoded
+    */
+    bool read_raw_buffer(qint32 k, const FiffRawReadPlan& plan, const FiffRawBufferCache::Source& cacheSource, fiff_int_t first, fiff_int_t picksamp, MatrixXd& dst, fiff_int_t dstCol, QMutex* pMutex = NULL) const;
+
 public:
     FiffStream::SPtr file;      /**< replaces fid */
     FiffInfo info;              /**< Fiff measurement information */
@@ -199,6 +245,9 @@ public:
     QList<FiffRawDir> rawdir;   /**< Special fiff diretory entry for raw data. */
     MatrixXd proj;              /**< SSP operator to apply to the data. */
     FiffCtfComp comp;           /**< Compensator. */
+
+private:
+    FiffRawReadPlan::ConstSPtr m_pReadPlan;   /**< Cached read plan of the last channel selection. */
 };
 
 } // NAMESPACE
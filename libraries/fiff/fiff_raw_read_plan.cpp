@@ -0,0 +1,469 @@
+//=============================================================================================================
+/**
+* @file     fiff_raw_read_plan.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    FiffRawReadPlan class definition.
+*
+*/
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_raw_read_plan.h"
+#include "fiff_raw_data.h"
+#include "fiff_file.h"
+
+#include <cstring>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// MNE INCLUDES
+//=============================================================================================================
+
+#include <utils/ioutils.h>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// Qt INCLUDES
+//=============================================================================================================
+
+#include <QtEndian>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace UTILSLIB;
+using namespace Eigen;
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+/**
+* Reads samples which are still in file (big endian) byte order.
+*/
+struct BigEndianSamples
+{
+    static inline double read(const uchar* p, qint16)
+    {
+        return qFromBigEndian<qint16>(p);
+    }
+
+    static inline double read(const uchar* p, qint32)
+    {
+        return qFromBigEndian<qint32>(p);
+    }
+
+    static inline double read(const uchar* p, float)
+    {
+        quint32 bits = qFromBigEndian<quint32>(p);
+        float value;
+        memcpy(&value, &bits, sizeof(float));
+        return value;
+    }
+
+    static inline void convert(const uchar* p, double* dst, qint64 count, qint16)
+    {
+        IOUtils::be_short_to_double(p, dst, count);
+    }
+
+    static inline void convert(const uchar* p, double* dst, qint64 count, qint32)
+    {
+        IOUtils::be_int_to_double(p, dst, count);
+    }
+
+    static inline void convert(const uchar* p, double* dst, qint64 count, float)
+    {
+        IOUtils::be_float_to_double(p, dst, count);
+    }
+};
+
+
+//*************************************************************************************************************
+/**
+* Reads samples which are already converted to native byte order.
+*/
+struct NativeSamples
+{
+    template<typename T>
+    static inline double read(const uchar* p, T)
+    {
+        T value;
+        memcpy(&value, p, sizeof(T));
+        return value;
+    }
+
+    template<typename T>
+    static inline void convert(const uchar* p, double* dst, qint64 count, T)
+    {
+        for(qint64 k = 0; k < count; ++k)
+            dst[k] = read(p + k * sizeof(T), T());
+    }
+};
+
+
+//*************************************************************************************************************
+/**
+* Gathers the rows of the picked samples of a raw buffer (channels x samples, sample major), converts them to
+* double and writes them, optionally scaled, column by column to dst. If rows is empty all channels are gathered
+* with the bulk conversion, in one call if the destination columns are contiguous.
+*/
+template<typename T, typename Samples>
+static void gather_samples(const uchar* src, qint32 nchan, qint32 first, qint32 picksamp, const RowVectorXi& rows, const double* scales, double* dst, qint64 dstStride)
+{
+    const qint32 nrows = rows.size() > 0 ? (qint32)rows.size() : nchan;
+    const int* t_pRows = rows.data();
+
+    if(!t_pRows) {
+        const uchar* t_pFirst = src + (qint64)first * nchan * sizeof(T);
+        if(dstStride == nchan) {
+            Samples::convert(t_pFirst, dst, (qint64)picksamp * nchan, T());
+        } else {
+            for(qint32 c = 0; c < picksamp; ++c)
+                Samples::convert(t_pFirst + (qint64)c * nchan * sizeof(T), dst + c * dstStride, nchan, T());
+        }
+
+        if(scales) {
+            for(qint32 c = 0; c < picksamp; ++c) {
+                double* t_pDst = dst + c * dstStride;
+                for(qint32 r = 0; r < nrows; ++r)
+                    t_pDst[r] *= scales[r];
+            }
+        }
+        return;
+    }
+
+    for(qint32 c = 0; c < picksamp; ++c) {
+        const uchar* t_pSample = src + (qint64)(first + c) * nchan * sizeof(T);
+        double* t_pDst = dst + c * dstStride;
+
+        for(qint32 r = 0; r < nrows; ++r)
+            t_pDst[r] = Samples::read(t_pSample + (qint64)t_pRows[r] * sizeof(T), T());
+
+        if(scales) {
+            for(qint32 r = 0; r < nrows; ++r)
+                t_pDst[r] *= scales[r];
+        }
+    }
+}
+
+
+//*************************************************************************************************************
+
+template<typename T>
+static void gather_samples(const uchar* src, bool bigEndian, qint32 nchan, qint32 first, qint32 picksamp, const RowVectorXi& rows, const double* scales, double* dst, qint64 dstStride)
+{
+    if(bigEndian)
+        gather_samples<T, BigEndianSamples>(src, nchan, first, picksamp, rows, scales, dst, dstStride);
+    else
+        gather_samples<T, NativeSamples>(src, nchan, first, picksamp, rows, scales, dst, dstStride);
+}
+
+
+//*************************************************************************************************************
+/**
+* Returns the size of one sample of the supported raw buffer types, 0 if the type is not supported.
+*/
+static qint64 sample_size(fiff_int_t type)
+{
+    switch(type) {
+    case FIFFT_DAU_PACK16:
+        return sizeof(qint16);
+    case FIFFT_INT:
+        return sizeof(qint32);
+    case FIFFT_FLOAT:
+        return sizeof(float);
+    default:
+        return 0;
+    }
+}
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+FiffRawReadPlan::FiffRawReadPlan()
+: m_iNchan(0)
+, m_iNout(0)
+, m_iCompKind(-1)
+{
+
+}
+
+
+//*************************************************************************************************************
+
+FiffRawReadPlan::FiffRawReadPlan(const FiffRawData& raw, const RowVectorXi& sel)
+: m_iNchan(raw.info.nchan)
+, m_iNout(sel.size() > 0 ? (qint32)sel.size() : raw.info.nchan)
+, m_vecSel(sel)
+, m_vecCals(raw.cals)
+, m_matProj(raw.proj)
+, m_iCompKind(raw.comp.kind)
+{
+    qint32 i, k;
+
+    if(m_iCompKind != -1)
+        m_matComp = raw.comp.data->data;
+
+    typedef Eigen::Triplet<double> T;
+    std::vector<T> tripletList;
+
+    if(m_matProj.size() == 0 && m_iCompKind == -1) {
+        //
+        //  Calibration of the selected channels only
+        //
+        m_vecInputRows = sel;
+        m_vecScales.resize(m_iNout);
+        tripletList.reserve(m_iNout);
+        for(i = 0; i < m_iNout; ++i) {
+            m_vecScales[i] = sel.size() > 0 ? m_vecCals[sel[i]] : m_vecCals[i];
+            tripletList.push_back(T(i, i, m_vecScales[i]));
+        }
+
+        m_matMult = SparseMatrix<double>(m_iNout, m_iNout);
+        m_matMult.setFromTriplets(tripletList.begin(), tripletList.end());
+        return;
+    }
+
+    //
+    //  Combine projection, compensation and calibration of the selected rows
+    //
+    MatrixXd op;
+    if(m_matProj.size() == 0)
+        op = m_matComp;
+    else if(m_iCompKind == -1)
+        op = m_matProj;
+    else
+        op = m_matProj * m_matComp;
+
+    if(sel.size() > 0) {
+        MatrixXd selOp(m_iNout, m_iNchan);
+        for(i = 0; i < m_iNout; ++i)
+            selOp.row(i) = op.row(sel[i]);
+        op = selOp;
+    }
+
+    MatrixXd calOp = op;
+    op = op * m_vecCals.asDiagonal();
+
+    //
+    //  Only channels with a non-zero weight have to be read from the buffers
+    //
+    QList<qint32> usedChannels;
+    tripletList.reserve(op.rows() * op.cols());
+    for(k = 0; k < op.cols(); ++k) {
+        bool used = false;
+        for(i = 0; i < op.rows(); ++i) {
+            if(op(i,k) != 0) {
+                tripletList.push_back(T(i, k, op(i,k)));
+                used = true;
+            }
+        }
+        if(used)
+            usedChannels.append(k);
+    }
+
+    m_matMult = SparseMatrix<double>(op.rows(), op.cols());
+    if(tripletList.size() > 0)
+        m_matMult.setFromTriplets(tripletList.begin(), tripletList.end());
+
+    m_vecInputRows.resize(usedChannels.size());
+    m_matOperator.resize(m_iNout, usedChannels.size());
+    m_matCalOperator.resize(m_iNout, usedChannels.size());
+    for(k = 0; k < usedChannels.size(); ++k) {
+        m_vecInputRows[k] = usedChannels[k];
+        m_matOperator.col(k) = op.col(usedChannels[k]);
+        m_matCalOperator.col(k) = calOp.col(usedChannels[k]);
+    }
+}
+
+
+//*************************************************************************************************************
+
+bool FiffRawReadPlan::isValidFor(const FiffRawData& raw, const RowVectorXi& sel) const
+{
+    if(isEmpty() || raw.info.nchan != m_iNchan || raw.comp.kind != m_iCompKind)
+        return false;
+
+    if(sel.size() != m_vecSel.size() || sel != m_vecSel)
+        return false;
+
+    if(raw.cals.size() != m_vecCals.size() || raw.cals != m_vecCals)
+        return false;
+
+    if(raw.proj.rows() != m_matProj.rows() || raw.proj.cols() != m_matProj.cols() || raw.proj != m_matProj)
+        return false;
+
+    if(m_iCompKind != -1) {
+        const MatrixXd& comp = raw.comp.data->data;
+        if(comp.rows() != m_matComp.rows() || comp.cols() != m_matComp.cols() || comp != m_matComp)
+            return false;
+    }
+
+    return true;
+}
+
+
+//*************************************************************************************************************
+
+bool FiffRawReadPlan::apply(const uchar* buffer, fiff_int_t type, fiff_int_t size, fiff_int_t nsamp, fiff_int_t first, fiff_int_t picksamp, bool bigEndian, MatrixXd& dst, fiff_int_t dstCol) const
+{
+    if(!buffer || isEmpty() || picksamp <= 0)
+        return false;
+
+    if(first < 0 || first + picksamp > nsamp || dst.rows() != m_iNout || dstCol + picksamp > dst.cols())
+        return false;
+
+    qint64 elemSize = sample_size(type);
+    if(elemSize == 0 || size < (qint64)m_iNchan * nsamp * elemSize)
+        return false;
+
+    //
+    //  Without an operator the calibrated rows are written straight to the destination,
+    //  otherwise the used channels are gathered and the operator is applied in one product
+    //
+    if(m_vecScales.size() == 0 && m_vecInputRows.size() == 0) {
+        dst.block(0, dstCol, m_iNout, picksamp).setZero();
+        return true;
+    }
+
+    MatrixXd gathered;
+    double* t_pDst;
+    qint64 dstStride;
+    const double* t_pScales;
+    if(m_vecScales.size() > 0) {
+        t_pDst = dst.data() + (qint64)dstCol * dst.rows();
+        dstStride = dst.rows();
+        t_pScales = m_vecScales.data();
+    } else {
+        gathered.resize(m_vecInputRows.size(), picksamp);
+        t_pDst = gathered.data();
+        dstStride = gathered.rows();
+        t_pScales = NULL;
+    }
+
+    switch(type) {
+    case FIFFT_DAU_PACK16:
+        gather_samples<qint16>(buffer, bigEndian, m_iNchan, first, picksamp, m_vecInputRows, t_pScales, t_pDst, dstStride);
+        break;
+    case FIFFT_INT:
+        gather_samples<qint32>(buffer, bigEndian, m_iNchan, first, picksamp, m_vecInputRows, t_pScales, t_pDst, dstStride);
+        break;
+    default:
+        gather_samples<float>(buffer, bigEndian, m_iNchan, first, picksamp, m_vecInputRows, t_pScales, t_pDst, dstStride);
+        break;
+    }
+
+    if(m_vecScales.size() == 0)
+        dst.block(0, dstCol, m_iNout, picksamp).noalias() = m_matOperator * gathered;
+
+    return true;
+}
+
+
+//*************************************************************************************************************
+
+bool FiffRawReadPlan::apply(const MatrixXd& calibrated, fiff_int_t first, fiff_int_t picksamp, MatrixXd& dst, fiff_int_t dstCol) const
+{
+    if(isEmpty() || picksamp <= 0 || calibrated.rows() != m_iNchan)
+        return false;
+
+    if(first < 0 || first + picksamp > calibrated.cols() || dst.rows() != m_iNout || dstCol + picksamp > dst.cols())
+        return false;
+
+    if(m_vecScales.size() == 0 && m_vecInputRows.size() == 0) {
+        dst.block(0, dstCol, m_iNout, picksamp).setZero();
+        return true;
+    }
+
+    //
+    //  The calibration is already applied, only selection and operator remain
+    //
+    if(m_vecScales.size() > 0) {
+        if(m_vecInputRows.size() == 0) {
+            dst.block(0, dstCol, m_iNout, picksamp) = calibrated.block(0, first, m_iNchan, picksamp);
+        } else {
+            for(qint32 c = 0; c < picksamp; ++c)
+                for(qint32 r = 0; r < m_iNout; ++r)
+                    dst(r, dstCol + c) = calibrated(m_vecInputRows[r], first + c);
+        }
+        return true;
+    }
+
+    MatrixXd gathered(m_vecInputRows.size(), picksamp);
+    for(qint32 c = 0; c < picksamp; ++c)
+        for(qint32 r = 0; r < m_vecInputRows.size(); ++r)
+            gathered(r, c) = calibrated(m_vecInputRows[r], first + c);
+
+    dst.block(0, dstCol, m_iNout, picksamp).noalias() = m_matCalOperator * gathered;
+
+    return true;
+}
+
+
+//*************************************************************************************************************
+
+bool FiffRawReadPlan::decode(const uchar* buffer, fiff_int_t type, fiff_int_t size, fiff_int_t nsamp, bool bigEndian, const RowVectorXd& cals, MatrixXd& dst)
+{
+    const qint32 nchan = (qint32)cals.size();
+    qint64 elemSize = sample_size(type);
+    if(!buffer || nchan == 0 || nsamp <= 0 || elemSize == 0 || size < (qint64)nchan * nsamp * elemSize)
+        return false;
+
+    dst.resize(nchan, nsamp);
+
+    RowVectorXi allRows;
+    switch(type) {
+    case FIFFT_DAU_PACK16:
+        gather_samples<qint16>(buffer, bigEndian, nchan, 0, nsamp, allRows, cals.data(), dst.data(), nchan);
+        break;
+    case FIFFT_INT:
+        gather_samples<qint32>(buffer, bigEndian, nchan, 0, nsamp, allRows, cals.data(), dst.data(), nchan);
+        break;
+    default:
+        gather_samples<float>(buffer, bigEndian, nchan, 0, nsamp, allRows, cals.data(), dst.data(), nchan);
+        break;
+    }
+
+    return true;
+}
@@ -0,0 +1,253 @@
+//=============================================================================================================
+/**
+* @file     fiff_raw_read_plan.h
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    FiffRawReadPlan class declaration.
+*
+*/
+
+#ifndef FIFF_RAW_READ_PLAN_H
+#define FIFF_RAW_READ_PLAN_H
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_global.h"
+#include "fiff_types.h"
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// Eigen INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+#include <Eigen/SparseCore>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// Qt INCLUDES
+//=============================================================================================================
+
+#include <QSharedPointer>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE NAMESPACE FIFFLIB
+//=============================================================================================================
+
+namespace FIFFLIB
+{
+
+class FiffRawData;
+
+
+//=============================================================================================================
+/**
+* The read plan holds the complete operator which turns a raw data buffer into calibrated, compensated and
+* projected data of a channel selection. It is compiled once per FiffRawData and selection. Applying it to a
+* buffer gathers only the channels which contribute to the output and converts them to double in one pass.
+*
+* @brief Precompiled calibration, compensation, projection and selection operator for raw data reads
+*/
+class FIFFSHARED_EXPORT FiffRawReadPlan
+{
+public:
+    typedef QSharedPointer<FiffRawReadPlan> SPtr;               /**< Shared pointer type for FiffRawReadPlan. */
+    typedef QSharedPointer<const FiffRawReadPlan> ConstSPtr;    /**< Const shared pointer type for FiffRawReadPlan. */
+
+    //=========================================================================================================
+    /**
+    * Default constructor. Creates an empty read plan.
+    */
+    FiffRawReadPlan();
+
+    //=========================================================================================================
+    /**
+    * Compiles the read plan for the given raw data and channel selection.
+    *
+    * @param[in] raw        The raw data providing calibrations, projector and compensator
+    * @param[in] sel        Channel selection vector (optional)
+    */
+    FiffRawReadPlan(const FiffRawData& raw, const Eigen::RowVectorXi& sel = defaultRowVectorXi);
+
+    //=========================================================================================================
+    /**
+    * True if the read plan is empty.
+    *
+    * @return true if the read plan is empty
+    */
+    inline bool isEmpty() const;
+
+    //=========================================================================================================
+    /**
+    * Checks whether the read plan was compiled for the current state of raw and the given selection.
+    *
+    * @param[in] raw        The raw data to check against
+    * @param[in] sel        Channel selection vector
+    *
+    * @return true if the plan can be applied to buffers of raw, false if it has to be recompiled
+    */
+    bool isValidFor(const FiffRawData& raw, const Eigen::RowVectorXi& sel = defaultRowVectorXi) const;
+
+    //=========================================================================================================
+    /**
+    * Returns the number of channels stored in each raw data buffer.
+    *
+    * @return the number of channels of the raw data buffers
+    */
+    inline qint32 nchan() const;
+
+    //=========================================================================================================
+    /**
+    * Returns the number of rows the plan produces, i.e. the number of selected channels.
+    *
+    * @return the number of output rows
+    */
+    inline qint32 nout() const;
+
+    //=========================================================================================================
+    /**
+    * Returns the used multiplication matrix (compensator, projection, calibration) as returned by
+    * FiffRawData::read_raw_segment.
+    *
+    * @return the multiplication matrix
+    */
+    inline const Eigen::SparseMatrix<double>& mult() const;
+
+    //=========================================================================================================
+    /**
+    * Applies the plan to the samples [first, first+picksamp-1] of one raw data buffer and writes the result
+    * to the columns [dstCol, dstCol+picksamp-1] of dst. Supported buffer types are FIFFT_DAU_PACK16,
+    * FIFFT_INT and FIFFT_FLOAT.
+    *
+    * @param[in] buffer         The raw data buffer (channels x samples, sample major)
+    * @param[in] type           The fiff data type of the buffer
+    * @param[in] size           The size of the buffer in bytes
+    * @param[in] nsamp          Number of samples stored in the buffer
+    * @param[in] first          First sample of the buffer to pick
+    * @param[in] picksamp       Number of samples to pick
+    * @param[in] bigEndian      Whether the buffer is still in file byte order (e.g. memory mapped) or already native
+    * @param[out] dst           The destination matrix, needs nout() rows
+    * @param[in] dstCol         First destination column
+    *
+    * @return true if succeeded, false if the buffer type is not supported or the buffer is too small
+    */
+    bool apply(const uchar* buffer, fiff_int_t type, fiff_int_t size, fiff_int_t nsamp, fiff_int_t first, fiff_int_t picksamp, bool bigEndian, Eigen::MatrixXd& dst, fiff_int_t dstCol) const;
+
+    //=========================================================================================================
+    /**
+    * Applies the plan to the samples [first, first+picksamp-1] of an already decoded and calibrated raw data
+    * buffer (see decode) and writes the result to the columns [dstCol, dstCol+picksamp-1] of dst.
+    *
+    * @param[in] calibrated     The decoded and calibrated buffer, needs nchan() rows
+    * @param[in] first          First sample of the buffer to pick
+    * @param[in] picksamp       Number of samples to pick
+    * @param[out] dst           The destination matrix, needs nout() rows
+    * @param[in] dstCol         First destination column
+    *
+    * @return true if succeeded, false if the buffer does not match the plan
+    */
+    bool apply(const Eigen::MatrixXd& calibrated, fiff_int_t first, fiff_int_t picksamp, Eigen::MatrixXd& dst, fiff_int_t dstCol) const;
+
+    //=========================================================================================================
+    /**
+    * Decodes all channels and samples of a raw data buffer and applies the calibrations. The result can be
+    * shared by all read plans of the same raw data, e.g. through FiffRawBufferCache.
+    *
+    * @param[in] buffer         The raw data buffer (channels x samples, sample major)
+    * @param[in] type           The fiff data type of the buffer
+    * @param[in] size           The size of the buffer in bytes
+    * @param[in] nsamp          Number of samples stored in the buffer
+    * @param[in] bigEndian      Whether the buffer is still in file byte order (e.g. memory mapped) or already native
+    * @param[in] cals           The calibration of each channel
+    * @param[out] dst           The decoded buffer (channels x samples)
+    *
+    * @return true if succeeded, false if the buffer type is not supported or the buffer is too small
+    */
+    static bool decode(const uchar* buffer, fiff_int_t type, fiff_int_t size, fiff_int_t nsamp, bool bigEndian, const Eigen::RowVectorXd& cals, Eigen::MatrixXd& dst);
+
+private:
+    qint32                      m_iNchan;           /**< Number of channels in the raw data buffers. */
+    qint32                      m_iNout;            /**< Number of output rows. */
+    Eigen::RowVectorXi          m_vecInputRows;     /**< Buffer channels which are gathered from each buffer. Empty if all channels are used. */
+    Eigen::RowVectorXd          m_vecScales;        /**< Calibration per gathered channel, used when no projection or compensation is active. */
+    Eigen::MatrixXd             m_matOperator;      /**< Operator applied to the gathered channels if projection or compensation is active, empty otherwise. */
+    Eigen::MatrixXd             m_matCalOperator;   /**< Same as m_matOperator without the calibration, applied to decoded buffers. */
+    Eigen::SparseMatrix<double> m_matMult;          /**< Multiplication matrix as returned by read_raw_segment. */
+
+    Eigen::RowVectorXi          m_vecSel;           /**< The selection the plan was compiled for. */
+    Eigen::RowVectorXd          m_vecCals;          /**< The calibrations the plan was compiled for. */
+    Eigen::MatrixXd             m_matProj;          /**< The projector the plan was compiled for. */
+    Eigen::MatrixXd             m_matComp;          /**< The compensator the plan was compiled for. */
+    fiff_int_t                  m_iCompKind;        /**< The compensator kind the plan was compiled for. */
+};
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline bool FiffRawReadPlan::isEmpty() const
+{
+    return m_iNout == 0;
+}
+
+
+//*************************************************************************************************************
+
+inline qint32 FiffRawReadPlan::nchan() const
+{
+    return m_iNchan;
+}
+
+
+//*************************************************************************************************************
+
+inline qint32 FiffRawReadPlan::nout() const
+{
+    return m_iNout;
+}
+
+
+//*************************************************************************************************************
+
+inline const Eigen::SparseMatrix<double>& FiffRawReadPlan::mult() const
+{
+    return m_matMult;
+}
+
+} // NAMESPACE
+
+#endif // FIFF_RAW_READ_PLAN_H
@@ -0,0 +1,283 @@
+//=============================================================================================================
+/**
+* @file     fiff_raw_reader.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    FiffRawReader class definition.
+*
+*/
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_raw_reader.h"
+#include "fiff_stream.h"
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// Qt INCLUDES
+//=============================================================================================================
+
+#include <QtConcurrent>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace Eigen;
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+/**
+* One raw data buffer of a segment: which samples of the buffer are picked and where they go.
+*/
+struct RawBufferJob
+{
+    qint32      rawdir;     /**< Index of the buffer in the raw directory. */
+    fiff_int_t  first;      /**< First picked sample of the buffer. */
+    fiff_int_t  picksamp;   /**< Number of picked samples. */
+    fiff_int_t  dest;       /**< Destination column in the segment. */
+};
+
+
+//*************************************************************************************************************
+/**
+* Reads and decodes one raw data buffer into its columns of the segment.
+*/
+struct RawBufferDecoder
+{
+    FiffRawData::SPtr           pRaw;
+    QSharedPointer<QMutex>      pMutex;
+    FiffRawReadPlan::ConstSPtr  plan;
+    FiffRawBufferCache::Source  cacheSource;
+    MatrixXd*                   pData;
+
+    void operator()(const RawBufferJob& job) const
+    {
+        if(!pRaw->read_raw_buffer(job.rawdir, *plan, cacheSource, job.first, job.picksamp, *pData, job.dest, pMutex.data()))
+            pData->block(0, job.dest, pData->rows(), job.picksamp).setZero();
+    }
+};
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+FiffRawReader::FiffRawReader(const FiffRawData::SPtr& p_pRaw, bool p_bPrefetch)
+: m_pRaw(p_pRaw)
+, m_pMutex(new QMutex)
+, m_bPrefetch(p_bPrefetch)
+, m_iLastFrom(-1)
+, m_iPrefetchFrom(-1)
+, m_iPrefetchTo(-1)
+{
+
+}
+
+
+//*************************************************************************************************************
+
+FiffRawReader::~FiffRawReader()
+{
+    m_prefetchFuture.waitForFinished();
+}
+
+
+//*************************************************************************************************************
+
+void FiffRawReader::setPrefetchEnabled(bool p_bPrefetch)
+{
+    m_bPrefetch = p_bPrefetch;
+}
+
+
+//*************************************************************************************************************
+
+bool FiffRawReader::isPrefetchEnabled() const
+{
+    return m_bPrefetch;
+}
+
+
+//*************************************************************************************************************
+
+QFuture<FiffRawReader::Segment> FiffRawReader::read_raw_segment_async(fiff_int_t from, fiff_int_t to, const RowVectorXi& sel)
+{
+    if(from == -1)
+        from = m_pRaw->first_samp;
+    if(to == -1)
+        to = m_pRaw->last_samp;
+    if(from < m_pRaw->first_samp)
+        from = m_pRaw->first_samp;
+    if(to > m_pRaw->last_samp)
+        to = m_pRaw->last_samp;
+
+    if(!m_pRaw->file->device()->isOpen()) {
+        QMutexLocker locker(m_pMutex.data());
+        m_pRaw->file->unmap_file(); // closing the device invalidated the mapping
+        if(!m_pRaw->file->device()->open(QIODevice::ReadOnly))
+            printf("Cannot open file %s\n", m_pRaw->info.filename.toUtf8().constData());
+    }
+
+    FiffRawReadPlan::ConstSPtr plan = m_pRaw->read_plan(sel);
+
+    QFuture<Segment> future = startRead(from, to, plan);
+
+    //
+    //  Prefetch the adjacent window in the direction of travel
+    //
+    if(m_bPrefetch && from <= to) {
+        fiff_int_t nsamp = to - from + 1;
+        fiff_int_t nextFrom, nextTo;
+
+        if(m_iLastFrom == -1 || from >= m_iLastFrom) {
+            nextFrom = to + 1;
+            nextTo = qMin(to + nsamp, m_pRaw->last_samp);
+        } else {
+            nextFrom = qMax(from - nsamp, m_pRaw->first_samp);
+            nextTo = from - 1;
+        }
+
+        //A stale prefetch cannot be cancelled. Replacing it while it still runs would pile up reads in the pool,
+        //so a new prefetch is only started once the old one has finished.
+        bool bStaleRunning = m_iPrefetchFrom != -1 && m_prefetchFuture.isRunning();
+
+        if(nextFrom <= nextTo && !bStaleRunning && !(nextFrom == m_iPrefetchFrom && nextTo == m_iPrefetchTo && plan == m_pPrefetchPlan)) {
+            m_prefetchFuture = QtConcurrent::run(readSegment, m_pRaw, m_pMutex, plan, nextFrom, nextTo);
+            m_iPrefetchFrom = nextFrom;
+            m_iPrefetchTo = nextTo;
+            m_pPrefetchPlan = plan;
+        }
+    }
+
+    m_iLastFrom = from;
+
+    return future;
+}
+
+
+//*************************************************************************************************************
+
+bool FiffRawReader::read_raw_segment(MatrixXd& data, MatrixXd& times, fiff_int_t from, fiff_int_t to, const RowVectorXi& sel)
+{
+    Segment segment = read_raw_segment_async(from, to, sel).result();
+
+    if(segment.first.cols() == 0) {
+        printf("No data in this range\n");
+        return false;
+    }
+
+    data = segment.first;
+    times = segment.second;
+
+    return true;
+}
+
+
+//*************************************************************************************************************
+
+QFuture<FiffRawReader::Segment> FiffRawReader::startRead(fiff_int_t from, fiff_int_t to, const FiffRawReadPlan::ConstSPtr& plan)
+{
+    if(from == m_iPrefetchFrom && to == m_iPrefetchTo && plan == m_pPrefetchPlan) {
+        QFuture<Segment> future = m_prefetchFuture;
+        m_iPrefetchFrom = m_iPrefetchTo = -1;
+        m_pPrefetchPlan.clear();
+        return future;
+    }
+
+    return QtConcurrent::run(readSegment, m_pRaw, m_pMutex, plan, from, to);
+}
+
+
+//*************************************************************************************************************
+
+FiffRawReader::Segment FiffRawReader::readSegment(FiffRawData::SPtr pRaw, QSharedPointer<QMutex> pMutex, FiffRawReadPlan::ConstSPtr plan, fiff_int_t from, fiff_int_t to)
+{
+    Segment segment;
+
+    if(from > to)
+        return segment;
+
+    //
+    //  Split the segment into its buffers
+    //
+    QList<RawBufferJob> jobs;
+    fiff_int_t dest = 0;
+    for(qint32 k = 0; k < pRaw->rawdir.size(); ++k) {
+        const FiffRawDir& rawDir = pRaw->rawdir.at(k);
+
+        if(rawDir.last >= from && rawDir.first <= to) {
+            RawBufferJob job;
+            job.rawdir = k;
+            job.first = qMax(from, rawDir.first) - rawDir.first;
+            job.picksamp = qMin(to, rawDir.last) - rawDir.first - job.first + 1;
+            job.dest = dest;
+            jobs.append(job);
+
+            dest += job.picksamp;
+        }
+
+        if(rawDir.last >= to)
+            break;
+    }
+
+    segment.first = MatrixXd(plan->nout(), to - from + 1);
+    if(dest < segment.first.cols())
+        segment.first.rightCols(segment.first.cols() - dest).setZero();
+
+    //
+    //  Decode all buffers in parallel, each job writes its own columns
+    //
+    RawBufferDecoder decoder;
+    decoder.pRaw = pRaw;
+    decoder.pMutex = pMutex;
+    decoder.plan = plan;
+    decoder.cacheSource = pRaw->cache_source();
+    decoder.pData = &segment.first;
+
+    QtConcurrent::blockingMap(jobs, decoder);
+
+    segment.second = MatrixXd(1, to - from + 1);
+    for(qint32 i = 0; i < segment.second.cols(); ++i)
+        segment.second(0, i) = ((float)(from + i)) / pRaw->info.sfreq;
+
+    return segment;
+}
@@ -0,0 +1,182 @@
+//=============================================================================================================
+/**
+* @file     fiff_raw_reader.h
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    FiffRawReader class declaration.
+*
+*/
+
+#ifndef FIFF_RAW_READER_H
+#define FIFF_RAW_READER_H
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_global.h"
+#include "fiff_types.h"
+#include "fiff_raw_data.h"
+#include "fiff_raw_read_plan.h"
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// Eigen INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// Qt INCLUDES
+//=============================================================================================================
+
+#include <QFuture>
+#include <QMutex>
+#include <QPair>
+#include <QSharedPointer>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE NAMESPACE FIFFLIB
+//=============================================================================================================
+
+namespace FIFFLIB
+{
+
+
+//=============================================================================================================
+/**
+* Reads raw data segments asynchronously. A requested segment is split into its raw data buffers which are
+* read and decoded in parallel on the global thread pool. After each request the adjacent window in the
+* direction of travel is prefetched in the background, so that scrolling through a file or reading
+* consecutive epochs finds the next segment already decoded.
+*
+* Memory mapped files (see FiffStream::map_file) are decoded fully in parallel. Otherwise the tag reads are
+* serialized on the stream and only the decoding runs in parallel. While a reader is in use the raw data file
+* should only be read through the reader.
+*
+* @brief Parallel raw data reader with read-ahead
+*/
+class FIFFSHARED_EXPORT FiffRawReader
+{
+public:
+    typedef QSharedPointer<FiffRawReader> SPtr;               /**< Shared pointer type for FiffRawReader. */
+    typedef QSharedPointer<const FiffRawReader> ConstSPtr;    /**< Const shared pointer type for FiffRawReader. */
+
+    typedef QPair<Eigen::MatrixXd, Eigen::MatrixXd> Segment;  /**< A data (channels x samples) and times pair. */
+
+    //=========================================================================================================
+    /**
+    * Constructs a reader for the given raw data.
+    *
+    * @param[in] p_pRaw         The raw data to read from
+    * @param[in] p_bPrefetch    Whether the adjacent window should be prefetched after each request (default = true)
+    */
+    explicit FiffRawReader(const FiffRawData::SPtr& p_pRaw, bool p_bPrefetch = true);
+
+    //=========================================================================================================
+    /**
+    * Destroys the reader, a running prefetch is waited for.
+    */
+    ~FiffRawReader();
+
+    //=========================================================================================================
+    /**
+    * Enables or disables prefetching of the adjacent window.
+    *
+    * @param[in] p_bPrefetch    Whether to prefetch
+    */
+    void setPrefetchEnabled(bool p_bPrefetch);
+
+    //=========================================================================================================
+    /**
+    * Returns whether the adjacent window is prefetched after each request.
+    *
+    * @return true if prefetching is enabled
+    */
+    bool isPrefetchEnabled() const;
+
+    //=========================================================================================================
+    /**
+    * Starts reading a raw data segment in the background. The result is the same as of
+    * FiffRawData::read_raw_segment.
+    *
+    * @param[in] from       first sample to include. If omitted, defaults to the first sample in data (optional)
+    * @param[in] to         last sample to include. If omitted, defaults to the last sample in data (optional)
+    * @param[in] sel        channel selection vector (optional)
+    *
+    * @return the future holding the data and times of the segment, both are empty if the range contains no data
+    */
+    QFuture<Segment> read_raw_segment_async(fiff_int_t from = -1, fiff_int_t to = -1, const Eigen::RowVectorXi& sel = defaultRowVectorXi);
+
+    //=========================================================================================================
+    /**
+    * Reads a raw data segment and waits for the result. The buffers are still decoded in parallel.
+    *
+    * @param[out] data      returns the data matrix (channels x samples)
+    * @param[out] times     returns the time values corresponding to the samples
+    * @param[in] from       first sample to include. If omitted, defaults to the first sample in data (optional)
+    * @param[in] to         last sample to include. If omitted, defaults to the last sample in data (optional)
+    * @param[in] sel        channel selection vector (optional)
+    *
+    * @return true if succeeded, false otherwise
+    */
+    bool read_raw_segment(Eigen::MatrixXd& data, Eigen::MatrixXd& times, fiff_int_t from = -1, fiff_int_t to = -1, const Eigen::RowVectorXi& sel = defaultRowVectorXi);
+
+private:
+    //=========================================================================================================
+    /**
+    * Starts reading the segment [from, to], or hands out the prefetched one if it matches.
+    */
+    QFuture<Segment> startRead(fiff_int_t from, fiff_int_t to, const FiffRawReadPlan::ConstSPtr& plan);
+
+    //=========================================================================================================
+    /**
+    * Reads and decodes all buffers of the segment [from, to] in parallel. Runs in a worker thread.
+    */
+    static Segment readSegment(FiffRawData::SPtr pRaw, QSharedPointer<QMutex> pMutex, FiffRawReadPlan::ConstSPtr plan, fiff_int_t from, fiff_int_t to);
+
+    FiffRawData::SPtr           m_pRaw;             /**< The raw data to read from. */
+    QSharedPointer<QMutex>      m_pMutex;           /**< Serializes tag reads of files which are not memory mapped. */
+    bool                        m_bPrefetch;        /**< Whether the adjacent window is prefetched. */
+    fiff_int_t                  m_iLastFrom;        /**< First sample of the last request, used to determine the direction of travel. */
+
+    QFuture<Segment>            m_prefetchFuture;   /**< The prefetched segment. */
+    fiff_int_t                  m_iPrefetchFrom;    /**< First sample of the prefetched segment. */
+    fiff_int_t                  m_iPrefetchTo;      /**< Last sample of the prefetched segment. */
+    FiffRawReadPlan::ConstSPtr  m_pPrefetchPlan;    /**< Read plan the prefetched segment was decoded with. */
+};
+
+} // NAMESPACE
+
+#endif // FIFF_RAW_READER_H
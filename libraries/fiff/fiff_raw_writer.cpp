@@ -0,0 +1,500 @@
+//=============================================================================================================
+/**
+* @file     fiff_raw_writer.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    FiffRawWriter class definition.
+*
+*/
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_raw_writer.h"
+#include "fiff_file.h"
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// MNE INCLUDES
+//=============================================================================================================
+
+#include <utils/ioutils.h>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// Qt INCLUDES
+//=============================================================================================================
+
+#include <QMutexLocker>
+#include <QtEndian>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace UTILSLIB;
+using namespace Eigen;
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+static void append_skip(QByteArray& p_staging, qint32 p_iSkip)
+{
+    uchar t_skip[FIFFC_TAG_INFO_SIZE + 4];
+    qToBigEndian<qint32>(FIFF_DATA_SKIP, t_skip);
+    qToBigEndian<qint32>(FIFFT_INT, t_skip + 4);
+    qToBigEndian<qint32>(4, t_skip + 8);
+    qToBigEndian<qint32>(FIFFV_NEXT_SEQ, t_skip + 12);
+    qToBigEndian<qint32>(p_iSkip, t_skip + FIFFC_TAG_INFO_SIZE);
+    p_staging.append((const char*)t_skip, sizeof(t_skip));
+}
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+FiffRawWriter::FiffRawWriter(const FiffStream::SPtr& p_pStream, qint32 p_iPoolSize, bool p_bDropWhenFull, qint64 p_iCoalesceBytes)
+: m_pStream(p_pStream)
+, m_bDropWhenFull(p_bDropWhenFull)
+, m_iCoalesceBytes(p_iCoalesceBytes)
+, m_qVecPool(qMax(p_iPoolSize, 1))
+, m_qVecSkip(qMax(p_iPoolSize, 1), 0)
+, m_iPendingSkip(0)
+, m_iInFlight(0)
+, m_iFilling(0)
+, m_bStop(false)
+, m_bFinish(false)
+, m_iMaxQueueDepth(0)
+, m_iDropped(0)
+, m_iWritten(0)
+, m_iWriteErrors(0)
+{
+    for(qint32 i = 0; i < m_qVecPool.size(); ++i)
+        m_qQueueFree.enqueue(i);
+
+    this->start();
+}
+
+
+//*************************************************************************************************************
+
+FiffRawWriter::FiffRawWriter(const OpenFunction& p_openStream, qint32 p_iPoolSize, bool p_bDropWhenFull, qint64 p_iCoalesceBytes)
+: m_openStream(p_openStream)
+, m_bDropWhenFull(p_bDropWhenFull)
+, m_iCoalesceBytes(p_iCoalesceBytes)
+, m_qVecPool(qMax(p_iPoolSize, 1))
+, m_qVecSkip(qMax(p_iPoolSize, 1), 0)
+, m_iPendingSkip(0)
+, m_iInFlight(0)
+, m_iFilling(0)
+, m_bStop(false)
+, m_bFinish(false)
+, m_iMaxQueueDepth(0)
+, m_iDropped(0)
+, m_iWritten(0)
+, m_iWriteErrors(0)
+{
+    for(qint32 i = 0; i < m_qVecPool.size(); ++i)
+        m_qQueueFree.enqueue(i);
+
+    this->start();
+}
+
+
+//*************************************************************************************************************
+
+FiffRawWriter::~FiffRawWriter()
+{
+    stop();
+}
+
+
+//*************************************************************************************************************
+
+bool FiffRawWriter::write_raw_buffer(const MatrixXd& buf, const RowVectorXd& cals)
+{
+    if (buf.rows() != cals.cols())
+    {
+        printf("buffer and calibration sizes do not match\n");
+        return false;
+    }
+
+    qint32 index = acquire(buf.rows()*buf.cols());
+    if(index < 0)
+        return false;
+
+    Map<MatrixXf> tmp(tagData(index), buf.rows(), buf.cols());
+    tmp = (cals.cwiseInverse().asDiagonal()*buf).cast<float>();
+
+    enqueue(index);
+    return true;
+}
+
+
+//*************************************************************************************************************
+
+bool FiffRawWriter::write_raw_buffer(const MatrixXd& buf, const SparseMatrix<double>& mult)
+{
+    if (buf.rows() != mult.cols()) {
+        printf("buffer and mult sizes do not match\n");
+        return false;
+    }
+
+    qint32 index = acquire(mult.rows()*buf.cols());
+    if(index < 0)
+        return false;
+
+    SparseMatrix<double> inv_mult(mult);
+    for (int k=0; k<inv_mult.outerSize(); ++k)
+        for (SparseMatrix<double>::InnerIterator it(inv_mult,k); it; ++it)
+            it.valueRef() = 1/it.value();
+
+    Map<MatrixXf> tmp(tagData(index), mult.rows(), buf.cols());
+    tmp = (inv_mult*buf).cast<float>();
+
+    enqueue(index);
+    return true;
+}
+
+
+//*************************************************************************************************************
+
+bool FiffRawWriter::write_raw_buffer(const MatrixXd& buf)
+{
+    qint32 index = acquire(buf.rows()*buf.cols());
+    if(index < 0)
+        return false;
+
+    Map<MatrixXf> tmp(tagData(index), buf.rows(), buf.cols());
+    tmp = buf.cast<float>();
+
+    enqueue(index);
+    return true;
+}
+
+
+//*************************************************************************************************************
+
+bool FiffRawWriter::write_raw_buffer(const MatrixXf& buf)
+{
+    qint32 index = acquire(buf.rows()*buf.cols());
+    if(index < 0)
+        return false;
+
+    Map<MatrixXf> tmp(tagData(index), buf.rows(), buf.cols());
+    tmp = buf;
+
+    enqueue(index);
+    return true;
+}
+
+
+//*************************************************************************************************************
+
+void FiffRawWriter::flush()
+{
+    QMutexLocker locker(&m_qMutex);
+    while(isRunning() && (!m_qQueueFull.isEmpty() || m_iInFlight > 0))
+        m_qBufferFree.wait(&m_qMutex);
+}
+
+
+//*************************************************************************************************************
+
+void FiffRawWriter::finish_writing_raw()
+{
+    finish_writing_raw_async();
+    this->wait();
+}
+
+
+//*************************************************************************************************************
+
+void FiffRawWriter::finish_writing_raw_async(const TailFunction& p_writeTail)
+{
+    QMutexLocker locker(&m_qMutex);
+    if(m_bStop)
+        return;
+    m_bStop = true;
+    m_bFinish = true;
+    m_writeTail = p_writeTail;
+    m_qBufferQueued.wakeAll();
+}
+
+
+//*************************************************************************************************************
+
+qint32 FiffRawWriter::queueDepth() const
+{
+    QMutexLocker locker(&m_qMutex);
+    return m_qQueueFull.size() + m_iInFlight;
+}
+
+
+//*************************************************************************************************************
+
+qint32 FiffRawWriter::maxQueueDepth() const
+{
+    QMutexLocker locker(&m_qMutex);
+    return m_iMaxQueueDepth;
+}
+
+
+//*************************************************************************************************************
+
+qint64 FiffRawWriter::droppedBuffers() const
+{
+    QMutexLocker locker(&m_qMutex);
+    return m_iDropped;
+}
+
+
+//*************************************************************************************************************
+
+qint64 FiffRawWriter::writtenBuffers() const
+{
+    QMutexLocker locker(&m_qMutex);
+    return m_iWritten;
+}
+
+
+//*************************************************************************************************************
+
+qint64 FiffRawWriter::writeErrors() const
+{
+    QMutexLocker locker(&m_qMutex);
+    return m_iWriteErrors;
+}
+
+
+//*************************************************************************************************************
+
+void FiffRawWriter::run()
+{
+    if(m_openStream)
+        m_pStream = m_openStream();
+
+    QByteArray t_staging;
+    t_staging.reserve(m_iCoalesceBytes);
+    QList<qint32> t_batch;
+
+    while(true) {
+        {
+            QMutexLocker locker(&m_qMutex);
+            while(m_qQueueFull.isEmpty() && (!m_bStop || m_iFilling > 0))
+                m_qBufferQueued.wait(&m_qMutex);
+
+            if(m_qQueueFull.isEmpty())
+                break;
+
+            while(!m_qQueueFull.isEmpty())
+                t_batch.append(m_qQueueFull.dequeue());
+            m_iInFlight = t_batch.size();
+        }
+
+        //
+        //  Swap to file byte order and collect small tags into one write
+        //
+        qint64 t_iErrors = 0;
+        for(qint32 i = 0; i < t_batch.size(); ++i) {
+            QByteArray& t_tag = m_qVecPool[t_batch[i]];
+
+            //
+            //  Buffers dropped in front of this one are replaced by a skip, so that the following samples keep their time
+            //
+            if(m_qVecSkip[t_batch[i]] > 0)
+                append_skip(t_staging, m_qVecSkip[t_batch[i]]);
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+            IOUtils::swap_float_array((float*)(t_tag.data() + FIFFC_TAG_INFO_SIZE), (t_tag.size() - FIFFC_TAG_INFO_SIZE) / sizeof(float));
+#endif
+            if(!t_staging.isEmpty() && t_staging.size() + t_tag.size() > m_iCoalesceBytes) {
+                if(!write_all(t_staging.constData(), t_staging.size()))
+                    ++t_iErrors;
+                t_staging.resize(0);
+            }
+
+            if(t_tag.size() >= m_iCoalesceBytes) {
+                if(!write_all(t_tag.constData(), t_tag.size()))
+                    ++t_iErrors;
+            } else {
+                t_staging.append(t_tag.constData(), t_tag.size());
+            }
+        }
+
+        if(!t_staging.isEmpty()) {
+            if(!write_all(t_staging.constData(), t_staging.size()))
+                ++t_iErrors;
+            t_staging.resize(0);
+        }
+
+        {
+            QMutexLocker locker(&m_qMutex);
+            for(qint32 i = 0; i < t_batch.size(); ++i)
+                m_qQueueFree.enqueue(t_batch[i]);
+            m_iWritten += t_batch.size();
+            m_iWriteErrors += t_iErrors;
+            m_iInFlight = 0;
+            m_qBufferFree.wakeAll();
+        }
+        t_batch.clear();
+    }
+
+    //
+    //  Buffers dropped after the last written one
+    //
+    m_qMutex.lock();
+    qint32 t_iPendingSkip = m_iPendingSkip;
+    m_iPendingSkip = 0;
+    bool t_bFinish = m_bFinish;
+    TailFunction t_writeTail = m_writeTail;
+    m_qMutex.unlock();
+
+    qint64 t_iErrors = 0;
+    if(t_iPendingSkip > 0) {
+        append_skip(t_staging, t_iPendingSkip);
+        if(!write_all(t_staging.constData(), t_staging.size()))
+            ++t_iErrors;
+    }
+
+    if(t_bFinish && m_pStream) {
+        if(t_writeTail)
+            t_writeTail(m_pStream);
+        m_pStream->finish_writing_raw();
+        if(m_pStream->status() != QDataStream::Ok) {
+            printf("FiffRawWriter: Could not finish %s\n", m_pStream->streamName().toUtf8().constData());
+            ++t_iErrors;
+        }
+    }
+
+    QMutexLocker locker(&m_qMutex);
+    m_iWriteErrors += t_iErrors;
+    m_qBufferFree.wakeAll();
+}
+
+
+//*************************************************************************************************************
+
+qint32 FiffRawWriter::acquire(qint32 nel)
+{
+    QMutexLocker locker(&m_qMutex);
+    if(m_bStop) {
+        //The writer thread is stopping, the buffer would never be written
+        ++m_iDropped;
+        return -1;
+    }
+    while(m_qQueueFree.isEmpty()) {
+        if(m_bDropWhenFull || m_bStop) {
+            ++m_iDropped;
+            ++m_iPendingSkip;
+            return -1;
+        }
+        m_qBufferFree.wait(&m_qMutex);
+    }
+    qint32 index = m_qQueueFree.dequeue();
+    m_qVecSkip[index] = m_iPendingSkip;
+    m_iPendingSkip = 0;
+    ++m_iFilling;
+    locker.unlock();
+
+    //
+    //  The buffers keep their capacity, only the first buffers of a recording allocate
+    //
+    QByteArray& t_tag = m_qVecPool[index];
+    t_tag.resize(FIFFC_TAG_INFO_SIZE + nel*sizeof(float));
+
+    uchar* t_pHeader = (uchar*)t_tag.data();
+    qToBigEndian<qint32>(FIFF_DATA_BUFFER, t_pHeader);
+    qToBigEndian<qint32>(FIFFT_FLOAT, t_pHeader + 4);
+    qToBigEndian<qint32>(nel*sizeof(float), t_pHeader + 8);
+    qToBigEndian<qint32>(FIFFV_NEXT_SEQ, t_pHeader + 12);
+
+    return index;
+}
+
+
+//*************************************************************************************************************
+
+void FiffRawWriter::enqueue(qint32 index)
+{
+    QMutexLocker locker(&m_qMutex);
+    --m_iFilling;
+    m_qQueueFull.enqueue(index);
+    m_iMaxQueueDepth = qMax(m_iMaxQueueDepth, m_qQueueFull.size() + m_iInFlight);
+    m_qBufferQueued.wakeOne();
+}
+
+
+//*************************************************************************************************************
+
+bool FiffRawWriter::write_all(const char* data, qint64 size)
+{
+    if(!m_pStream) {
+        return false;
+    }
+
+    QIODevice* t_pDevice = m_pStream->device();
+    if(t_pDevice->write(data, size) != size) {
+        printf("FiffRawWriter: Could not write %lld bytes to %s\n", (long long)size, t_pDevice->errorString().toUtf8().constData());
+        return false;
+    }
+    return true;
+}
+
+
+//*************************************************************************************************************
+
+float* FiffRawWriter::tagData(qint32 index)
+{
+    return (float*)(m_qVecPool[index].data() + FIFFC_TAG_INFO_SIZE);
+}
+
+
+//*************************************************************************************************************
+
+void FiffRawWriter::stop()
+{
+    {
+        QMutexLocker locker(&m_qMutex);
+        m_bStop = true;
+        m_qBufferQueued.wakeAll();
+    }
+    this->wait();
+}
@@ -0,0 +1,328 @@
+//=============================================================================================================
+/**
+* @file     fiff_raw_writer.h
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    FiffRawWriter class declaration.
+*
+*/
+
+#ifndef FIFF_RAW_WRITER_H
+#define FIFF_RAW_WRITER_H
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_global.h"
+#include "fiff_types.h"
+#include "fiff_stream.h"
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// Eigen INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+#include <Eigen/SparseCore>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// Qt INCLUDES
+//=============================================================================================================
+
+#include <QByteArray>
+#include <QMutex>
+#include <QQueue>
+#include <QSharedPointer>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <functional>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE NAMESPACE FIFFLIB
+//=============================================================================================================
+
+namespace FIFFLIB
+{
+
+
+//=============================================================================================================
+/**
+* Writes raw data buffers to a stream prepared by FiffStream::start_writing_raw on a background thread. The
+* calling thread only scales the buffer into a reused tag of the buffer pool. The writer thread swaps the tags in
+* bulk to file byte order and writes them, coalescing small tags into larger writes. If all pool buffers are
+* queued, new buffers are either dropped (acquisition) or the caller waits until one is free. Dropped buffers are
+* recorded as a FIFF_DATA_SKIP in front of the next written buffer, so the samples after the gap keep their time.
+* As for any skip, the readers count it in buffers of the size of that next buffer.
+*
+* While the writer is active the stream must not be written to directly; flush() hands it back. To keep all file
+* I/O off the calling thread, the stream can also be opened by the writer thread and the file can be finished on it,
+* see finish_writing_raw_async.
+*
+* @brief Asynchronous raw data buffer writer
+*/
+class FIFFSHARED_EXPORT FiffRawWriter : public QThread
+{
+public:
+    typedef QSharedPointer<FiffRawWriter> SPtr;             /**< Shared pointer type for FiffRawWriter. */
+    typedef QSharedPointer<const FiffRawWriter> ConstSPtr;  /**< Const shared pointer type for FiffRawWriter. */
+
+    typedef std::function<FiffStream::SPtr()> OpenFunction;                 /**< Opens the stream, e.g. with FiffStream::start_writing_raw. */
+    typedef std::function<void(const FiffStream::SPtr&)> TailFunction;      /**< Writes the last tags before the file is finished. */
+
+    //=========================================================================================================
+    /**
+    * Creates the writer and starts the writer thread.
+    *
+    * @param[in] p_pStream          The stream to write to, as returned by FiffStream::start_writing_raw
+    * @param[in] p_iPoolSize        Number of pool buffers, i.e. maximal queue depth (default = 32)
+    * @param[in] p_bDropWhenFull    Whether buffers are dropped when the queue is full instead of waiting (default = true)
+    * @param[in] p_iCoalesceBytes   Tags are collected until this size is reached before they are written (default = 4 MB)
+    */
+    explicit FiffRawWriter(const FiffStream::SPtr& p_pStream, qint32 p_iPoolSize = 32, bool p_bDropWhenFull = true, qint64 p_iCoalesceBytes = 4*1024*1024);
+
+    //=========================================================================================================
+    /**
+    * Creates the writer and starts the writer thread, which first opens the stream. Buffers can be queued right
+    * away. If the stream cannot be opened, writing the queued buffers fails and counts as write errors.
+    *
+    * @param[in] p_openStream       Opens the stream on the writer thread, must keep its device alive as long as the writer
+    * @param[in] p_iPoolSize        Number of pool buffers, i.e. maximal queue depth (default = 32)
+    * @param[in] p_bDropWhenFull    Whether buffers are dropped when the queue is full instead of waiting (default = true)
+    * @param[in] p_iCoalesceBytes   Tags are collected until this size is reached before they are written (default = 4 MB)
+    */
+    explicit FiffRawWriter(const OpenFunction& p_openStream, qint32 p_iPoolSize = 32, bool p_bDropWhenFull = true, qint64 p_iCoalesceBytes = 4*1024*1024);
+
+    //=========================================================================================================
+    /**
+    * Writes all queued buffers and stops the writer thread. The file is not finished.
+    */
+    ~FiffRawWriter();
+
+    //=========================================================================================================
+    /**
+    * Queues a raw data buffer which is divided by the calibrations, as FiffStream::write_raw_buffer.
+    *
+    * @param[in] buf    the buffer to write
+    * @param[in] cals   calibration factors
+    *
+    * @return true if the buffer was queued, false if it was dropped (a skip is written instead) or the sizes do not match
+    */
+    bool write_raw_buffer(const Eigen::MatrixXd& buf, const Eigen::RowVectorXd& cals);
+
+    //=========================================================================================================
+    /**
+    * Queues a raw data buffer to which the inverse of the mult matrix is applied, as FiffStream::write_raw_buffer.
+    *
+    * @param[in] buf    the buffer to write
+    * @param[in] mult   the mult matrix
+    *
+    * @return true if the buffer was queued, false if it was dropped or the sizes do not match
+    */
+    bool write_raw_buffer(const Eigen::MatrixXd& buf, const Eigen::SparseMatrix<double>& mult);
+
+    //=========================================================================================================
+    /**
+    * Queues an uncalibrated raw data buffer.
+    *
+    * @param[in] buf    the buffer to write
+    *
+    * @return true if the buffer was queued, false if it was dropped
+    */
+    bool write_raw_buffer(const Eigen::MatrixXd& buf);
+
+    //=========================================================================================================
+    /**
+    * Queues an uncalibrated raw data buffer which is already in single precision.
+    *
+    * @param[in] buf    the buffer to write
+    *
+    * @return true if the buffer was queued, false if it was dropped
+    */
+    bool write_raw_buffer(const Eigen::MatrixXf& buf);
+
+    //=========================================================================================================
+    /**
+    * Blocks until all queued buffers are written. Afterwards the stream can be written to directly, e.g. to add
+    * the reference to the next file of a split recording.
+    */
+    void flush();
+
+    //=========================================================================================================
+    /**
+    * Writes all queued buffers, stops the writer thread and finishes the file, see FiffStream::finish_writing_raw.
+    * Buffers dropped after the last written one are recorded as a final FIFF_DATA_SKIP.
+    */
+    void finish_writing_raw();
+
+    //=========================================================================================================
+    /**
+    * As finish_writing_raw, but returns immediately. The writer thread writes the queued buffers and the pending
+    * skip, calls p_writeTail with the stream, e.g. to add the reference to the next file of a split recording, and
+    * finishes the file. No further buffers are accepted. Destroying the writer waits until the file is finished.
+    *
+    * @param[in] p_writeTail    Writes the last tags of the raw data block (optional)
+    */
+    void finish_writing_raw_async(const TailFunction& p_writeTail = TailFunction());
+
+    //=========================================================================================================
+    /**
+    * Returns the number of buffers which are queued and not yet written.
+    *
+    * @return the current queue depth
+    */
+    qint32 queueDepth() const;
+
+    //=========================================================================================================
+    /**
+    * Returns the largest queue depth since the writer was created.
+    *
+    * @return the maximal queue depth
+    */
+    qint32 maxQueueDepth() const;
+
+    //=========================================================================================================
+    /**
+    * Returns the number of buffers which were dropped because the queue was full.
+    *
+    * @return the number of dropped buffers
+    */
+    qint64 droppedBuffers() const;
+
+    //=========================================================================================================
+    /**
+    * Returns the number of buffers which were written.
+    *
+    * @return the number of written buffers
+    */
+    qint64 writtenBuffers() const;
+
+    //=========================================================================================================
+    /**
+    * Returns the number of failed writes to the device, including the writes which failed because the stream could
+    * not be opened.
+    *
+    * @return the number of write errors
+    */
+    qint64 writeErrors() const;
+
+protected:
+    //=========================================================================================================
+    /**
+    * The writer thread: swaps and writes the queued buffers.
+    */
+    virtual void run();
+
+private:
+    //=========================================================================================================
+    /**
+    * Takes a free buffer from the pool and prepares the tag header for nel floats.
+    *
+    * @param[in] nel    Number of floats of the tag
+    *
+    * @return the pool index, -1 if the buffer is dropped
+    */
+    qint32 acquire(qint32 nel);
+
+    //=========================================================================================================
+    /**
+    * Hands a filled buffer to the writer thread.
+    *
+    * @param[in] index  The pool index
+    */
+    void enqueue(qint32 index);
+
+    //=========================================================================================================
+    /**
+    * Returns a pointer to the float data of a pool buffer.
+    *
+    * @param[in] index  The pool index
+    *
+    * @return the data of the tag
+    */
+    float* tagData(qint32 index);
+
+    //=========================================================================================================
+    /**
+    * Stops the writer thread after all queued buffers are written.
+    */
+    void stop();
+
+    //=========================================================================================================
+    /**
+    * Writes data to the device of the stream.
+    *
+    * @param[in] data   The data to write
+    * @param[in] size   Number of bytes
+    *
+    * @return true if all bytes were written
+    */
+    bool write_all(const char* data, qint64 size);
+
+    OpenFunction            m_openStream;           /**< Opens the stream on the writer thread, declared before the stream so that it outlives it. */
+    FiffStream::SPtr        m_pStream;              /**< The stream to write to. */
+    bool                    m_bDropWhenFull;        /**< Whether buffers are dropped when the queue is full. */
+    qint64                  m_iCoalesceBytes;       /**< Size up to which tags are collected before writing. */
+
+    mutable QMutex          m_qMutex;               /**< Guards the queues, the flags and the statistics. */
+    QWaitCondition          m_qBufferQueued;        /**< Signaled when a buffer was queued or the writer is stopped. */
+    QWaitCondition          m_qBufferFree;          /**< Signaled when buffers were written and returned to the pool. */
+    QVector<QByteArray>     m_qVecPool;             /**< The reused tags (header and data). */
+    QVector<qint32>         m_qVecSkip;             /**< Number of dropped buffers to skip in front of each pool buffer. */
+    qint32                  m_iPendingSkip;         /**< Number of buffers dropped since the last queued one. */
+    QQueue<qint32>          m_qQueueFree;           /**< Indices of the free pool buffers. */
+    QQueue<qint32>          m_qQueueFull;           /**< Indices of the buffers which wait to be written. */
+    qint32                  m_iInFlight;            /**< Number of buffers taken by the writer thread and not yet returned. */
+    qint32                  m_iFilling;             /**< Number of buffers taken from the pool and not yet queued. */
+    bool                    m_bStop;                /**< Whether the writer thread should stop when the queue is empty. */
+    bool                    m_bFinish;              /**< Whether the writer thread finishes the file when it stops. */
+    TailFunction            m_writeTail;            /**< Writes the last tags before the file is finished. */
+
+    qint32                  m_iMaxQueueDepth;       /**< Largest queue depth. */
+    qint64                  m_iDropped;             /**< Number of dropped buffers. */
+    qint64                  m_iWritten;             /**< Number of written buffers. */
+    qint64                  m_iWriteErrors;         /**< Number of failed writes. */
+};
+
+} // NAMESPACE
+
+#endif // FIFF_RAW_WRITER_H
@@ -93,6 +93,7 @@
 
 #include <QFile>
 #include <QTcpSocket>
+#include <QtEndian>
 
 
 //*************************************************************************************************************
@@ -111,6 +112,8 @@ using namespace UTILSLIB;
 
 FiffStream::FiffStream(QIODevice *p_pIODevice)
 : QDataStream(p_pIODevice)
+, m_pMappedData(NULL)
+, m_iMappedSize(0)
 {
     this->setFloatingPointPrecision(QDataStream::SinglePrecision);
     this->setByteOrder(QDataStream::BigEndian);
@@ -122,6 +125,8 @@ FiffStream::FiffStream(QIODevice *p_pIODevice)
 
 FiffStream::FiffStream(QByteArray * a, QIODevice::OpenMode mode)
 : QDataStream(a, mode)
+, m_pMappedData(NULL)
+, m_iMappedSize(0)
 {
     this->setFloatingPointPrecision(QDataStream::SinglePrecision);
     this->setByteOrder(QDataStream::BigEndian);
@@ -310,6 +315,15 @@ bool FiffStream::open(QIODevice::OpenModeFlag mode)
         return false;
     }
 
+    //
+    //   Use the index sidecar if it is up to date
+    //
+    m_pIndex.clear();
+    QFile* t_pFile = qobject_cast<QFile*>(this->device());
+    bool t_bUseIndex = FiffIndex::isEnabled() && t_pFile && mode == QIODevice::ReadOnly;
+    if (t_bUseIndex)
+        m_pIndex = FiffIndex::load(t_pFile->fileName(), m_id);
+
     //
     //   Read or create the directory tree
     //
@@ -320,7 +334,10 @@ bool FiffStream::open(QIODevice::OpenModeFlag mode)
     /*
     * Do we have a directory or not?
     */
-    if (dirpos <= 0) {  /* Must do it in the hard way... */
+    if (m_pIndex) {     /* Take it from the index */
+        m_dir = m_pIndex->dir;
+    }
+    else if (dirpos <= 0) {  /* Must do it in the hard way... */
         bool ok = false;
         m_dir = this->make_dir(&ok);
         if (!ok) {
@@ -355,6 +372,12 @@ bool FiffStream::open(QIODevice::OpenModeFlag mode)
     else
         this->m_dirtree->parent.clear();
 
+    if (t_bUseIndex && !m_pIndex) {
+        m_pIndex = this->make_index();
+        if (!m_pIndex->save(t_pFile->fileName()))
+            printf("(index not saved) ");
+    }
+
     printf("[done]\n");
 
     //
@@ -369,6 +392,8 @@ bool FiffStream::open(QIODevice::OpenModeFlag mode)
 
 bool FiffStream::close()
 {
+    unmap_file();
+
     if(this->device()->isOpen())
         this->device()->close();
 
@@ -445,6 +470,66 @@ FiffDirNode::SPtr FiffStream::make_subtree(QList<FiffDirEntry::SPtr> &dentry)
 }
 
 
+//*************************************************************************************************************
+
+bool FiffStream::is_mapped() const
+{
+    return m_pMappedData != NULL && this->device()->isOpen();
+}
+
+
+//*************************************************************************************************************
+
+bool FiffStream::map_file()
+{
+    if(is_mapped())
+        return true;
+
+    //A closed file drops its mappings
+    m_pMappedData = NULL;
+    m_iMappedSize = 0;
+
+    QFile* t_pFile = qobject_cast<QFile*>(this->device());
+    if(!t_pFile) {
+        qWarning("FiffStream::map_file - Memory mapping is only supported for files.");
+        return false;
+    }
+
+    if(!t_pFile->isOpen() && !t_pFile->open(QIODevice::ReadOnly)) {
+        qWarning("FiffStream::map_file - Cannot open %s.", t_pFile->fileName().toUtf8().constData());
+        return false;
+    }
+
+    qint64 t_iSize = t_pFile->size();
+    uchar* t_pData = t_iSize > 0 ? t_pFile->map(0, t_iSize) : NULL;
+    if(!t_pData) {
+        qWarning("FiffStream::map_file - Cannot map %s: %s", t_pFile->fileName().toUtf8().constData(), t_pFile->errorString().toUtf8().constData());
+        return false;
+    }
+
+    m_pMappedData = t_pData;
+    m_iMappedSize = t_iSize;
+
+    return true;
+}
+
+
+//*************************************************************************************************************
+
+void FiffStream::unmap_file()
+{
+    if(!m_pMappedData)
+        return;
+
+    QFile* t_pFile = qobject_cast<QFile*>(this->device());
+    if(t_pFile && t_pFile->isOpen())
+        t_pFile->unmap(m_pMappedData);
+
+    m_pMappedData = NULL;
+    m_iMappedSize = 0;
+}
+
+
 //*************************************************************************************************************
 
 QStringList FiffStream::read_bad_channels(const FiffDirNode::SPtr& p_Node)
@@ -990,6 +1075,14 @@ bool FiffStream::read_meas_info(const FiffDirNode::SPtr& p_Node, FiffInfo& info,
         return false;
     }
     //
+    //   The measurement info of the whole file is stored in the index
+    //
+    if (m_pIndex && m_pIndex->info && p_Node == m_dirtree) {
+        info = *m_pIndex->info;
+        p_NodeInfo = meas[0];
+        return true;
+    }
+    //
     QList<FiffDirNode::SPtr> meas_info = meas[0]->dir_tree_find(FIFFB_MEAS_INFO);
     if (meas_info.count() == 0) {
         printf("Could not find measurement info\n");
@@ -1646,6 +1739,17 @@ bool FiffStream::read_rt_tag(FiffTag::SPtr &p_pTag)
 bool FiffStream::read_tag(FiffTag::SPtr &p_pTag, fiff_long_t pos)
 {
     if (pos >= 0) {
+        //
+        // Indexed tags are served from memory, the stream is left behind the tag as if it had been read
+        //
+        if (m_pIndex && m_pIndex->find_tag(pos, p_pTag)) {
+            if (p_pTag->next != FIFFV_NEXT_SEQ)
+                this->device()->seek(p_pTag->next);
+            else
+                this->device()->seek(pos + (fiff_long_t)FIFFC_TAG_INFO_SIZE + p_pTag->size());
+            return true;
+        }
+
         this->device()->seek(pos);
     }
 
@@ -1679,6 +1783,28 @@ bool FiffStream::read_tag(FiffTag::SPtr &p_pTag, fiff_long_t pos)
 }
 
 
+//*************************************************************************************************************
+
+const uchar* FiffStream::read_mapped_tag(fiff_long_t pos, fiff_int_t& kind, fiff_int_t& type, fiff_int_t& size) const
+{
+    if(!is_mapped() || pos < 0 || pos + (fiff_long_t)FIFFC_TAG_INFO_SIZE > m_iMappedSize)
+        return NULL;
+
+    //
+    // Decode the big endian tag header in place
+    //
+    const uchar* t_pHeader = m_pMappedData + pos;
+    kind = qFromBigEndian<qint32>(t_pHeader);
+    type = qFromBigEndian<qint32>(t_pHeader + 4);
+    size = qFromBigEndian<qint32>(t_pHeader + 8);
+
+    if(size < 0 || pos + (fiff_long_t)FIFFC_TAG_INFO_SIZE + size > m_iMappedSize)
+        return NULL;
+
+    return t_pHeader + FIFFC_TAG_INFO_SIZE;
+}
+
+
 //*************************************************************************************************************
 
 bool FiffStream::setup_read_raw(QIODevice &p_IODevice, FiffRawData& data, bool allow_maxshield)
@@ -2617,8 +2743,14 @@ fiff_long_t FiffStream::write_double(fiff_int_t kind, const double* data, fiff_i
 
 //    this->setFloatingPointPrecision(QDataStream::SinglePrecision);
 
-    for(qint32 i = 0; i < nel; ++i)
-        *this << data[i];
+    //
+    //  Swap the whole array at once and write it with a single call
+    //
+    QByteArray t_buf((const char*)data, datasize);
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    IOUtils::swap_double_array((double*)t_buf.data(), nel);
+#endif
+    this->writeRawData(t_buf.constData(), datasize);
 
     return pos;
 }
@@ -2639,8 +2771,14 @@ fiff_long_t FiffStream::write_float(fiff_int_t kind, const float* data, fiff_int
 
 //    this->setFloatingPointPrecision(QDataStream::SinglePrecision);
 
-    for(qint32 i = 0; i < nel; ++i)
-        *this << data[i];
+    //
+    //  Swap the whole array at once and write it with a single call
+    //
+    QByteArray t_buf((const char*)data, datasize);
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    IOUtils::swap_float_array((float*)t_buf.data(), nel);
+#endif
+    this->writeRawData(t_buf.constData(), datasize);
 
     return pos;
 }
@@ -2995,8 +3133,11 @@ fiff_long_t FiffStream::write_int(fiff_int_t kind, const fiff_int_t* data, fiff_
     *this << (qint32)datasize;
     *this << (qint32)next;
 
-    for(qint32 i = 0; i < nel; ++i)
-        *this << data[i];
+    QByteArray t_buf((const char*)data, datasize);
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    IOUtils::swap_int_array((qint32*)t_buf.data(), nel);
+#endif
+    this->writeRawData(t_buf.constData(), datasize);
 
     return pos;
 }
@@ -3238,6 +3379,43 @@ QList<FiffDirEntry::SPtr> FiffStream::make_dir(bool *ok)
 }
 
 
+//*************************************************************************************************************
+
+FiffIndex::SPtr FiffStream::make_index()
+{
+    FiffIndex::SPtr t_pIndex(new FiffIndex);
+    t_pIndex->id = m_id;
+    t_pIndex->dir = m_dir;
+
+    //
+    //   Keep the indexed tags in file byte order, they are converted when served
+    //
+    FiffTag::SPtr t_pTag;
+    for (qint32 k = 0; k < m_dir.size(); ++k) {
+        if (!FiffIndex::isIndexed(m_dir[k]) || !this->device()->seek(m_dir[k]->pos))
+            continue;
+
+        this->read_tag_info(t_pTag, false);
+        if (t_pTag->size() > 0 && this->readRawData(t_pTag->data(), t_pTag->size()) != t_pTag->size())
+            continue;
+
+        t_pIndex->add_tag(m_dir[k]->pos, t_pTag);
+    }
+
+    //
+    //   Decode the measurement info once, files without a measurement block have none
+    //
+    if (m_dirtree && m_dirtree->dir_tree_find(FIFFB_MEAS).size() > 0) {
+        FiffDirNode::SPtr t_pNodeInfo;
+        t_pIndex->info = FiffInfo::SPtr(new FiffInfo);
+        if (!this->read_meas_info(m_dirtree, *t_pIndex->info, t_pNodeInfo))
+            t_pIndex->info.clear();
+    }
+
+    return t_pIndex;
+}
+
+
 //*************************************************************************************************************
 
 bool FiffStream::check_beginning(FiffTag::SPtr &p_pTag)
@@ -47,6 +47,7 @@
 
 #include "fiff_dir_node.h"
 #include "fiff_dir_entry.h"
+#include "fiff_index.h"
 
 
 
@@ -276,6 +277,30 @@ public:
     */
     FiffDirNode::SPtr make_subtree(QList<FiffDirEntry::SPtr>& dentry);
 
+    //=========================================================================================================
+    /**
+    * Returns whether the underlying file is currently memory mapped.
+    *
+    * @return true if the file is mapped, false otherwise
+    */
+    bool is_mapped() const;
+
+    //=========================================================================================================
+    /**
+    * Maps the whole underlying file into memory. This is only supported when the stream operates on a QFile.
+    * If the file is not open yet, it is opened read only. The mapping is released by unmap_file() or when
+    * the stream is closed.
+    *
+    * @return true if succeeded, false otherwise
+    */
+    bool map_file();
+
+    //=========================================================================================================
+    /**
+    * Releases the memory mapping created by map_file().
+    */
+    void unmap_file();
+
     //=========================================================================================================
     /**
     * fiff_read_bad_channels
@@ -445,6 +470,21 @@ public:
     */
     bool read_tag(QSharedPointer<FiffTag>& p_pTag, fiff_long_t pos = -1);
 
+    //=========================================================================================================
+    /**
+    * Looks up one tag in the memory mapped file without copying or converting its data.
+    * The tag header is decoded, the returned pointer refers to the raw (big endian) tag data inside the
+    * file mapping and stays valid until the file is unmapped.
+    *
+    * @param[in] pos        position of the tag inside the fif file
+    * @param[out] kind      the tag kind
+    * @param[out] type      the tag data type
+    * @param[out] size      the size of the tag data in bytes
+    *
+    * @return pointer to the tag data, NULL if the file is not mapped or the tag lies outside of the file
+    */
+    const uchar* read_mapped_tag(fiff_long_t pos, fiff_int_t& kind, fiff_int_t& type, fiff_int_t& size) const;
+
     //=========================================================================================================
     /**
     * fiff_setup_read_raw
@@ -889,6 +929,15 @@ private:
     */
     QList<FiffDirEntry::SPtr> make_dir(bool *ok=Q_NULLPTR);
 
+    //=========================================================================================================
+    /**
+    * Creates the index of the current directory and reads the indexed tags and the measurement info into it.
+    * The directory tree has to be set up.
+    *
+    * @return The created index
+    */
+    FiffIndex::SPtr make_index();
+
 private:
 
 //    char         *file_name;    /**< Name of the file */ -> Use streamName() instead
@@ -897,6 +946,9 @@ private:
     QList<FiffDirEntry::SPtr>   m_dir;  /**< This is the directory. If no directory exists, open automatically scans the file to create one. */
 //    int         nent;           /**< How many entries? */ -> Use nent() instead
     FiffDirNode::SPtr           m_dirtree; /**< Directory compiled into a tree */
+    uchar*                      m_pMappedData;  /**< Start of the file mapping, NULL if the file is not mapped */
+    qint64                      m_iMappedSize;  /**< Size of the file mapping in bytes */
+    FiffIndex::SPtr             m_pIndex;       /**< Index of the directory and the small tags, NULL if no index sidecar is used */
 //    char        *ext_file_name; /**< Name of the file holding the external data */
 //    FILE        *ext_fd;        /**< The file descriptor of the above file if open  */
 
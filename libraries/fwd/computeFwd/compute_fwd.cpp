@@ -2210,12 +2210,12 @@ void ComputeFwd::calculateFwd() const
         settings->use_threads = false;
     if (nmeg > 0)
         if ((FwdBemModel::compute_forward_meg(spaces,nspace,megcoils,compcoils,comp_data,
-                                              settings->fixed_ori,bem_model,&settings->r0,settings->use_threads,&meg_forward,
+                                              settings->fixed_ori,bem_model,&settings->r0,settings->use_threads,settings->nthread,&meg_forward,
                                               settings->compute_grad ? &meg_forward_grad : NULL)) == FAIL)
             goto out;
     if (neeg > 0)
         if ((FwdBemModel::compute_forward_eeg(spaces,nspace,eegels,
-                                              settings->fixed_ori,bem_model,eeg_model,settings->use_threads,&eeg_forward,
+                                              settings->fixed_ori,bem_model,eeg_model,settings->use_threads,settings->nthread,&eeg_forward,
                                               settings->compute_grad ? &eeg_forward_grad : NULL)) == FAIL)
             goto out;
     /*
@@ -130,6 +130,7 @@ void ComputeFwdSettings::usage(char *name)
     fprintf(stderr,"\t--includeall      Omit all source space checks\n");
     fprintf(stderr,"\t--all             calculate forward solution in all nodes instead the selected ones only.\n");
     fprintf(stderr,"\t--fwd  name       save the solution here\n");
+    fprintf(stderr,"\t--threads n       number of threads to use (default : all cores)\n");
     fprintf(stderr,"\t--help            print this info.\n");
     fprintf(stderr,"\t--version         print version info.\n\n");
     exit(1);
@@ -352,6 +353,19 @@ bool ComputeFwdSettings::check_args (int *argc,char **argv)
             }
             solname = QString(argv[k+1]);
         }
+        else if (strcmp(argv[k],"--threads") == 0) {
+            found = 2;
+            if (k == *argc - 1) {
+                qCritical("--threads: argument required.");
+                return false;
+            }
+            if (sscanf(argv[k+1],"%d",&nthread) != 1) {
+                qCritical("Could not interpret the number of threads.");
+                return false;
+            }
+            if (nthread < 0)
+                nthread = 0;
+        }
         else if (strcmp(argv[k],"--label") == 0) {
             found = 2;
             if (k == *argc - 1) {
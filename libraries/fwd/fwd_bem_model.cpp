@@ -182,17 +182,6 @@ float **mne_cmatrix_40 (int nr,int nc)
 
 
 //float
-Eigen::MatrixXf toFloatEigenMatrix_40(float **mat, const int m, const int n)
-{
-    Eigen::MatrixXf eigen_mat(m,n);
-
-    for ( int i = 0; i < m; ++i)
-        for ( int j = 0; j < n; ++j)
-            eigen_mat(i,j) = mat[i][j];
-
-    return eigen_mat;
-}
-
 void fromFloatEigenMatrix_40(const Eigen::MatrixXf& from_mat, float **& to_mat, const int m, const int n)
 {
     for ( int i = 0; i < m; ++i)
@@ -214,13 +203,28 @@ void fromFloatEigenMatrix_40(const Eigen::MatrixXf& from_mat, float **& to_mat)
 
 float **mne_lu_invert_40(float **mat,int dim)
 /*
-      * Invert a matrix using the LU decomposition from
-      * LAPACK
+      * Invert a matrix using a blocked LU decomposition with partial pivoting.
+      * The matrix must have been allocated with mne_cmatrix_40. It is factorized
+      * in place and the row pointers are redirected to the inverse, i.e., only
+      * one additional dim x dim buffer is needed.
+      *
+      * The row-major storage is viewed as the transpose in column-major order.
+      * Since inv(A') = inv(A)' the result read row by row is inv(A).
       */
 {
-    Eigen::MatrixXf eigen_mat = toFloatEigenMatrix_40(mat, dim, dim);
-    Eigen::MatrixXf eigen_mat_inv = eigen_mat.inverse();
-    fromFloatEigenMatrix_40(eigen_mat_inv, mat);
+    Eigen::Map<Eigen::MatrixXf> eigen_mat(mat[0],dim,dim);
+    Eigen::PartialPivLU<Eigen::Ref<Eigen::MatrixXf> > lu(eigen_mat);
+    float *whole;
+    int   i;
+
+    whole = MALLOC_40(dim*dim,float);
+    if (!whole) matrix_error_40(2,dim,dim);
+    Eigen::Map<Eigen::MatrixXf> eigen_mat_inv(whole,dim,dim);
+    eigen_mat_inv = lu.solve(Eigen::MatrixXf::Identity(dim,dim));
+
+    FREE_40(mat[0]);
+    for (i = 0; i < dim; i++)
+        mat[i] = whole + i*dim;
     return mat;
 }
 
@@ -317,18 +321,13 @@ float **mne_mat_mat_mult_40 (float **m1,float **m2,int d1,int d2,int d3)
            &one,m2[0],&d3,m1[0],&d2,&zero,result[0],&d3);
     return (result);
 #else
+    /*
+     * Let Eigen do the work: the blocked product kernel is multithreaded with OpenMP
+     */
+    typedef Eigen::Matrix<float,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> RowMatrixXf;
     float **result = ALLOC_CMATRIX_40(d1,d3);
-    int j,k,p;
-    float sum;
-
-    for (j = 0; j < d1; j++)
-        for (k = 0; k < d3; k++) {
-            sum = 0.0;
-            for (p = 0; p < d2; p++)
-                sum = sum + m1[j][p]*m2[p][k];
-            result[j][k] = sum;
-        }
-    return (result);
+    Eigen::Map<RowMatrixXf>(result[0],d1,d3).noalias() = Eigen::Map<RowMatrixXf>(m1[0],d1,d2)*Eigen::Map<RowMatrixXf>(m2[0],d2,d3);
+    return result;
 #endif
 }
 
@@ -1087,10 +1086,8 @@ float **FwdBemModel::fwd_bem_lin_pot_coeff(const QList<MneSurfaceOld*>& surfs)
     float **sub_mat = NULL;
     int   np1,np2,ntri,np_tot,np_max;
     float **nodes;
-    MneTriangle*   tri;
-    double omega[3];
-    double *row = NULL;
-    int    j,k,p,q,c;
+    QVector<int> rows;
+    int    j,p,q;
     int    joff,koff;
     MneSurfaceOld* surf1;
     MneSurfaceOld* surf2;
@@ -1101,12 +1098,14 @@ float **FwdBemModel::fwd_bem_lin_pot_coeff(const QList<MneSurfaceOld*>& surfs)
             np_max = surfs[p]->np;
     }
 
+    /*
+     * Every element is assigned below, no need to clear the matrix first
+     */
     mat = ALLOC_CMATRIX_40(np_tot,np_tot);
-    for (j = 0; j < np_tot; j++)
-        for (k = 0; k < np_tot; k++)
-            mat[j][k] = 0.0;
-    row        = MALLOC_40(np_max,double);
     sub_mat = MALLOC_40(np_max,float *);
+    rows.resize(np_max);
+    for (j = 0; j < np_max; j++)
+        rows[j] = j;
     for (p = 0, joff = 0; p < surfs.size(); p++, joff = joff + np1) {
         surf1 = surfs[p];
         np1   = surf1->np;
@@ -1120,26 +1119,33 @@ float **FwdBemModel::fwd_bem_lin_pot_coeff(const QList<MneSurfaceOld*>& surfs)
                     fwd_bem_explain_surface(surf1->id).toUtf8().constData(),np1,
                     fwd_bem_explain_surface(surf2->id).toUtf8().constData(),np2);
 
-            for (j = 0; j < np1; j++) {
-                for (k = 0; k < np2; k++)
-                    row[k] = 0.0;
+            /*
+             * The rows are independent: compute them in parallel directly into the matrix
+             */
+            QtConcurrent::blockingMap(rows.begin(), rows.begin() + np1, [&](const int& jj) {
+                VectorXd     row = VectorXd::Zero(np2);
+                double       omega[3];
+                MneTriangle* tri;
+                float        *mat_row = mat[jj+joff]+koff;
+                int          k,c;
+
                 for (k = 0, tri = surf2->tris; k < ntri; k++,tri++) {
                     /*
-               * No contribution from a triangle that
-               * this vertex belongs to
-               */
-                    if (p == q && (tri->vert[0] == j || tri->vert[1] == j || tri->vert[2] == j))
+                     * No contribution from a triangle that
+                     * this vertex belongs to
+                     */
+                    if (p == q && (tri->vert[0] == jj || tri->vert[1] == jj || tri->vert[2] == jj))
                         continue;
                     /*
-               * Otherwise do the hard job
-               */
-                    lin_pot_coeff (nodes[j],tri,omega);
+                     * Otherwise do the hard job
+                     */
+                    lin_pot_coeff (nodes[jj],tri,omega);
                     for (c = 0; c < 3; c++)
                         row[tri->vert[c]] = row[tri->vert[c]] - omega[c];
                 }
                 for (k = 0; k < np2; k++)
-                    mat[j+joff][k+koff] = row[k];
-            }
+                    mat_row[k] = row[k];
+            });
             if (p == q) {
                 for (j = 0; j < np1; j++)
                     sub_mat[j] = mat[j+joff]+koff;
@@ -1148,7 +1154,6 @@ float **FwdBemModel::fwd_bem_lin_pot_coeff(const QList<MneSurfaceOld*>& surfs)
             fprintf(stderr,"[done]\n");
         }
     }
-    FREE_40(row);
     FREE_40(sub_mat);
     return(mat);
 }
@@ -1395,17 +1400,22 @@ float **FwdBemModel::fwd_bem_solid_angles(const QList<MneSurfaceOld*>& surfs)
 {
     MneSurfaceOld* surf1;
     MneSurfaceOld* surf2;
-    MneTriangle* tri;
-    int ntri1,ntri2,ntri_tot;
-    int j,k,p,q;
+    int ntri1,ntri2,ntri_tot,ntri_max;
+    int j,p,q;
     int joff,koff;
     float **solids;
-    float result;
     float **sub_solids = NULL;
     float desired;
+    QVector<int> rows;
 
-    for (p = 0,ntri_tot = 0; p < surfs.size(); p++)
+    for (p = 0,ntri_tot = ntri_max = 0; p < surfs.size(); p++) {
         ntri_tot += surfs[p]->ntri;
+        if (surfs[p]->ntri > ntri_max)
+            ntri_max = surfs[p]->ntri;
+    }
+    rows.resize(ntri_max);
+    for (j = 0; j < ntri_max; j++)
+        rows[j] = j;
 
     sub_solids = MALLOC_40(ntri_tot,float *);
     solids = ALLOC_CMATRIX_40(ntri_tot,ntri_tot);
@@ -1416,14 +1426,21 @@ float **FwdBemModel::fwd_bem_solid_angles(const QList<MneSurfaceOld*>& surfs)
             surf2 = surfs[q];
             ntri2 = surf2->ntri;
             fprintf(stderr,"\t\t%s (%d) -> %s (%d) ... ",fwd_bem_explain_surface(surf1->id).toUtf8().constData(),ntri1,fwd_bem_explain_surface(surf2->id).toUtf8().constData(),ntri2);
-            for (j = 0; j < ntri1; j++)
+            /*
+             * The rows are independent: compute them in parallel
+             */
+            QtConcurrent::blockingMap(rows.begin(), rows.begin() + ntri1, [&](const int& jj) {
+                MneTriangle* tri;
+                float        *solids_row = solids[jj+joff]+koff;
+                int          k;
+
                 for (k = 0, tri = surf2->tris; k < ntri2; k++, tri++) {
-                    if (p == q && j == k)
-                        result = 0.0;
+                    if (p == q && jj == k)
+                        solids_row[k] = 0.0;
                     else
-                        result = MneSurfaceOrVolume::solid_angle (surf1->tris[j].cent,tri);
-                    solids[j+joff][k+koff] = result;
+                        solids_row[k] = MneSurfaceOrVolume::solid_angle (surf1->tris[jj].cent,tri);
                 }
+            });
             for (j = 0; j < ntri1; j++)
                 sub_solids[j] = solids[j+joff]+koff;
             fprintf(stderr,"[done]\n");
@@ -2196,15 +2213,11 @@ float **FwdBemModel::fwd_bem_field_coeff(FwdBemModel *m, FwdCoilSet *coils)	/* G
      * Compute the weighting factors to obtain the magnetic field
      */
 {
-    MneSurfaceOld*     surf;
-    MneTriangle*    tri;
-    FwdCoil*        coil;
     FwdCoilSet*     tcoils = NULL;
     int            ntri;
     float          **coeff = NULL;
-    int            j,k,p,s,off;
-    double         res;
-    double         mult;
+    int            j;
+    QVector<int>   coil_idx;
 
     if (m->solution == NULL) {
         printf("Solution matrix missing in fwd_bem_field_coeff");
@@ -2240,24 +2253,32 @@ float **FwdBemModel::fwd_bem_field_coeff(FwdBemModel *m, FwdCoilSet *coils)	/* G
     }
     ntri  = m->nsol;
     coeff = ALLOC_CMATRIX_40(coils->ncoil,ntri);
-
-    for (s = 0, off = 0; s < m->nsurf; s++) {
-        surf = m->surfs[s];
-        ntri = surf->ntri;
-        tri  = surf->tris;
-        mult = m->field_mult[s];
-
-        for (k = 0; k < ntri; k++,tri++) {
-            for (j = 0; j < coils->ncoil; j++) {
-                coil = coils->coils[j];
+    /*
+     * Each coil fills its own row of the matrix: distribute the coils over the threads
+     */
+    coil_idx.resize(coils->ncoil);
+    for (j = 0; j < coils->ncoil; j++)
+        coil_idx[j] = j;
+    QtConcurrent::blockingMap(coil_idx, [&](const int& jj) {
+        FwdCoil*        coil = coils->coils[jj];
+        MneSurfaceOld*  surf;
+        MneTriangle*    tri;
+        double          res,mult;
+        int             k,p,s,off,nt;
+
+        for (s = 0, off = 0; s < m->nsurf; s++) {
+            surf = m->surfs[s];
+            nt   = surf->ntri;
+            mult = m->field_mult[s];
+            for (k = 0, tri = surf->tris; k < nt; k++,tri++) {
                 res = 0.0;
                 for (p = 0; p < coil->np; p++)
                     res = res + coil->w[p]*one_field_coeff(coil->rmag[p],coil->cosmag[p],tri);
-                coeff[j][k+off] = mult*res;
+                coeff[jj][k+off] = mult*res;
             }
+            off = off + nt;
         }
-        off = off + ntri;
-    }
+    });
     delete tcoils;
     return coeff;
 }
@@ -2411,6 +2432,49 @@ void FwdBemModel::fwd_bem_one_lin_field_coeff_simple(float *dest, float *normal,
 }
 
 
+//*************************************************************************************************************
+
+typedef struct {
+    Eigen::ArrayXf rx[3],ry[3],rz[3];   /* Triangle vertex locations */
+    Eigen::ArrayXf nx,ny,nz;            /* Normals scaled by area/3 */
+    Eigen::ArrayXi vert[3];             /* Triangle vertices */
+} fwdTriGeometry;
+
+static void fwd_bem_tri_geometry(MneSurfaceOld* surf, fwdTriGeometry& g)
+/*
+ * Copy the triangle data needed by fwd_bem_one_lin_field_coeff_simple
+ * into a structure of arrays to evaluate all triangles at once
+ */
+{
+    MneTriangle* tri;
+    int          k,c;
+    int          ntri = surf->ntri;
+    float        *r;
+
+    for (c = 0; c < 3; c++) {
+        g.rx[c].resize(ntri);
+        g.ry[c].resize(ntri);
+        g.rz[c].resize(ntri);
+        g.vert[c].resize(ntri);
+    }
+    g.nx.resize(ntri);
+    g.ny.resize(ntri);
+    g.nz.resize(ntri);
+    for (k = 0, tri = surf->tris; k < ntri; k++, tri++) {
+        for (c = 0; c < 3; c++) {
+            r = (c == 0) ? tri->r1 : ((c == 1) ? tri->r2 : tri->r3);
+            g.rx[c][k]   = r[X_40];
+            g.ry[c][k]   = r[Y_40];
+            g.rz[c][k]   = r[Z_40];
+            g.vert[c][k] = tri->vert[c];
+        }
+        g.nx[k] = tri->area*tri->nn[X_40]/3.0;
+        g.ny[k] = tri->area*tri->nn[Y_40]/3.0;
+        g.nz[k] = tri->area*tri->nn[Z_40]/3.0;
+    }
+}
+
+
 //*************************************************************************************************************
 
 float **FwdBemModel::fwd_bem_lin_field_coeff(FwdBemModel *m, FwdCoilSet *coils, int method)    /* Which integration formula to use */
@@ -2419,16 +2483,12 @@ float **FwdBemModel::fwd_bem_lin_field_coeff(FwdBemModel *m, FwdCoilSet *coils,
           * in the linear potential approximation
           */
 {
-    MneSurfaceOld*  surf;
-    MneTriangle* tri;
-    FwdCoil*     coil;
     FwdCoilSet*  tcoils = NULL;
-    int         ntri;
     float       **coeff  = NULL;
-    int         j,k,p,pp,off,s;
-    double      res[3],one[3];
-    float       mult;
+    int         j,s;
     linFieldIntFunc func;
+    QVector<int>            coil_idx;
+    QVector<fwdTriGeometry> geom;
 
     if (m->solution == NULL) {
         printf("Solution matrix missing in fwd_bem_lin_field_coeff");
@@ -2470,41 +2530,92 @@ float **FwdBemModel::fwd_bem_lin_field_coeff(FwdBemModel *m, FwdCoilSet *coils,
         func = fwd_bem_one_lin_field_coeff_simple;
 
     coeff = ALLOC_CMATRIX_40(coils->ncoil,m->nsol);
-    for (k = 0; k < m->nsol; k++)
-        for (j = 0; j < coils->ncoil; j++)
-            coeff[j][k] = 0.0;
+    for (j = 0; j < coils->ncoil; j++)
+        for (s = 0; s < m->nsol; s++)
+            coeff[j][s] = 0.0;
     /*
-       * Process each of the surfaces
-       */
-    for (s = 0, off = 0; s < m->nsurf; s++) {
-        surf = m->surfs[s];
-        ntri = surf->ntri;
-        tri  = surf->tris;
-        mult = m->field_mult[s];
-
-        for (k = 0; k < ntri; k++,tri++) {
-            for (j = 0; j < coils->ncoil; j++) {
-                coil = coils->coils[j];
+     * The simple formula is evaluated for all triangles of a surface at once
+     */
+    if (method != FWD_BEM_LIN_FIELD_FERGUSON && method != FWD_BEM_LIN_FIELD_URANKAR) {
+        geom.resize(m->nsurf);
+        for (s = 0; s < m->nsurf; s++)
+            fwd_bem_tri_geometry(m->surfs[s],geom[s]);
+    }
+    /*
+     * Each coil fills its own row of the matrix: distribute the coils over the threads
+     */
+    coil_idx.resize(coils->ncoil);
+    for (j = 0; j < coils->ncoil; j++)
+        coil_idx[j] = j;
+    QtConcurrent::blockingMap(coil_idx, [&](const int& jj) {
+        FwdCoil*        coil = coils->coils[jj];
+        MneSurfaceOld*  surf;
+        MneTriangle*    tri;
+        float           *row = coeff[jj];
+        double          res[3],one[3];
+        float           mult;
+        int             k,p,pp,s,off,nt;
+
+        for (s = 0, off = 0; s < m->nsurf; s++) {
+            surf = m->surfs[s];
+            nt   = surf->ntri;
+            mult = m->field_mult[s];
+
+            if (!geom.isEmpty()) {
+                const fwdTriGeometry& g = geom.at(s);
+                Eigen::ArrayXf wx,wy,wz;
+                Eigen::ArrayXf dx,dy,dz,dl;
+                Eigen::ArrayXf acc[3];
+
                 for (pp = 0; pp < 3; pp++)
-                    res[pp] = 0;
-                /*
-             * Accumulate the coefficients for each triangle node...
-             */
+                    acc[pp] = Eigen::ArrayXf::Zero(nt);
                 for (p = 0; p < coil->np; p++) {
-                    func(coil->rmag[p],coil->cosmag[p],tri,one);
-                    for (pp = 0; pp < 3; pp++)
-                        res[pp] = res[pp] + coil->w[p]*one[pp];
+                    float *dest   = coil->rmag[p];
+                    float *normal = coil->cosmag[p];
+                    /*
+                     * (dest - r) x nn . normal = (dest - r) . (nn x normal)
+                     */
+                    wx = coil->w[p]*(g.ny*normal[Z_40] - g.nz*normal[Y_40]);
+                    wy = coil->w[p]*(g.nz*normal[X_40] - g.nx*normal[Z_40]);
+                    wz = coil->w[p]*(g.nx*normal[Y_40] - g.ny*normal[X_40]);
+                    for (pp = 0; pp < 3; pp++) {
+                        dx = dest[X_40] - g.rx[pp];
+                        dy = dest[Y_40] - g.ry[pp];
+                        dz = dest[Z_40] - g.rz[pp];
+                        dl = dx.square() + dy.square() + dz.square();
+                        acc[pp] += (dx*wx + dy*wy + dz*wz)/(dl*dl.sqrt());
+                    }
                 }
                 /*
-             * Add these to the corresponding coefficient matrix
-             * elements...
-             */
+                 * Add these to the corresponding coefficient matrix elements...
+                 */
                 for (pp = 0; pp < 3; pp++)
-                    coeff[j][tri->vert[pp]+off] = coeff[j][tri->vert[pp]+off] + mult*res[pp];
+                    for (k = 0; k < nt; k++)
+                        row[g.vert[pp][k]+off] += mult*acc[pp][k];
+            }
+            else {
+                for (k = 0, tri = surf->tris; k < nt; k++,tri++) {
+                    for (pp = 0; pp < 3; pp++)
+                        res[pp] = 0;
+                    /*
+                     * Accumulate the coefficients for each triangle node...
+                     */
+                    for (p = 0; p < coil->np; p++) {
+                        func(coil->rmag[p],coil->cosmag[p],tri,one);
+                        for (pp = 0; pp < 3; pp++)
+                            res[pp] = res[pp] + coil->w[p]*one[pp];
+                    }
+                    /*
+                     * Add these to the corresponding coefficient matrix
+                     * elements...
+                     */
+                    for (pp = 0; pp < 3; pp++)
+                        row[tri->vert[pp]+off] = row[tri->vert[pp]+off] + mult*res[pp];
+                }
             }
+            off = off + surf->np;
         }
-        off = off + surf->np;
-    }
+    });
     /*
        * Discard the duplicate
        */
@@ -2548,7 +2659,7 @@ int FwdBemModel::fwd_bem_specify_coils(FwdBemModel *m, FwdCoilSet *coils)
 
     csol->ncoil     = coils->ncoil;
     csol->np        = m->nsol;
-    csol->solution  = mne_mat_mat_mult_40(sol,m->solution,coils->ncoil,m->nsol,m->nsol);//TODO: Suspicion, that this is slow - use Eigen
+    csol->solution  = mne_mat_mat_mult_40(sol,m->solution,coils->ncoil,m->nsol,m->nsol);
 
     FREE_CMATRIX_40(sol);
     return OK;
@@ -2963,19 +3074,22 @@ int FwdBemModel::fwd_bem_field_grad(float *rd, float Q[], FwdCoilSet *coils, flo
 void *FwdBemModel::meg_eeg_fwd_one_source_space(void *arg)
 /*
 * Compute the MEG or EEG forward solution for one source space
+* (or the vertices first...last-1 of it)
 * and possibly for only one source component
 */
 {
     FwdThreadArg* a = (FwdThreadArg*)arg;
     MneSourceSpaceOld* s = a->s;
     int            j,p,q;
+    int            first = a->first;
+    int            last  = a->last < 0 ? s->np : a->last;
     float          *xyz[3];
 
     p = a->off;
     q = 3*a->off;
     if (a->fixed_ori) {					  /* The normal source component only */
         if (a->field_pot_grad && a->res_grad) {                   /* Gradient requested? */
-            for (j = 0; j < s->np; j++)
+            for (j = first; j < last; j++)
                 if (s->inuse[j]) {
                     if (a->field_pot_grad(s->rr[j],s->nn[j],a->coils_els,a->res[p],
                                           a->res_grad[q],a->res_grad[q+1],a->res_grad[q+2],
@@ -2986,7 +3100,7 @@ void *FwdBemModel::meg_eeg_fwd_one_source_space(void *arg)
                 }
         }
         else {
-            for (j = 0; j < s->np; j++)
+            for (j = first; j < last; j++)
                 if (s->inuse[j])
                     if (a->field_pot(s->rr[j],s->nn[j],a->coils_els,a->res[p++],a->client) != OK)
                         goto bad;
@@ -2994,7 +3108,7 @@ void *FwdBemModel::meg_eeg_fwd_one_source_space(void *arg)
     }
     else {						  /* All source components */
         if (a->field_pot_grad && a->res_grad) {               /* Gradient requested? */
-            for (j = 0; j < s->np; j++) {
+            for (j = first; j < last; j++) {
                 if (s->inuse[j]) {
                     if (a->comp < 0) {				  /* Compute all components */
                         if (a->field_pot_grad(s->rr[j],Qx,a->coils_els,a->res[p],
@@ -3044,7 +3158,7 @@ void *FwdBemModel::meg_eeg_fwd_one_source_space(void *arg)
             }
         }
         else {
-            for (j = 0; j < s->np; j++) {
+            for (j = first; j < last; j++) {
                 if (s->inuse[j]) {
                     if (a->vec_field_pot) {
                         xyz[0] = a->res[p++];
@@ -3095,7 +3209,99 @@ bad : {
 
 //*************************************************************************************************************
 
-int FwdBemModel::compute_forward_meg(MneSourceSpaceOld **spaces, int nspace, FwdCoilSet *coils, FwdCoilSet *comp_coils, MneCTFCompDataSet *comp_data, bool fixed_ori, FwdBemModel *bem_model, Vector3f *r0, bool use_threads, MneNamedMatrix **resp, MneNamedMatrix **resp_grad)
+#define FWD_SOURCE_CHUNK 32     /* Number of sources computed by one work item */
+
+typedef struct {
+    MneSourceSpaceOld*  s;      /* The source space */
+    int                 first;  /* First vertex */
+    int                 last;   /* Last vertex + 1 */
+    int                 off;    /* Offset of the first source in the result */
+} fwdSourceChunk;
+
+static int fwd_compute_source_chunks(FwdThreadArg* one_arg, MneSourceSpaceOld* *spaces, int nspace, int nthread, bool meg, bool bem_model)
+/*
+ * Split the source spaces into chunks of FWD_SOURCE_CHUNK sources and let nthread workers,
+ * each with its own copy of the workspace, pick up the next unprocessed chunk until all are done
+ */
+{
+    QVector<fwdSourceChunk> chunks;
+    QList<FwdThreadArg*>    args;
+    QList<QFuture<void> >   futures;
+    QThreadPool             pool;
+    QAtomicInt              next(0);
+    QAtomicInt              stat(OK);
+    fwdSourceChunk          chunk;
+    int                     k,j,off,nsrc;
+
+    for (k = 0, off = 0; k < nspace; k++) {
+        chunk.s     = spaces[k];
+        chunk.first = 0;
+        chunk.off   = off;
+        for (j = 0, nsrc = 0; j < spaces[k]->np; j++) {
+            if (spaces[k]->inuse[j]) {
+                if (nsrc == FWD_SOURCE_CHUNK) {
+                    chunk.last = j;
+                    chunks.append(chunk);
+                    chunk.first = j;
+                    chunk.off   = off;
+                    nsrc = 0;
+                }
+                nsrc++;
+                off = one_arg->fixed_ori ? off + 1 : off + 3;
+            }
+        }
+        if (nsrc > 0) {
+            chunk.last = spaces[k]->np;
+            chunks.append(chunk);
+        }
+    }
+    if (nthread > chunks.size())
+        nthread = chunks.size();
+    if (nthread < 1)
+        return OK;
+    /*
+     * We need copies to allocate separate workspace for each thread
+     */
+    for (k = 0; k < nthread; k++)
+        args.append(meg ? FwdThreadArg::create_meg_multi_thread_duplicate(one_arg,bem_model)
+                        : FwdThreadArg::create_eeg_multi_thread_duplicate(one_arg,bem_model));
+    fprintf(stderr,"%d threads : %d chunks of up to %d sources.\n",nthread,chunks.size(),FWD_SOURCE_CHUNK);
+    /*
+     * Ready to start the threads & Wait for them to complete
+     */
+    pool.setMaxThreadCount(nthread);
+    for (k = 0; k < nthread; k++) {
+        FwdThreadArg* a = args[k];
+        futures.append(QtConcurrent::run(&pool, [a, &chunks, &next, &stat]() {
+            int c;
+            while (stat.load() == OK && (c = next.fetchAndAddOrdered(1)) < chunks.size()) {
+                a->s     = chunks[c].s;
+                a->first = chunks[c].first;
+                a->last  = chunks[c].last;
+                a->off   = chunks[c].off;
+                a->comp  = -1;
+                FwdBemModel::meg_eeg_fwd_one_source_space(a);
+                if (a->stat != OK)
+                    stat.store(FAIL);
+            }
+        }));
+    }
+    for (k = 0; k < futures.size(); k++)
+        futures[k].waitForFinished();
+
+    for (k = 0; k < args.size(); k++) {
+        if (meg)
+            FwdThreadArg::free_meg_multi_thread_duplicate(args[k],bem_model);
+        else
+            FwdThreadArg::free_eeg_multi_thread_duplicate(args[k],bem_model);
+    }
+    return stat.load();
+}
+
+
+//*************************************************************************************************************
+
+int FwdBemModel::compute_forward_meg(MneSourceSpaceOld **spaces, int nspace, FwdCoilSet *coils, FwdCoilSet *comp_coils, MneCTFCompDataSet *comp_data, bool fixed_ori, FwdBemModel *bem_model, Vector3f *r0, bool use_threads, int nthread, MneNamedMatrix **resp, MneNamedMatrix **resp_grad)
 /*
 * Compute the MEG forward solution
 * Use either the sphere model or BEM in the calculations
@@ -3110,11 +3316,11 @@ int FwdBemModel::compute_forward_meg(MneSourceSpaceOld **spaces, int nspace, Fwd
                                              * for one dipole orientation */
     int                 nmeg = coils->ncoil;/* Number of channels */
     int                 nsource;            /* Total number of sources */
-    int                 k,p,q,off;
+    int                 k,off;
     QStringList         names;              /* Channel names */
     void                *client;
     FwdThreadArg*       one_arg = NULL;
-    int                 nproc = QThread::idealThreadCount();
+    int                 nproc = nthread > 0 ? nthread : QThread::idealThreadCount();
     QStringList         emptyList;
 
     if (bem_model) {
@@ -3215,54 +3421,13 @@ int FwdBemModel::compute_forward_meg(MneSourceSpaceOld **spaces, int nspace, Fwd
         use_threads = false;
 
     if (use_threads) {
-        int            nthread  = (fixed_ori || vec_field || nproc < 6) ? nspace : 3*nspace;
-        QList <FwdThreadArg*> args; //fwdThreadArg   *args    = MALLOC_40(nthread,fwdThreadArg);
-        int            stat;
         /*
-        * We need copies to allocate separate workspace for each thread
+        * Distribute chunks of sources dynamically over all threads
         */
-        if (fixed_ori || vec_field || nproc < 6) {
-            for (k = 0, off = 0; k < nthread; k++) {
-                FwdThreadArg* t_arg = FwdThreadArg::create_meg_multi_thread_duplicate(one_arg,bem_model != NULL);
-                t_arg->s   = spaces[k];
-                t_arg->off = off;
-                off = fixed_ori ? off + spaces[k]->nuse : off + 3*spaces[k]->nuse;
-                args.append(t_arg);
-            }
-            fprintf(stderr,"%d processors. I will use one thread for each of the %d source spaces.\n",
-                    nproc,nspace);
-        }
-        else {
-            for (k = 0, off = 0, q = 0; k < nspace; k++) {
-                for (p = 0; p < 3; p++,q++) {
-                    FwdThreadArg* t_arg = FwdThreadArg::create_meg_multi_thread_duplicate(one_arg,bem_model != NULL);
-                    t_arg->s    = spaces[k];
-                    t_arg->off  = off;
-                    t_arg->comp = p;
-                    args.append(t_arg);
-                }
-                off = fixed_ori ? off + spaces[k]->nuse : off + 3*spaces[k]->nuse;
-            }
-            fprintf(stderr,"%d processors. I will use %d threads : %d source spaces x 3 source components.\n",
-                    nproc,nthread,nspace);
-        }
-        fprintf(stderr,"Computing MEG at %d source locations (%s orientations)...",
+        fprintf(stderr,"%d processors. ",nproc);
+        fprintf(stderr,"Computing MEG at %d source locations (%s orientations) using ",
                 nsource,fixed_ori ? "fixed" : "free");
-        /*
-        * Ready to start the threads & Wait for them to complete
-        */
-        QtConcurrent::blockingMap(args, meg_eeg_fwd_one_source_space);
-        /*
-        * Check the results
-        */
-        for (k = 0, stat = OK; k < nthread; k++)
-            if (args[k]->stat != OK) {
-                stat = FAIL;
-                break;
-            }
-        for (k = 0; k < args.size(); k++)//nthread == args.size()
-            FwdThreadArg::free_meg_multi_thread_duplicate(args[k],bem_model != NULL);
-        if (stat != OK)
+        if (fwd_compute_source_chunks(one_arg,spaces,nspace,nproc,true,bem_model != NULL) != OK)
             goto bad;
     }
     else {
@@ -3309,7 +3474,7 @@ bad : {
 
 //*************************************************************************************************************
 
-int FwdBemModel::compute_forward_eeg(MneSourceSpaceOld **spaces, int nspace, FwdCoilSet *els, bool fixed_ori, FwdBemModel *bem_model, FwdEegSphereModel *m, bool use_threads, MneNamedMatrix **resp, MneNamedMatrix **resp_grad)
+int FwdBemModel::compute_forward_eeg(MneSourceSpaceOld **spaces, int nspace, FwdCoilSet *els, bool fixed_ori, FwdBemModel *bem_model, FwdEegSphereModel *m, bool use_threads, int nthread, MneNamedMatrix **resp, MneNamedMatrix **resp_grad)
 /*
     * Compute the EEG forward solution
     * Use either the sphere model or BEM in the calculations
@@ -3323,11 +3488,11 @@ int FwdBemModel::compute_forward_eeg(MneSourceSpaceOld **spaces, int nspace, Fwd
                                              * for one dipole orientation */
     int             nsource;                /* Total number of sources */
     int             neeg = els->ncoil;      /* Number of channels */
-    int             k,p,q,off;
+    int             k,off;
     QStringList     names;                  /* Channel names */
     void            *client;
     FwdThreadArg*   one_arg = NULL;
-    int             nproc = QThread::idealThreadCount();
+    int             nproc = nthread > 0 ? nthread : QThread::idealThreadCount();
     QStringList     emptyList;
     /*
        * Count the sources
@@ -3399,52 +3564,13 @@ int FwdBemModel::compute_forward_eeg(MneSourceSpaceOld **spaces, int nspace, Fwd
         use_threads = false;
 
     if (use_threads) {
-        int            nthread  = (fixed_ori || vec_pot || nproc < 6) ? nspace : 3*nspace;
-        QList <FwdThreadArg*> args; //FwdThreadArg*   *args    = MALLOC_40(nthread,FwdThreadArg*);
-        int            stat;
         /*
-        * We need copies to allocate separate workspace for each thread
+        * Distribute chunks of sources dynamically over all threads
         */
-        if (fixed_ori || vec_pot || nproc < 6) {
-            for (k = 0, off = 0; k < nthread; k++) {
-                FwdThreadArg* t_arg = FwdThreadArg::create_eeg_multi_thread_duplicate(one_arg,bem_model != NULL);
-                t_arg->s   = spaces[k];
-                t_arg->off = off;
-                off = fixed_ori ? off + spaces[k]->nuse : off + 3*spaces[k]->nuse;
-                args.append(t_arg);
-            }
-            printf("%d processors. I will use one thread for each of the %d source spaces.\n",nproc,nspace);
-        }
-        else {
-            for (k = 0, off = 0, q = 0; k < nspace; k++) {
-                for (p = 0; p < 3; p++,q++) {
-                    FwdThreadArg* t_arg = FwdThreadArg::create_eeg_multi_thread_duplicate(one_arg,bem_model != NULL);
-                    t_arg->s    = spaces[k];
-                    t_arg->off  = off;
-                    t_arg->comp = p;
-                    args.append(t_arg);
-                }
-                off = fixed_ori ? off + spaces[k]->nuse : off + 3*spaces[k]->nuse;
-            }
-            printf("%d processors. I will use %d threads : %d source spaces x 3 source components.\n",nproc,nthread,nspace);
-        }
-        printf("Computing EEG at %d source locations (%s orientations)...",
+        fprintf(stderr,"%d processors. ",nproc);
+        fprintf(stderr,"Computing EEG at %d source locations (%s orientations) using ",
                 nsource,fixed_ori ? "fixed" : "free");
-        /*
-        * Ready to start the threads & Wait for them to complete
-        */
-        QtConcurrent::blockingMap(args, meg_eeg_fwd_one_source_space);
-        /*
-        * Check the results
-        */
-        for (k = 0, stat = OK; k < nthread; k++)
-            if (args[k]->stat != OK) {
-                stat = FAIL;
-                break;
-            }
-        for (k = 0; k < args.size(); k++)//nthread == args.size()
-            FwdThreadArg::free_eeg_multi_thread_duplicate(args[k],bem_model != NULL);
-        if (stat != OK)
+        if (fwd_compute_source_chunks(one_arg,spaces,nspace,nproc,false,bem_model != NULL) != OK)
             goto bad;
     }
     else {
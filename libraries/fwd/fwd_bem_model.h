@@ -465,6 +465,7 @@ public:
                                     FwdBemModel*        bem_model,   /* BEM model definition */
                                     Eigen::Vector3f*    r0,         /* Sphere model origin */
                                     bool                use_threads, /* Parallelize with threads? */
+                                    int                 nthread,     /* How many threads (<= 0 = all cores) */
                                     MNELIB::MneNamedMatrix*     *resp,       /* The results */
                                     MNELIB::MneNamedMatrix*     *resp_grad);
 
@@ -475,6 +476,7 @@ public:
                                     FwdBemModel*        bem_model,   /* BEM model definition */
                                     FwdEegSphereModel*  m,           /* Sphere model definition */
                                     bool                use_threads, /* Parallelize with threads? */
+                                    int                 nthread,     /* How many threads (<= 0 = all cores) */
                                     MNELIB::MneNamedMatrix*     *resp,       /* The results */
                                     MNELIB::MneNamedMatrix*     *resp_grad);
 
@@ -46,6 +46,7 @@
 
 
 #include <QtAlgorithms>
+#include <QVector>
 
 
 #include <qmath.h>
@@ -225,6 +226,10 @@ void mne_free_dcmatrix_1 (double **m)
 #define EPS      1e-10
 #define SIN_EPS  1e-3
 
+#define POT_TABLE_NBETA     400     /* Intervals in -log(1-beta) in the potential lookup table */
+#define POT_TABLE_NGAMMA    800     /* Intervals in the stretched gamma coordinate, see pot_table_gamma */
+#define POT_TABLE_BETA_MAX  0.95    /* The exact series is used beyond this */
+
 
 
 static int         terms = 0;       /* These statistics may be useful */
@@ -239,6 +244,7 @@ static int         eval = 0;
 FwdEegSphereModel::FwdEegSphereModel()
 : fn(NULL)
 , nterms  (0)
+, pot_table_beta (0.0)
 , lambda  (NULL)
 , mu      (NULL)
 , nfit    (0)
@@ -269,6 +275,9 @@ FwdEegSphereModel::FwdEegSphereModel(const FwdEegSphereModel& p_FwdEegSphereMode
         for (k = 0; k < p_FwdEegSphereModel.nterms; k++)
             this->fn[k] = p_FwdEegSphereModel.fn[k];
     }
+    this->pot_table_r    = p_FwdEegSphereModel.pot_table_r;
+    this->pot_table_t    = p_FwdEegSphereModel.pot_table_t;
+    this->pot_table_beta = p_FwdEegSphereModel.pot_table_beta;
     if (p_FwdEegSphereModel.nfit > 0) {
         this->mu     = VectorXf(p_FwdEegSphereModel.nfit);
         this->lambda = VectorXf(p_FwdEegSphereModel.nfit);
@@ -550,6 +559,140 @@ void FwdEegSphereModel::calc_pot_components(double beta, double cgamma, double *
 }
 
 
+//*************************************************************************************************************
+
+void FwdEegSphereModel::calc_pot_components_vec(const ArrayXd& beta, const ArrayXd& cgamma, ArrayXd& Vr, ArrayXd& Vt, const VectorXd& fn, int nterms)
+{
+    ArrayXd p0,p01,p1,p11;
+    ArrayXd betan,multn;
+    int     n;
+    /*
+     * Same recursion as in next_legen, with P1 divided by sin(gamma)
+     */
+    Vr    = ArrayXd::Zero(beta.size());
+    Vt    = ArrayXd::Zero(beta.size());
+    betan = ArrayXd::Ones(beta.size());
+    for (n = 1; n <= nterms; n++) {
+        if (betan.size() == 0 || betan.abs().maxCoeff() < EPS)
+            break;
+        if (n == 1) {
+            p01 = ArrayXd::Ones(beta.size());
+            p0  = cgamma;
+            p11 = ArrayXd::Zero(beta.size());
+            p1  = ArrayXd::Ones(beta.size());
+        }
+        else {
+            p01 = ((2*n-1)*cgamma*p0 - (n-1)*p01)/(double)n;
+            p11 = ((2*n-1)*cgamma*p1 - n*p11)/(double)(n-1);
+            p0.swap(p01);
+            p1.swap(p11);
+        }
+        multn = betan*fn[n-1];	/* The 2*n + 1 factor is included in fn */
+        Vr += multn*p0;
+        Vt += multn*p1/(double)n;
+        betan *= beta;
+    }
+    return;
+}
+
+
+//*************************************************************************************************************
+
+static double pot_table_gamma(double gamma, double beta)
+/*
+ * As beta approaches one the series peaks at gamma = 0 with a width of about 1 - beta.
+ * This coordinate runs from 0 to NGAMMA over 0 <= gamma <= pi and concentrates
+ * the nodes in the peak.
+ */
+{
+    double a = 1.0 - beta;
+    return POT_TABLE_NGAMMA*log(1.0 + gamma/a)/log(1.0 + M_PI/a);
+}
+
+
+//*************************************************************************************************************
+
+void FwdEegSphereModel::fwd_eeg_make_pot_table()
+/*
+ * Node (i,j) corresponds to -log(1-beta) = (i-1)*hu and pot_table_gamma = j-1.
+ * The table is padded by one node on each side for the cubic interpolation,
+ * the padding nodes are at negative beta and gamma and at gamma > pi.
+ */
+{
+    ArrayXd beta,cgamma,Vr,Vt;
+    double  hu,a,b;
+    int     k;
+
+    pot_table_beta = 0.0;
+    pot_table_r.resize(0,0);
+    pot_table_t.resize(0,0);
+    if (nlayer() == 0 || fn.size() == 0)
+        return;
+
+    pot_table_beta = qMin((double)layers[0].rad/layers[nlayer()-1].rad,POT_TABLE_BETA_MAX);
+    hu = -log(1.0 - pot_table_beta)/POT_TABLE_NBETA;
+
+    pot_table_r.resize(POT_TABLE_NBETA+3,POT_TABLE_NGAMMA+3);
+    pot_table_t.resize(POT_TABLE_NBETA+3,POT_TABLE_NGAMMA+3);
+    for (k = 0; k < POT_TABLE_NBETA+3; k++) {
+        b      = 1.0 - exp(-(k-1)*hu);
+        a      = 1.0 - b;
+        cgamma = (a*((log(1.0 + M_PI/a)/POT_TABLE_NGAMMA*ArrayXd::LinSpaced(POT_TABLE_NGAMMA+3,-1,POT_TABLE_NGAMMA+1)).exp() - 1.0)).cos();
+        beta   = ArrayXd::Constant(cgamma.size(),b);
+        calc_pot_components_vec(beta,cgamma,Vr,Vt,fn,nterms);
+        pot_table_r.row(k) = Vr.matrix().transpose();
+        pot_table_t.row(k) = Vt.matrix().transpose();
+    }
+    return;
+}
+
+
+//*************************************************************************************************************
+
+static void cubic_weights(double t, double *w)
+/*
+ * Catmull-Rom weights for the nodes -1, 0, 1, 2 at 0 <= t <= 1
+ */
+{
+    double t2 = t*t;
+    double t3 = t2*t;
+
+    w[0] = 0.5*(-t3 + 2*t2 - t);
+    w[1] = 0.5*(3*t3 - 5*t2 + 2);
+    w[2] = 0.5*(-3*t3 + 4*t2 + t);
+    w[3] = 0.5*(t3 - t2);
+}
+
+
+//*************************************************************************************************************
+
+void FwdEegSphereModel::fwd_eeg_eval_pot_table(const ArrayXd& beta, const ArrayXd& cgamma, ArrayXd& Vr, ArrayXd& Vt) const
+{
+    double hu = -log(1.0 - pot_table_beta)/POT_TABLE_NBETA;
+    double x,y,wb[4],wg[4],w;
+    int    k,i,j,p,q;
+
+    Vr.resize(beta.size());
+    Vt.resize(beta.size());
+    for (k = 0; k < beta.size(); k++) {
+        x = -log(1.0 - beta[k])/hu;
+        y = pot_table_gamma(acos(qBound(-1.0,cgamma[k],1.0)),beta[k]);
+        i = qBound(0,(int)x,POT_TABLE_NBETA-1);
+        j = qBound(0,(int)y,POT_TABLE_NGAMMA-1);
+        cubic_weights(x-i,wb);
+        cubic_weights(y-j,wg);
+        Vr[k] = Vt[k] = 0.0;
+        for (p = 0; p < 4; p++)
+            for (q = 0; q < 4; q++) {
+                w = wb[p]*wg[q];
+                Vr[k] += w*pot_table_r(i+p,j+q);
+                Vt[k] += w*pot_table_t(i+p,j+q);
+            }
+    }
+    return;
+}
+
+
 //*************************************************************************************************************
 // fwd_multi_spherepot.c
 int FwdEegSphereModel::fwd_eeg_multi_spherepot(float *rd, float *Q, float **el, int neeg, float *Vval, void *client)	  /* The model definition */
@@ -575,23 +718,27 @@ int FwdEegSphereModel::fwd_eeg_multi_spherepot(float *rd, float *Q, float **el,
 */
 {
     FwdEegSphereModel* m = (FwdEegSphereModel*)client;
-    float  my_rd[3],pos[3];
+    float  my_rd[3],*pos;
     int    k,p;
-    float  pos2,rd_len,pos_len;
-    double beta,cos_gamma,Vr,Vt;
+    float  rd_len,pos_len;
     float  vec1[3],vec2[3],v1,v2;
+    Matrix3Xf pos_all(3,neeg);
+    VectorXf  pos2(neeg);
+    ArrayXd   beta(neeg),cos_gamma(neeg),Vr,Vt;
     float  cos_beta,Qr,Qt,Q2,c;
     float  pi4_inv = 0.25/M_PI;
     float  sigmaM_inv;
+    QVector<int> beyond;
     /*
-       * Precompute the coefficients
+       * The coefficients and the table are precomputed in fwd_setup_eeg_sphere_model.
+       * This routine may be called from several threads at once and only reads them.
        */
-    if (m->fn.size() == 0 || m->nterms != MAXTERMS) {
-        m->fn.resize(MAXTERMS);
-        m->nterms = MAXTERMS;
-        for (k = 0; k < MAXTERMS; k++)
-            m->fn[k] = (2*k+3)*m->fwd_eeg_get_multi_sphere_model_coeff(k+1);
+    if (m->fn.size() == 0) {
+        printf("The EEG sphere model %s has not been set up.\n",m->name.toUtf8().constData());
+        return FAIL;
     }
+    if (neeg <= 0)
+        return OK;
     /*
        * Move to the sphere coordinates
        */
@@ -627,6 +774,7 @@ int FwdEegSphereModel::fwd_eeg_multi_spherepot(float *rd, float *Q, float **el,
         Qr = Qt = 0.0;
     }
     for (k = 0; k < neeg; k++) {
+        pos = pos_all.data() + 3*k;
         for (p = 0; p < 3; p++)
             pos[p] = el[k][p] - m->r0[p];
         /*
@@ -640,14 +788,44 @@ int FwdEegSphereModel::fwd_eeg_multi_spherepot(float *rd, float *Q, float **el,
             for (p = 0; p < 3; p++)
                 pos[p] = pos_len*pos[p];
         }
-        pos2 = VEC_DOT_1(pos,pos);
-        pos_len = sqrt(pos2);
+        pos2[k] = VEC_DOT_1(pos,pos);
+        pos_len = sqrt(pos2[k]);
         /*
          * Calculate the two ingredients for the final result
          */
-        cos_gamma = VEC_DOT_1(pos,rd)/(rd_len*pos_len);
-        beta = rd_len/pos_len;
-        calc_pot_components(beta,cos_gamma,&Vr,&Vt,m->fn,m->nterms);
+        cos_gamma[k] = VEC_DOT_1(pos,rd)/(rd_len*pos_len);
+        beta[k] = rd_len/pos_len;
+    }
+    /*
+     * Evaluate the series for all electrodes at once from the lookup table,
+     * the exact series is used for those beyond its range
+     */
+    if (m->pot_table_beta > 0.0) {
+        for (k = 0; k < neeg; k++)
+            if (beta[k] > m->pot_table_beta) {
+                beyond.append(k);
+                beta[k] = m->pot_table_beta;
+            }
+        m->fwd_eeg_eval_pot_table(beta,cos_gamma,Vr,Vt);
+        if (!beyond.isEmpty()) {
+            ArrayXd beyond_beta(beyond.size()),beyond_cos_gamma(beyond.size()),beyond_Vr,beyond_Vt;
+            for (p = 0; p < beyond.size(); p++) {
+                beyond_beta[p]      = rd_len/sqrt(pos2[beyond[p]]);
+                beyond_cos_gamma[p] = cos_gamma[beyond[p]];
+            }
+            calc_pot_components_vec(beyond_beta,beyond_cos_gamma,beyond_Vr,beyond_Vt,m->fn,m->nterms);
+            for (p = 0; p < beyond.size(); p++) {
+                Vr[beyond[p]] = beyond_Vr[p];
+                Vt[beyond[p]] = beyond_Vt[p];
+            }
+        }
+    }
+    else
+        calc_pot_components_vec(beta,cos_gamma,Vr,Vt,m->fn,m->nterms);
+    Vt *= (1.0 - cos_gamma.square()).max(0.0).sqrt();
+
+    for (k = 0; k < neeg; k++) {
+        pos = pos_all.data() + 3*k;
         /*
          * Then compute the combined result
          */
@@ -663,7 +841,7 @@ int FwdEegSphereModel::fwd_eeg_multi_spherepot(float *rd, float *Q, float **el,
             Qr = VEC_DOT_1(Q,rd)/rd_len;
             Qt = sqrt(Q2 - Qr*Qr);
         }
-        Vval[k] = pi4_inv*(Qr*Vr + Qt*cos_beta*Vt)/pos2;
+        Vval[k] = pi4_inv*(Qr*Vr[k] + Qt*cos_beta*Vt[k])/pos2[k];
     }
     /*
        * Scale by the conductivity if we have the layers
@@ -1077,6 +1255,15 @@ bool FwdEegSphereModel::fwd_setup_eeg_sphere_model(float rad, bool fit_berg_sche
             return false;
     }
 
+    /*
+    * Precompute the series coefficients and tabulate the series for fwd_eeg_multi_spherepot
+    */
+    this->fn.resize(MAXTERMS);
+    this->nterms = MAXTERMS;
+    for (int k = 0; k < MAXTERMS; k++)
+        this->fn[k] = (2*k+3)*this->fwd_eeg_get_multi_sphere_model_coeff(k+1);
+    this->fwd_eeg_make_pot_table();
+
     fprintf(stderr,"Defined EEG sphere model with rad = %7.2f mm\n", 1000.0*rad);
     return true;
 }
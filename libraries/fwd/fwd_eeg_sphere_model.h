@@ -192,6 +192,51 @@ public:
                     const Eigen::VectorXd& fn,
                     int    nterms);
 
+    //=========================================================================================================
+    /**
+    * Vectorized version of calc_pot_components which evaluates the series for a batch of source/field point
+    * pairs at once. The tangential component is returned divided by the sine of the angle between the points.
+    *
+    * @param[in] beta       rd/r of each pair
+    * @param[in] cgamma     Cosine of the angle between the source and field points of each pair
+    * @param[out] Vr        Potential component for the radial dipole
+    * @param[out] Vt        Potential component for the tangential dipole divided by sin(gamma)
+    * @param[in] fn         The series coefficients
+    * @param[in] nterms     Number of coefficients
+    */
+    static void calc_pot_components_vec(const Eigen::ArrayXd& beta,
+                                        const Eigen::ArrayXd& cgamma,
+                                        Eigen::ArrayXd& Vr,
+                                        Eigen::ArrayXd& Vt,
+                                        const Eigen::VectorXd& fn,
+                                        int nterms);
+
+    //=========================================================================================================
+    /**
+    * Tabulates the series of calc_pot_components_vec over beta = rd/r and the angle gamma between the source
+    * and field points. Beta covers the range from zero to the ratio of the innermost and outermost radii,
+    * at most 0.95. The nodes are spaced evenly in -log(1-beta) and, in gamma, concentrated towards gamma = 0
+    * as beta grows, where the series is sharply peaked. The interpolation error relative to the largest
+    * potential at the same beta is below 2e-7 over the whole range.
+    * Requires fn to be set, called by fwd_setup_eeg_sphere_model.
+    */
+    void fwd_eeg_make_pot_table();
+
+    //=========================================================================================================
+    /**
+    * Evaluates the series by bicubic interpolation in the table made by fwd_eeg_make_pot_table.
+    * All beta values must be within the range of the table.
+    *
+    * @param[in] beta       rd/r of each pair
+    * @param[in] cgamma     Cosine of the angle between the source and field points of each pair
+    * @param[out] Vr        Potential component for the radial dipole
+    * @param[out] Vt        Potential component for the tangential dipole divided by sin(gamma)
+    */
+    void fwd_eeg_eval_pot_table(const Eigen::ArrayXd& beta,
+                                const Eigen::ArrayXd& cgamma,
+                                Eigen::ArrayXd& Vr,
+                                Eigen::ArrayXd& Vt) const;
+
     static int fwd_eeg_multi_spherepot(float   *rd,	          /* Dipole position */
                        float   *Q,	          /* Dipole moment */
                        float   **el,	  /* Electrode positions */
@@ -317,7 +362,8 @@ public:
     /**
     * fwd_eeg_sphere_models.c
     *
-    * Setup the EEG sphere model calculations
+    * Setup the EEG sphere model calculations. This also precomputes the series coefficients and the
+    * potential table used by fwd_eeg_multi_spherepot, which only reads them and may thus run in several threads.
     *
     * @param[in] rad
     * @param[in] fit_berg_scherg    If Fit Berg Scherg should be performed
@@ -383,6 +429,10 @@ public:
     Eigen::VectorXd fn;                 /**< Coefficients saved to speed up the computations */
     int             nterms;             /**< How many? */
 
+    Eigen::MatrixXd pot_table_r;        /**< Radial series tabulated over beta (rows) and gamma (columns) */
+    Eigen::MatrixXd pot_table_t;        /**< Tangential series divided by sin(gamma), same layout */
+    double          pot_table_beta;     /**< Largest beta covered by the tables, 0 = no tables */
+
     Eigen::VectorXf mu;             /**< The Berg-Scherg equivalence parameters */
     Eigen::VectorXf lambda;
     int             nfit;           /**< How many? */
@@ -138,6 +138,8 @@ public:
     MNELIB::MneSourceSpaceOld   *s;                 /* The source space to process */
     int                 fixed_ori;         /* Compute fixed orientation solution? */
     int                 comp;              /* Which component to compute for free orientations */
+    int                 first;             /* First vertex of the source space to process */
+    int                 last;              /* Last vertex + 1 of the source space to process (-1 = all) */
     int                 stat;
 
 // ### OLD STRUCT ###
@@ -4,8 +4,15 @@
 #include "../c/mne_meas_data_set.h"
 #include "guess_data.h"
 
+#include <fiff/fiff_raw_buffer_cache.h>
+
 #include <string.h>
 
+#include <QtConcurrent>
+#include <QThread>
+#include <QThreadPool>
+#include <QAtomicInt>
+
 
 
 using namespace INVERSELIB;
@@ -57,6 +64,8 @@ using namespace FWDLIB;
 
 #define EPS_VALUES 0.05
 
+#define FIT_BATCH_PER_THREAD 16     /* Time points picked for each thread before fitting */
+
 
 //*************************************************************************************************************
 //=============================================================================================================
@@ -597,6 +606,83 @@ int mne_get_values_from_data_ch (float time,      /* Interesting time point */
 
 
 
+//*************************************************************************************************************
+
+typedef struct {
+    float time;         /* The time point */
+    float *B;           /* The data picked at this time point */
+    ECD   dip;          /* The fitted dipole */
+    bool  ok;           /* Was the fit successful? */
+} fitTimePoint;
+
+
+//*************************************************************************************************************
+
+static QList<DipoleFitData*> create_fit_threads(DipoleFitData* fit, int nthread, int verbose)
+/*
+ * One copy of the fitting data for each thread, the original is used if there is only one
+ */
+{
+    QList<DipoleFitData*> fits;
+    int k;
+
+    if (nthread <= 0)
+        nthread = QThread::idealThreadCount();
+    if (verbose)
+        nthread = 1;        /* Keep the iteration reports of consecutive fits apart */
+    if (nthread <= 1)
+        fits.append(fit);
+    else {
+        for (k = 0; k < nthread; k++)
+            fits.append(DipoleFitData::create_fit_thread_duplicate(fit));
+    }
+    return fits;
+}
+
+
+//*************************************************************************************************************
+
+static void free_fit_threads(QList<DipoleFitData*>& fits, DipoleFitData* fit)
+{
+    for (int k = 0; k < fits.size(); k++)
+        if (fits[k] != fit)
+            DipoleFitData::free_fit_thread_duplicate(fits[k]);
+    fits.clear();
+}
+
+
+//*************************************************************************************************************
+
+static void fit_time_points(fitTimePoint* points, int npoint, const QList<DipoleFitData*>& fits, GuessData* guess, int verbose)
+/*
+ * Each thread picks the next time point to fit until all of them are done.
+ * The time points are independent of each other.
+ */
+{
+    QAtomicInt            next(0);
+    QThreadPool           pool;
+    QList<QFuture<void> > futures;
+    int                   k;
+
+    if (fits.size() == 1) {
+        for (k = 0; k < npoint; k++)
+            points[k].ok = DipoleFitData::fit_one(fits[0],guess,points[k].time,points[k].B,verbose,points[k].dip);
+        return;
+    }
+    pool.setMaxThreadCount(fits.size());
+    for (k = 0; k < fits.size(); k++) {
+        DipoleFitData* fit = fits[k];
+        futures.append(QtConcurrent::run(&pool, [fit, guess, verbose, points, npoint, &next]() {
+            int p;
+            while ((p = next.fetchAndAddOrdered(1)) < npoint)
+                points[p].ok = DipoleFitData::fit_one(fit,guess,points[p].time,points[p].B,verbose,points[p].dip);
+        }));
+    }
+    for (k = 0; k < futures.size(); k++)
+        futures[k].waitForFinished();
+}
+
+
 //*************************************************************************************************************
 //=============================================================================================================
 // DEFINE MEMBER METHODS
@@ -710,11 +796,11 @@ ECDSet DipoleFit::calculateFit() const
 
 
     if (raw) {
-        if (fit_dipoles_raw(settings->measname,raw,sel,fit_data,guess,settings->tmin,settings->tmax,settings->tstep,settings->integ,settings->verbose) == FAIL)
+        if (fit_dipoles_raw(settings->measname,raw,sel,fit_data,guess,settings->tmin,settings->tmax,settings->tstep,settings->integ,settings->verbose,set,settings->nthread) == FAIL)
             goto out;
     }
     else {
-        if (fit_dipoles(settings->measname,data,fit_data,guess,settings->tmin,settings->tmax,settings->tstep,settings->integ,settings->verbose,set) == FAIL)
+        if (fit_dipoles(settings->measname,data,fit_data,guess,settings->tmin,settings->tmax,settings->tstep,settings->integ,settings->verbose,set,settings->nthread) == FAIL)
             goto out;
     }
     printf("%d dipoles fitted\n",set.size());
@@ -728,43 +814,57 @@ out : {
 
 //*************************************************************************************************************
 
-int DipoleFit::fit_dipoles( const QString& dataname, MneMeasData* data, DipoleFitData* fit, GuessData* guess, float tmin, float tmax, float tstep, float integ, int verbose, ECDSet& p_set)
+int DipoleFit::fit_dipoles( const QString& dataname, MneMeasData* data, DipoleFitData* fit, GuessData* guess, float tmin, float tmax, float tstep, float integ, int verbose, ECDSet& p_set, int nthread)
 {
-    float *one = MALLOC(data->nchan,float);
+    QList<DipoleFitData*> fits = create_fit_threads(fit,nthread,verbose);
+    int   nbatch = FIT_BATCH_PER_THREAD*fits.size();
+    float **one  = ALLOC_CMATRIX(nbatch,data->nchan);
+    fitTimePoint *points = new fitTimePoint[nbatch];
     float time;
     ECDSet set;
-    ECD   dip;
-    int   s;
+    int   s,k,npoint;
     int   report_interval = 10;
 
     set.dataname = dataname;
 
     fprintf(stderr,"Fitting...%c",verbose ? '\n' : '\0');
-    for (s = 0, time = tmin; time < tmax; s++, time = tmin  + s*tstep) {
+    for (s = 0, time = tmin; time < tmax; ) {
         /*
-     * Pick the data point
+     * Pick the data for a batch of time points
      */
-        if (mne_get_values_from_data(time,integ,data->current->data,data->current->np,data->nchan,data->current->tmin,
-                                     1.0/data->current->tstep,FALSE,one) == FAIL) {
-            fprintf(stderr,"Cannot pick time: %7.1f ms\n",1000*time);
-            continue;
+        for (npoint = 0; npoint < nbatch && time < tmax; s++, time = tmin  + s*tstep) {
+            if (mne_get_values_from_data(time,integ,data->current->data,data->current->np,data->nchan,data->current->tmin,
+                                         1.0/data->current->tstep,FALSE,one[npoint]) == FAIL) {
+                fprintf(stderr,"Cannot pick time: %7.1f ms\n",1000*time);
+                continue;
+            }
+            points[npoint].time = time;
+            points[npoint].B    = one[npoint];
+            npoint++;
         }
-
-        if (!DipoleFitData::fit_one(fit,guess,time,one,verbose,dip))
-            printf("t = %7.1f ms : %s\n",1000*time,"error (tbd: catch)");
-        else {
-            set.addEcd(dip);
-            if (verbose)
-                dip.print(stdout);
+        fit_time_points(points,npoint,fits,guess,verbose);
+        /*
+     * Collect the results in temporal order
+     */
+        for (k = 0; k < npoint; k++) {
+            if (!points[k].ok)
+                printf("t = %7.1f ms : %s\n",1000*points[k].time,"error (tbd: catch)");
             else {
-                if (set.size() % report_interval == 0)
-                    fprintf(stderr,"%d..",set.size());
+                set.addEcd(points[k].dip);
+                if (verbose)
+                    points[k].dip.print(stdout);
+                else {
+                    if (set.size() % report_interval == 0)
+                        fprintf(stderr,"%d..",set.size());
+                }
             }
         }
     }
     if (!verbose)
         fprintf(stderr,"[done]\n");
-    FREE(one);
+    delete [] points;
+    FREE_CMATRIX(one);
+    free_fit_threads(fits,fit);
     p_set = set;
     return OK;
 }
@@ -772,9 +872,12 @@ int DipoleFit::fit_dipoles( const QString& dataname, MneMeasData* data, DipoleFi
 
 //*************************************************************************************************************
 
-int DipoleFit::fit_dipoles_raw(const QString& dataname, MneRawData* raw, mneChSelection sel, DipoleFitData* fit, GuessData* guess, float tmin, float tmax, float tstep, float integ, int verbose, ECDSet& p_set)
+int DipoleFit::fit_dipoles_raw(const QString& dataname, MneRawData* raw, mneChSelection sel, DipoleFitData* fit, GuessData* guess, float tmin, float tmax, float tstep, float integ, int verbose, ECDSet& p_set, int nthread)
 {
-    float *one    = MALLOC(sel->nchan,float);
+    QList<DipoleFitData*> fits = create_fit_threads(fit,nthread,verbose);
+    int   nbatch  = FIT_BATCH_PER_THREAD*fits.size();
+    float **one   = ALLOC_CMATRIX(nbatch,sel->nchan);
+    fitTimePoint *points = new fitTimePoint[nbatch];
     float sfreq   = raw->info->sfreq;
     float myinteg = integ > 0.0 ? 2*integ : 0.1;
     int   overlap = ceil(myinteg*sfreq);
@@ -782,12 +885,20 @@ int DipoleFit::fit_dipoles_raw(const QString& dataname, MneRawData* raw, mneChSe
     int   step    = length - overlap;
     int   stepo   = step + overlap/2;
     int   start   = raw->first_samp;
-    int   s,picks;
+    int   s,k,picks,npoint;
     float time,stime;
     float **data  = ALLOC_CMATRIX(sel->nchan,length);
-    ECD    dip;
     ECDSet set;
     int    report_interval = 10;
+    /*
+   * Consecutive segments overlap, keep the decoded buffers of about two segments in the raw buffer cache
+   * unless the application configured the cache itself
+   */
+    FIFFLIB::FiffRawBufferCache::SPtr cache = FIFFLIB::FiffRawBufferCache::globalCache();
+    bool  own_cache = !cache->isEnabled();
+
+    if (own_cache)
+        cache->setMaxBytes(2*(qint64)length*raw->info->nchan*sizeof(double));
 
     set.dataname = dataname;
 
@@ -798,47 +909,66 @@ int DipoleFit::fit_dipoles_raw(const QString& dataname, MneRawData* raw, mneChSe
     if (MneRawData::mne_raw_pick_data_filt(raw,sel,start,length,data) == FAIL)
         goto bad;
     fprintf(stderr,"Fitting...%c",verbose ? '\n' : '\0');
-    for (s = 0, time = tmin; time < tmax; s++, time = tmin  + s*tstep) {
-        picks = time*sfreq - start;
-        if (picks > stepo) {		/* Need a new data segment? */
-            start = start + step;
-            if (MneRawData::mne_raw_pick_data_filt(raw,sel,start,length,data) == FAIL)
-                goto bad;
-            picks = time*sfreq - start;
-            stime = start/sfreq;
-        }
+    for (s = 0, time = tmin; time < tmax; ) {
         /*
-     * Get the values
+     * Pick the data for a batch of time points, loading new segments as needed
      */
-        if (mne_get_values_from_data_ch (time,integ,data,length,sel->nchan,stime,sfreq,FALSE,one) == FAIL) {
-            fprintf(stderr,"Cannot pick time: %8.3f s\n",time);
-            continue;
+        for (npoint = 0; npoint < nbatch && time < tmax; s++, time = tmin  + s*tstep) {
+            picks = time*sfreq - start;
+            if (picks > stepo) {		/* Need a new data segment? */
+                start = start + step;
+                if (MneRawData::mne_raw_pick_data_filt(raw,sel,start,length,data) == FAIL)
+                    goto bad;
+                picks = time*sfreq - start;
+                stime = start/sfreq;
+            }
+            /*
+       * Get the values
+       */
+            if (mne_get_values_from_data_ch (time,integ,data,length,sel->nchan,stime,sfreq,FALSE,one[npoint]) == FAIL) {
+                fprintf(stderr,"Cannot pick time: %8.3f s\n",time);
+                continue;
+            }
+            points[npoint].time = time;
+            points[npoint].B    = one[npoint];
+            npoint++;
         }
         /*
      * Fit
      */
-        if (!DipoleFitData::fit_one(fit,guess,time,one,verbose,dip))
-            qWarning() << "Error";
-        else {
-            set.addEcd(dip);
-            if (verbose)
-                dip.print(stdout);
+        fit_time_points(points,npoint,fits,guess,verbose);
+        for (k = 0; k < npoint; k++) {
+            if (!points[k].ok)
+                qWarning() << "Error";
             else {
-                if (set.size() % report_interval == 0)
-                    fprintf(stderr,"%d..",set.size());
+                set.addEcd(points[k].dip);
+                if (verbose)
+                    points[k].dip.print(stdout);
+                else {
+                    if (set.size() % report_interval == 0)
+                        fprintf(stderr,"%d..",set.size());
+                }
             }
         }
     }
     if (!verbose)
         fprintf(stderr,"[done]\n");
     FREE_CMATRIX(data);
-    FREE(one);
+    FREE_CMATRIX(one);
+    delete [] points;
+    free_fit_threads(fits,fit);
+    if (own_cache)
+        cache->setMaxBytes(0);
     p_set = set;
     return OK;
 
 bad : {
         FREE_CMATRIX(data);
-        FREE(one);
+        FREE_CMATRIX(one);
+        delete [] points;
+        free_fit_threads(fits,fit);
+        if (own_cache)
+            cache->setMaxBytes(0);
         return FAIL;
     }
 }
@@ -846,8 +976,8 @@ bad : {
 
 //*************************************************************************************************************
 
-int DipoleFit::fit_dipoles_raw(const QString& dataname, MneRawData* raw, mneChSelection sel, DipoleFitData* fit, GuessData* guess, float tmin, float tmax, float tstep, float integ, int verbose)
+int DipoleFit::fit_dipoles_raw(const QString& dataname, MneRawData* raw, mneChSelection sel, DipoleFitData* fit, GuessData* guess, float tmin, float tmax, float tstep, float integ, int verbose, int nthread)
 {
     ECDSet set;
-    return fit_dipoles_raw(dataname, raw, sel, fit, guess, tmin, tmax, tstep, integ, verbose, set);
+    return fit_dipoles_raw(dataname, raw, sel, fit, guess, tmin, tmax, tstep, integ, verbose, set, nthread);
 }
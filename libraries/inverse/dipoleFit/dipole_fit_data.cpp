@@ -14,6 +14,7 @@
 #include <mne/c/mne_surface_old.h>
 
 #include <fwd/fwd_comp_data.h>
+#include <mne/c/mne_ctf_comp_data_set.h>
 
 #include <Eigen/Dense>
 
@@ -5240,6 +5241,159 @@ bad : {
 }
 
 
+//*************************************************************************************************************
+
+static FwdBemModel* dup_fit_bem_model(FwdBemModel* orig)
+/*
+ * Only the potential work space needs to be separate
+ */
+{
+    FwdBemModel* res = new FwdBemModel();
+
+    *res    = *orig;
+    res->v0 = NULL;
+    return res;
+}
+
+
+//*************************************************************************************************************
+
+static void free_dup_fit_bem_model(FwdBemModel* bem)
+/*
+ * Release the work space only, everything else is shared with the original
+ */
+{
+    if (!bem)
+        return;
+    bem->surfs.clear();
+    bem->nsurf       = 0;
+    bem->ntri        = NULL;
+    bem->np          = NULL;
+    bem->sigma       = NULL;
+    bem->gamma       = NULL;
+    bem->source_mult = NULL;
+    bem->field_mult  = NULL;
+    bem->solution    = NULL;
+    bem->head_mri_t  = NULL;
+    delete bem;             /* Frees v0 */
+}
+
+
+//*************************************************************************************************************
+
+static dipoleFitFuncs dup_dipole_fit_funcs(dipoleFitFuncs f)
+/*
+ * Duplicate the forward calculation clients which contain work space
+ */
+{
+    dipoleFitFuncs res;
+    FwdCompData*   orig;
+    FwdCompData*   comp;
+
+    if (!f)
+        return NULL;
+    res  = new_dipole_fit_funcs();
+    *res = *f;
+    res->meg_client_free = NULL;
+    res->eeg_client_free = NULL;
+    if (f->meg_client) {
+        orig = (FwdCompData*)f->meg_client;
+        res->meg_client = comp = new FwdCompData;
+        *comp = *orig;
+        comp->work        = NULL;
+        comp->vec_work    = NULL;
+        comp->set         = orig->set ? new MneCTFCompDataSet(*(orig->set)) : NULL;
+        comp->client_free = NULL;
+        if (orig->field == FwdBemModel::fwd_bem_field)
+            comp->client = dup_fit_bem_model((FwdBemModel*)orig->client);
+    }
+    if (f->eeg_pot == FwdBemModel::fwd_bem_pot_els)
+        res->eeg_client = dup_fit_bem_model((FwdBemModel*)f->eeg_client);
+    return res;
+}
+
+
+//*************************************************************************************************************
+
+static void free_dup_dipole_fit_funcs(dipoleFitFuncs f)
+{
+    FwdCompData* comp;
+
+    if (!f)
+        return;
+    if (f->meg_client) {
+        comp = (FwdCompData*)f->meg_client;
+        if (comp->field == FwdBemModel::fwd_bem_field)
+            free_dup_fit_bem_model((FwdBemModel*)comp->client);
+        comp->client     = NULL;
+        comp->comp_coils = NULL;
+        delete comp;            /* Frees the work space and the compensation data */
+    }
+    if (f->eeg_pot == FwdBemModel::fwd_bem_pot_els)
+        free_dup_fit_bem_model((FwdBemModel*)f->eeg_client);
+    FREE_3(f);
+}
+
+
+//*************************************************************************************************************
+
+DipoleFitData* DipoleFitData::create_fit_thread_duplicate(DipoleFitData* fit)
+/*
+ * Create a duplicate to make fit_one thread safe
+ * Do not duplicate read-only parts of the relevant structures
+ */
+{
+    DipoleFitData* res = new DipoleFitData();
+
+    *res = *fit;
+    res->sphere_funcs     = dup_dipole_fit_funcs(fit->sphere_funcs);
+    res->bem_funcs        = dup_dipole_fit_funcs(fit->bem_funcs);
+    res->mag_dipole_funcs = dup_dipole_fit_funcs(fit->mag_dipole_funcs);
+    if (fit->funcs == fit->bem_funcs)
+        res->funcs = res->bem_funcs;
+    else if (fit->funcs == fit->mag_dipole_funcs)
+        res->funcs = res->mag_dipole_funcs;
+    else
+        res->funcs = res->sphere_funcs;
+    res->user      = NULL;
+    res->user_free = NULL;
+    return res;
+}
+
+
+//*************************************************************************************************************
+
+void DipoleFitData::free_fit_thread_duplicate(DipoleFitData* dup)
+{
+    if (!dup)
+        return;
+    free_dup_dipole_fit_funcs(dup->sphere_funcs);
+    free_dup_dipole_fit_funcs(dup->bem_funcs);
+    free_dup_dipole_fit_funcs(dup->mag_dipole_funcs);
+    /*
+     * The rest belongs to the original
+     */
+    dup->mri_head_t       = NULL;
+    dup->meg_head_t       = NULL;
+    dup->chs              = NULL;
+    dup->meg_coils        = NULL;
+    dup->eeg_els          = NULL;
+    dup->noise            = NULL;
+    dup->noise_orig       = NULL;
+    dup->pick             = NULL;
+    dup->bem_model        = NULL;
+    dup->eeg_model        = NULL;
+    dup->proj             = NULL;
+    dup->user             = NULL;
+    dup->user_free        = NULL;
+    dup->sphere_funcs     = NULL;
+    dup->bem_funcs        = NULL;
+    dup->mag_dipole_funcs = NULL;
+    dup->funcs            = NULL;
+    delete dup;
+}
+
+
 
 
 
@@ -214,6 +214,26 @@ public:
     */
     static bool fit_one(DipoleFitData* fit, GuessData* guess, float time, float *B, int verbose, ECD& res);
 
+    //=========================================================================================================
+    /**
+    * Create a duplicate of the fitting data for one fitting thread. The forward calculation clients which
+    * contain work space are duplicated, all read-only data is shared with the original.
+    * The duplicate must be freed with free_fit_thread_duplicate before the original is deleted.
+    *
+    * @param[in] fit        Precomputed fitting data
+    *
+    * @return the duplicate
+    */
+    static DipoleFitData* create_fit_thread_duplicate(DipoleFitData* fit);
+
+    //=========================================================================================================
+    /**
+    * Free a duplicate made with create_fit_thread_duplicate. The shared data is left untouched.
+    *
+    * @param[in] dup        The duplicate to free
+    */
+    static void free_fit_thread_duplicate(DipoleFitData* dup);
+
 
 
 //============================= dipole_forward.c
@@ -237,6 +237,7 @@ void DipoleFitSettings::usage(char *name)
     printf("\t--mindist dist/mm Exclude points which are closer than this distance from the inner skull surface  (default = %6.1f mm).\n",1000*guess_mindist);
     printf("\t--grid    dist/mm Source space grid size (default = %6.1f mm).\n",1000*guess_grid);
     printf("\t--magdip          Fit magnetic dipoles instead of current dipoles.\n");
+    printf("\t--threads n       Number of threads to fit time points in parallel (default : all cores).\n");
     printf("\nOutput:\n\n");
     printf("\t--dip     name    xfit dip format output file name\n");
     printf("\t--bdip    name    xfit bdip format output file name\n");
@@ -799,6 +800,22 @@ bool DipoleFitSettings::check_args (int *argc,char **argv)
             }
             bdipname = QString(argv[k+1]);
         }
+        else if (strcmp(argv[k],"--threads") == 0) {
+            found = 2;
+            if (k == *argc - 1) {
+                qCritical ("--threads: argument required.");
+                return false;
+            }
+            if (sscanf(argv[k+1],"%d",&ival) != 1) {
+                qCritical() << "Illegal number:" << argv[k+1];
+                return false;
+            }
+            if (ival < 0) {
+                qCritical ("Number of threads should be non-negative.");
+                return false;
+            }
+            nthread = ival;
+        }
         else if (strcmp(argv[k],"--verbose") == 0) {
             found = 1;
             verbose = true;
@@ -169,6 +169,7 @@ public:
     bool  do_baseline  = false;         /**< Are both baseline limits set? */
     int   setno        = 1;             /**< Which data set */
     bool  verbose      = false;
+    int   nthread      = 0;             /**< Number of threads used for fitting, 0 = all cores */
     mneFilterDefRec     filter;
     QStringList projnames;              /**< Projection file names */
     bool omit_data_proj = false;
@@ -267,100 +267,24 @@ void HPIFit::fitHPI(const MatrixXd& t_mat,
     }
 
     //Find good seed point/starting point for the coil position in 3D space
-    //Find biggest amplitude per pickup coil (sensor) and store corresponding sensor channel index
-    VectorXi chIdcs(numCoils);
-
-    for (int j = 0; j < numCoils; j++) {
-        double maxVal = 0;
-        int chIdx = 0;
-
-        for (int i = 0; i < amp.rows(); ++i) {
-            if(std::fabs(amp(i,j)) > maxVal) {
-                maxVal = std::fabs(amp(i,j));
-
-                if(chIdx < innerind.size()) {
-                    chIdx = innerind.at(i);
-                }
-            }
-        }
-
-        chIdcs(j) = chIdx;
-    }
-
-    //Generate seed point by projection the found channel position 3cm inwards
-    Eigen::MatrixXd coilPos = Eigen::MatrixXd::Zero(numCoils,3);
-
-    for (int j = 0; j < chIdcs.rows(); ++j) {
-        int chIdx = chIdcs(j);
-
-        if(chIdx < pFiffInfo->chs.size()) {
-            double x = pFiffInfo->chs.at(chIdcs(j)).chpos.r0[0];
-            double y = pFiffInfo->chs.at(chIdcs(j)).chpos.r0[1];
-            double z = pFiffInfo->chs.at(chIdcs(j)).chpos.r0[2];
-
-            coilPos(j,0) = -1 * pFiffInfo->chs.at(chIdcs(j)).chpos.ez[0] * 0.03 + x;
-            coilPos(j,1) = -1 * pFiffInfo->chs.at(chIdcs(j)).chpos.ez[1] * 0.03 + y;
-            coilPos(j,2) = -1 * pFiffInfo->chs.at(chIdcs(j)).chpos.ez[2] * 0.03 + z;
-        }
-
-        //std::cout << "HPIFit::fitHPI - Coil " << j << " max value index " << chIdx << std::endl;
-    }
+    VectorXi chIdcs;
+    Eigen::MatrixXd coilPos = computeSeedPoints(amp, innerind, pFiffInfo, chIdcs);
 
     coil.pos = coilPos;
 
     coil = dipfit(coil, sensors, amp, numCoils, matProjectorsInnerind);
 
-    Eigen::Matrix4d trans = computeTransformation(headHPI, coil.pos);
-    //Eigen::Matrix4d trans = computeTransformation(coil.pos, headHPI);
-
-    // Store the final result to fiff info
-    // Set final device/head matrix and its inverse to the fiff info
-    transDevHead.from = 1;
-    transDevHead.to = 4;
-
-    for(int r = 0; r < 4; ++r) {
-        for(int c = 0; c < 4 ; ++c) {
-            transDevHead.trans(r,c) = trans(r,c);
-        }
-    }
-
-    // Also store the inverse
-    transDevHead.invtrans = transDevHead.trans.inverse();
-
-    //Calculate GOF
-    MatrixXd temp = coil.pos;
-    temp.conservativeResize(coil.pos.rows(),coil.pos.cols()+1);
-
-    temp.block(0,3,numCoils,1).setOnes();
-    temp.transposeInPlace();
-
-    MatrixXd testPos = trans * temp;
-    MatrixXd diffPos = testPos.block(0,0,3,numCoils) - headHPI.transpose();
-
-    for(int i = 0; i < diffPos.cols(); ++i) {
-        vGof.append(diffPos.col(i).norm());
-    }
-
-    //Generate final fitted points and store in digitizer set
-    for(int i = 0; i < coil.pos.rows(); ++i) {
-        FiffDigPoint digPoint;
-        digPoint.kind = FIFFV_POINT_EEG;
-        digPoint.ident = i;
-        digPoint.r[0] = coil.pos(i,0);
-        digPoint.r[1] = coil.pos(i,1);
-        digPoint.r[2] = coil.pos(i,2);
-
-        fittedPointSet << digPoint;
-    }
+    MatrixXd diffPos = storeFitResult(coil, headHPI, transDevHead, vGof, fittedPointSet);
 
     if(bDoDebug) {
         // DEBUG HPI fitting and write debug results
         std::cout << std::endl << std::endl << "HPIFit::fitHPI - dpfiterror" << coil.dpfiterror << std::endl << coil.pos << std::endl;
         std::cout << std::endl << std::endl << "HPIFit::fitHPI - Initial seed point for HPI coils" << std::endl << coil.pos << std::endl;
-        std::cout << std::endl << std::endl << "HPIFit::fitHPI - temp" << std::endl << temp << std::endl;
+
+        MatrixXd testPos = diffPos + headHPI.transpose();
         std::cout << std::endl << std::endl << "HPIFit::fitHPI - testPos" << std::endl << testPos << std::endl;
         std::cout << std::endl << std::endl << "HPIFit::fitHPI - Diff fitted - original" << std::endl << diffPos << std::endl;
-        std::cout << std::endl << std::endl << "HPIFit::fitHPI - dev/head trans" << std::endl << trans << std::endl;
+        std::cout << std::endl << std::endl << "HPIFit::fitHPI - dev/head trans" << std::endl << transDevHead.trans << std::endl;
 
         QString sTimeStamp = QDateTime::currentDateTime().toString("yyMMdd_hhmmss");
 
@@ -394,7 +318,7 @@ void HPIFit::fitHPI(const MatrixXd& t_mat,
 
 //*************************************************************************************************************
 
-CoilParam HPIFit::dipfit(struct CoilParam coil, struct SensorInfo sensors, const Eigen::MatrixXd& data, int numCoils, const Eigen::MatrixXd& t_matProjectors)
+CoilParam HPIFit::dipfit(struct CoilParam coil, const struct SensorInfo& sensors, const Eigen::MatrixXd& data, int numCoils, const Eigen::MatrixXd& t_matProjectors)
 {
     //Do this in conncurrent mode
     //Generate QList structure which can be handled by the QConcurrent framework
@@ -404,8 +328,8 @@ CoilParam HPIFit::dipfit(struct CoilParam coil, struct SensorInfo sensors, const
         HPIFitData coilData;
         coilData.coilPos = coil.pos.row(i);
         coilData.sensorData = data.col(i);
-        coilData.sensorPos = sensors;
-        coilData.matProjector = t_matProjectors;
+        coilData.pSensorPos = &sensors;
+        coilData.pMatProjector = &t_matProjectors;
 
         lCoilData.append(coilData);
     }
@@ -436,6 +360,254 @@ CoilParam HPIFit::dipfit(struct CoilParam coil, struct SensorInfo sensors, const
 }
 
 
+//*************************************************************************************************************
+
+Eigen::MatrixXd HPIFit::computeSeedPoints(const Eigen::MatrixXd& amp, const QVector<int>& innerind, FiffInfo::SPtr pFiffInfo, VectorXi& chIdcs)
+{
+    int numCoils = amp.cols();
+
+    //Find biggest amplitude per pickup coil (sensor) and store corresponding sensor channel index
+    chIdcs.resize(numCoils);
+
+    for (int j = 0; j < numCoils; j++) {
+        double maxVal = 0;
+        int chIdx = 0;
+
+        for (int i = 0; i < amp.rows(); ++i) {
+            if(std::fabs(amp(i,j)) > maxVal) {
+                maxVal = std::fabs(amp(i,j));
+
+                if(chIdx < innerind.size()) {
+                    chIdx = innerind.at(i);
+                }
+            }
+        }
+
+        chIdcs(j) = chIdx;
+    }
+
+    //Generate seed point by projection the found channel position 3cm inwards
+    Eigen::MatrixXd coilPos = Eigen::MatrixXd::Zero(numCoils,3);
+
+    for (int j = 0; j < chIdcs.rows(); ++j) {
+        int chIdx = chIdcs(j);
+
+        if(chIdx < pFiffInfo->chs.size()) {
+            double x = pFiffInfo->chs.at(chIdcs(j)).chpos.r0[0];
+            double y = pFiffInfo->chs.at(chIdcs(j)).chpos.r0[1];
+            double z = pFiffInfo->chs.at(chIdcs(j)).chpos.r0[2];
+
+            coilPos(j,0) = -1 * pFiffInfo->chs.at(chIdcs(j)).chpos.ez[0] * 0.03 + x;
+            coilPos(j,1) = -1 * pFiffInfo->chs.at(chIdcs(j)).chpos.ez[1] * 0.03 + y;
+            coilPos(j,2) = -1 * pFiffInfo->chs.at(chIdcs(j)).chpos.ez[2] * 0.03 + z;
+        }
+
+        //std::cout << "HPIFit::fitHPI - Coil " << j << " max value index " << chIdx << std::endl;
+    }
+
+    return coilPos;
+}
+
+
+//*************************************************************************************************************
+
+bool HPIFit::demodulateContinuous(const MatrixXd& t_mat,
+                                  const MatrixXd& t_matProjectors,
+                                  const QVector<int>& vFreqs,
+                                  FiffInfo::SPtr pFiffInfo,
+                                  HPIFitState& state,
+                                  int iWindowSize)
+{
+    if(t_mat.rows() == 0 || t_mat.cols() == 0 || t_matProjectors.rows() != t_mat.rows() || t_matProjectors.cols() != t_mat.rows()) {
+        std::cout<<std::endl<< "HPIFit::demodulateContinuous - Data or projector dimensions do not match. Returning.";
+        return false;
+    }
+
+    //
+    // Rebuild the channel setup if needed
+    //
+    if(state.vFreqs != vFreqs || state.bads != pFiffInfo->bads
+            || state.matProjectorsFull.rows() != t_matProjectors.rows() || state.matProjectorsFull.cols() != t_matProjectors.cols()
+            || state.matProjectorsFull != t_matProjectors) {
+        //Get HPI coils from digitizers
+        QList<FiffDigPoint> lHPIPoints;
+        for(int i = 0; i < pFiffInfo->dig.size(); ++i) {
+            if(pFiffInfo->dig[i].kind == FIFFV_POINT_HPI) {
+                lHPIPoints.append(pFiffInfo->dig[i]);
+            }
+        }
+
+        if(vFreqs.size() < lHPIPoints.size() || lHPIPoints.isEmpty()) {
+            std::cout<<std::endl<< "HPIFit::demodulateContinuous - Not enough coil frequencies or HPI digitizer points. Returning.";
+            return false;
+        }
+
+        //A change of the coil frequencies changes the coil order, do not use the old positions as seed
+        if(state.vFreqs != vFreqs) {
+            state.bPosValid = false;
+        }
+
+        state.numCoils = lHPIPoints.size();
+        state.vFreqs = vFreqs;
+        state.bads = pFiffInfo->bads;
+        state.matProjectorsFull = t_matProjectors;
+
+        state.headHPI.resize(state.numCoils,3);
+        for (int i = 0; i < state.numCoils; ++i) {
+            state.headHPI(i,0) = lHPIPoints.at(i).r[0];
+            state.headHPI(i,1) = lHPIPoints.at(i).r[1];
+            state.headHPI(i,2) = lHPIPoints.at(i).r[2];
+        }
+
+        //TODO: Only supports babymeg and vectorview gradiometeres for hpi fitting.
+        state.innerind.clear();
+        for (int i = 0; i < pFiffInfo->nchan; ++i) {
+            if(pFiffInfo->chs[i].chpos.coil_type == FIFFV_COIL_BABY_MAG ||
+                    pFiffInfo->chs[i].chpos.coil_type == FIFFV_COIL_VV_PLANAR_T1 ||
+                    pFiffInfo->chs[i].chpos.coil_type == FIFFV_COIL_VV_PLANAR_T2 ||
+                    pFiffInfo->chs[i].chpos.coil_type == FIFFV_COIL_VV_PLANAR_T3) {
+                if(!(pFiffInfo->bads.contains(pFiffInfo->ch_names.at(i)))) {
+                    state.innerind.append(i);
+                }
+            }
+        }
+
+        int numInner = state.innerind.size();
+        state.matProjectorsInner.resize(numInner, numInner);
+        state.sensors.coilpos.resize(numInner,3);
+        state.sensors.coilori.resize(numInner,3);
+        state.sensors.tra = Eigen::MatrixXd::Identity(numInner,numInner);
+
+        for(int i = 0; i < numInner; ++i) {
+            for(int j = 0; j < numInner; ++j) {
+                state.matProjectorsInner(i,j) = t_matProjectors(state.innerind.at(i), state.innerind.at(j));
+            }
+
+            for(int k = 0; k < 3; ++k) {
+                state.sensors.coilpos(i,k) = pFiffInfo->chs[state.innerind.at(i)].chpos.r0[k];
+                state.sensors.coilori(i,k) = pFiffInfo->chs[state.innerind.at(i)].chpos.ez[k];
+            }
+        }
+
+        //The inner channels changed, restart the demodulation
+        state.lBlockXR.clear();
+        state.lBlockRR.clear();
+        state.lBlockSizes.clear();
+        state.iWindowSamples = 0;
+    }
+
+    //
+    // Demodulate the new block against sine and cosine references locked to the absolute sample count
+    //
+    int numCoils = state.numCoils;
+    int numSamples = t_mat.cols();
+    double samF = pFiffInfo->sfreq;
+
+    Eigen::MatrixXd matRef(numSamples, numCoils*2);
+    for(int i = 0; i < numCoils; ++i) {
+        //Phase of the first sample, reduced before the multiplication with 2 pi to stay exact for long recordings
+        double dPhase0 = 2 * M_PI * std::fmod((double)vFreqs.at(i) * (double)state.iSampleCount, samF) / samF;
+        double dPhaseStep = 2 * M_PI * vFreqs.at(i) / samF;
+
+        for(int j = 0; j < numSamples; ++j) {
+            matRef(j,i) = sin(dPhase0 + j*dPhaseStep);
+            matRef(j,i+numCoils) = cos(dPhase0 + j*dPhaseStep);
+        }
+    }
+
+    Eigen::MatrixXd innerdata(state.innerind.size(), numSamples);
+    for(int j = 0; j < state.innerind.size(); ++j) {
+        innerdata.row(j) = t_mat.row(state.innerind[j]);
+    }
+
+    state.lBlockXR.append(innerdata * matRef);
+    state.lBlockRR.append(matRef.transpose() * matRef);
+    state.lBlockSizes.append(numSamples);
+    state.iWindowSamples += numSamples;
+    state.iSampleCount += numSamples;
+
+    //Slide the window
+    while(state.lBlockSizes.size() > 1 && state.iWindowSamples - state.lBlockSizes.first() >= iWindowSize) {
+        state.iWindowSamples -= state.lBlockSizes.takeFirst();
+        state.lBlockXR.removeFirst();
+        state.lBlockRR.removeFirst();
+    }
+
+    if(state.iWindowSamples < iWindowSize) {
+        return false;
+    }
+
+    //
+    // Least squares amplitudes over the window: topo = sum(X*R) * inv(sum(R'*R))
+    //
+    Eigen::MatrixXd matXR = state.lBlockXR.first();
+    Eigen::MatrixXd matRR = state.lBlockRR.first();
+    for(int b = 1; b < state.lBlockSizes.size(); ++b) {
+        matXR += state.lBlockXR.at(b);
+        matRR += state.lBlockRR.at(b);
+    }
+
+    Eigen::MatrixXd topo = matRR.ldlt().solve(matXR.transpose()).transpose();
+
+    //The field pattern of each coil has one common phase, take the dominant in-phase component
+    state.amp.resize(topo.rows(), numCoils);
+    for(int i = 0; i < numCoils; ++i) {
+        Eigen::Matrix2d matGram;
+        matGram(0,0) = topo.col(i).squaredNorm();
+        matGram(1,1) = topo.col(i+numCoils).squaredNorm();
+        matGram(0,1) = matGram(1,0) = topo.col(i).dot(topo.col(i+numCoils));
+
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d> eig(matGram);
+        Eigen::Vector2d vecDir = eig.eigenvectors().col(1);
+
+        state.amp.col(i) = vecDir(0) * topo.col(i) + vecDir(1) * topo.col(i+numCoils);
+    }
+
+    return true;
+}
+
+
+//*************************************************************************************************************
+
+bool HPIFit::fitHPIContinuous(FiffCoordTrans& transDevHead,
+                              QVector<double>& vGof,
+                              FiffDigPointSet& fittedPointSet,
+                              FiffInfo::SPtr pFiffInfo,
+                              HPIFitState& state)
+{
+    int numCoils = state.numCoils;
+
+    if(numCoils == 0 || state.amp.cols() != numCoils || state.amp.rows() != state.innerind.size()) {
+        std::cout<<std::endl<< "HPIFit::fitHPIContinuous - No demodulated data available. Returning.";
+        return false;
+    }
+
+    vGof.clear();
+
+    struct CoilParam coil;
+    coil.mom = Eigen::MatrixXd::Zero(numCoils,3);
+    coil.dpfiterror = Eigen::VectorXd::Zero(numCoils);
+    coil.dpfitnumitr = Eigen::VectorXd::Zero(numCoils);
+
+    //Warm start from the previous solution if that one was good
+    if(state.bPosValid && state.coilPos.rows() == numCoils) {
+        coil.pos = state.coilPos;
+    } else {
+        VectorXi chIdcs;
+        coil.pos = computeSeedPoints(state.amp, state.innerind, pFiffInfo, chIdcs);
+    }
+
+    coil = dipfit(coil, state.sensors, state.amp, numCoils, state.matProjectorsInner);
+
+    state.coilPos = coil.pos;
+    state.bPosValid = coil.dpfiterror.maxCoeff() < state.dMaxSeedError;
+
+    storeFitResult(coil, state.headHPI, transDevHead, vGof, fittedPointSet);
+
+    return true;
+}
+
+
 //*************************************************************************************************************
 
 Eigen::Matrix4d HPIFit::computeTransformation(Eigen::MatrixXd NH, Eigen::MatrixXd BT)
@@ -504,3 +676,56 @@ Eigen::Matrix4d HPIFit::computeTransformation(Eigen::MatrixXd NH, Eigen::MatrixX
 
     return transFinal;
 }
+
+
+//*************************************************************************************************************
+
+Eigen::MatrixXd HPIFit::storeFitResult(const CoilParam& coil,
+                                       const Eigen::MatrixXd& headHPI,
+                                       FiffCoordTrans& transDevHead,
+                                       QVector<double>& vGof,
+                                       FiffDigPointSet& fittedPointSet)
+{
+    int numCoils = coil.pos.rows();
+
+    Eigen::Matrix4d trans = computeTransformation(headHPI, coil.pos);
+
+    // Store the final result to fiff info
+    // Set final device/head matrix and its inverse to the fiff info
+    transDevHead.from = 1;
+    transDevHead.to = 4;
+
+    for(int r = 0; r < 4; ++r) {
+        for(int c = 0; c < 4 ; ++c) {
+            transDevHead.trans(r,c) = trans(r,c);
+        }
+    }
+
+    // Also store the inverse
+    transDevHead.invtrans = transDevHead.trans.inverse();
+
+    //Calculate GOF
+    MatrixXd temp(4, numCoils);
+    temp.topRows(3) = coil.pos.transpose();
+    temp.row(3).setOnes();
+
+    MatrixXd diffPos = (trans * temp).topRows(3) - headHPI.transpose();
+
+    for(int i = 0; i < diffPos.cols(); ++i) {
+        vGof.append(diffPos.col(i).norm());
+    }
+
+    //Generate final fitted points and store in digitizer set
+    for(int i = 0; i < numCoils; ++i) {
+        FiffDigPoint digPoint;
+        digPoint.kind = FIFFV_POINT_EEG;
+        digPoint.ident = i;
+        digPoint.r[0] = coil.pos(i,0);
+        digPoint.r[1] = coil.pos(i,1);
+        digPoint.r[2] = coil.pos(i,2);
+
+        fittedPointSet << digPoint;
+    }
+
+    return diffPos;
+}
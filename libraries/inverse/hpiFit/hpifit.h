@@ -42,6 +42,7 @@
 //=============================================================================================================
 
 #include "../inverse_global.h"
+#include "hpifitdata.h"
 
 
 //*************************************************************************************************************
@@ -58,6 +59,9 @@
 //=============================================================================================================
 
 #include <QSharedPointer>
+#include <QList>
+#include <QVector>
+#include <QStringList>
 
 
 //*************************************************************************************************************
@@ -95,6 +99,47 @@ struct CoilParam {
     Eigen::VectorXd dpfitnumitr;
 };
 
+//=========================================================================================================
+/**
+* The state kept between the calls of the continuous HPI fitting, see HPIFit::demodulateContinuous and
+* HPIFit::fitHPIContinuous. The coil signals are demodulated by a running lock-in: every block is multiplied with
+* sine and cosine references of all coil frequencies, which are phase locked to the absolute sample count. The
+* per block products are summed over a sliding window. Solving with the summed reference Gram matrix gives the
+* same coil amplitudes as a least squares fit over the whole window, without revisiting old samples.
+*/
+struct HPIFitState {
+    HPIFitState()
+    : numCoils(0)
+    , iSampleCount(0)
+    , iWindowSamples(0)
+    , bPosValid(false)
+    , dMaxSeedError(0.1)
+    {}
+
+    // Channel setup, rebuilt when projectors, bad channels or coil frequencies change
+    Eigen::MatrixXd     matProjectorsFull;      /**< The projectors the setup was built for. */
+    QStringList         bads;                   /**< The bad channels the setup was built for. */
+    QVector<int>        vFreqs;                 /**< The coil frequencies the setup was built for. */
+    int                 numCoils;               /**< Number of HPI coils. */
+    QVector<int>        innerind;               /**< Indices of the good inner layer channels. */
+    SensorInfo          sensors;                /**< Sensor information of the inner layer channels. */
+    Eigen::MatrixXd     matProjectorsInner;     /**< The projectors restricted to the inner layer channels. */
+    Eigen::MatrixXd     headHPI;                /**< Digitized HPI coil positions. */
+
+    // Running lock-in demodulation
+    qint64              iSampleCount;           /**< Absolute index of the next sample, the reference phase is locked to it. */
+    QList<Eigen::MatrixXd> lBlockXR;            /**< Per block products of data and references, inner channels x 2*coils. */
+    QList<Eigen::MatrixXd> lBlockRR;            /**< Per block reference Gram matrices, 2*coils x 2*coils. */
+    QList<int>          lBlockSizes;            /**< Per block number of samples. */
+    int                 iWindowSamples;         /**< Number of samples in the lock-in window. */
+    Eigen::MatrixXd     amp;                    /**< Demodulated coil amplitudes, inner channels x coils. */
+
+    // Warm start
+    Eigen::MatrixXd     coilPos;                /**< Coil positions of the last fit, device coordinates. */
+    bool                bPosValid;              /**< Whether coilPos is used as seed for the next fit. */
+    double              dMaxSeedError;          /**< Largest relative dipole fit residual for a fit to seed the next one. */
+};
+
 
 //*************************************************************************************************************
 //=============================================================================================================
@@ -145,6 +190,45 @@ public:
                         bool bDoDebug = false,
                         const QString& sHPIResourceDir = QString("./HPIFittingDebug"));
 
+    //=========================================================================================================
+    /**
+    * Feeds a new data block to the running lock-in demodulation of the continuous HPI fitting mode.
+    *
+    * @param[in] t_mat           The new data block, all channels. Blocks have to be passed gap-less.
+    * @param[in] t_matProjectors The projectors to apply. Bad channels are still included.
+    * @param[in] vFreqs          The frequencies for each coil.
+    * @param[in] pFiffInfo       Associated Fiff Information.
+    * @param[in, out] state      The continuous fitting state.
+    * @param[in] iWindowSize     Length of the demodulation window in samples.
+    *
+    * @return true if the demodulation window is filled and fitHPIContinuous can be called, false otherwise.
+    */
+    static bool demodulateContinuous(const Eigen::MatrixXd& t_mat,
+                                     const Eigen::MatrixXd& t_matProjectors,
+                                     const QVector<int>& vFreqs,
+                                     QSharedPointer<FIFFLIB::FiffInfo> pFiffInfo,
+                                     HPIFitState& state,
+                                     int iWindowSize);
+
+    //=========================================================================================================
+    /**
+    * Fits the HPI coils to the amplitudes of the running lock-in demodulation. The fit starts from the coil
+    * positions of the previous fit if that one was good, otherwise from the sensors with the largest amplitudes.
+    *
+    * @param[out] transDevHead   The final dev head transformation matrix
+    * @param[out] vGof           The goodness of fit in mm for each fitted HPI coil.
+    * @param[out] fittedPointSet The final fitted positions in form of a digitizer set.
+    * @param[in] pFiffInfo       Associated Fiff Information.
+    * @param[in, out] state      The continuous fitting state.
+    *
+    * @return true if succeeded, false otherwise.
+    */
+    static bool fitHPIContinuous(FIFFLIB::FiffCoordTrans &transDevHead,
+                                 QVector<double> &vGof,
+                                 FIFFLIB::FiffDigPointSet& fittedPointSet,
+                                 QSharedPointer<FIFFLIB::FiffInfo> pFiffInfo,
+                                 HPIFitState& state);
+
 protected:
     //=========================================================================================================
     /**
@@ -158,7 +242,21 @@ protected:
     *
     * @return Returns the coil parameters.
     */
-    static CoilParam dipfit(struct CoilParam coil, struct SensorInfo sensors, const Eigen::MatrixXd &data, int numCoils, const Eigen::MatrixXd &t_matProjectors);
+    static CoilParam dipfit(struct CoilParam coil, const struct SensorInfo& sensors, const Eigen::MatrixXd &data, int numCoils, const Eigen::MatrixXd &t_matProjectors);
+
+    //=========================================================================================================
+    /**
+    * Generates seed points for the coil fits by projecting the position of the sensor with the largest
+    * amplitude of each coil 3cm inwards.
+    *
+    * @param[in] amp             The coil amplitudes, inner channels x coils.
+    * @param[in] innerind        The indices of the inner channels.
+    * @param[in] pFiffInfo       Associated Fiff Information.
+    * @param[out] chIdcs         The selected channel of each coil.
+    *
+    * @return Returns the seed points (coils x 3).
+    */
+    static Eigen::MatrixXd computeSeedPoints(const Eigen::MatrixXd& amp, const QVector<int>& innerind, QSharedPointer<FIFFLIB::FiffInfo> pFiffInfo, Eigen::VectorXi& chIdcs);
 
     //=========================================================================================================
     /**
@@ -172,6 +270,26 @@ protected:
     static Eigen::Matrix4d computeTransformation(Eigen::MatrixXd NH, Eigen::MatrixXd BT);
 
     static QString         m_sHPIResourceDir;      /**< Hold the resource folder to store the debug information in. */
+
+private:
+    //=========================================================================================================
+    /**
+    * Computes the device to head transformation from the fitted coils, its goodness of fit and the fitted
+    * digitizer points. Shared by fitHPI and fitHPIContinuous.
+    *
+    * @param[in] coil               The fitted coil parameters.
+    * @param[in] headHPI            The digitized HPI coil positions in head space (coils x 3).
+    * @param[out] transDevHead      The final dev head transformation matrix.
+    * @param[out] vGof              The goodness of fit in mm for each fitted HPI coil.
+    * @param[out] fittedPointSet    The final fitted positions in form of a digitizer set.
+    *
+    * @return Returns the difference between the transformed coil positions and headHPI (3 x coils).
+    */
+    static Eigen::MatrixXd storeFitResult(const CoilParam& coil,
+                                          const Eigen::MatrixXd& headHPI,
+                                          FIFFLIB::FiffCoordTrans& transDevHead,
+                                          QVector<double>& vGof,
+                                          FIFFLIB::FiffDigPointSet& fittedPointSet);
 };
 
 //*************************************************************************************************************
@@ -79,6 +79,8 @@ using namespace INVERSELIB;
 //=============================================================================================================
 
 HPIFitData::HPIFitData()
+: pSensorPos(0)
+, pMatProjector(0)
 {
 
 }
@@ -91,7 +93,7 @@ void HPIFitData::doDipfitConcurrent()
     // Initialize variables
     Eigen::RowVectorXd currentCoil = this->coilPos;
     Eigen::VectorXd currentData = this->sensorData;
-    SensorInfo currentSensors = this->sensorPos;
+    const SensorInfo& currentSensors = *this->pSensorPos;
 
     int display = 0;
     int maxiter = 500;
@@ -102,11 +104,11 @@ void HPIFitData::doDipfitConcurrent()
                                        2 * maxiter * currentCoil.cols(),
                                        display,
                                        currentData,
-                                       this->matProjector,
+                                       *this->pMatProjector,
                                        currentSensors,
                                        simplex_numitr);
 
-    this->errorInfo = dipfitError(currentCoil, currentData, currentSensors, this->matProjector);
+    this->errorInfo = dipfitError(this->coilPos, currentData, currentSensors, *this->pMatProjector);
     this->errorInfo.numIterations = simplex_numitr;
 }
 
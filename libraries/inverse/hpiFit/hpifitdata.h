@@ -145,11 +145,11 @@ public:
     */
     void doDipfitConcurrent();
 
-    Eigen::RowVectorXd  coilPos;
-    Eigen::RowVectorXd  sensorData;
-    DipFitError         errorInfo;
-    SensorInfo          sensorPos;
-    Eigen::MatrixXd     matProjector;
+    Eigen::RowVectorXd      coilPos;
+    Eigen::RowVectorXd      sensorData;
+    DipFitError             errorInfo;
+    const SensorInfo*       pSensorPos;         /**< Sensor information, shared by all coils and owned by the caller. */
+    const Eigen::MatrixXd*  pMatProjector;      /**< Projectors, shared by all coils and owned by the caller. */
 
 protected:
     //=========================================================================================================
@@ -52,6 +52,14 @@
 #include <iostream>
 
 
+//*************************************************************************************************************
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QSet>
+
+
 //*************************************************************************************************************
 //=============================================================================================================
 // Eigen INCLUDES
@@ -78,6 +86,8 @@ using namespace INVERSELIB;
 MinimumNorm::MinimumNorm(const MNEInverseOperator &p_inverseOperator, float lambda, const QString method)
 : m_inverseOperator(p_inverseOperator)
 , inverseSetup(false)
+, m_bFastApply(false)
+, m_bFastCombineXyz(false)
 {
     this->setRegularization(lambda);
     this->setMethod(method);
@@ -88,6 +98,8 @@ MinimumNorm::MinimumNorm(const MNEInverseOperator &p_inverseOperator, float lamb
 MinimumNorm::MinimumNorm(const MNEInverseOperator &p_inverseOperator, float lambda, bool dSPM, bool sLORETA)
 : m_inverseOperator(p_inverseOperator)
 , inverseSetup(false)
+, m_bFastApply(false)
+, m_bFastCombineXyz(false)
 {
     this->setRegularization(lambda);
     this->setMethod(dSPM, sLORETA);
@@ -201,6 +213,23 @@ MNESourceEstimate MinimumNorm::calculateInverse(const MatrixXd &data, float tmin
         return MNESourceEstimate();
     }
 
+    if(m_bFastApply && m_matKernelFast.size() > 0)
+    {
+        MatrixXf sol = m_matKernelFast * data.cast<float>(); //apply imaging kernel
+
+        if(m_bFastCombineXyz)
+        {
+            const qint32 nSources = sol.rows() / 3;
+            MatrixXf sol1 = (sol.topRows(nSources).array().square()
+                             + sol.middleRows(nSources, nSources).array().square()
+                             + sol.bottomRows(nSources).array().square()).sqrt();
+
+            return MNESourceEstimate(sol1.cast<double>(), m_vecVerticesFast, tmin, tstep);
+        }
+
+        return MNESourceEstimate(sol.cast<double>(), m_vecVerticesFast, tmin, tstep);
+    }
+
     MatrixXd sol = K * data; //apply imaging kernel
 
     if (inv.source_ori == FIFFV_MNE_FREE_ORI)
@@ -257,6 +286,68 @@ void MinimumNorm::doInverseSetup(qint32 nave, bool pick_normal)
     std::cout << "K " << K.rows() << " x " << K.cols() << std::endl;
 
     inverseSetup = true;
+
+    if(m_bFastApply)
+        setupFastKernel();
+}
+
+
+//*************************************************************************************************************
+
+void MinimumNorm::setupFastKernel()
+{
+    m_matKernelFast.resize(0,0);
+
+    VectorXi p_vecVertices(inv.src[0].vertno.size() + inv.src[1].vertno.size());
+    p_vecVertices << inv.src[0].vertno, inv.src[1].vertno;
+
+    const qint32 nSources = p_vecVertices.size();
+    qint32 nComp;
+    if(K.rows() == 3 * nSources)
+        nComp = 3;
+    else if(K.rows() == nSources)
+        nComp = 1;
+    else
+    {
+        qWarning("MinimumNorm::setupFastKernel - Kernel rows (%d) do not match the number of sources (%d).", (int)K.rows(), nSources);
+        return;
+    }
+
+    //Noise normalization is diagonal and positive -> scale the kernel rows of each source before combining
+    VectorXd vecNoiseNorm = VectorXd::Ones(nSources);
+    if(m_bdSPM || m_bsLORETA)
+    {
+        if(inv.noisenorm.rows() == nSources && inv.noisenorm.cols() == nSources)
+            vecNoiseNorm = inv.noisenorm.diagonal();
+        else
+            qWarning("MinimumNorm::setupFastKernel - Noise normalization does not match the number of sources, it is not applied.");
+    }
+
+    VectorXi vecSel = m_vecSourceSel;
+    if(vecSel.size() == 0)
+        vecSel = VectorXi::LinSpaced(nSources, 0, nSources - 1);
+
+    const qint32 nSel = vecSel.size();
+    m_matKernelFast.resize(nSel * nComp, K.cols());
+    m_vecVerticesFast.resize(nSel);
+
+    for(qint32 i = 0; i < nSel; ++i)
+    {
+        const qint32 iSource = vecSel[i];
+        if(iSource < 0 || iSource >= nSources)
+        {
+            qWarning("MinimumNorm::setupFastKernel - Source selection index %d out of range.", iSource);
+            m_matKernelFast.resize(0,0);
+            return;
+        }
+
+        for(qint32 c = 0; c < nComp; ++c)
+            m_matKernelFast.row(c * nSel + i) = (vecNoiseNorm[iSource] * K.row(iSource * nComp + c)).cast<float>();
+
+        m_vecVerticesFast[i] = p_vecVertices[iSource];
+    }
+
+    m_bFastCombineXyz = (nComp == 3);
 }
 
 
@@ -327,3 +418,57 @@ void MinimumNorm::setRegularization(float lambda)
 {
     m_fLambda = lambda;
 }
+
+
+//*************************************************************************************************************
+
+void MinimumNorm::setFastApply(bool fastApply)
+{
+    m_bFastApply = fastApply;
+
+    if(!m_bFastApply)
+        m_matKernelFast.resize(0,0);
+    else if(inverseSetup)
+        setupFastKernel();
+}
+
+
+//*************************************************************************************************************
+
+void MinimumNorm::setSourceSelection(const VectorXi &p_vecSourceSel)
+{
+    m_vecSourceSel = p_vecSourceSel;
+
+    if(m_bFastApply && inverseSetup)
+        setupFastKernel();
+}
+
+
+//*************************************************************************************************************
+
+void MinimumNorm::setSourceSelection(const Label &p_label)
+{
+    if(p_label.isEmpty() || p_label.hemi < 0 || p_label.hemi >= m_inverseOperator.src.size())
+    {
+        setSourceSelection(VectorXi());
+        return;
+    }
+
+    QSet<qint32> t_setLabelVertices;
+    for(qint32 i = 0; i < p_label.vertices.size(); ++i)
+        t_setLabelVertices.insert(p_label.vertices[i]);
+
+    qint32 iOffset = 0;
+    for(qint32 h = 0; h < p_label.hemi; ++h)
+        iOffset += m_inverseOperator.src[h].vertno.size();
+
+    const VectorXi &vertno = m_inverseOperator.src[p_label.hemi].vertno;
+    VectorXi vecSel(vertno.size());
+    qint32 count = 0;
+    for(qint32 i = 0; i < vertno.size(); ++i)
+        if(t_setLabelVertices.contains(vertno[i]))
+            vecSel[count++] = iOffset + i;
+    vecSel.conservativeResize(count);
+
+    setSourceSelection(vecSel);
+}
@@ -125,6 +125,17 @@ public:
     */
     virtual MNESourceEstimate calculateInverse(const FiffEvoked &p_fiffEvoked, bool pick_normal = false);
 
+    //=========================================================================================================
+    /**
+    * Applies the imaging kernel to a data block. If the fast apply mode is active, the single precision kernel
+    * is used, see setFastApply.
+    *
+    * @param[in] data       Data block (channels x samples), channels have to match the inverse operator.
+    * @param[in] tmin       Time of the first sample.
+    * @param[in] tstep      Time between two samples.
+    *
+    * @return the calculated source estimation
+    */
     virtual MNESourceEstimate calculateInverse(const MatrixXd &data, float tmin, float tstep) const;
 
     virtual void doInverseSetup(qint32 nave, bool pick_normal = false);
@@ -167,6 +178,33 @@ public:
     */
     void setRegularization(float lambda);
 
+    //=========================================================================================================
+    /**
+    * Enables the fast apply mode for real-time use. doInverseSetup then additionally stores the kernel in
+    * single precision with the noise normalization folded in and the x, y and z rows of free orientation sources
+    * grouped into three blocks. calculateInverse(const MatrixXd&, ...) applies it by a single float matrix
+    * product and combines the orientations in one vectorized pass.
+    *
+    * @param[in] fastApply  Whether to use the single precision kernel.
+    */
+    void setFastApply(bool fastApply);
+
+    //=========================================================================================================
+    /**
+    * Restricts the fast apply mode to a subset of the sources.
+    *
+    * @param[in] p_vecSourceSel     Indices of the selected sources, counted over both hemispheres. Empty selects all.
+    */
+    void setSourceSelection(const VectorXi &p_vecSourceSel);
+
+    //=========================================================================================================
+    /**
+    * Restricts the fast apply mode to the sources within a label.
+    *
+    * @param[in] p_label    The label. An empty label selects all sources.
+    */
+    void setSourceSelection(const Label &p_label);
+
     inline MatrixXd& getKernel();
 
 private:
@@ -183,6 +221,18 @@ private:
     Label label;                            /**< The corresponding labels */
     MatrixXd K;                             /**< Imaging kernel */
 
+    //=========================================================================================================
+    /**
+    * Builds the single precision kernel of the fast apply mode from K.
+    */
+    void setupFastKernel();
+
+    bool m_bFastApply;                      /**< Use the single precision kernel */
+    bool m_bFastCombineXyz;                 /**< Whether the fast kernel holds three orientation blocks */
+    MatrixXf m_matKernelFast;               /**< Single precision imaging kernel, noise normalized and orientation blocked */
+    VectorXi m_vecSourceSel;                /**< Selected sources of the fast apply mode, empty for all */
+    VectorXi m_vecVerticesFast;             /**< Vertices of the rows of the fast apply result */
+
 };
 
 //*************************************************************************************************************
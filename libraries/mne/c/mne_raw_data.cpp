@@ -40,6 +40,9 @@
 
 #include "mne_raw_data.h"
 
+#include <fiff/fiff_raw_buffer_cache.h>
+#include <fiff/fiff_raw_read_plan.h>
+
 #include <QFile>
 
 #include <Eigen/Core>
@@ -1177,6 +1180,41 @@ int MneRawData::load_one_buffer(MneRawData *data, MneRawBufDef *buf)
     fprintf(stderr,"Read buffer %d .. %d\n",buf->firsts,buf->lasts);
 #endif
 
+    /*
+     * Decoded buffers are shared with FiffRawData through the buffer cache
+     */
+    FiffRawBufferCache::SPtr cache = FiffRawBufferCache::globalCache();
+    if (cache->isEnabled()) {
+        RowVectorXd cals(buf->nchan);
+        for (int c = 0; c < buf->nchan; c++)
+            cals[c] = data->info->chInfo[c].range*data->info->chInfo[c].cal;
+
+        FiffRawBufferCache::Source source = FiffRawBufferCache::source(data->filename,cals);
+        FiffRawBufferCache::BufferPtr decoded = cache->find(source,buf->ent->pos);
+
+        if (!decoded) {
+            FiffTag::SPtr t_pTag;
+            QSharedPointer<MatrixXd> t_pDecoded(new MatrixXd);
+
+            if (!data->stream->read_tag(t_pTag,buf->ent->pos) ||
+                    !FiffRawReadPlan::decode((const uchar*)t_pTag->data(),t_pTag->type,t_pTag->size(),buf->ns,false,cals,*t_pDecoded)) {
+                printf("Cannot decode raw data buffer at %d.",buf->ent->pos);
+                buf->valid = FALSE;
+                return FAIL;
+            }
+            cache->insert(source,buf->ent->pos,t_pDecoded);
+            decoded = t_pDecoded;
+        }
+
+        for (int c = 0; c < buf->nchan; c++)
+            for (int s = 0; s < buf->ns; s++)
+                buf->vals[c][s] = (*decoded)(c,s);
+
+        buf->valid       = TRUE;
+        buf->comp_status = data->comp_file;
+        return OK;
+    }
+
     if (mne_read_raw_buffer_t(data->stream,
                               buf->ent,
                               buf->vals,
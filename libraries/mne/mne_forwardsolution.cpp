@@ -941,7 +941,7 @@ FiffCov MNEForwardSolution::compute_depth_prior(const MatrixXd &Gain, const Fiff
 
 //*************************************************************************************************************
 
-FiffCov MNEForwardSolution::compute_orient_prior(float loose)
+FiffCov MNEForwardSolution::compute_orient_prior(float loose) const
 {
     bool is_fixed_ori = this->isFixedOrient();
     qint32 n_sources = this->sol->data.cols();
@@ -1120,7 +1120,7 @@ MNEForwardSolution MNEForwardSolution::pick_types(bool meg, bool eeg, const QStr
 
 //*************************************************************************************************************
 
-void MNEForwardSolution::prepare_forward(const FiffInfo &p_info, const FiffCov &p_noise_cov, bool p_pca, FiffInfo &p_outFwdInfo, MatrixXd &gain, FiffCov &p_outNoiseCov, MatrixXd &p_outWhitener, qint32 &p_outNumNonZero) const
+void MNEForwardSolution::prepare_forward(const FiffInfo &p_info, const FiffCov &p_noise_cov, bool p_pca, FiffInfo &p_outFwdInfo, MatrixXd &gain, FiffCov &p_outNoiseCov, MatrixXd &p_outWhitener, qint32 &p_outNumNonZero, bool p_bReuseGain) const
 {
     QStringList fwd_ch_names, ch_names;
     for(qint32 i = 0; i < this->info.chs.size(); ++i)
@@ -1200,9 +1200,17 @@ void MNEForwardSolution::prepare_forward(const FiffInfo &p_info, const FiffCov &
     fwd_idx.conservativeResize(count_fwd_idx);
     info_idx.conservativeResize(count_info_idx);
 
-    gain.resize(count_fwd_idx, this->sol->data.cols());
-    for(qint32 i = 0; i < count_fwd_idx; ++i)
-        gain.row(i) = this->sol->data.row(fwd_idx[i]);
+    //   The gain only depends on the selected channels
+    if(p_bReuseGain && p_outFwdInfo.ch_names == ch_names && gain.rows() == count_fwd_idx && gain.cols() == this->sol->data.cols())
+    {
+        printf("\tReusing the gain matrix of the previous call.\n");
+    }
+    else
+    {
+        gain.resize(count_fwd_idx, this->sol->data.cols());
+        for(qint32 i = 0; i < count_fwd_idx; ++i)
+            gain.row(i) = this->sol->data.row(fwd_idx[i]);
+    }
 
     p_outFwdInfo = p_info.pick_info(info_idx);
 
@@ -270,7 +270,7 @@ public:
     *
     * @return Orientation priors.
     */
-    FiffCov compute_orient_prior(float loose = 0.2);
+    FiffCov compute_orient_prior(float loose = 0.2) const;
 
     //=========================================================================================================
     /**
@@ -362,8 +362,9 @@ public:
     * @param[out] p_outNoiseCov     noise covariance matrix
     * @param[out] p_outWhitener     Whitener
     * @param[out] p_outNumNonZero   the rank (non zeros)
+    * @param[in] p_bReuseGain       If true and p_outFwdInfo and gain hold the result of a previous call for this forward solution and the same selected channels, the gain matrix is not picked again.
     */
-    void prepare_forward(const FiffInfo &p_info, const FiffCov &p_noise_cov, bool p_pca, FiffInfo &p_outFwdInfo, MatrixXd &gain, FiffCov &p_outNoiseCov, MatrixXd &p_outWhitener, qint32 &p_outNumNonZero) const;
+    void prepare_forward(const FiffInfo &p_info, const FiffCov &p_noise_cov, bool p_pca, FiffInfo &p_outFwdInfo, MatrixXd &gain, FiffCov &p_outNoiseCov, MatrixXd &p_outWhitener, qint32 &p_outNumNonZero, bool p_bReuseGain = false) const;
 
 //    //=========================================================================================================
 //    /**
@@ -686,8 +686,21 @@ MatrixXd MNEInverseOperator::cluster_kernel(const AnnotationSet &p_AnnotationSet
 
 //*************************************************************************************************************
 
-MNEInverseOperator MNEInverseOperator::make_inverse_operator(const FiffInfo &info, MNEForwardSolution forward, const FiffCov &p_noise_cov, float loose, float depth, bool fixed, bool limit_depth_chs)
+MNEInverseOperator MNEInverseOperator::make_inverse_operator(const FiffInfo &info, const MNEForwardSolution &forward, const FiffCov &p_noise_cov, float loose, float depth, bool fixed, bool limit_depth_chs)
 {
+    PreparedForward t_prepared;
+    return make_inverse_operator(info, forward, p_noise_cov, t_prepared, loose, depth, fixed, limit_depth_chs);
+}
+
+
+//*************************************************************************************************************
+
+MNEInverseOperator MNEInverseOperator::make_inverse_operator(const FiffInfo &info, const MNEForwardSolution &forward, const FiffCov &p_noise_cov, PreparedForward &p_prepared, float loose, float depth, bool fixed, bool limit_depth_chs)
+{
+    //The forward solution is only copied when it has to be converted to fixed orientation
+    const MNEForwardSolution* t_pForward = &forward;
+    MNEForwardSolution t_forwardFixed;
+
     bool is_fixed_ori = forward.isFixedOrient();
     MNEInverseOperator p_MNEInverseOperator;
 
@@ -737,7 +750,15 @@ MNEInverseOperator MNEInverseOperator::make_inverse_operator(const FiffInfo &inf
     MatrixXd whitener;
     qint32 n_nzero;
     FiffCov p_outNoiseCov;
-    forward.prepare_forward(info, p_noise_cov, false, gain_info, gain, p_outNoiseCov, whitener, n_nzero);
+    QStringList t_prevChs = p_prepared.gain_info.ch_names;
+    forward.prepare_forward(info, p_noise_cov, false, p_prepared.gain_info, p_prepared.gain, p_outNoiseCov, whitener, n_nzero, true);
+    gain_info = p_prepared.gain_info;
+
+    //The gain is only copied when it is whitened
+    const MatrixXd* t_pGain = &p_prepared.gain;
+
+    if(t_prevChs != gain_info.ch_names || p_prepared.depth != depth || p_prepared.limit_depth_chs != limit_depth_chs)
+        p_prepared.depth_prior = FiffCov::SDPtr();
 
     //
     // 5. Compose the depth weight matrix
@@ -746,16 +767,27 @@ MNEInverseOperator MNEInverseOperator::make_inverse_operator(const FiffInfo &inf
     MatrixXd patch_areas;
     if(depth > 0)
     {
-        std::cout << "ToDo: patch_areas" << std::endl;
-//        patch_areas = forward.get('patch_areas', None)
-        p_depth_prior = FiffCov::SDPtr(new FiffCov(MNEForwardSolution::compute_depth_prior(gain, gain_info, is_fixed_ori, depth, 10.0, patch_areas, limit_depth_chs)));
+        if(p_prepared.depth_prior.constData())
+        {
+            printf("\tReusing the depth prior of the previous inverse operator.\n");
+            p_depth_prior = p_prepared.depth_prior;
+        }
+        else
+        {
+            std::cout << "ToDo: patch_areas" << std::endl;
+//            patch_areas = forward.get('patch_areas', None)
+            p_depth_prior = FiffCov::SDPtr(new FiffCov(MNEForwardSolution::compute_depth_prior(*t_pGain, gain_info, is_fixed_ori, depth, 10.0, patch_areas, limit_depth_chs)));
+            p_prepared.depth_prior = p_depth_prior;
+            p_prepared.depth = depth;
+            p_prepared.limit_depth_chs = limit_depth_chs;
+        }
     }
     else
     {
-        p_depth_prior->data = MatrixXd::Ones(gain.cols(), gain.cols());
+        p_depth_prior->data = MatrixXd::Ones(t_pGain->cols(), t_pGain->cols());
         p_depth_prior->kind = FIFFV_MNE_DEPTH_PRIOR_COV;
         p_depth_prior->diag = true;
-        p_depth_prior->dim = gain.cols();
+        p_depth_prior->dim = t_pGain->cols();
         p_depth_prior->nfree = 1;
     }
 
@@ -779,9 +811,12 @@ MNEInverseOperator MNEInverseOperator::make_inverse_operator(const FiffInfo &inf
             p_depth_prior->data.conservativeResize(count, 1);
 
 //            forward = deepcopy(forward)
-            forward.to_fixed_ori();
-            is_fixed_ori = forward.isFixedOrient();
-            forward.prepare_forward(info, p_outNoiseCov, false, gain_info, gain, p_outNoiseCov, whitener, n_nzero);
+            t_forwardFixed = forward;
+            t_forwardFixed.to_fixed_ori();
+            t_pForward = &t_forwardFixed;
+            is_fixed_ori = t_forwardFixed.isFixedOrient();
+            t_forwardFixed.prepare_forward(info, p_outNoiseCov, false, gain_info, gain, p_outNoiseCov, whitener, n_nzero);
+            t_pGain = &gain;
         }
     }
     printf("\tComputing inverse operator with %d channels.\n", gain_info.ch_names.size());
@@ -796,7 +831,7 @@ MNEInverseOperator MNEInverseOperator::make_inverse_operator(const FiffInfo &inf
     FiffCov::SDPtr p_orient_prior;
     if(!is_fixed_ori)
     {
-        p_orient_prior = FiffCov::SDPtr(new FiffCov(forward.compute_orient_prior(loose)));
+        p_orient_prior = FiffCov::SDPtr(new FiffCov(t_pForward->compute_orient_prior(loose)));
         p_source_cov->data.array() *= p_orient_prior->data.array();
     }
 
@@ -807,7 +842,7 @@ MNEInverseOperator MNEInverseOperator::make_inverse_operator(const FiffInfo &inf
     // 9. Apply whitening to the forward computation matrix
     //
     printf("\tWhitening the forward solution.\n");
-    gain = whitener*gain;
+    gain = whitener*(*t_pGain);
 
     // 10. Exclude the source space points within the labels (not done)
 
@@ -909,14 +944,14 @@ MNEInverseOperator MNEInverseOperator::make_inverse_operator(const FiffInfo &inf
     p_MNEInverseOperator.orient_prior = p_orient_prior;
     p_MNEInverseOperator.projs = info.projs;
     p_MNEInverseOperator.eigen_leads_weighted = false;
-    p_MNEInverseOperator.source_ori = forward.source_ori;
-    p_MNEInverseOperator.mri_head_t = forward.mri_head_t;
+    p_MNEInverseOperator.source_ori = t_pForward->source_ori;
+    p_MNEInverseOperator.mri_head_t = t_pForward->mri_head_t;
     p_MNEInverseOperator.methods = p_iMethods;
-    p_MNEInverseOperator.nsource = forward.nsource;
-    p_MNEInverseOperator.coord_frame = forward.coord_frame;
-    p_MNEInverseOperator.source_nn = forward.source_nn;
-    p_MNEInverseOperator.src = forward.src;
-    p_MNEInverseOperator.info = forward.info;
+    p_MNEInverseOperator.nsource = t_pForward->nsource;
+    p_MNEInverseOperator.coord_frame = t_pForward->coord_frame;
+    p_MNEInverseOperator.source_nn = t_pForward->source_nn;
+    p_MNEInverseOperator.src = t_pForward->src;
+    p_MNEInverseOperator.info = t_pForward->info;
     p_MNEInverseOperator.info.bads = info.bads;
 
     return p_MNEInverseOperator;
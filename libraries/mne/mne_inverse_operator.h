@@ -157,6 +157,27 @@ struct RegionMT
 };
 
 
+//=========================================================================================================
+/**
+* Noise covariance independent parts of an inverse operator. They are reused by make_inverse_operator when the
+* inverse operator of the same forward solution is rebuilt for new noise covariances.
+*/
+struct PreparedForward
+{
+    FiffInfo        gain_info;          /**< Info of the channels the gain matrix was picked for */
+    MatrixXd        gain;               /**< Gain matrix of these channels, not whitened */
+    FiffCov::SDPtr  depth_prior;        /**< Depth prior computed from the gain matrix */
+    float           depth;              /**< Depth weighting the prior was computed with */
+    bool            limit_depth_chs;    /**< Whether the prior was computed with limit_depth_chs */
+
+    PreparedForward()
+    : depth(0.0f)
+    , limit_depth_chs(false)
+    {
+    }
+};
+
+
 //=============================================================================================================
 /**
 * Inverse operator
@@ -291,7 +312,27 @@ public:
     *
     * @return the assembled inverse operator
     */
-    static MNEInverseOperator make_inverse_operator(const FiffInfo &info, MNEForwardSolution forward, const FiffCov& p_noise_cov, float loose = 0.2f, float depth = 0.8f, bool fixed = false, bool limit_depth_chs = true);
+    static MNEInverseOperator make_inverse_operator(const FiffInfo &info, const MNEForwardSolution &forward, const FiffCov& p_noise_cov, float loose = 0.2f, float depth = 0.8f, bool fixed = false, bool limit_depth_chs = true);
+
+    //=========================================================================================================
+    /**
+    * Assembles the inverse operator and reuses the noise covariance independent parts of a previous call. The gain
+    * matrix and the depth prior only depend on the noise covariance through the selected channels. They are
+    * recomputed, and p_prepared updated, whenever the selected channels, depth or limit_depth_chs change. Use this
+    * when the inverse operator of the same forward solution is repeatedly rebuilt for new noise covariances.
+    *
+    * @param[in] info                   The measurement info to specify the channels to include. Bad channels in info['bads'] are not used.
+    * @param[in] forward                Forward operator, must be the same for all calls with the same p_prepared.
+    * @param[in] p_noise_cov            The noise covariance matrix.
+    * @param[in, out] p_prepared        The parts of the previous call; default constructed on the first call.
+    * @param[in] loose                  float in [0, 1]. Value that weights the source variances of the dipole components defining the tangent space of the cortical surfaces.
+    * @param[in] depth                  float in [0, 1]. Depth weighting coefficients. If None, no depth weighting is performed.
+    * @param[in] fixed                  Use fixed source orientations normal to the cortical mantle. If True, the loose parameter is ignored.
+    * @param[in] limit_depth_chs        If True, use only grad channels in depth weighting (equivalent to MNE C code). If grad chanels aren't present, only mag channels will be used (if no mag, then eeg). If False, use all channels.
+    *
+    * @return the assembled inverse operator
+    */
+    static MNEInverseOperator make_inverse_operator(const FiffInfo &info, const MNEForwardSolution &forward, const FiffCov& p_noise_cov, PreparedForward &p_prepared, float loose = 0.2f, float depth = 0.8f, bool fixed = false, bool limit_depth_chs = true);
 
     //=========================================================================================================
     /**
@@ -57,7 +57,6 @@
 #include <QMutexLocker>
 #include <QDebug>
 #include <QElapsedTimer>
-#include <QtConcurrent/QtConcurrent>
 
 
 //*************************************************************************************************************
@@ -78,15 +77,6 @@ using namespace UTILSLIB;
 using namespace Eigen;
 
 
-//*************************************************************************************************************
-//=============================================================================================================
-// DEFINE GLOABAL MEMBER METHODS
-//=============================================================================================================
-
-int             m_dValueVariance = 0.5;           /**< Variance value to detect artifacts */
-double          m_dValueThreshold = 300e-6;          /**< Threshold to detect artifacts */
-
-
 //*************************************************************************************************************
 //=============================================================================================================
 // DEFINE MEMBER METHODS
@@ -117,6 +107,8 @@ RtAve::RtAve(quint32 numAverages,
 , m_pStimEvokedSet(FiffEvokedSet::SPtr(new FiffEvokedSet))
 , m_bActivateThreshold(false)
 , m_bActivateVariance(false)
+, m_dValueVariance(0.5)
+, m_dValueThreshold(300e-6)
 {
     qRegisterMetaType<FIFFLIB::FiffEvokedSet::SPtr>("FIFFLIB::FiffEvokedSet::SPtr");
 
@@ -334,7 +326,13 @@ void RtAve::doAveraging(const MatrixXd& rawSegment)
     //QElapsedTimer time;
     //time.start();
 
-    QList<QPair<int,double> > lDetectedTriggers = DetectTrigger::detectTriggerFlanksMax(rawSegment, m_iTriggerChIndex, 0, m_fTriggerThreshold, true);
+    //Each trigger onset is reported exactly once, also if it lies on a block boundary. The conditions are keyed by the raw trigger value, as before.
+    const QVector<DetectTrigger::TriggerEvent>& vTriggerEvents = m_triggerDetector.detectTriggerEvents(rawSegment);
+
+    QList<QPair<int,double> > lDetectedTriggers;
+    for(int i = 0; i < vTriggerEvents.size(); ++i) {
+        lDetectedTriggers.append(QPair<int,double>(vTriggerEvents.at(i).iBlockSample, vTriggerEvents.at(i).dValue));
+    }
 
     //qDebug()<<"RtAve::doAveraging() - time for detection"<<time.elapsed();
     //time.start();
@@ -386,7 +384,7 @@ void RtAve::doAveraging(const MatrixXd& rawSegment)
                 generateEvoked(dTriggerType);
 
                 //If number of averages was reached emit new average
-                if(m_mapStimAve[dTriggerType].size() > 0) {
+                if(m_mapStimAve[dTriggerType].iCount > 0) {
                     emit evokedStim(m_pStimEvokedSet);
                 }
 
@@ -394,7 +392,7 @@ void RtAve::doAveraging(const MatrixXd& rawSegment)
 
                 //qDebug()<<"RtAve::run() - Number of calculated averages:" << m_iNumberCalcAverages[dTriggerType];
                 //qDebug()<<"RtAve::run() - dTriggerType:" << dTriggerType;
-                //qDebug()<<"RtAve::run() - m_mapStimAve[dTriggerType].size():" << m_mapStimAve[dTriggerType].size();
+                //qDebug()<<"RtAve::run() - m_mapStimAve[dTriggerType].iCount:" << m_mapStimAve[dTriggerType].iCount;
             } else {
                 //qDebug()<<"4";
                 fillBackBuffer(rawSegment, dTriggerType);
@@ -508,25 +506,52 @@ void RtAve::mergeData(double dTriggerType)
 {
     QMutexLocker locker(&m_qMutex);
 
-    MatrixXd mergedData(m_mapDataPre[dTriggerType].rows(), m_mapDataPre[dTriggerType].cols() + m_mapDataPost[dTriggerType].cols());
+    int iRows = m_mapDataPre[dTriggerType].rows();
+    int iCols = m_mapDataPre[dTriggerType].cols() + m_mapDataPost[dTriggerType].cols();
 
-    mergedData << m_mapDataPre[dTriggerType], m_mapDataPost[dTriggerType];
+    //m_matEpoch keeps its memory, it is swapped with the oldest epoch of the ring
+    m_matEpoch.resize(iRows, iCols);
+    m_matEpoch << m_mapDataPre[dTriggerType], m_mapDataPost[dTriggerType];
 
     //Perform artifact threshold
-    bool bArtifactedDetected = checkForArtifact(mergedData);
+    if(checkForArtifact(m_matEpoch)) {
+        return;
+    }
 
-    if(bArtifactedDetected == false) {
-        //Add cut data to average buffer
-        m_mapStimAve[dTriggerType].append(mergedData);
+    //If zero averages are used only the last epoch is kept
+    int iCapacity = m_iNumAverages >= 1 ? m_iNumAverages : 1;
 
-        //Pop data from buffer
-        if(m_mapStimAve[dTriggerType].size() > m_iNumAverages && m_iNumAverages >= 1) {
-            m_mapStimAve[dTriggerType].pop_front();
-        }
+    EpochRing& ring = m_mapStimAve[dTriggerType];
+
+    if(ring.vEpochs.size() != iCapacity || ring.matSum.rows() != iRows || ring.matSum.cols() != iCols) {
+        ring.vEpochs.fill(MatrixXd::Zero(iRows, iCols), iCapacity);
+        ring.matSum = MatrixXd::Zero(iRows, iCols);
+        ring.matSumSq = MatrixXd::Zero(iRows, iCols);
+        ring.iHead = 0;
+        ring.iCount = 0;
+    }
+
+    //Remove the oldest epoch from the sums if the ring is full and add the new one
+    if(ring.iCount == iCapacity) {
+        ring.matSum -= ring.vEpochs[ring.iHead];
+        ring.matSumSq -= ring.vEpochs[ring.iHead].cwiseAbs2();
+    } else {
+        ring.iCount++;
+    }
+
+    ring.vEpochs[ring.iHead].swap(m_matEpoch);
+    ring.matSum += ring.vEpochs[ring.iHead];
+    ring.matSumSq += ring.vEpochs[ring.iHead].cwiseAbs2();
+
+    ring.iHead = (ring.iHead + 1) % iCapacity;
 
-        //Proceed a bit different if we use zero number of averages
-        if(m_mapStimAve[dTriggerType].size() > 1 && m_iNumAverages == 0) {
-            m_mapStimAve[dTriggerType].pop_front();
+    //Re-sum once per revolution so that rounding errors of the running sums do not accumulate
+    if(ring.iHead == 0 && ring.iCount == iCapacity) {
+        ring.matSum = ring.vEpochs[0];
+        ring.matSumSq = ring.vEpochs[0].cwiseAbs2();
+        for(int i = 1; i < iCapacity; ++i) {
+            ring.matSum += ring.vEpochs[i];
+            ring.matSumSq += ring.vEpochs[i].cwiseAbs2();
         }
     }
 }
@@ -534,99 +559,96 @@ void RtAve::mergeData(double dTriggerType)
 
 //*************************************************************************************************************
 
-void checkChVariance(QPair<bool, RowVectorXd>& pairData)
+MatrixXd RtAve::ringVariance(const EpochRing& ring) const
 {
-    RowVectorXd temp = pairData.second;
+    if(ring.iCount < 2) {
+        return MatrixXd::Zero(ring.matSum.rows(), ring.matSum.cols());
+    }
 
-    double dMedian = temp.norm() / temp.cols();
+    //Unbiased variance from the running sums, rounding may leave tiny negative values
+    MatrixXd matVar = (ring.matSumSq - ring.matSum.cwiseAbs2() / ring.iCount) / (ring.iCount - 1);
 
-    temp = temp.array() - dMedian;
-    temp.array().square();
+    return matVar.cwiseMax(0.0);
+}
 
-//    qDebug() << "RtAve::checkForArtifact - dMedian" << abs(dMedian);
-//    qDebug() << "RtAve::checkForArtifact - m_iValueVariance * dMedian" << m_iValueVariance * abs(dMedian);
-//    qDebug() << "RtAve::checkForArtifact - compare value " << abs(pairData.second.norm() / pairData.second.cols());
 
-    //If variance is 3 times bigger than median -> reject
-    if(temp.norm() / temp.cols() > (m_dValueVariance * std::fabs(dMedian))) {
-        pairData.first = true;
-    } else {
-        pairData.first = false;
+//*************************************************************************************************************
+
+MatrixXd RtAve::variance(double dTriggerType)
+{
+    QMutexLocker locker(&m_qMutex);
+
+    if(!m_mapStimAve.contains(dTriggerType)) {
+        return MatrixXd();
     }
-}
 
+    return ringVariance(m_mapStimAve[dTriggerType]);
+}
 
 
 //*************************************************************************************************************
 
-void checkChThreshold(QPair<bool, RowVectorXd>& pairData)
+VectorXd RtAve::snr(double dTriggerType)
 {
-    RowVectorXd temp = pairData.second;
+    QMutexLocker locker(&m_qMutex);
 
-    temp = temp.array() - temp(0);
+    if(!m_mapStimAve.contains(dTriggerType) || m_mapStimAve[dTriggerType].iCount == 0) {
+        return VectorXd();
+    }
 
-    double min = temp.minCoeff();
-    double max = temp.maxCoeff();
+    const EpochRing& ring = m_mapStimAve[dTriggerType];
 
-//    qDebug() << "RtAve::checkForArtifact - min" << min;
-//    qDebug() << "RtAve::checkForArtifact - max" << max;
-//    qDebug() << "RtAve::checkForArtifact - m_dValueThreshold" << m_dValueThreshold;
+    //Power of the average and of its noise, i.e. the variance of the mean of iCount epochs
+    VectorXd vecSignal = (ring.matSum / ring.iCount).cwiseAbs2().rowwise().sum();
+    VectorXd vecNoise = ringVariance(ring).rowwise().sum() / ring.iCount;
 
-    //If absolute vaue of min or max if bigger than threshold -> reject
-    if((std::fabs(min) > m_dValueThreshold) || (std::fabs(max) > m_dValueThreshold)) {
-        pairData.first = true;
-    } else {
-        pairData.first = false;
+    VectorXd vecSnr = VectorXd::Zero(vecSignal.size());
+    for(int i = 0; i < vecSnr.size(); ++i) {
+        if(vecNoise(i) > 0.0) {
+            vecSnr(i) = vecSignal(i) / vecNoise(i);
+        }
     }
+
+    return vecSnr;
 }
 
 
 //*************************************************************************************************************
 
-bool RtAve::checkForArtifact(MatrixXd& data)
+bool RtAve::checkForArtifact(const MatrixXd& data)
 {
     bool bReject = false;
 
-    if(m_bActivateThreshold || m_bActivateVariance) {
-        //Prepare concurrent data handling
-        QList<QPair<bool, RowVectorXd> > lchData;
-
-        for(int i = 0; i < m_pFiffInfo->chs.size(); ++i) {
-            if((m_pFiffInfo->chs.at(i).kind == FIFFV_MEG_CH || m_pFiffInfo->chs.at(i).kind == FIFFV_EEG_CH)
-                    && !m_pFiffInfo->bads.contains(m_pFiffInfo->chs.at(i).ch_name) && m_pFiffInfo->chs.at(i).chpos.coil_type != FIFFV_COIL_BABY_REF_MAG
-                    && m_pFiffInfo->chs.at(i).chpos.coil_type != FIFFV_COIL_BABY_REF_MAG2) {
-                QPair<bool, RowVectorXd> pair;
-                pair.first = false;
-                pair.second = data.row(i);
-                lchData.append(pair);
-            }
-        }
-
-        //qDebug() << "RtAve::checkForArtifact - lchData.size()" << lchData.size();
+    //Channels can be marked bad while averaging is running
+    if(m_lArtifactChBads != m_pFiffInfo->bads) {
+        updateArtifactChannels();
+    }
 
+    if((m_bActivateThreshold || m_bActivateVariance) && data.cols() > 0) {
         if(m_bActivateVariance) {
-            //Start the concurrent processing
-            QFuture<void> future = QtConcurrent::map(lchData, checkChVariance);
-            future.waitForFinished();
+            //Deviation of each channel from its mean absolute level
+            VectorXd vecLevel = data.rowwise().norm() / data.cols();
+            VectorXd vecDeviation = (data.colwise() - vecLevel).rowwise().norm() / data.cols();
 
-            for(int i = 0; i < lchData.size(); ++i) {
-                if(lchData.at(i).first) {
+            for(int i = 0; i < m_vecArtifactChIdx.size(); ++i) {
+                int iChIdx = m_vecArtifactChIdx(i);
+
+                //If variance is m_dValueVariance times bigger than median -> reject
+                if(vecDeviation(iChIdx) > m_dValueVariance * std::fabs(vecLevel(iChIdx))) {
                     bReject = true;
-                    qDebug() << "RtAve::checkForArtifact - Reject trial";
                     break;
                 }
             }
         }
 
         if(m_bActivateThreshold && !bReject) {
-            //Start the concurrent processing
-            QFuture<void> future = QtConcurrent::map(lchData, checkChThreshold);
-            future.waitForFinished();
+            //Peak deviation of each channel from its first sample
+            VectorXd vecPeak = (data.colwise() - data.col(0)).cwiseAbs().rowwise().maxCoeff();
 
-            for(int i = 0; i < lchData.size(); ++i) {
-                if(lchData.at(i).first) {
+            for(int i = 0; i < m_vecArtifactChIdx.size(); ++i) {
+                //If absolute vaue of min or max if bigger than threshold -> reject
+                if(vecPeak(m_vecArtifactChIdx(i)) > m_dValueThreshold) {
                     bReject = true;
-                    qDebug() << "RtAve::checkForArtifact - Reject trial";
                     break;
                 }
             }
@@ -647,7 +669,9 @@ void RtAve::generateEvoked(double dTriggerType)
 {
     QMutexLocker locker(&m_qMutex);
 
-    if(m_mapStimAve[dTriggerType].isEmpty()) {
+    const EpochRing& ring = m_mapStimAve[dTriggerType];
+
+    if(ring.iCount == 0) {
         return;
     }
 
@@ -679,18 +703,8 @@ void RtAve::generateEvoked(double dTriggerType)
     }
 
     // Generate final evoked
-    MatrixXd finalAverage = MatrixXd::Zero(m_mapStimAve[dTriggerType].first().rows(), m_iPreStimSamples+m_iPostStimSamples);
-
     if(m_iAverageMode == 0) {
-        for(int i = 0; i < m_mapStimAve[dTriggerType].size(); ++i) {
-            finalAverage += m_mapStimAve[dTriggerType].at(i);
-        }
-
-        if(m_mapStimAve[dTriggerType].isEmpty()) {
-            finalAverage = finalAverage/1;
-        } else {
-            finalAverage = finalAverage/m_mapStimAve[dTriggerType].size();
-        }
+        MatrixXd finalAverage = ring.matSum / ring.iCount;
 
         if(m_bDoBaselineCorrection) {
             finalAverage = MNEMath::rescale(finalAverage, evoked.times, m_pairBaselineSec, QString("mean"));
@@ -704,7 +718,7 @@ void RtAve::generateEvoked(double dTriggerType)
 
         evoked.nave = m_mapNumberCalcAverages[dTriggerType];
     } else if(m_iAverageMode == 1) {
-        MatrixXd tempMatrix = m_mapStimAve[dTriggerType].last();
+        MatrixXd tempMatrix = ring.vEpochs.at((ring.iHead + ring.vEpochs.size() - 1) % ring.vEpochs.size());
 
         if(m_bDoBaselineCorrection) {
             tempMatrix = MNEMath::rescale(tempMatrix, evoked.times, m_pairBaselineSec, QString("mean"));
@@ -726,6 +740,28 @@ void RtAve::generateEvoked(double dTriggerType)
 }
 
 
+//*************************************************************************************************************
+
+void RtAve::updateArtifactChannels()
+{
+    m_lArtifactChBads = m_pFiffInfo->bads;
+
+    QList<int> lArtifactChIdx;
+    for(int i = 0; i < m_pFiffInfo->chs.size(); ++i) {
+        if((m_pFiffInfo->chs.at(i).kind == FIFFV_MEG_CH || m_pFiffInfo->chs.at(i).kind == FIFFV_EEG_CH)
+                && !m_pFiffInfo->bads.contains(m_pFiffInfo->chs.at(i).ch_name) && m_pFiffInfo->chs.at(i).chpos.coil_type != FIFFV_COIL_BABY_REF_MAG
+                && m_pFiffInfo->chs.at(i).chpos.coil_type != FIFFV_COIL_BABY_REF_MAG2) {
+            lArtifactChIdx.append(i);
+        }
+    }
+
+    m_vecArtifactChIdx.resize(lArtifactChIdx.size());
+    for(int i = 0; i < lArtifactChIdx.size(); ++i) {
+        m_vecArtifactChIdx(i) = lArtifactChIdx.at(i);
+    }
+}
+
+
 //*************************************************************************************************************
 
 void RtAve::reset()
@@ -742,6 +778,13 @@ void RtAve::reset()
     m_iAverageMode = m_iNewAverageMode;
     m_iNumAverages = m_iNewNumAverages;
 
+    //Channels which are checked for artifacts
+    updateArtifactChannels();
+
+    //The threshold is applied relative to the resting level of the trigger channel, as the block wise offset removal did before.
+    //Analog trigger channels ramp through several codes, pulses within the former burst length of 100 samples count as one trigger.
+    m_triggerDetector.setTriggerChannels(QList<int>() << m_iTriggerChIndex, m_fTriggerThreshold, -1, DetectTrigger::Rising, 1, true, 100);
+
     qDebug()<<"RtAve::reset() - 2";
 
     //Clear all evoked data information
@@ -48,6 +48,7 @@
 #include <fiff/fiff_info.h>
 
 #include <utils/generics/circularmatrixbuffer.h>
+#include <utils/detecttrigger.h>
 
 
 //*************************************************************************************************************
@@ -58,6 +59,7 @@
 #include <QThread>
 #include <QMutex>
 #include <QSharedPointer>
+#include <QVector>
 
 
 //*************************************************************************************************************
@@ -245,6 +247,28 @@ public:
     */
     void reset();
 
+    //=========================================================================================================
+    /**
+    * Returns the variance of the epochs which form the current running average of a trigger type, before the
+    * baseline correction. It is computed from the running sums of the epoch ring.
+    *
+    * @param[in] dTriggerType   The trigger type, i.e. the comment of the evoked.
+    *
+    * @return the variance of each channel and sample. Zero if less than two epochs were averaged.
+    */
+    Eigen::MatrixXd variance(double dTriggerType);
+
+    //=========================================================================================================
+    /**
+    * Returns the signal to noise ratio of each channel of the current running average of a trigger type, i.e. the
+    * power of the average divided by the power of its noise, which is the epoch variance over the number of epochs.
+    *
+    * @param[in] dTriggerType   The trigger type, i.e. the comment of the evoked.
+    *
+    * @return the signal to noise ratio of each channel. Zero where no noise can be estimated.
+    */
+    Eigen::VectorXd snr(double dTriggerType);
+
 protected:
     //=========================================================================================================
     /**
@@ -287,13 +311,21 @@ private:
 
     //=========================================================================================================
     /**
-    * Checks the givven matrix for artifacts beyond a threshold value.
+    * Checks the givven matrix for artifacts beyond a threshold value. All channels are checked in one pass over
+    * the epoch, only the channels selected by updateArtifactChannels() decide about the rejection.
     *
     * @param[in] data           The data matrix.
     *
     * @return   Whether a thresold artifact was detected.
     */
-    bool checkForArtifact(Eigen::MatrixXd& data);
+    bool checkForArtifact(const Eigen::MatrixXd& data);
+
+    //=========================================================================================================
+    /**
+    * Selects the good MEG and EEG channels which are checked for artifacts. Needs to be called again whenever
+    * the bad channels of the measurement info change.
+    */
+    void updateArtifactChannels();
 
     //=========================================================================================================
     /**
@@ -313,6 +345,32 @@ private:
     */
     inline bool controlValuesChanged();
 
+    //=========================================================================================================
+    /**
+    * The accepted epochs of one trigger type. The epochs are kept in a preallocated ring and their sum and sum of
+    * squares are updated incrementally, so the moving average and variance do not need to be recomputed from the
+    * stored epochs.
+    */
+    struct EpochRing {
+        EpochRing() : iHead(0), iCount(0) {}
+
+        QVector<Eigen::MatrixXd>    vEpochs;        /**< The preallocated epochs. */
+        Eigen::MatrixXd             matSum;         /**< Sum of the epochs currently in the ring. */
+        Eigen::MatrixXd             matSumSq;       /**< Sum of the squared epochs currently in the ring. */
+        int                         iHead;          /**< Index of the next epoch to be written, i.e. the oldest one if the ring is full. */
+        int                         iCount;         /**< Number of epochs in the ring. */
+    };
+
+    //=========================================================================================================
+    /**
+    * Computes the variance of the epochs in a ring. The caller has to hold m_qMutex.
+    *
+    * @param[in] ring   The epoch ring.
+    *
+    * @return the variance of each channel and sample.
+    */
+    Eigen::MatrixXd ringVariance(const EpochRing& ring) const;
+
     QMutex                                          m_qMutex;                   /**< Provides access serialization between threads*/
 
     qint32                                          m_iNumAverages;             /**< Number of averages */
@@ -331,6 +389,7 @@ private:
     qint32                                          m_iNewTriggerIndex;         /**< Old row index of the data matrix which is to be scanned for triggers */
 
     float                                           m_fTriggerThreshold;        /**< Threshold to detect trigger */
+    UTILSLIB::DetectTrigger                         m_triggerDetector;          /**< Streaming trigger detector, keeps the trigger state between data blocks. */
 
     bool                                            m_bActivateThreshold;       /**< Whether to do threshold artifact reduction or not. */
     bool                                            m_bActivateVariance;        /**< Whether to do variance artifact reduction or not. */
@@ -345,7 +404,12 @@ private:
     FIFFLIB::FiffEvokedSet::SPtr                    m_pStimEvokedSet;           /**< Holds the evoked information. */
 
     QMap<int,QList<int> >                           m_qMapDetectedTrigger;      /**< Detected trigger for each trigger channel. */
-    QMap<double,QList<Eigen::MatrixXd> >            m_mapStimAve;               /**< the current stimulus average buffer. Holds m_iNumAverages vectors */
+    QMap<double,EpochRing>                          m_mapStimAve;               /**< the current stimulus average buffer. Holds m_iNumAverages epochs */
+    Eigen::MatrixXd                                 m_matEpoch;                 /**< The merged epoch which is checked for artifacts before it is swapped into the ring. */
+    Eigen::VectorXi                                 m_vecArtifactChIdx;         /**< Rows of the channels which are checked for artifacts. */
+    QStringList                                     m_lArtifactChBads;          /**< The bad channels m_vecArtifactChIdx was selected with. */
+    double                                          m_dValueVariance;           /**< Variance value to detect artifacts */
+    double                                          m_dValueThreshold;          /**< Threshold to detect artifacts */
     QMap<double,Eigen::MatrixXd>                    m_mapDataPre;               /**< The matrix holding the pre stim data. */
     QMap<double,Eigen::MatrixXd>                    m_mapDataPost;              /**< The matrix holding the post stim data. */
     QMap<double,qint32>                             m_mapMatDataPostIdx;        /**< Current index inside of the matrix m_matDataPost */
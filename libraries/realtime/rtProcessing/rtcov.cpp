@@ -45,6 +45,8 @@
 #include <iostream>
 #include <fiff/fiff_cov.h>
 
+#include <cmath>
+
 
 //*************************************************************************************************************
 //=============================================================================================================
@@ -72,6 +74,13 @@ RtCov::RtCov(qint32 p_iMaxSamples, FiffInfo::SPtr p_pFiffInfo, QObject *parent)
 : QThread(parent)
 , m_iMaxSamples(p_iMaxSamples)
 , m_iNewMaxSamples(0)
+, m_eMode(Block)
+, m_eNewMode(Block)
+, m_iUpdateInterval(0)
+, m_dWeightSum(0.0)
+, m_dWeightSqSum(0.0)
+, m_iSamplesSeen(0)
+, m_iDowndatedSamples(0)
 , m_pFiffInfo(p_pFiffInfo)
 , m_bIsRunning(false)
 {
@@ -105,7 +114,29 @@ void RtCov::append(const MatrixXd &p_DataSegment)
 
 void RtCov::setSamples(qint32 samples)
 {
+    mutex.lock();
     m_iNewMaxSamples = samples;
+    mutex.unlock();
+}
+
+
+//*************************************************************************************************************
+
+void RtCov::setEstimationMode(EstimationMode mode)
+{
+    mutex.lock();
+    m_eNewMode = mode;
+    mutex.unlock();
+}
+
+
+//*************************************************************************************************************
+
+void RtCov::setUpdateInterval(qint32 samples)
+{
+    mutex.lock();
+    m_iUpdateInterval = samples > 0 ? samples : 0;
+    mutex.unlock();
 }
 
 
@@ -151,10 +182,9 @@ void RtCov::run()
     }
     bool doProj = true;
 
-    quint32 n_samples = 0;
+    quint64 n_samplesSincePublish = 0;
 
-    FiffCov::SPtr cov(new FiffCov());
-    VectorXd mu;
+    resetAccumulation();
 
     while(m_bIsRunning)
     {
@@ -162,55 +192,176 @@ void RtCov::run()
         {
             MatrixXd rawSegment = m_pRawMatrixBuffer->pop();
 
-            if(n_samples == 0)
-            {
-                mu = rawSegment.rowwise().sum();
-                cov->data = rawSegment * rawSegment.transpose();
+            if(!m_bIsRunning)
+                break;
+
+            //Apply pending settings
+            mutex.lock();
+            if(m_iNewMaxSamples > 0) {
+                m_iMaxSamples = m_iNewMaxSamples;
+                m_iNewMaxSamples = 0;
             }
-            else
-            {
-                mu.array() += rawSegment.rowwise().sum().array();
-                cov->data += rawSegment * rawSegment.transpose();
+            if(m_eNewMode != m_eMode) {
+                m_eMode = m_eNewMode;
+                resetAccumulation();
+                n_samplesSincePublish = 0;
             }
-            n_samples += rawSegment.cols();
+            quint32 iUpdateInterval = m_iUpdateInterval;
+            mutex.unlock();
 
-            if(n_samples > m_iMaxSamples)
-            {
-                mu /= (float)n_samples;
-                cov->data.array() -= n_samples * (mu * mu.transpose()).array();
-                cov->data.array() /= (n_samples - 1);
+            if(m_vecFirstMoment.size() != rawSegment.rows()) {
+                resetAccumulation();
+                n_samplesSincePublish = 0;
+            }
 
-                cov->kind = FIFFV_MNE_NOISE_COV;
-                cov->diag = false;
-                cov->dim = cov->data.rows();
+            switch(m_eMode)
+            {
+                case ExponentialForgetting:
+                    accumulate(rawSegment, 1.0 - 1.0 / (double)qMax(m_iMaxSamples, (quint32)2));
+                    break;
+
+                case SlidingWindow:
+                    accumulate(rawSegment, 1.0);
+                    m_qWindowBlocks.enqueue(rawSegment);
+
+                    while(m_qWindowBlocks.size() > 1 && m_dWeightSum - m_qWindowBlocks.head().cols() >= m_iMaxSamples)
+                        downdate(m_qWindowBlocks.dequeue());
+
+                    //Cancellation errors of the downdates build up, rebuild the moments from time to time
+                    if(m_iDowndatedSamples > 16 * (quint64)qMax(m_iMaxSamples, (quint32)1)) {
+                        QQueue<MatrixXd> qBlocks = m_qWindowBlocks;
+                        resetAccumulation();
+                        for(int i = 0; i < qBlocks.size(); ++i)
+                            accumulate(qBlocks.at(i), 1.0);
+                        m_qWindowBlocks = qBlocks;
+                    }
+                    break;
+
+                default:
+                    accumulate(rawSegment, 1.0);
+                    break;
+            }
 
-                //ToDo do picks
-                cov->names = m_pFiffInfo->ch_names;
-                cov->projs = m_pFiffInfo->projs;
-                cov->bads = m_pFiffInfo->bads;
-                cov->nfree = n_samples;
+            n_samplesSincePublish += rawSegment.cols();
 
-                // regularize noise covariance
-                *cov.data() = cov->regularize(*m_pFiffInfo, 0.05, 0.05, 0.1, doProj, exclude);
+            if(m_eMode == Block)
+            {
+                if(m_iSamplesSeen > m_iMaxSamples)
+                {
+                    publish(exclude, doProj);
+                    resetAccumulation();
+                    n_samplesSincePublish = 0;
+                }
+            }
+            else if(m_iSamplesSeen >= m_iMaxSamples && n_samplesSincePublish >= iUpdateInterval)
+            {
+                publish(exclude, doProj);
+                n_samplesSincePublish = 0;
+            }
+        }
+    }
+}
 
-                emit covCalculated(cov);
 
-                cov = FiffCov::SPtr(new FiffCov());
-                n_samples = 0;
-            }
+//*************************************************************************************************************
 
+void RtCov::resetAccumulation()
+{
+    m_matSecondMoment.resize(0,0);
+    m_vecFirstMoment.resize(0);
+    m_dWeightSum = 0.0;
+    m_dWeightSqSum = 0.0;
+    m_iSamplesSeen = 0;
+    m_iDowndatedSamples = 0;
+    m_qWindowBlocks.clear();
+}
 
-//            qint32 samples = rawSegment.cols();
-//            VectorXf mu = rawSegment.rowwise().sum().array() / (float)samples;
 
-//            MatrixXf noise_covariance = rawSegment * rawSegment.transpose();// noise_covariance == raw_covariance
-//            noise_covariance.array() -= samples * (mu * mu.transpose()).array();
-//            noise_covariance.array() /= (samples - 1);
+//*************************************************************************************************************
 
-//            std::cout << "Noise Covariance:\n" << noise_covariance.block(0,0,10,10) << std::endl;
+void RtCov::accumulate(const MatrixXd &p_matBlock, double p_dLambda)
+{
+    const int nChan = p_matBlock.rows();
+    const int nSamp = p_matBlock.cols();
 
-//            printf("%d raw buffer (%d x %d) generated\r\n", count, tmp.rows(), tmp.cols());
+    if(m_vecFirstMoment.size() != nChan) {
+        m_matSecondMoment = MatrixXd::Zero(nChan, nChan);
+        m_vecFirstMoment = VectorXd::Zero(nChan);
+    }
 
+    if(p_dLambda < 1.0)
+    {
+        //Age the old moments by the whole block and weight the new samples by their age within the block
+        const double dDecay = std::pow(p_dLambda, nSamp);
+        m_matSecondMoment.triangularView<Lower>() *= dDecay;
+        m_vecFirstMoment *= dDecay;
+        m_dWeightSum *= dDecay;
+        m_dWeightSqSum *= dDecay * dDecay;
+
+        VectorXd vecWeights(nSamp);
+        double w = 1.0;
+        for(int j = nSamp - 1; j >= 0; --j) {
+            vecWeights[j] = w;
+            w *= p_dLambda;
         }
+
+        MatrixXd matWeighted = p_matBlock * vecWeights.cwiseSqrt().asDiagonal();
+        m_matSecondMoment.selfadjointView<Lower>().rankUpdate(matWeighted);
+        m_vecFirstMoment.noalias() += p_matBlock * vecWeights;
+        m_dWeightSum += vecWeights.sum();
+        m_dWeightSqSum += vecWeights.squaredNorm();
     }
+    else
+    {
+        m_matSecondMoment.selfadjointView<Lower>().rankUpdate(p_matBlock);
+        m_vecFirstMoment.noalias() += p_matBlock.rowwise().sum();
+        m_dWeightSum += nSamp;
+        m_dWeightSqSum += nSamp;
+    }
+
+    m_iSamplesSeen += nSamp;
+}
+
+
+//*************************************************************************************************************
+
+void RtCov::downdate(const MatrixXd &p_matBlock)
+{
+    m_matSecondMoment.selfadjointView<Lower>().rankUpdate(p_matBlock, -1.0);
+    m_vecFirstMoment.noalias() -= p_matBlock.rowwise().sum();
+    m_dWeightSum -= p_matBlock.cols();
+    m_dWeightSqSum -= p_matBlock.cols();
+    m_iDowndatedSamples += p_matBlock.cols();
+}
+
+
+//*************************************************************************************************************
+
+void RtCov::publish(const QStringList &p_sExclude, bool p_bDoProj)
+{
+    //Unbiased weighted estimate: (sum w x x^T - S S^T / W) / (W - sum w^2 / W)
+    const double dDenom = m_dWeightSum - m_dWeightSqSum / m_dWeightSum;
+    if(m_dWeightSum <= 0.0 || dDenom <= 0.0)
+        return;
+
+    FiffCov::SPtr cov(new FiffCov());
+
+    cov->data = m_matSecondMoment.selfadjointView<Lower>();
+    cov->data.noalias() -= m_vecFirstMoment * (m_vecFirstMoment.transpose() / m_dWeightSum);
+    cov->data /= dDenom;
+
+    cov->kind = FIFFV_MNE_NOISE_COV;
+    cov->diag = false;
+    cov->dim = cov->data.rows();
+
+    //ToDo do picks
+    cov->names = m_pFiffInfo->ch_names;
+    cov->projs = m_pFiffInfo->projs;
+    cov->bads = m_pFiffInfo->bads;
+    cov->nfree = (qint32)std::floor(m_dWeightSum * m_dWeightSum / m_dWeightSqSum + 0.5);
+
+    // regularize noise covariance
+    *cov.data() = cov->regularize(*m_pFiffInfo, 0.05, 0.05, 0.1, p_bDoProj, p_sExclude);
+
+    emit covCalculated(cov);
 }
@@ -68,6 +68,7 @@
 
 #include <QThread>
 #include <QMutex>
+#include <QQueue>
 #include <QSharedPointer>
 
 
@@ -100,7 +101,12 @@ using namespace FIFFLIB;
 
 //=============================================================================================================
 /**
-* Real-time covariance estimation
+* Real-time covariance estimation. In Block mode the data of each chunk of p_iMaxSamples samples is accumulated
+* into an independent covariance estimate which is published before the accumulation restarts. The continuous
+* modes never restart: ExponentialForgetting weights each sample with lambda^age where lambda = 1 - 1/p_iMaxSamples,
+* SlidingWindow keeps exactly the last p_iMaxSamples samples (plus at most one block). Both publish a fresh
+* regularized estimate every update interval samples. Only the lower triangle of the second moment is accumulated
+* by symmetric rank-k updates.
 *
 * @brief Real-time covariance estimation
 */
@@ -111,6 +117,15 @@ public:
     typedef QSharedPointer<RtCov> SPtr;             /**< Shared pointer type for RtCov. */
     typedef QSharedPointer<const RtCov> ConstSPtr;  /**< Const shared pointer type for RtCov. */
 
+    /**
+    * Covariance estimation modes.
+    */
+    enum EstimationMode {
+        Block,                      /**< Independent estimates over consecutive chunks of samples. */
+        ExponentialForgetting,      /**< Continuous estimate with exponentially decaying sample weights. */
+        SlidingWindow               /**< Continuous estimate over the most recent samples. */
+    };
+
     //=========================================================================================================
     /**
     * Creates the real-time covariance estimation object.
@@ -151,6 +166,23 @@ public:
     */
     void setSamples(qint32 samples);
 
+    //=========================================================================================================
+    /**
+    * Sets the estimation mode. Changing the mode restarts the accumulation.
+    *
+    * @param[in] mode       estimation mode to set
+    */
+    void setEstimationMode(EstimationMode mode);
+
+    //=========================================================================================================
+    /**
+    * Sets after how many new samples a continuous estimator publishes a new covariance. The Block mode always
+    * publishes once per chunk.
+    *
+    * @param[in] samples    update interval in samples; 0 publishes after every received block
+    */
+    void setUpdateInterval(qint32 samples);
+
     //=========================================================================================================
     /**
     * Starts the RtCov by starting the producer's thread.
@@ -186,12 +218,59 @@ protected:
     virtual void run();
 
 private:
+    //=========================================================================================================
+    /**
+    * Resets the accumulated moments.
+    */
+    void resetAccumulation();
+
+    //=========================================================================================================
+    /**
+    * Adds a data block to the moments. Only the lower triangle of m_matSecondMoment is updated.
+    *
+    * @param[in] p_matBlock     the data block (channels x samples)
+    * @param[in] p_dLambda      per sample forgetting factor, 1.0 for no forgetting
+    */
+    void accumulate(const MatrixXd &p_matBlock, double p_dLambda);
+
+    //=========================================================================================================
+    /**
+    * Removes a data block, which was added without forgetting, from the moments.
+    *
+    * @param[in] p_matBlock     the data block (channels x samples)
+    */
+    void downdate(const MatrixXd &p_matBlock);
+
+    //=========================================================================================================
+    /**
+    * Computes, regularizes and emits the covariance of the current moments.
+    *
+    * @param[in] p_sExclude     channels excluded from regularization
+    * @param[in] p_bDoProj      whether to apply the projectors during regularization
+    */
+    void publish(const QStringList &p_sExclude, bool p_bDoProj);
+
     QMutex      mutex;                  /**< Provides access serialization between threads*/
 
     quint32      m_iMaxSamples;         /**< Maximal amount of samples received, before covariance is estimated.*/
 
     quint32      m_iNewMaxSamples;      /**< New maximal amount of samples received, before covariance is estimated.*/
 
+    EstimationMode  m_eMode;            /**< The estimation mode. */
+
+    EstimationMode  m_eNewMode;         /**< Mode requested by setEstimationMode, applied by the estimation thread. */
+
+    quint32      m_iUpdateInterval;     /**< Number of new samples after which a continuous estimator publishes. */
+
+    MatrixXd    m_matSecondMoment;      /**< Weighted sum of x*x^T, only the lower triangle is valid. */
+    VectorXd    m_vecFirstMoment;       /**< Weighted sum of x. */
+    double      m_dWeightSum;           /**< Sum of the sample weights. */
+    double      m_dWeightSqSum;         /**< Sum of the squared sample weights, gives the effective degrees of freedom. */
+    quint64     m_iSamplesSeen;         /**< Number of samples accumulated since the last reset. */
+    quint64     m_iDowndatedSamples;    /**< Number of samples removed by downdates since the moments were rebuilt. */
+
+    QQueue<MatrixXd> m_qWindowBlocks;   /**< Blocks currently inside the sliding window. */
+
     FiffInfo::SPtr  m_pFiffInfo;        /**< Holds the fiff measurement information. */
 
     bool        m_bIsRunning;           /**< Holds if real-time Covariance estimation is running.*/
@@ -41,6 +41,14 @@
 #include "rtfilter.h"
 
 
+//*************************************************************************************************************
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QThread>
+
+
 //*************************************************************************************************************
 //=============================================================================================================
 // USED NAMESPACES
@@ -54,16 +62,10 @@ using namespace FIFFLIB;
 
 //*************************************************************************************************************
 //=============================================================================================================
-// DEFINE GLOBAL METHODS
+// DEFINES
 //=============================================================================================================
 
-void doFilterPerChannelRTMSA(QPair<QList<FilterData>,QPair<int,RowVectorXd> > &channelDataTime)
-{
-    for(int i = 0; i < channelDataTime.first.size(); ++i) {
-        //channelDataTime.second.second = channelDataTime.first.at(i).applyConvFilter(channelDataTime.second.second, true, FilterData::ZeroPad);
-        channelDataTime.second.second = channelDataTime.first.at(i).applyFFTFilter(channelDataTime.second.second, true, FilterData::ZeroPad); //FFT Convolution for rt is not suitable. FFT make the signal filtering non causal.
-    }
-}
+#define FILTER_TILE_BYTES   (256*1024)  // data of one tile should fit into the L2 cache
 
 
 //*************************************************************************************************************
@@ -72,6 +74,10 @@ void doFilterPerChannelRTMSA(QPair<QList<FilterData>,QPair<int,RowVectorXd> > &c
 //=============================================================================================================
 
 RtFilter::RtFilter()
+: m_pData(NULL)
+, m_iBlockSize(0)
+, m_iHistory(0)
+, m_iFFTLength(0)
 {
 }
 
@@ -85,70 +91,276 @@ RtFilter::~RtFilter()
 
 //*************************************************************************************************************
 
-MatrixXd RtFilter::filterChannelsConcurrently(const MatrixXd& matDataIn, int iMaxFilterLength, const QVector<int>& lFilterChannelList, const QList<FilterData>& lFilterData)
+MatrixXd RtFilter::filterChannelsConcurrently(const MatrixXd& matDataIn, bool bDelayUnfiltered, const QVector<int>& lFilterChannelList, const QList<FilterData>& lFilterData)
+{
+    MatrixXd matDataOut = matDataIn;
+    filterChannelsInPlace(matDataOut, bDelayUnfiltered, lFilterChannelList, lFilterData);
+    return matDataOut;
+}
+
+
+//*************************************************************************************************************
+
+void RtFilter::filterChannelsInPlace(MatrixXd& matData, bool bDelayUnfiltered, const QVector<int>& lFilterChannelList, const QList<FilterData>& lFilterData)
 {
-    //Initialise the overlay matrix
-    if(m_matOverlap.cols() != iMaxFilterLength || m_matOverlap.rows() < matDataIn.rows()) {
-        m_matOverlap.resize(matDataIn.rows(), iMaxFilterLength);
-        m_matOverlap.setZero();
+    //Mark the rows which are to be filtered
+    QVector<bool> vecIsFiltered(matData.rows(), false);
+    for(int i = 0; i < lFilterChannelList.size(); ++i) {
+        if(lFilterChannelList.at(i) >= 0 && lFilterChannelList.at(i) < matData.rows()) {
+            vecIsFiltered[lFilterChannelList.at(i)] = true;
+        }
     }
 
-    if(m_matDelay.cols() != iMaxFilterLength/2 || m_matOverlap.rows() < matDataIn.rows()) {
-        m_matDelay.resize(matDataIn.rows(), iMaxFilterLength/2);
-        m_matDelay.setZero();
+    QVector<int> vecFilterRows;
+    vecFilterRows.reserve(matData.rows());
+    for(int i = 0; i < matData.rows(); ++i) {
+        if(vecIsFiltered.at(i)) {
+            vecFilterRows.append(i);
+        }
     }
 
-    //Resize output matrix to match input matrix
-    MatrixXd matDataOut(matDataIn.rows(), matDataIn.cols());
+    //Delay the channels which are not filtered, so they stay aligned with the filtered ones
+    int iDelay = bDelayUnfiltered ? getGroupDelay(lFilterData) : 0;
+
+    if(iDelay > 0) {
+        if(m_matDelay.rows() != matData.rows() || m_matDelay.cols() != iDelay) {
+            m_matDelay = MatrixXd::Zero(matData.rows(), iDelay);
+        }
+
+        RowVectorXd vecDelayed(iDelay + matData.cols());
+
+        for(int i = 0; i < matData.rows(); ++i) {
+            if(!vecIsFiltered.at(i)) {
+                vecDelayed << m_matDelay.row(i), matData.row(i);
+                matData.row(i) = vecDelayed.head(matData.cols());
+                m_matDelay.row(i) = vecDelayed.tail(iDelay);
+            }
+        }
+    }
 
-    //Generate QList structure which can be handled by the QConcurrent framework
-    QList<QPair<QList<FilterData>,QPair<int,RowVectorXd> > > timeData;
-    QList<int> notFilterChannelIndex;
+    if(vecFilterRows.isEmpty() || lFilterData.isEmpty() || matData.cols() == 0) {
+        return;
+    }
 
-    //Only select channels specified in lFilterChannelList
-    for(qint32 i = 0; i < matDataIn.rows(); ++i) {
-        int pos = lFilterChannelList.indexOf(i);
-        if(pos != -1 && pos < matDataIn.rows()) {
-            timeData.append(QPair<QList<FilterData>,QPair<int,RowVectorXd> >(lFilterData,QPair<int,RowVectorXd>(pos,matDataIn.row(pos))));
+    QList<FilterData> lFIRFilterData;
+    QList<FilterData> lIIRFilterData;
+    for(int i = 0; i < lFilterData.size(); ++i) {
+        if(lFilterData.at(i).isIIR()) {
+            lIIRFilterData.append(lFilterData.at(i));
         } else {
-            notFilterChannelIndex.append(i);
+            lFIRFilterData.append(lFilterData.at(i));
         }
     }
 
-    //Do the concurrent filtering
-    if(!timeData.isEmpty()) {
-        QFuture<void> future = QtConcurrent::map(timeData,
-                                             doFilterPerChannelRTMSA);
+    //Do the concurrent FIR filtering
+    if(!lFIRFilterData.isEmpty()) {
+        prepare(lFIRFilterData, vecFilterRows, matData.cols());
+
+        m_pData = &matData;
 
-        future.waitForFinished();
+        if(m_qVecTiles.size() == 1) {
+            doFilterTile(m_qVecTiles[0]);
+        } else {
+            QFuture<void> future = QtConcurrent::map(m_qVecTiles, doFilterTile);
+            future.waitForFinished();
+        }
 
-        //Do the overlap add method and store in matDataOut
-        int iFilteredNumberCols = timeData.at(0).second.second.cols();
+        m_pData = NULL;
+    }
 
-        for(int r = 0; r < timeData.size(); r++) {
-            //Get the currently filtered data. This data has a delay of filterLength/2 in front and back.
-            RowVectorXd tempData = timeData.at(r).second.second;
+    if(!lIIRFilterData.isEmpty()) {
+        filterIIR(matData, vecFilterRows, lIIRFilterData);
+    }
+}
 
-            //Perform the actual overlap add by adding the last filterlength data to the newly filtered one
-            tempData.head(iMaxFilterLength) += m_matOverlap.row(timeData.at(r).second.first);
 
-            //Write the newly calulated filtered data to the filter data matrix. Keep in mind that the current block also effect last part of the last block (begin at dataIndex-iFilterDelay).
-            int start = 0;
-            matDataOut.row(timeData.at(r).second.first).segment(start,iFilteredNumberCols-iMaxFilterLength) = tempData.head(iFilteredNumberCols-iMaxFilterLength);
+//*************************************************************************************************************
 
-            //Refresh the m_matOverlap with the new calculated filtered data.
-            m_matOverlap.row(timeData.at(r).second.first) = timeData.at(r).second.second.tail(iMaxFilterLength);
+int RtFilter::getGroupDelay(const QList<FilterData>& lFilterData)
+{
+    int iHistory = 0;
+    for(int i = 0; i < lFilterData.size(); ++i) {
+        if(!lFilterData.at(i).isIIR()) {
+            iHistory += qMax((int)lFilterData.at(i).m_dCoeffA.cols(), 1) - 1;
         }
     }
 
-    //Fill filtered data with raw data if the channel was not filtered
-    for(int i = 0; i < notFilterChannelIndex.size(); ++i) {
-        matDataOut.row(notFilterChannelIndex.at(i)) << m_matDelay.row(notFilterChannelIndex.at(i)), matDataIn.row(notFilterChannelIndex.at(i)).head(matDataIn.cols() - iMaxFilterLength/2);
+    return iHistory/2;
+}
+
+
+//*************************************************************************************************************
+
+void RtFilter::reset()
+{
+    m_lFilterCoeffs.clear();
+    m_vecFilterRows.clear();
+    m_qVecTiles.clear();
+    m_matSegments.resize(0, 0);
+    m_matDelay.resize(0, 0);
+    m_iBlockSize = 0;
+    m_matIIRSOS.resize(0, 0);
+    m_vecIIRRows.clear();
+}
+
+
+//*************************************************************************************************************
+
+void RtFilter::doFilterTile(FilterTile& tile)
+{
+    RtFilter* pRtFilter = tile.pRtFilter;
+    MatrixXd& matData = *pRtFilter->m_pData;
+
+    int iHistory = pRtFilter->m_iHistory;
+    int iBlockSize = pRtFilter->m_iBlockSize;
+
+    for(int r = tile.iFirst; r < tile.iFirst + tile.iCount; ++r) {
+        int iRow = pRtFilter->m_vecFilterRows.at(r);
+
+        //Append the new block to the history of the channel
+        pRtFilter->m_matSegments.row(r).tail(iBlockSize) = matData.row(iRow);
 
-        //matDataOut.row(notFilterChannelIndex.at(i)).segment(0, matDataIn.row(notFilterChannelIndex.at(i)).cols()) = matDataIn.row(notFilterChannelIndex.at(i));
+        tile.vecTime.setZero();
+        tile.vecTime.head(iHistory + iBlockSize) = pRtFilter->m_matSegments.row(r);
+
+        //Circular convolution, the first iHistory samples are wrapped around and discarded
+        tile.pFFT->fwd(tile.vecFreq, tile.vecTime);
+        tile.vecFreq.array() *= pRtFilter->m_vecFreqResp.array();
+        tile.pFFT->inv(tile.vecTime, tile.vecFreq);
+
+        matData.row(iRow) = tile.vecTime.segment(iHistory, iBlockSize);
+
+        //Keep the last samples as history for the next block
+        if(iHistory > 0) {
+            pRtFilter->m_matSegments.row(r).head(iHistory) = pRtFilter->m_matSegments.row(r).tail(iHistory).eval();
+        }
     }
+}
 
-    m_matDelay = matDataIn.block(0, matDataIn.cols()-iMaxFilterLength/2, matDataIn.rows(), iMaxFilterLength/2);
 
-    return matDataOut;
+//*************************************************************************************************************
+
+void RtFilter::prepare(const QList<FilterData>& lFilterData, const QVector<int>& vecFilterRows, int iBlockSize)
+{
+    //Check whether anything changed since the last block
+    bool bChanged = iBlockSize != m_iBlockSize || vecFilterRows != m_vecFilterRows || lFilterData.size() != m_lFilterCoeffs.size();
+
+    for(int i = 0; !bChanged && i < lFilterData.size(); ++i) {
+        const RowVectorXd& vecCoeffs = lFilterData.at(i).m_dCoeffA;
+        bChanged = vecCoeffs.cols() != m_lFilterCoeffs.at(i).cols() || vecCoeffs != m_lFilterCoeffs.at(i);
+    }
+
+    if(!bChanged) {
+        return;
+    }
+
+    m_lFilterCoeffs.clear();
+    for(int i = 0; i < lFilterData.size(); ++i) {
+        m_lFilterCoeffs.append(lFilterData.at(i).m_dCoeffA);
+    }
+
+    m_vecFilterRows = vecFilterRows;
+    m_iBlockSize = iBlockSize;
+
+    //The cascaded filters act like one filter whose length is the sum of the single lengths
+    int iLength = 1;
+    for(int i = 0; i < m_lFilterCoeffs.size(); ++i) {
+        iLength += qMax((int)m_lFilterCoeffs.at(i).cols(), 1) - 1;
+    }
+
+    m_iHistory = iLength - 1;
+
+    m_iFFTLength = 2;
+    while(m_iFFTLength < m_iBlockSize + m_iHistory) {
+        m_iFFTLength *= 2;
+    }
+
+    //Transform the filters once for this FFT length
+    Eigen::FFT<double> fft;
+    fft.SetFlag(fft.HalfSpectrum);
+
+    RowVectorXd vecCoeffsZeroPad;
+    RowVectorXcd vecFreq;
+
+    m_vecFreqResp = RowVectorXcd::Ones(m_iFFTLength/2 + 1);
+    for(int i = 0; i < m_lFilterCoeffs.size(); ++i) {
+        vecCoeffsZeroPad = RowVectorXd::Zero(m_iFFTLength);
+        vecCoeffsZeroPad.head(m_lFilterCoeffs.at(i).cols()) = m_lFilterCoeffs.at(i);
+        fft.fwd(vecFreq, vecCoeffsZeroPad);
+        m_vecFreqResp.array() *= vecFreq.array();
+    }
+
+    //New filters start with an empty history
+    m_matSegments = MatrixXdR::Zero(m_vecFilterRows.size(), m_iHistory + m_iBlockSize);
+
+    //Split the channels into tiles, but provide at least one tile per thread
+    int iNumRows = m_vecFilterRows.size();
+    int iNumThreads = qMax(QThread::idealThreadCount(), 1);
+    int iRowsPerTile = qMax(1, FILTER_TILE_BYTES / (int)(sizeof(double) * (m_iHistory + 2 * m_iBlockSize)));
+    iRowsPerTile = qMin(iRowsPerTile, (iNumRows + iNumThreads - 1) / iNumThreads);
+
+    m_qVecTiles.clear();
+    for(int iFirst = 0; iFirst < iNumRows; iFirst += iRowsPerTile) {
+        FilterTile tile;
+        tile.pRtFilter = this;
+        tile.iFirst = iFirst;
+        tile.iCount = qMin(iRowsPerTile, iNumRows - iFirst);
+        tile.pFFT = QSharedPointer<Eigen::FFT<double> >(new Eigen::FFT<double>);
+        tile.pFFT->SetFlag(Eigen::FFT<double>::HalfSpectrum);
+        tile.vecTime = RowVectorXd::Zero(m_iFFTLength);
+        tile.vecFreq = RowVectorXcd::Zero(m_iFFTLength/2 + 1);
+        m_qVecTiles.append(tile);
+    }
+}
+
+
+//*************************************************************************************************************
+
+void RtFilter::filterIIR(MatrixXd& matData, const QVector<int>& vecFilterRows, const QList<FilterData>& lIIRFilterData)
+{
+    //Stack the sections of all filters, they are applied one after another
+    int iNumSections = 0;
+    for(int i = 0; i < lIIRFilterData.size(); ++i) {
+        iNumSections += lIIRFilterData.at(i).m_matSOS.rows();
+    }
+
+    MatrixXd matSOS(iNumSections, 6);
+    for(int i = 0, iRow = 0; i < lIIRFilterData.size(); ++i) {
+        matSOS.block(iRow, 0, lIIRFilterData.at(i).m_matSOS.rows(), 6) = lIIRFilterData.at(i).m_matSOS;
+        iRow += lIIRFilterData.at(i).m_matSOS.rows();
+    }
+
+    int iNumRows = vecFilterRows.size();
+
+    //New filters or channels start from rest
+    if(vecFilterRows != m_vecIIRRows || matSOS.rows() != m_matIIRSOS.rows() || matSOS != m_matIIRSOS) {
+        m_matIIRSOS = matSOS;
+        m_vecIIRRows = vecFilterRows;
+        m_matIIRState1 = MatrixXd::Zero(iNumRows, iNumSections);
+        m_matIIRState2 = MatrixXd::Zero(iNumRows, iNumSections);
+        m_vecIIROut.resize(iNumRows);
+    }
+
+    //Gather the channels, so that one column holds all channels of one sample
+    m_matIIRWork.resize(iNumRows, matData.cols());
+    for(int r = 0; r < iNumRows; ++r) {
+        m_matIIRWork.row(r) = matData.row(vecFilterRows.at(r));
+    }
+
+    //Transposed direct form II, every operation runs over all channels at once
+    for(int j = 0; j < m_matIIRWork.cols(); ++j) {
+        for(int s = 0; s < iNumSections; ++s) {
+            double b0 = m_matIIRSOS(s,0), b1 = m_matIIRSOS(s,1), b2 = m_matIIRSOS(s,2);
+            double a1 = m_matIIRSOS(s,4), a2 = m_matIIRSOS(s,5);
+
+            m_vecIIROut = b0 * m_matIIRWork.col(j) + m_matIIRState1.col(s);
+            m_matIIRState1.col(s) = b1 * m_matIIRWork.col(j) - a1 * m_vecIIROut + m_matIIRState2.col(s);
+            m_matIIRState2.col(s) = b2 * m_matIIRWork.col(j) - a2 * m_vecIIROut;
+            m_matIIRWork.col(j) = m_vecIIROut;
+        }
+    }
+
+    for(int r = 0; r < iNumRows; ++r) {
+        matData.row(vecFilterRows.at(r)) = m_matIIRWork.row(r);
+    }
 }
@@ -82,26 +82,30 @@ namespace REALTIMELIB
 
 //=============================================================================================================
 /**
-* Real-time noise Spectrum estimation
+* Real-time multichannel filtering. FIR filters are applied with the overlap-save method: every channel keeps
+* the last samples of the previous block, so consecutive blocks are filtered as one continuous signal. The filter
+* spectrum and the FFT plans are created once and reused as long as the filters and the block size do not change.
+* The channels are stored channel-major and split into cache sized tiles, which are filtered concurrently.
+* IIR filters (FilterData::isIIR) are applied afterwards as a cascade of biquads. Their state is kept per channel
+* and all channels are processed at once for every sample, they add no group delay of half the filter length.
 *
-* @brief Real-time Noise estimation
+* @brief Real-time multichannel FIR and IIR filter
 */
 class REALTIMESHARED_EXPORT RtFilter
 {
-
 public:
     typedef QSharedPointer<RtFilter> SPtr;             /**< Shared pointer type for RtFilter. */
     typedef QSharedPointer<const RtFilter> ConstSPtr;  /**< Const shared pointer type for RtFilter. */
 
     //=========================================================================================================
     /**
-    * Creates the real-time covariance estimation object.
+    * Creates the real-time filter object.
     */
     explicit RtFilter();
 
     //=========================================================================================================
     /**
-    * Destroys the Real-time noise estimation object.
+    * Destroys the real-time filter object.
     */
     ~RtFilter();
 
@@ -109,20 +113,112 @@ public:
     /**
     * Calculates the filtered version of the raw input data
     *
-    * @param [in] matDataIn     data which is to be filtered
-    * @param [out] matDataOut    data which is to be filtered
-    * @param [in] iDataIndex    current position in the global data matrix
+    * @param [in] matDataIn             data which is to be filtered
+    * @param [in] bDelayUnfiltered      whether the channels which are not filtered are delayed by the group delay of the FIR filters
+    * @param [in] lFilterChannelList    the rows which are to be filtered
+    * @param [in] lFilterData           the filters which are applied one after another
+    *
+    * @return the filtered data
+    */
+    Eigen::MatrixXd filterChannelsConcurrently(const Eigen::MatrixXd& matDataIn, bool bDelayUnfiltered, const QVector<int>& lFilterChannelList, const QList<UTILSLIB::FilterData> &lFilterData);
+
+    //=========================================================================================================
+    /**
+    * Filters the data in place.
+    *
+    * @param [in, out] matData          data which is to be filtered
+    * @param [in] bDelayUnfiltered      whether the channels which are not filtered are delayed by the group delay of the FIR filters
+    * @param [in] lFilterChannelList    the rows which are to be filtered
+    * @param [in] lFilterData           the filters which are applied one after another
+    */
+    void filterChannelsInPlace(Eigen::MatrixXd& matData, bool bDelayUnfiltered, const QVector<int>& lFilterChannelList, const QList<UTILSLIB::FilterData> &lFilterData);
+
+    //=========================================================================================================
+    /**
+    * Returns the group delay of the cascaded FIR filters in samples. Every linear phase filter of length n delays
+    * the data by (n-1)/2 samples, the delays of the cascade add up. IIR filters are not taken into account.
+    *
+    * @param [in] lFilterData           the filters which are applied one after another
+    *
+    * @return the group delay in samples
     */
-    Eigen::MatrixXd filterChannelsConcurrently(const Eigen::MatrixXd& matDataIn, int iMaxFilterLength, const QVector<int>& lFilterChannelList, const QList<UTILSLIB::FilterData> &lFilterData);
+    static int getGroupDelay(const QList<UTILSLIB::FilterData> &lFilterData);
+
+    //=========================================================================================================
+    /**
+    * Clears the filter history, the next block is filtered as if it was the first one.
+    */
+    void reset();
 
 protected:
-    Eigen::MatrixXd                 m_matOverlap;                   /**< Last overlap block */
-    Eigen::MatrixXd                 m_matDelay;                     /**< Last delay block */
+    Eigen::MatrixXd                 m_matDelay;                     /**< Last delay block of the channels which are not filtered */
 
 private:
+    typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> MatrixXdR;   /**< Channel-major matrix. */
+
+    //=========================================================================================================
+    /**
+    * A range of channels which is filtered by one thread. Every tile owns its FFT object, so the plans are
+    * created only once and the tiles never share scratch memory.
+    */
+    struct FilterTile {
+        RtFilter*                               pRtFilter;  /**< The filter the tile belongs to */
+        int                                     iFirst;     /**< First row of the tile in m_matSegments */
+        int                                     iCount;     /**< Number of rows of the tile */
+        QSharedPointer<Eigen::FFT<double> >     pFFT;       /**< FFT object holding the plans of this tile */
+        Eigen::RowVectorXd                      vecTime;    /**< Time domain scratch buffer */
+        Eigen::RowVectorXcd                     vecFreq;    /**< Frequency domain scratch buffer */
+    };
+
+    //=========================================================================================================
+    /**
+    * Filters all channels of a tile, runs in the thread pool.
+    *
+    * @param [in, out] tile     the tile to filter
+    */
+    static void doFilterTile(FilterTile& tile);
+
+    //=========================================================================================================
+    /**
+    * Recomputes the filter spectrum and the tiles if the filters, the channels or the block size changed.
+    *
+    * @param [in] lFilterData       the filters
+    * @param [in] vecFilterRows     the rows which are to be filtered
+    * @param [in] iBlockSize        the number of samples per block
+    */
+    void prepare(const QList<UTILSLIB::FilterData> &lFilterData, const QVector<int>& vecFilterRows, int iBlockSize);
 
+    //=========================================================================================================
+    /**
+    * Applies the IIR filters to the given rows. The state of the sections is carried over to the next block.
+    *
+    * @param [in, out] matData      data which is to be filtered
+    * @param [in] vecFilterRows     the rows which are to be filtered
+    * @param [in] lIIRFilterData    the IIR filters
+    */
+    void filterIIR(Eigen::MatrixXd& matData, const QVector<int>& vecFilterRows, const QList<UTILSLIB::FilterData> &lIIRFilterData);
+
+    QList<Eigen::RowVectorXd>       m_lFilterCoeffs;                /**< Coefficients of the filters the spectrum was computed for */
+    QVector<int>                    m_vecFilterRows;                /**< Rows which are filtered */
+    QVector<FilterTile>             m_qVecTiles;                    /**< Channel tiles */
+
+    MatrixXdR                       m_matSegments;                  /**< Per filtered channel the history followed by the current block */
+    Eigen::RowVectorXcd             m_vecFreqResp;                  /**< Half spectrum of the cascaded filters */
+    Eigen::MatrixXd*                m_pData;                        /**< The block which is currently filtered */
+
+    int                             m_iBlockSize;                   /**< Number of samples per block */
+    int                             m_iHistory;                     /**< Number of samples kept from the previous block */
+    int                             m_iFFTLength;                   /**< FFT length used for the overlap-save */
+
+    Eigen::MatrixXd                 m_matIIRSOS;                    /**< Second-order sections of all IIR filters */
+    QVector<int>                    m_vecIIRRows;                   /**< Rows the IIR state belongs to */
+    Eigen::MatrixXd                 m_matIIRState1;                 /**< First state of every section, one column per section */
+    Eigen::MatrixXd                 m_matIIRState2;                 /**< Second state of every section, one column per section */
+    Eigen::MatrixXd                 m_matIIRWork;                   /**< The filtered rows, one column holds all channels of one sample */
+    Eigen::VectorXd                 m_vecIIROut;                    /**< Output of the current section */
 };
 
+
 //*************************************************************************************************************
 //=============================================================================================================
 // INLINE DEFINITIONS
@@ -79,6 +79,16 @@ using namespace INVERSELIB;
 // DEFINE MEMBER METHODS RtHPISWorker
 //=============================================================================================================
 
+RtHPISWorker::RtHPISWorker(QAtomicInt* pPendingBlocks)
+: m_iSamplesSinceFit(0)
+, m_pPendingBlocks(pPendingBlocks)
+{
+}
+
+
+//*************************************************************************************************************
+
+
 void RtHPISWorker::doWork(const Eigen::MatrixXd& matData,
             const Eigen::MatrixXd& m_matProjectors,
             const QVector<int>& vFreqs,
@@ -101,6 +111,54 @@ void RtHPISWorker::doWork(const Eigen::MatrixXd& matData,
 }
 
 
+//*************************************************************************************************************
+
+void RtHPISWorker::doWorkContinuous(const Eigen::MatrixXd& matData,
+                                    const Eigen::MatrixXd& matProjectors,
+                                    const QVector<int>& vFreqs,
+                                    QSharedPointer<FIFFLIB::FiffInfo> pFiffInfo,
+                                    int iWindowSize,
+                                    int iFitInterval)
+{
+    //Skip the fit while newer blocks are waiting, the demodulation has to see every block though
+    bool bNewestBlock = true;
+    if(m_pPendingBlocks) {
+        bNewestBlock = m_pPendingBlocks->fetchAndAddOrdered(-1) <= 1;
+    }
+
+    if(!HPIFit::demodulateContinuous(matData, matProjectors, vFreqs, pFiffInfo, m_fitState, iWindowSize)) {
+        m_iSamplesSinceFit = 0;
+        return;
+    }
+
+    m_iSamplesSinceFit += matData.cols();
+
+    if(!bNewestBlock || m_iSamplesSinceFit < iFitInterval) {
+        return;
+    }
+
+    m_iSamplesSinceFit = 0;
+
+    FittingResult fitResult;
+    if(HPIFit::fitHPIContinuous(fitResult.devHeadTrans,
+                                fitResult.errorDistances,
+                                fitResult.fittedCoils,
+                                pFiffInfo,
+                                m_fitState)) {
+        emit resultReady(fitResult);
+    }
+}
+
+
+//*************************************************************************************************************
+
+void RtHPISWorker::resetContinuous()
+{
+    m_fitState = HPIFitState();
+    m_iSamplesSinceFit = 0;
+}
+
+
 //*************************************************************************************************************
 //=============================================================================================================
 // DEFINE MEMBER METHODS RtHPIS
@@ -109,12 +167,16 @@ void RtHPISWorker::doWork(const Eigen::MatrixXd& matData,
 RtHPIS::RtHPIS(FiffInfo::SPtr p_pFiffInfo, QObject *parent)
 : QObject(parent)
 , m_pFiffInfo(p_pFiffInfo)
+, m_bContinuous(false)
+, m_iWindowSize(0)
+, m_iFitInterval(0)
+, m_iPendingBlocks(0)
 {
     qRegisterMetaType<REALTIMELIB::FittingResult>("REALTIMELIB::FittingResult");
     qRegisterMetaType<QVector<int> >("QVector<int>");
     qRegisterMetaType<QSharedPointer<FIFFLIB::FiffInfo> >("QSharedPointer<FIFFLIB::FiffInfo>");
 
-    RtHPISWorker *worker = new RtHPISWorker;
+    RtHPISWorker *worker = new RtHPISWorker(&m_iPendingBlocks);
     worker->moveToThread(&m_workerThread);
 
     connect(&m_workerThread, &QThread::finished,
@@ -123,6 +185,12 @@ RtHPIS::RtHPIS(FiffInfo::SPtr p_pFiffInfo, QObject *parent)
     connect(this, &RtHPIS::operate,
             worker, &RtHPISWorker::doWork);
 
+    connect(this, &RtHPIS::operateContinuous,
+            worker, &RtHPISWorker::doWorkContinuous);
+
+    connect(this, &RtHPIS::resetContinuous,
+            worker, &RtHPISWorker::resetContinuous);
+
     connect(worker, &RtHPISWorker::resultReady,
             this, &RtHPIS::handleResults);
 
@@ -143,10 +211,21 @@ RtHPIS::~RtHPIS()
 
 void RtHPIS::append(const MatrixXd &data)
 {
-    emit operate(data,
-                 m_matProjectors,
-                 m_vCoilFreqs,
-                 m_pFiffInfo);
+    if(m_bContinuous) {
+        m_iPendingBlocks.fetchAndAddOrdered(1);
+
+        emit operateContinuous(data,
+                               m_matProjectors,
+                               m_vCoilFreqs,
+                               m_pFiffInfo,
+                               m_iWindowSize > 0 ? m_iWindowSize : (int)(0.2 * m_pFiffInfo->sfreq),
+                               m_iFitInterval > 0 ? m_iFitInterval : (int)(0.1 * m_pFiffInfo->sfreq));
+    } else {
+        emit operate(data,
+                     m_matProjectors,
+                     m_vCoilFreqs,
+                     m_pFiffInfo);
+    }
 }
 
 
@@ -166,6 +245,21 @@ void RtHPIS::setProjectionMatrix(const Eigen::MatrixXd& matProjectors)
 }
 
 
+//*************************************************************************************************************
+
+void RtHPIS::setContinuousMode(bool bContinuous, int iWindowSize, int iFitInterval)
+{
+    //Start from scratch whenever the tracking is switched on
+    if(bContinuous && !m_bContinuous) {
+        emit resetContinuous();
+    }
+
+    m_bContinuous = bContinuous;
+    m_iWindowSize = iWindowSize;
+    m_iFitInterval = iFitInterval;
+}
+
+
 //*************************************************************************************************************
 
 void RtHPIS::handleResults(const REALTIMELIB::FittingResult& fitResult)
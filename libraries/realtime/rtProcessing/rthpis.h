@@ -50,6 +50,7 @@
 #include <fiff/fiff_dig_point_set.h>
 #include <fiff/fiff_dig_point.h>
 #include <fiff/fiff_coord_trans.h>
+#include <inverse/hpiFit/hpifit.h>
 
 
 //*************************************************************************************************************
@@ -69,6 +70,7 @@
 #include <QMutex>
 #include <QSharedPointer>
 #include <QVector>
+#include <QAtomicInt>
 
 
 //*************************************************************************************************************
@@ -115,6 +117,14 @@ class RtHPISWorker : public QObject
     Q_OBJECT
 
 public:
+    //=========================================================================================================
+    /**
+    * Creates the worker.
+    *
+    * @param[in] pPendingBlocks  Counter of the blocks queued for the continuous mode, decremented by the worker.
+    */
+    explicit RtHPISWorker(QAtomicInt* pPendingBlocks = 0);
+
     //=========================================================================================================
     /**
     * Perform one single HPI fit.
@@ -129,8 +139,38 @@ public:
                 const QVector<int>& vFreqs,
                 QSharedPointer<FIFFLIB::FiffInfo> pFiffInfo);
 
+    //=========================================================================================================
+    /**
+    * Feeds one block to the continuous HPI fitting. The coil positions are fitted once the demodulation window
+    * is filled, at most every iFitInterval samples and only if no further block is queued.
+    *
+    * @param[in] matData         The new data block.
+    * @param[in] matProjectors   The projectors to apply. Bad channels are still included.
+    * @param[in] vFreqs          The frequencies for each coil.
+    * @param[in] pFiffInfo       Associated Fiff Information.
+    * @param[in] iWindowSize     Length of the demodulation window in samples.
+    * @param[in] iFitInterval    Minimal number of samples between two fits.
+    */
+    void doWorkContinuous(const Eigen::MatrixXd& matData,
+                          const Eigen::MatrixXd& matProjectors,
+                          const QVector<int>& vFreqs,
+                          QSharedPointer<FIFFLIB::FiffInfo> pFiffInfo,
+                          int iWindowSize,
+                          int iFitInterval);
+
+    //=========================================================================================================
+    /**
+    * Resets the state of the continuous HPI fitting.
+    */
+    void resetContinuous();
+
 signals:
     void resultReady(const REALTIMELIB::FittingResult &fitResult);
+
+private:
+    INVERSELIB::HPIFitState     m_fitState;             /**< The state of the continuous HPI fitting. */
+    int                         m_iSamplesSinceFit;     /**< Samples demodulated since the last continuous fit. */
+    QAtomicInt*                 m_pPendingBlocks;       /**< Number of blocks queued for the continuous mode. */
 };
 
 //=============================================================================================================
@@ -186,6 +226,18 @@ public:
     */
     void setProjectionMatrix(const Eigen::MatrixXd& matProjectors);
 
+    //=========================================================================================================
+    /**
+    * Switches the continuous head position tracking on or off. In continuous mode every appended block is fed to a
+    * running lock-in demodulation and the coils are refitted, starting from their last positions, at the given
+    * rate. Blocks have to be appended gap-less. Otherwise every appended block is fitted independently.
+    *
+    * @param[in] bContinuous     Whether to track continuously.
+    * @param[in] iWindowSize     Length of the demodulation window in samples, 0 uses 200 ms.
+    * @param[in] iFitInterval    Minimal number of samples between two fits, 0 uses 100 ms.
+    */
+    void setContinuousMode(bool bContinuous, int iWindowSize = 0, int iFitInterval = 0);
+
 protected:
     //=========================================================================================================
     /**
@@ -199,12 +251,26 @@ protected:
     QVector<int>        m_vCoilFreqs;           /**< Vector contains the HPI coil frequencies. */
     Eigen::MatrixXd     m_matProjectors;        /**< Holds the matrix with the SSP and compensator projectors.*/
 
+    bool                m_bContinuous;          /**< Whether the continuous mode is active. */
+    int                 m_iWindowSize;          /**< Demodulation window of the continuous mode in samples. */
+    int                 m_iFitInterval;         /**< Minimal number of samples between two continuous fits. */
+    QAtomicInt          m_iPendingBlocks;       /**< Number of blocks queued for the continuous mode. */
+
 signals:
     void newFittingResultAvailable(const REALTIMELIB::FittingResult &fitResult);
     void operate(const Eigen::MatrixXd& matData,
                  const Eigen::MatrixXd& matProjectors,
                  const QVector<int>& vFreqs,
                  QSharedPointer<FIFFLIB::FiffInfo> pFiffInfo);
+
+    void operateContinuous(const Eigen::MatrixXd& matData,
+                           const Eigen::MatrixXd& matProjectors,
+                           const QVector<int>& vFreqs,
+                           QSharedPointer<FIFFLIB::FiffInfo> pFiffInfo,
+                           int iWindowSize,
+                           int iFitInterval);
+
+    void resetContinuous();
 };
 
 //*************************************************************************************************************
@@ -66,6 +66,7 @@ using namespace REALTIMELIB;
 RtInvOp::RtInvOp(FiffInfo::SPtr &p_pFiffInfo, MNEForwardSolution::SPtr &p_pFwd, QObject *parent)
 : QThread(parent)
 , m_bIsRunning(false)
+, m_bNoiseCovPending(false)
 , m_pFiffInfo(p_pFiffInfo)
 , m_pFwd(p_pFwd)
 {
@@ -86,11 +87,12 @@ RtInvOp::~RtInvOp()
 void RtInvOp::appendNoiseCov(FiffCov &p_noiseCov)
 {
     mutex.lock();
-    //Use here a circular buffer
-    m_vecNoiseCov.push_back(p_noiseCov);
-
-    qDebug() << "RtInvOp m_vecNoiseCov" << m_vecNoiseCov.size();
+    if(m_bNoiseCovPending)
+        qDebug() << "RtInvOp: Previous noise covariance was not processed yet, replacing it.";
 
+    m_noiseCov = p_noiseCov;
+    m_bNoiseCovPending = true;
+    m_waitNoiseCov.wakeOne();
     mutex.unlock();
 }
 
@@ -99,7 +101,11 @@ void RtInvOp::appendNoiseCov(FiffCov &p_noiseCov)
 
 bool RtInvOp::stop()
 {
+    mutex.lock();
     m_bIsRunning = false;
+    m_waitNoiseCov.wakeAll();
+    mutex.unlock();
+
     QThread::wait();
 
     return true;
@@ -110,21 +116,38 @@ bool RtInvOp::stop()
 
 void RtInvOp::run()
 {
+    mutex.lock();
     m_bIsRunning = true;
+    mutex.unlock();
+
+    // Restrict forward solution as necessary for MEG, this does not depend on the covariance
+    if(!m_pFwdMeg)
+        m_pFwdMeg = MNEForwardSolution::SPtr(new MNEForwardSolution(m_pFwd->pick_types(true, false)));
 
-    while(m_bIsRunning)
+    FiffCov t_noiseCov;
+
+    while(true)
     {
-        if(m_vecNoiseCov.size() > 0)
-        {
-            // Restrict forward solution as necessary for MEG
-            MNEForwardSolution t_forwardMeg = m_pFwd->pick_types(true, false);
-
-            mutex.lock();
-            MNEInverseOperator::SPtr t_invOpMeg(new MNEInverseOperator(*m_pFiffInfo.data(), t_forwardMeg, m_vecNoiseCov[0], 0.2f, 0.8f));
-            m_vecNoiseCov.pop_front();
-            mutex.unlock();
+        mutex.lock();
+        while(m_bIsRunning && !m_bNoiseCovPending)
+            m_waitNoiseCov.wait(&mutex);
 
-            emit invOperatorCalculated(t_invOpMeg);
+        if(!m_bIsRunning) {
+            mutex.unlock();
+            break;
         }
+
+        t_noiseCov = m_noiseCov;
+        m_bNoiseCovPending = false;
+        mutex.unlock();
+
+        MNEInverseOperator::SPtr t_invOpMeg(new MNEInverseOperator(MNEInverseOperator::make_inverse_operator(*m_pFiffInfo.data(),
+                                                                                                             *m_pFwdMeg.data(),
+                                                                                                             t_noiseCov,
+                                                                                                             m_preparedFwdMeg,
+                                                                                                             0.2f,
+                                                                                                             0.8f)));
+
+        emit invOperatorCalculated(t_invOpMeg);
     }
 }
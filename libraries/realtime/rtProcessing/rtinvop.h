@@ -67,6 +67,7 @@
 
 #include <QThread>
 #include <QMutex>
+#include <QWaitCondition>
 #include <QSharedPointer>
 
 
@@ -99,7 +100,9 @@ using namespace MNELIB;
 
 //=============================================================================================================
 /**
-* Real-time inverse dSPM, sLoreta inverse operator estimation
+* Real-time inverse dSPM, sLoreta inverse operator estimation. The worker sleeps until a noise covariance arrives.
+* Covariances which arrive while an operator is being computed are coalesced to the latest one. The picked
+* forward solution, its gain matrix and the depth prior are computed once and reused for all subsequent covariances.
 *
 * @brief Real-time inverse operator estimation
 */
@@ -128,7 +131,7 @@ public:
 
     //=========================================================================================================
     /**
-    * Slot to receive incoming noise covariance estimations.
+    * Slot to receive incoming noise covariance estimations. A covariance which was not yet processed is replaced.
     *
     * @param[in] p_NoiseCov     Noise covariance estimation
     */
@@ -170,12 +173,17 @@ protected:
 
 private:
     QMutex      mutex;                  /**< Provides access serialization between threads. */
+    QWaitCondition m_waitNoiseCov;      /**< Signaled when a new noise covariance arrived or the worker is stopped. */
     bool        m_bIsRunning;           /**< Whether RtInv is running. */
 
-    QVector<FiffCov> m_vecNoiseCov;     /**< Noise covariance matrices. */
+    FiffCov     m_noiseCov;             /**< Latest noise covariance, not yet processed if m_bNoiseCovPending. */
+    bool        m_bNoiseCovPending;     /**< Whether m_noiseCov holds an unprocessed covariance. */
 
     FiffInfo::SPtr m_pFiffInfo;         /**< The fiff measurement information. */
     MNEForwardSolution::SPtr m_pFwd;    /**< The forward solution. */
+
+    MNEForwardSolution::SPtr m_pFwdMeg; /**< Cached MEG part of the forward solution. */
+    PreparedForward m_preparedFwdMeg;   /**< Cached gain matrix and depth prior of m_pFwdMeg. */
 };
 
 //*************************************************************************************************************
@@ -60,6 +60,7 @@
 //=============================================================================================================
 
 #include <utils/generics/circularmatrixbuffer.h>
+#include <utils/welchpsd.h>
 
 
 //*************************************************************************************************************
@@ -180,8 +181,6 @@ protected:
     */
     virtual void run();
 
-    QVector <float> hanning(int N, short itype);
-
 private:
     QMutex      mutex;                  /**< Provides access serialization between threads*/
 
@@ -191,7 +190,7 @@ private:
 
     CircularMatrixBuffer<double>::SPtr m_pRawMatrixBuffer;   /**< The Circular Raw Matrix Buffer. */
 
-    QVector <float> m_fWin;
+    UTILSLIB::WelchPsd m_welchPsd;      /**< Streaming Welch PSD estimation. */
 
     double m_Fs;
 
@@ -204,8 +203,6 @@ protected:
     int m_iSensors;
     int m_iBlockIndex;
 
-    MatrixXd m_matCircBuf;
-
 public:
     MatrixXd m_matSpecData;
     QMutex ReadMutex;
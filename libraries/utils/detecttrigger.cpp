@@ -47,6 +47,8 @@
 //=============================================================================================================
 
 #include <iostream>
+#include <algorithm>
+#include <limits>
 
 
 //*************************************************************************************************************
@@ -67,14 +69,178 @@ using namespace Eigen;
 using namespace UTILSLIB;
 
 
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE STATIC MEMBERS
+//=============================================================================================================
+
+const int DetectTrigger::NoCode = std::numeric_limits<int>::min();
+
+
 //*************************************************************************************************************
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
 
 DetectTrigger::DetectTrigger()
+: m_dThreshold(0.5)
+, m_iMask(-1)
+, m_type(Rising)
+, m_iMinPulseSamples(1)
+, m_bRemoveOffset(false)
+, m_iRefractorySamples(0)
+, m_iSampleCount(0)
+{
+
+}
+
+
+//*************************************************************************************************************
+
+void DetectTrigger::setTriggerChannels(const QList<int>& lTriggerChannels, double dThreshold, int iMask, EdgeType type, int iMinPulseSamples, bool bRemoveOffset, int iRefractorySamples)
+{
+    m_lTriggerChannels = lTriggerChannels;
+    m_dThreshold = dThreshold;
+    m_iMask = iMask;
+    m_type = type;
+    m_iMinPulseSamples = iMinPulseSamples > 0 ? iMinPulseSamples : 1;
+    m_bRemoveOffset = bRemoveOffset;
+    m_iRefractorySamples = iRefractorySamples > 0 ? iRefractorySamples : 0;
+
+    reset();
+}
+
+
+//*************************************************************************************************************
+
+void DetectTrigger::reset(qint64 iFirstSample)
+{
+    m_iSampleCount = iFirstSample;
+
+    ChannelState state;
+    state.iCode = NoCode;
+    state.dValue = 0.0;
+    state.dOffset = 0.0;
+    state.iRunStart = iFirstSample;
+    state.bRunValid = false;
+    state.bRunReported = false;
+    state.iLastOnset = iFirstSample - m_iRefractorySamples;
+    state.bOffsetSet = false;
+
+    m_vChannelStates.fill(state, m_lTriggerChannels.size());
+    m_vEvents.resize(0);
+}
+
+
+//*************************************************************************************************************
+
+const QVector<DetectTrigger::TriggerEvent>& DetectTrigger::detectTriggerEvents(const MatrixXd &data)
+{
+    m_vEvents.resize(0);
+
+    qint64 iBlockStart = m_iSampleCount;
+    int iNumSamples = data.cols();
+
+    if(iNumSamples == 0) {
+        return m_vEvents;
+    }
+
+    for(int i = 0; i < m_lTriggerChannels.size(); ++i) {
+        int iChIdx = m_lTriggerChannels.at(i);
+
+        if(iChIdx >= data.rows() || iChIdx < 0) {
+            continue;
+        }
+
+        ChannelState& state = m_vChannelStates[i];
+
+        if(m_bRemoveOffset && !state.bOffsetSet) {
+            state.dOffset = data(iChIdx,0);
+            state.bOffsetSet = true;
+        }
+
+        //Threshold the whole block and keep the code of the samples which are on, each sample is compared with its predecessor
+        m_vecCodes = (data.row(iChIdx).transpose().array() + 0.5).floor().cast<int>();
+        if(m_iMask != -1) {
+            int iMask = m_iMask;
+            m_vecCodes = m_vecCodes.unaryExpr([iMask](int iCode) { return iCode & iMask; });
+            m_vecCodes = (m_vecCodes != 0).select(m_vecCodes, NoCode);
+        }
+        m_vecCodes = (data.row(iChIdx).transpose().array() - state.dOffset >= m_dThreshold).select(m_vecCodes, NoCode);
+
+        m_vecChanged.resize(iNumSamples);
+        m_vecChanged(0) = m_vecCodes(0) != state.iCode;
+        m_vecChanged.tail(iNumSamples-1) = m_vecCodes.tail(iNumSamples-1) != m_vecCodes.head(iNumSamples-1);
+
+        if(m_vecChanged.any()) {
+            for(int j = 0; j < iNumSamples; ++j) {
+                if(m_vecChanged(j)) {
+                    closeRun(state, iChIdx, iBlockStart + j, iBlockStart);
+
+                    state.iCode = m_vecCodes(j);
+                    state.dValue = data(iChIdx,j);
+                    state.iRunStart = iBlockStart + j;
+                    state.bRunValid = false;
+                    state.bRunReported = false;
+                }
+            }
+        }
+
+        //Report the current code once it was held long enough
+        if(!state.bRunValid && state.iCode != NoCode && iBlockStart + iNumSamples - state.iRunStart >= m_iMinPulseSamples) {
+            validateRun(state, iChIdx, iBlockStart);
+        }
+    }
+
+    m_iSampleCount += iNumSamples;
+
+    if(m_lTriggerChannels.size() > 1) {
+        std::stable_sort(m_vEvents.begin(), m_vEvents.end(), [](const TriggerEvent& a, const TriggerEvent& b) {
+            return a.iSample < b.iSample;
+        });
+    }
+
+    return m_vEvents;
+}
+
+
+//*************************************************************************************************************
+
+void DetectTrigger::validateRun(ChannelState& state, int iChannelIdx, qint64 iBlockStart)
+{
+    state.bRunValid = true;
+
+    //Codes which start within the refractory period belong to the pulse which was reported last, e.g. the steps of an analog ramp
+    if(state.iRunStart - state.iLastOnset < m_iRefractorySamples) {
+        return;
+    }
+
+    state.bRunReported = true;
+    state.iLastOnset = state.iRunStart;
+
+    if(m_type & Rising) {
+        TriggerEvent event = {state.iRunStart, int(state.iRunStart - iBlockStart), iChannelIdx, state.iCode, Rising, state.dValue};
+        m_vEvents.append(event);
+    }
+}
+
+
+//*************************************************************************************************************
+
+void DetectTrigger::closeRun(ChannelState& state, int iChannelIdx, qint64 iEnd, qint64 iBlockStart)
 {
+    if(state.iCode == NoCode) {
+        return;
+    }
+
+    if(!state.bRunValid && iEnd - state.iRunStart >= m_iMinPulseSamples) {
+        validateRun(state, iChannelIdx, iBlockStart);
+    }
 
+    if(state.bRunReported && (m_type & Falling)) {
+        TriggerEvent event = {iEnd, int(iEnd - iBlockStart), iChannelIdx, state.iCode, Falling, state.dValue};
+        m_vEvents.append(event);
+    }
 }
 
 
@@ -50,6 +50,10 @@
 //=============================================================================================================
 
 #include <QSharedPointer>
+#include <QList>
+#include <QMap>
+#include <QPair>
+#include <QVector>
 
 
 //*************************************************************************************************************
@@ -84,7 +88,9 @@ using namespace Eigen;
 
 //=============================================================================================================
 /**
-* Routines for detecting trigger flanks in a given signal
+* Routines for detecting trigger flanks in a given signal. Besides the static block wise routines a DetectTrigger
+* object can be used as a streaming detector: it keeps the last trigger code of each channel between blocks, so
+* that every edge is reported exactly once with its absolute sample index, even when it lies on a block boundary.
 *
 * @brief Trigger flank detection
 */
@@ -95,12 +101,74 @@ public:
     typedef QSharedPointer<DetectTrigger> SPtr;            /**< Shared pointer type for DetectTrigger class. */
     typedef QSharedPointer<const DetectTrigger> ConstSPtr; /**< Const shared pointer type for DetectTrigger class. */
 
+    enum EdgeType {
+        Rising = 0x1,
+        Falling = 0x2,
+        RisingAndFalling = Rising | Falling
+    };
+
+    struct TriggerEvent {
+        qint64      iSample;        /**< Absolute sample index of the edge. */
+        int         iBlockSample;   /**< Column of the edge in the processed block. Negative if the edge lies in a previous block (see iMinPulseSamples). */
+        int         iChannelIdx;    /**< Row index of the trigger channel. */
+        int         iValue;         /**< Masked trigger code, i.e. the rounded sample value. The new code for rising and the old code for falling edges. */
+        EdgeType    type;           /**< Rising or falling edge. */
+        double      dValue;         /**< Raw sample value at the onset of the pulse, without offset removal. */
+    };
+
     //=========================================================================================================
     /**
-    * Destroys the DetectTrigger class.
+    * Constructs a DetectTrigger object. Use setTriggerChannels before streaming data to detectTriggerEvents.
     */
     DetectTrigger();
 
+    //=========================================================================================================
+    /**
+    * Sets the channels and parameters for the streaming detection and resets the detector.
+    * A sample is on if it is at or above dThreshold. The edges are the changes of this on/off state, so analog
+    * trigger pulses below 0.5 are found as well. While a channel is on, a change of its code round(value) & iMask is
+    * an edge, too. With a mask, samples whose masked code is 0 are off.
+    * An analog trigger ramps through several codes and may cross the threshold more than once. Use
+    * iRefractorySamples to report such a pulse once: a pulse which starts less than iRefractorySamples after the
+    * last reported onset of the channel is not reported, neither its rising nor its falling edge.
+    *
+    * @param[in] lTriggerChannels   The row indices of the trigger channels.
+    * @param[in] dThreshold         Samples below this value are off.
+    * @param[in] iMask              Bit mask which is applied to the trigger code, e.g. to pick the bits of STI101.
+    * @param[in] type               The edges which are to be reported.
+    * @param[in] iMinPulseSamples   Minimal number of samples a code has to be held to be reported. Used to reject short glitches.
+    * @param[in] bRemoveOffset      Whether the first sample after a reset is subtracted before the threshold is applied. This replaces the block wise offset removal of detectTriggerFlanksMax.
+    * @param[in] iRefractorySamples Number of samples after a reported onset in which no further pulse of the same channel is reported. This replaces the burst length of detectTriggerFlanksMax.
+    */
+    void setTriggerChannels(const QList<int>& lTriggerChannels, double dThreshold = 0.5, int iMask = -1, EdgeType type = Rising, int iMinPulseSamples = 1, bool bRemoveOffset = false, int iRefractorySamples = 0);
+
+    //=========================================================================================================
+    /**
+    * Resets the edge state of all channels. The next block starts at sample iFirstSample.
+    *
+    * @param[in] iFirstSample   The absolute sample index of the first sample of the next block.
+    */
+    void reset(qint64 iFirstSample = 0);
+
+    //=========================================================================================================
+    /**
+    * Detects the trigger edges in the next data block. The events are ordered by their sample index. The returned
+    * vector is reused by the next call, i.e. no memory is allocated once the detector is warmed up.
+    *
+    * @param[in] data   The next data block (channels x samples).
+    *
+    * @return the events found in the block.
+    */
+    const QVector<TriggerEvent>& detectTriggerEvents(const MatrixXd &data);
+
+    //=========================================================================================================
+    /**
+    * Returns the absolute sample index of the first sample of the next block.
+    *
+    * @return the number of processed samples including the initial offset.
+    */
+    inline qint64 sampleCount() const;
+
     //=========================================================================================================
     /**
     * detectTriggerFlanks detects flanks from a given data matrix in row wise order. This function uses a simple maxCoeff function implemented by eigen to locate the triggers.
@@ -162,6 +230,37 @@ public:
     * @param return     This list holds the found trigger indices and corresponding signal values.
     */
     static QList<QPair<int,double> > detectTriggerFlanksGrad(const MatrixXd &data, int iTriggerChannelIdx, int iOffsetIndex, double dThreshold, bool bRemoveOffset, const QString& type, int iBurstLengthSamp = 100);
+
+private:
+    struct ChannelState {
+        int     iCode;          /**< Current trigger code, NoCode while the channel is off. */
+        double  dValue;         /**< Raw sample value at the start of the current code. */
+        double  dOffset;        /**< Offset which is subtracted before the threshold is applied. */
+        qint64  iRunStart;      /**< Absolute sample index at which the current code started. */
+        bool    bRunValid;      /**< Whether the current code was held for iMinPulseSamples. */
+        bool    bRunReported;   /**< Whether the current code was reported, i.e. it is valid and not within the refractory period. */
+        qint64  iLastOnset;     /**< Absolute sample index of the last reported onset. */
+        bool    bOffsetSet;     /**< Whether the offset was taken from the first sample. */
+    };
+
+    static const int NoCode;    /**< Code of a channel which is off. */
+
+    void validateRun(ChannelState& state, int iChannelIdx, qint64 iBlockStart);
+
+    void closeRun(ChannelState& state, int iChannelIdx, qint64 iEnd, qint64 iBlockStart);
+
+    QList<int>                  m_lTriggerChannels;     /**< Row indices of the trigger channels. */
+    double                      m_dThreshold;           /**< Samples below this value are treated as 0. */
+    int                         m_iMask;                /**< Bit mask applied to the trigger codes. */
+    EdgeType                    m_type;                 /**< The edges which are to be reported. */
+    int                         m_iMinPulseSamples;     /**< Minimal number of samples a code has to be held. */
+    bool                        m_bRemoveOffset;        /**< Whether the first sample after a reset is subtracted. */
+    int                         m_iRefractorySamples;   /**< Number of samples after a reported onset in which no further pulse is reported. */
+    qint64                      m_iSampleCount;         /**< Absolute sample index of the next block. */
+    QVector<ChannelState>       m_vChannelStates;       /**< Edge state of each trigger channel. */
+    QVector<TriggerEvent>       m_vEvents;              /**< Events of the last block. */
+    ArrayXi                     m_vecCodes;             /**< Trigger codes of the current channel and block, NoCode where the channel is off. */
+    Array<bool,Dynamic,1>       m_vecChanged;           /**< Whether the code changed at a sample of the current block. */
 };
 
 //*************************************************************************************************************
@@ -169,6 +268,11 @@ public:
 // INLINE DEFINITIONS
 //=============================================================================================================
 
+inline qint64 DetectTrigger::sampleCount() const
+{
+    return m_iSampleCount;
+}
+
 
 } // NAMESPACE
 
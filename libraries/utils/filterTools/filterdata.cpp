@@ -54,6 +54,7 @@
 //=============================================================================================================
 
 #include <iostream>
+#include <cmath>
 
 
 //*************************************************************************************************************
@@ -98,6 +99,7 @@ FilterData::FilterData()
 , m_sFreq(1000)
 , m_dLowpassFreq(4)
 , m_dHighpassFreq(40)
+, m_iIIROrder(4)
 {
 
 }
@@ -105,7 +107,7 @@ FilterData::FilterData()
 
 //*************************************************************************************************************
 
-FilterData::FilterData(QString unique_name, FilterType type, int order, double centerfreq, double bandwidth, double parkswidth, double sFreq, qint32 fftlength, DesignMethod designMethod)
+FilterData::FilterData(QString unique_name, FilterType type, int order, double centerfreq, double bandwidth, double parkswidth, double sFreq, qint32 fftlength, DesignMethod designMethod, int iirOrder)
 : m_Type(type)
 , m_iFilterOrder(order)
 , m_iFFTlength(fftlength)
@@ -115,6 +117,7 @@ FilterData::FilterData(QString unique_name, FilterType type, int order, double c
 , m_dCenterFreq(centerfreq)
 , m_dBandwidth(bandwidth)
 , m_sFreq(sFreq)
+, m_iIIROrder(iirOrder)
 {
     designFilter();
 }
@@ -124,6 +127,8 @@ FilterData::FilterData(QString unique_name, FilterType type, int order, double c
 
 void FilterData::designFilter()
 {
+    m_matSOS.resize(0, 6);
+
     switch(m_designMethod) {
         case Tschebyscheff: {
             ParksMcClellan filter(m_iFilterOrder, m_dCenterFreq, m_dBandwidth, m_dParksWidth, (ParksMcClellan::TPassType)m_Type);
@@ -183,6 +188,54 @@ void FilterData::designFilter()
 
             break;
         }
+
+        case Butterworth: {
+            double dNyquist = m_sFreq/2;
+
+            switch(m_Type) {
+                case LPF:
+                    m_matSOS = butterworthSections(m_iIIROrder, m_dCenterFreq*dNyquist, m_sFreq, false);
+                    break;
+
+                case HPF:
+                    m_matSOS = butterworthSections(m_iIIROrder, m_dCenterFreq*dNyquist, m_sFreq, true);
+                    break;
+
+                case BPF: {
+                    MatrixXd matHighpass = butterworthSections(m_iIIROrder, (m_dCenterFreq - m_dBandwidth/2)*dNyquist, m_sFreq, true);
+                    MatrixXd matLowpass = butterworthSections(m_iIIROrder, (m_dCenterFreq + m_dBandwidth/2)*dNyquist, m_sFreq, false);
+                    m_matSOS.resize(matHighpass.rows() + matLowpass.rows(), 6);
+                    m_matSOS << matHighpass, matLowpass;
+                    break;
+                }
+
+                case NOTCH:
+                    m_matSOS = notchSection(m_dCenterFreq*dNyquist, m_dBandwidth*dNyquist, m_sFreq);
+                    break;
+
+                default:
+                    break;
+            }
+
+            //Zero-phase FIR version for the offline and FFT based filtering: the autocorrelation of the impulse response
+            //equals filtering forward and backward with the IIR filter
+            RowVectorXd vecImpulse = RowVectorXd::Zero(m_iFilterOrder);
+            if(m_iFilterOrder > 0)
+                vecImpulse(0) = 1.0;
+            vecImpulse = applySOS(m_matSOS, vecImpulse);
+
+            m_dCoeffA = RowVectorXd::Zero(m_iFilterOrder);
+            for(int k = 0; k < m_iFilterOrder/2; ++k) {
+                double dValue = vecImpulse.head(m_iFilterOrder-k).dot(vecImpulse.tail(m_iFilterOrder-k));
+                m_dCoeffA(m_iFilterOrder/2 + k) = dValue;
+                if(k > 0)
+                    m_dCoeffA(m_iFilterOrder/2 - k) = dValue;
+            }
+
+            fftTransformCoeffs();
+
+            break;
+        }
     }
 
     switch(m_Type) {
@@ -338,6 +391,9 @@ QString FilterData::getStringForDesignMethod(const FilterData::DesignMethod &des
     if(designMethod == FilterData::Tschebyscheff)
         designMethodString = "Tschebyscheff";
 
+    if(designMethod == FilterData::Butterworth)
+        designMethodString = "Butterworth";
+
     return designMethodString;
 }
 
@@ -379,6 +435,9 @@ FilterData::DesignMethod FilterData::getDesignMethodForString(const QString &des
     if(designMethodString == "Cosine")
         designMethod = FilterData::Cosine;
 
+    if(designMethodString == "Butterworth")
+        designMethod = FilterData::Butterworth;
+
     return designMethod;
 }
 
@@ -403,3 +462,94 @@ FilterData::FilterType FilterData::getFilterTypeForString(const QString &filterT
 
     return filterType;
 }
+
+
+//*************************************************************************************************************
+
+RowVectorXd FilterData::applySOS(const MatrixXd& matSOS, const RowVectorXd& data)
+{
+    RowVectorXd vecFiltered = data;
+
+    //Transposed direct form II, one section after another
+    for(int s = 0; s < matSOS.rows(); ++s) {
+        double b0 = matSOS(s,0), b1 = matSOS(s,1), b2 = matSOS(s,2);
+        double a1 = matSOS(s,4), a2 = matSOS(s,5);
+        double z1 = 0.0, z2 = 0.0;
+
+        for(int i = 0; i < vecFiltered.cols(); ++i) {
+            double x = vecFiltered(i);
+            double y = b0*x + z1;
+            z1 = b1*x - a1*y + z2;
+            z2 = b2*x - a2*y;
+            vecFiltered(i) = y;
+        }
+    }
+
+    return vecFiltered;
+}
+
+
+//*************************************************************************************************************
+
+MatrixXd FilterData::butterworthSections(int iOrder, double dCutOff, double dSFreq, bool bHighpass)
+{
+    iOrder = qMax(iOrder, 1);
+
+    MatrixXd matSOS = MatrixXd::Zero((iOrder+1)/2, 6);
+
+    //Bilinear transform with prewarped cut off frequency
+    double K = tan(M_PI * qBound(1e-6, dCutOff/dSFreq, 0.5 - 1e-6));
+    double K2 = K*K;
+
+    //Conjugate pole pairs of the analog prototype
+    for(int k = 0; k < iOrder/2; ++k) {
+        double Q = 1.0 / (2.0 * sin(M_PI * (2*k + 1) / (2.0 * iOrder)));
+        double norm = 1.0 / (1.0 + K/Q + K2);
+
+        if(bHighpass) {
+            matSOS(k,0) = norm;
+            matSOS(k,1) = -2.0 * norm;
+        } else {
+            matSOS(k,0) = K2 * norm;
+            matSOS(k,1) = 2.0 * K2 * norm;
+        }
+        matSOS(k,2) = matSOS(k,0);
+        matSOS(k,3) = 1.0;
+        matSOS(k,4) = 2.0 * (K2 - 1.0) * norm;
+        matSOS(k,5) = (1.0 - K/Q + K2) * norm;
+    }
+
+    //Real pole of odd orders
+    if(iOrder % 2 == 1) {
+        int k = iOrder/2;
+        double norm = 1.0 / (K + 1.0);
+
+        matSOS(k,0) = bHighpass ? norm : K * norm;
+        matSOS(k,1) = bHighpass ? -norm : K * norm;
+        matSOS(k,3) = 1.0;
+        matSOS(k,4) = (K - 1.0) * norm;
+    }
+
+    return matSOS;
+}
+
+
+//*************************************************************************************************************
+
+MatrixXd FilterData::notchSection(double dCenterFreq, double dBandwidth, double dSFreq)
+{
+    MatrixXd matSOS(1, 6);
+
+    double w0 = 2.0 * M_PI * qBound(1e-6, dCenterFreq/dSFreq, 0.5 - 1e-6);
+    double alpha = sin(w0) * qMax(dBandwidth, 1e-6) / (2.0 * qMax(dCenterFreq, 1e-6));
+    double norm = 1.0 / (1.0 + alpha);
+
+    matSOS(0,0) = norm;
+    matSOS(0,1) = -2.0 * cos(w0) * norm;
+    matSOS(0,2) = norm;
+    matSOS(0,3) = 1.0;
+    matSOS(0,4) = -2.0 * cos(w0) * norm;
+    matSOS(0,5) = (1.0 - alpha) * norm;
+
+    return matSOS;
+}
@@ -102,7 +102,8 @@ public:
     enum DesignMethod {
         Tschebyscheff,
         Cosine,
-        External
+        External,
+        Butterworth
     } m_designMethod;
 
     enum FilterType {
@@ -135,8 +136,9 @@ public:
     * @param [in] sFreq sampling frequency
     * @param [in] fftlength length of the fft (multiple integer of 2^x)
     * @param [in] designMethod specifies the design method to use. Choose between Cosind and Tschebyscheff
+    * @param [in] iirOrder order of the Butterworth design, ignored by the other design methods and by notch filters
     */
-    FilterData(QString unique_name, FilterType type, int order, double centerfreq, double bandwidth, double parkswidth, double sFreq, qint32 fftlength=4096, DesignMethod designMethod = Cosine);
+    FilterData(QString unique_name, FilterType type, int order, double centerfreq, double bandwidth, double parkswidth, double sFreq, qint32 fftlength=4096, DesignMethod designMethod = Cosine, int iirOrder = 4);
 
     /**
      * @brief fftTransformCoeffs transforms the calculated filter coefficients to frequency-domain
@@ -148,6 +150,15 @@ public:
      */
     void designFilter();
 
+    //=========================================================================================================
+    /**
+    * Returns whether the filter is an IIR filter given by second-order sections (m_matSOS). IIR filters can be
+    * applied sample by sample without the group delay of the FIR filters.
+    *
+    * @return true if the filter is an IIR filter.
+    */
+    inline bool isIIR() const;
+
     /**
     * Applies the current filter to the input data using convolution in time domain. Pro: Uses only past samples (real-time capable) Con: Might not be as ideal as acausal version (steepness etc.)
     *
@@ -189,6 +200,21 @@ public:
      */
     static FilterData::FilterType getFilterTypeForString(const QString &filerTypeString);
 
+    /**
+     * @brief applySOS filters the data causally with the given second-order sections, starting from rest
+     */
+    static RowVectorXd applySOS(const MatrixXd& matSOS, const RowVectorXd& data);
+
+    /**
+     * @brief butterworthSections designs a Butterworth low- or highpass of the given order as second-order sections
+     */
+    static MatrixXd butterworthSections(int iOrder, double dCutOff, double dSFreq, bool bHighpass);
+
+    /**
+     * @brief notchSection designs a second-order notch filter with the given center frequency and bandwidth in Hz
+     */
+    static MatrixXd notchSection(double dCenterFreq, double dBandwidth, double dSFreq);
+
     double          m_sFreq;            /**< the sampling frequency. */
     int             m_iFilterOrder;     /**< represents the order of the filter instance. */
     int             m_iFFTlength;       /**< represents the filter length. */
@@ -206,6 +232,9 @@ public:
 
     RowVectorXcd    m_dFFTCoeffA;       /**< the FFT-transformed forward filter coefficient set, required for frequency-domain filtering, zero-padded to m_iFFTlength. */
     RowVectorXcd    m_dFFTCoeffB;       /**< the FFT-transformed backward filter coefficient set, required for frequency-domain filtering, zero-padded to m_iFFTlength. */
+
+    int             m_iIIROrder;        /**< order of the Butterworth design, the notch is always of second order. */
+    MatrixXd        m_matSOS;           /**< second-order sections of IIR filters, one section per row: b0 b1 b2 a0 a1 a2 with a0 = 1. Empty if FIR filter. */
 };
 
 //*************************************************************************************************************
@@ -213,6 +242,11 @@ public:
 // INLINE DEFINITIONS
 //=============================================================================================================
 
+inline bool FilterData::isIIR() const
+{
+    return m_matSOS.rows() > 0;
+}
+
 } // NAMESPACE UTILSLIB
 
 #ifndef metatype_filtertype
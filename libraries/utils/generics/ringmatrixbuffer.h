@@ -0,0 +1,572 @@
+//=============================================================================================================
+/**
+* @file     ringmatrixbuffer.h
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    RingMatrixBuffer class declaration
+*
+*/
+
+
+#ifndef RINGMATRIXBUFFER_H
+#define RINGMATRIXBUFFER_H
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "../utils_global.h"
+#include "buffer.h"
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <typeinfo>
+#include <climits>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// Eigen INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// Qt INCLUDES
+//=============================================================================================================
+
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSharedPointer>
+#include <QWaitCondition>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE NAMESPACE IOBUFFER
+//=============================================================================================================
+
+namespace IOBUFFER
+{
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace Eigen;
+
+
+//=============================================================================================================
+/**
+* Lock-free single producer / single consumer ring of preallocated matrix slots. It has the interface of
+* CircularMatrixBuffer and can replace it wherever exactly one thread pushes and one thread pops. A push or pop
+* copies (or swaps) one whole matrix and publishes it with a single atomic index update. Only when the ring is
+* full or empty the calling thread sleeps on a wait condition, optionally with a timeout.
+*
+* @brief Lock-free single producer / single consumer matrix ring buffer
+*/
+template<typename _Tp>
+class RingMatrixBuffer : public Buffer
+{
+public:
+    typedef QSharedPointer<RingMatrixBuffer> SPtr;              /**< Shared pointer type for RingMatrixBuffer. */
+    typedef QSharedPointer<const RingMatrixBuffer> ConstSPtr;   /**< Const shared pointer type for RingMatrixBuffer. */
+
+    //=========================================================================================================
+    /**
+    * Constructs a RingMatrixBuffer and preallocates all matrix slots.
+    *
+    * @param [in] uiMaxNumMatrices  length of buffer.
+    * @param [in] uiRows            Number of rows.
+    * @param [in] uiCols            Number of columns.
+    */
+    explicit RingMatrixBuffer(unsigned int uiMaxNumMatrices, unsigned int uiRows, unsigned int uiCols);
+
+    //=========================================================================================================
+    /**
+    * Destroys the RingMatrixBuffer.
+    */
+    ~RingMatrixBuffer();
+
+    //=========================================================================================================
+    /**
+    * Copies a matrix into the next free slot. Blocks while the buffer is full.
+    *
+    * @param [in] pMatrix           pointer to a Matrix which should be apend to the end.
+    * @param [in] iTimeoutMsecs     maximal time to wait for a free slot, -1 waits until a slot is free.
+    *
+    * @return true if the matrix was added, false on timeout, release, pause or wrong dimensions.
+    */
+    inline bool push(const Matrix<_Tp, Dynamic, Dynamic>* pMatrix, int iTimeoutMsecs = -1);
+
+    //=========================================================================================================
+    /**
+    * Swaps a matrix into the next free slot without copying. Afterwards the matrix holds the previous content of
+    * the slot, which has the same dimensions and can be refilled without allocation.
+    *
+    * @param [in, out] matrix       the Matrix which should be apend to the end.
+    * @param [in] iTimeoutMsecs     maximal time to wait for a free slot, -1 waits until a slot is free.
+    *
+    * @return true if the matrix was added, false on timeout, release, pause or wrong dimensions.
+    */
+    inline bool pushSwap(Matrix<_Tp, Dynamic, Dynamic>& matrix, int iTimeoutMsecs = -1);
+
+    //=========================================================================================================
+    /**
+    * Returns a copy of the first matrix (first in first out). Blocks while the buffer is empty. When the buffer
+    * is paused or released, a zero matrix is returned.
+    *
+    * @return the first matrix
+    */
+    inline Matrix<_Tp, Dynamic, Dynamic> pop();
+
+    //=========================================================================================================
+    /**
+    * Swaps the first matrix (first in first out) out of its slot without copying. The slot takes over the
+    * storage of the given matrix.
+    *
+    * @param [out] matrix           receives the first matrix.
+    * @param [in] iTimeoutMsecs     maximal time to wait for a matrix, -1 waits until a matrix is available.
+    *
+    * @return true if a matrix was popped, false on timeout, release or pause.
+    */
+    inline bool pop(Matrix<_Tp, Dynamic, Dynamic>& matrix, int iTimeoutMsecs = -1);
+
+    //=========================================================================================================
+    /**
+    * Clears the buffer. Must not be called while the consumer pops.
+    */
+    void clear();
+
+    //=========================================================================================================
+    /**
+    * Size of the buffer.
+    */
+    inline quint32 size() const;
+
+    //=========================================================================================================
+    /**
+    * Rows of the stored matrices of the buffer.
+    */
+    inline quint32 rows() const;
+
+    //=========================================================================================================
+    /**
+    * Cols of the stored matrices of the buffer.
+    */
+    inline quint32 cols() const;
+
+    //=========================================================================================================
+    /**
+    * Pauses the buffer. Skpis any incoming matrices and only pops zero matrices.
+    */
+    inline void pause(bool);
+
+    //=========================================================================================================
+    /**
+    * Releases a pop() which waits for a matrix.
+    * @param [out] bool returns true if the buffer was empty, i.e. a pop() might have been waiting, otherwise false.
+    */
+    inline bool releaseFromPop();
+
+    //=========================================================================================================
+    /**
+    * Releases a push() which waits for a free slot.
+    * @param [out] bool returns true if the buffer was full, i.e. a push() might have been waiting, otherwise false.
+    */
+    inline bool releaseFromPush();
+
+private:
+    //=========================================================================================================
+    /**
+    * Returns whether the ring is empty (bPush = false) or full (bPush = true).
+    *
+    * @param [in] bPush     whether the producer or the consumer asks.
+    * @return true if the caller has to wait.
+    */
+    inline bool isBlocked(bool bPush);
+
+    //=========================================================================================================
+    /**
+    * Sleeps until the caller can push (bPush = true) or pop (bPush = false).
+    *
+    * @param [in] bPush             whether the producer or the consumer waits.
+    * @param [in] iTimeoutMsecs     maximal time to wait, -1 waits without limit.
+    * @return true if the caller can proceed, false on timeout or release.
+    */
+    bool waitFor(bool bPush, int iTimeoutMsecs);
+
+    //=========================================================================================================
+    /**
+    * Wakes the other side if it sleeps in waitFor().
+    *
+    * @param [in] bPush     true to wake the producer, false to wake the consumer.
+    */
+    inline void wake(bool bPush);
+
+    //=========================================================================================================
+    /**
+    * Returns the slot index following the given one.
+    *
+    * @param [in] index     the slot index.
+    * @return the next slot index.
+    */
+    inline int nextIndex(int index) const;
+
+    unsigned int                    m_uiMaxNumMatrices;     /**< Holds the maximal number of matrices.*/
+    unsigned int                    m_uiRows;               /**< Holds the number rows.*/
+    unsigned int                    m_uiCols;               /**< Holds the number cols.*/
+    int                             m_iNumSlots;            /**< Number of slots, one more than m_uiMaxNumMatrices to distinguish full from empty.*/
+    Matrix<_Tp, Dynamic, Dynamic>*  m_pSlots;               /**< Holds the preallocated matrix slots.*/
+    QAtomicInt                      m_iReadIndex;           /**< Slot which is popped next, only advanced by the consumer.*/
+    QAtomicInt                      m_iWriteIndex;          /**< Slot which is pushed next, only advanced by the producer.*/
+    QAtomicInt                      m_iPushWaiting;         /**< Whether the producer sleeps.*/
+    QAtomicInt                      m_iPopWaiting;          /**< Whether the consumer sleeps.*/
+    QAtomicInt                      m_iReleasePush;         /**< Set by releaseFromPush(), consumed by a waiting push.*/
+    QAtomicInt                      m_iReleasePop;          /**< Set by releaseFromPop(), consumed by a waiting pop.*/
+    QMutex                          m_qMutex;               /**< Only used to sleep on the wait conditions.*/
+    QWaitCondition                  m_qNotFull;             /**< Signaled when a matrix was popped.*/
+    QWaitCondition                  m_qNotEmpty;            /**< Signaled when a matrix was pushed.*/
+    QAtomicInt                      m_iPause;               /**< Whether the buffer is paused, set from any thread.*/
+};
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+template<typename _Tp>
+RingMatrixBuffer<_Tp>::RingMatrixBuffer(unsigned int uiMaxNumMatrices, unsigned int uiRows, unsigned int uiCols)
+: Buffer(typeid(_Tp).name())
+, m_uiMaxNumMatrices(uiMaxNumMatrices)
+, m_uiRows(uiRows)
+, m_uiCols(uiCols)
+, m_iNumSlots(uiMaxNumMatrices + 1)
+, m_pSlots(new Matrix<_Tp, Dynamic, Dynamic>[m_iNumSlots])
+, m_iReadIndex(0)
+, m_iWriteIndex(0)
+, m_iPushWaiting(0)
+, m_iPopWaiting(0)
+, m_iReleasePush(0)
+, m_iReleasePop(0)
+, m_iPause(0)
+{
+    for(int i = 0; i < m_iNumSlots; ++i)
+        m_pSlots[i].setZero(m_uiRows, m_uiCols);
+}
+
+
+//*************************************************************************************************************
+
+template<typename _Tp>
+RingMatrixBuffer<_Tp>::~RingMatrixBuffer()
+{
+    delete [] m_pSlots;
+}
+
+
+//*************************************************************************************************************
+
+template<typename _Tp>
+inline bool RingMatrixBuffer<_Tp>::push(const Matrix<_Tp, Dynamic, Dynamic>* pMatrix, int iTimeoutMsecs)
+{
+    if(m_iPause.loadAcquire())
+        return false;
+
+    if(pMatrix->rows() != (int)m_uiRows || pMatrix->cols() != (int)m_uiCols) {
+        printf("Error: Matrix not appended to RingMatrixBuffer - wrong dimensions\n");
+        return false;
+    }
+
+    if(!waitFor(true, iTimeoutMsecs))
+        return false;
+
+    int iWrite = m_iWriteIndex.loadAcquire();
+    m_pSlots[iWrite] = *pMatrix;
+    m_iWriteIndex.fetchAndStoreOrdered(nextIndex(iWrite));
+
+    wake(false);
+    return true;
+}
+
+
+//*************************************************************************************************************
+
+template<typename _Tp>
+inline bool RingMatrixBuffer<_Tp>::pushSwap(Matrix<_Tp, Dynamic, Dynamic>& matrix, int iTimeoutMsecs)
+{
+    if(m_iPause.loadAcquire())
+        return false;
+
+    if(matrix.rows() != (int)m_uiRows || matrix.cols() != (int)m_uiCols) {
+        printf("Error: Matrix not appended to RingMatrixBuffer - wrong dimensions\n");
+        return false;
+    }
+
+    if(!waitFor(true, iTimeoutMsecs))
+        return false;
+
+    int iWrite = m_iWriteIndex.loadAcquire();
+    m_pSlots[iWrite].swap(matrix);
+    m_iWriteIndex.fetchAndStoreOrdered(nextIndex(iWrite));
+
+    wake(false);
+    return true;
+}
+
+
+//*************************************************************************************************************
+
+template<typename _Tp>
+inline Matrix<_Tp, Dynamic, Dynamic> RingMatrixBuffer<_Tp>::pop()
+{
+    Matrix<_Tp, Dynamic, Dynamic> matrix;
+
+    if(m_iPause.loadAcquire() || !waitFor(false, -1)) {
+        matrix.setZero(m_uiRows, m_uiCols);
+        return matrix;
+    }
+
+    int iRead = m_iReadIndex.loadAcquire();
+    matrix = m_pSlots[iRead];
+    m_iReadIndex.fetchAndStoreOrdered(nextIndex(iRead));
+
+    wake(true);
+    return matrix;
+}
+
+
+//*************************************************************************************************************
+
+template<typename _Tp>
+inline bool RingMatrixBuffer<_Tp>::pop(Matrix<_Tp, Dynamic, Dynamic>& matrix, int iTimeoutMsecs)
+{
+    if(m_iPause.loadAcquire() || !waitFor(false, iTimeoutMsecs))
+        return false;
+
+    int iRead = m_iReadIndex.loadAcquire();
+    m_pSlots[iRead].swap(matrix);
+    m_iReadIndex.fetchAndStoreOrdered(nextIndex(iRead));
+
+    wake(true);
+    return true;
+}
+
+
+//*************************************************************************************************************
+
+template<typename _Tp>
+void RingMatrixBuffer<_Tp>::clear()
+{
+    m_iReadIndex.fetchAndStoreOrdered(m_iWriteIndex.loadAcquire());
+
+    wake(true);
+}
+
+
+//*************************************************************************************************************
+
+template<typename _Tp>
+inline quint32 RingMatrixBuffer<_Tp>::size() const
+{
+    return m_uiMaxNumMatrices;
+}
+
+
+//*************************************************************************************************************
+
+template<typename _Tp>
+inline quint32 RingMatrixBuffer<_Tp>::rows() const
+{
+    return m_uiRows;
+}
+
+
+//*************************************************************************************************************
+
+template<typename _Tp>
+inline quint32 RingMatrixBuffer<_Tp>::cols() const
+{
+    return m_uiCols;
+}
+
+
+//*************************************************************************************************************
+
+template<typename _Tp>
+inline void RingMatrixBuffer<_Tp>::pause(bool bPause)
+{
+    m_iPause.storeRelease(bPause ? 1 : 0);
+}
+
+
+//*************************************************************************************************************
+
+template<typename _Tp>
+inline bool RingMatrixBuffer<_Tp>::releaseFromPop()
+{
+    if(isBlocked(false)) {
+        m_iReleasePop.fetchAndStoreOrdered(1);
+
+        QMutexLocker locker(&m_qMutex);
+        m_qNotEmpty.wakeAll();
+
+        return true;
+    }
+
+    return false;
+}
+
+
+//*************************************************************************************************************
+
+template<typename _Tp>
+inline bool RingMatrixBuffer<_Tp>::releaseFromPush()
+{
+    if(isBlocked(true)) {
+        m_iReleasePush.fetchAndStoreOrdered(1);
+
+        QMutexLocker locker(&m_qMutex);
+        m_qNotFull.wakeAll();
+
+        return true;
+    }
+
+    return false;
+}
+
+
+//*************************************************************************************************************
+
+template<typename _Tp>
+inline bool RingMatrixBuffer<_Tp>::isBlocked(bool bPush)
+{
+    //Ordered loads, so that the check cannot move before the waiting flag was published in waitFor()
+    int iRead = m_iReadIndex.fetchAndAddOrdered(0);
+    int iWrite = m_iWriteIndex.fetchAndAddOrdered(0);
+
+    return bPush ? nextIndex(iWrite) == iRead : iWrite == iRead;
+}
+
+
+//*************************************************************************************************************
+
+template<typename _Tp>
+bool RingMatrixBuffer<_Tp>::waitFor(bool bPush, int iTimeoutMsecs)
+{
+    if(!isBlocked(bPush))
+        return true;
+
+    QAtomicInt& iWaiting = bPush ? m_iPushWaiting : m_iPopWaiting;
+    QAtomicInt& iRelease = bPush ? m_iReleasePush : m_iReleasePop;
+    QWaitCondition& waitCondition = bPush ? m_qNotFull : m_qNotEmpty;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    bool bReady = true;
+
+    QMutexLocker locker(&m_qMutex);
+    iWaiting.fetchAndStoreOrdered(1);
+
+    while(isBlocked(bPush)) {
+        if(iRelease.fetchAndStoreOrdered(0)) {
+            bReady = false;
+            break;
+        }
+
+        unsigned long ulWait = ULONG_MAX;
+        if(iTimeoutMsecs >= 0) {
+            qint64 iRemaining = iTimeoutMsecs - timer.elapsed();
+            if(iRemaining <= 0) {
+                bReady = false;
+                break;
+            }
+            ulWait = (unsigned long)iRemaining;
+        }
+
+        waitCondition.wait(&m_qMutex, ulWait);
+    }
+
+    iWaiting.fetchAndStoreOrdered(0);
+
+    return bReady;
+}
+
+
+//*************************************************************************************************************
+
+template<typename _Tp>
+inline void RingMatrixBuffer<_Tp>::wake(bool bPush)
+{
+    QAtomicInt& iWaiting = bPush ? m_iPushWaiting : m_iPopWaiting;
+
+    //Only take the mutex if the other side announced that it sleeps
+    if(iWaiting.fetchAndAddOrdered(0)) {
+        QMutexLocker locker(&m_qMutex);
+        (bPush ? m_qNotFull : m_qNotEmpty).wakeAll();
+    }
+}
+
+
+//*************************************************************************************************************
+
+template<typename _Tp>
+inline int RingMatrixBuffer<_Tp>::nextIndex(int index) const
+{
+    return (index + 1) % m_iNumSlots;
+}
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// TYPEDEF
+//=============================================================================================================
+
+//ToDo Typedef -> warning visibility ignored -> dllexport/dllimport problem
+
+typedef UTILSSHARED_EXPORT RingMatrixBuffer<int>                      _int_RingMatrixBuffer;                 /**< Defines RingMatrixBuffer of integer type.*/
+typedef UTILSSHARED_EXPORT RingMatrixBuffer<float>                    _float_RingMatrixBuffer;               /**< Defines RingMatrixBuffer of float type.*/
+typedef UTILSSHARED_EXPORT RingMatrixBuffer<double>                   _double_RingMatrixBuffer;              /**< Defines RingMatrixBuffer of double type.*/
+
+} // NAMESPACE
+
+#endif // RINGMATRIXBUFFER_H
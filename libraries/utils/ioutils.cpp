@@ -47,6 +47,38 @@
 //=============================================================================================================
 
 #include <QDataStream>
+#include <QtEndian>
+#include <QtAlgorithms>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <cstring>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// SIMD INCLUDES
+//=============================================================================================================
+
+/**
+* The array routines pick their kernel at runtime. Kernels for newer instruction sets are compiled with function
+* target attributes (GCC, Clang) or are always available (MSVC), so the library itself is built for the
+* baseline architecture.
+*/
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define IOUTILS_SIMD_X86
+    #define IOUTILS_TARGET(isa) __attribute__((target(isa)))
+    #include <immintrin.h>
+#elif defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+    #define IOUTILS_SIMD_X86
+    #define IOUTILS_TARGET(isa)
+    #include <intrin.h>
+    #include <immintrin.h>
+#endif
 
 
 //*************************************************************************************************************
@@ -66,6 +98,329 @@ using namespace Eigen;
 using namespace UTILSLIB;
 
 
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+enum SwapInstructionSet {
+    SwapScalar,
+    SwapSsse3,
+    SwapAvx2
+};
+
+
+//*************************************************************************************************************
+
+static SwapInstructionSet detect_swap_instruction_set()
+{
+#if defined(IOUTILS_SIMD_X86) && defined(__GNUC__)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2"))
+        return SwapAvx2;
+    if(__builtin_cpu_supports("ssse3"))
+        return SwapSsse3;
+#elif defined(IOUTILS_SIMD_X86)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+    __cpuid(info, 1);
+    bool ssse3 = (info[2] & (1 << 9)) != 0;
+    bool avx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+    if(avx && maxLeaf >= 7) {
+        __cpuidex(info, 7, 0);
+        if(info[1] & (1 << 5))
+            return SwapAvx2;
+    }
+    if(ssse3)
+        return SwapSsse3;
+#endif
+    return SwapScalar;
+}
+
+
+//*************************************************************************************************************
+
+static SwapInstructionSet active_swap_instruction_set()
+{
+    static const SwapInstructionSet s_instructionSet = detect_swap_instruction_set();
+    return s_instructionSet;
+}
+
+
+//*************************************************************************************************************
+
+static void swap_bytes_scalar(uchar *data, qint64 count, int width)
+{
+    for(qint64 k = 0; k < count; ++k, data += width)
+        for(int i = 0; i < width/2; ++i)
+            qSwap(data[i], data[width-1-i]);
+}
+
+
+//*************************************************************************************************************
+
+template<typename T, typename D>
+static void be_to_native_scalar(const uchar *source, D *dest, qint64 count)
+{
+    for(qint64 k = 0; k < count; ++k)
+        dest[k] = (D)qFromBigEndian<T>(source + k*sizeof(T));
+}
+
+
+//*************************************************************************************************************
+
+static inline float be_float_scalar(const uchar *source)
+{
+    quint32 bits = qFromBigEndian<quint32>(source);
+    float value;
+    memcpy(&value, &bits, sizeof(float));
+    return value;
+}
+
+
+//*************************************************************************************************************
+
+template<typename D>
+static void be_float_to_native_scalar(const uchar *source, D *dest, qint64 count)
+{
+    for(qint64 k = 0; k < count; ++k)
+        dest[k] = (D)be_float_scalar(source + k*sizeof(float));
+}
+
+
+#ifdef IOUTILS_SIMD_X86
+
+//*************************************************************************************************************
+/**
+* Byte shuffle which reverses each element of the given width within 16 bytes.
+*/
+IOUTILS_TARGET("ssse3")
+static inline __m128i swap_mask_ssse3(int width)
+{
+    if(width == 2)
+        return _mm_setr_epi8(1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14);
+    if(width == 4)
+        return _mm_setr_epi8(3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12);
+    return _mm_setr_epi8(7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8);
+}
+
+
+//*************************************************************************************************************
+
+IOUTILS_TARGET("ssse3")
+static qint64 swap_bytes_ssse3(uchar *data, qint64 nbytes, int width)
+{
+    const __m128i mask = swap_mask_ssse3(width);
+    qint64 i = 0;
+    for(; i + 16 <= nbytes; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(data + i));
+        _mm_storeu_si128((__m128i*)(data + i), _mm_shuffle_epi8(v, mask));
+    }
+    return i;
+}
+
+
+//*************************************************************************************************************
+
+IOUTILS_TARGET("avx2")
+static qint64 swap_bytes_avx2(uchar *data, qint64 nbytes, int width)
+{
+    const __m256i mask = _mm256_broadcastsi128_si256(swap_mask_ssse3(width));
+    qint64 i = 0;
+    for(; i + 32 <= nbytes; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(data + i));
+        _mm256_storeu_si256((__m256i*)(data + i), _mm256_shuffle_epi8(v, mask));
+    }
+    return i;
+}
+
+
+//*************************************************************************************************************
+/**
+* The fused kernels return the number of converted values, the caller converts the remainder.
+*/
+IOUTILS_TARGET("ssse3")
+static qint64 be_short_to_double_ssse3(const uchar *source, double *dest, qint64 count)
+{
+    const __m128i mask = swap_mask_ssse3(2);
+    qint64 k = 0;
+    for(; k + 8 <= count; k += 8) {
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(source + 2*k)), mask);
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_pd(dest + k,     _mm_cvtepi32_pd(lo));
+        _mm_storeu_pd(dest + k + 2, _mm_cvtepi32_pd(_mm_unpackhi_epi64(lo, lo)));
+        _mm_storeu_pd(dest + k + 4, _mm_cvtepi32_pd(hi));
+        _mm_storeu_pd(dest + k + 6, _mm_cvtepi32_pd(_mm_unpackhi_epi64(hi, hi)));
+    }
+    return k;
+}
+
+
+//*************************************************************************************************************
+
+IOUTILS_TARGET("avx2")
+static qint64 be_short_to_double_avx2(const uchar *source, double *dest, qint64 count)
+{
+    const __m128i mask = swap_mask_ssse3(2);
+    qint64 k = 0;
+    for(; k + 8 <= count; k += 8) {
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(source + 2*k)), mask);
+        __m256i i32 = _mm256_cvtepi16_epi32(v);
+        _mm256_storeu_pd(dest + k,     _mm256_cvtepi32_pd(_mm256_castsi256_si128(i32)));
+        _mm256_storeu_pd(dest + k + 4, _mm256_cvtepi32_pd(_mm256_extracti128_si256(i32, 1)));
+    }
+    return k;
+}
+
+
+//*************************************************************************************************************
+
+IOUTILS_TARGET("ssse3")
+static qint64 be_int_to_double_ssse3(const uchar *source, double *dest, qint64 count)
+{
+    const __m128i mask = swap_mask_ssse3(4);
+    qint64 k = 0;
+    for(; k + 4 <= count; k += 4) {
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(source + 4*k)), mask);
+        _mm_storeu_pd(dest + k,     _mm_cvtepi32_pd(v));
+        _mm_storeu_pd(dest + k + 2, _mm_cvtepi32_pd(_mm_unpackhi_epi64(v, v)));
+    }
+    return k;
+}
+
+
+//*************************************************************************************************************
+
+IOUTILS_TARGET("avx2")
+static qint64 be_int_to_double_avx2(const uchar *source, double *dest, qint64 count)
+{
+    const __m128i mask = swap_mask_ssse3(4);
+    qint64 k = 0;
+    for(; k + 4 <= count; k += 4) {
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(source + 4*k)), mask);
+        _mm256_storeu_pd(dest + k, _mm256_cvtepi32_pd(v));
+    }
+    return k;
+}
+
+
+//*************************************************************************************************************
+
+IOUTILS_TARGET("ssse3")
+static qint64 be_float_to_double_ssse3(const uchar *source, double *dest, qint64 count)
+{
+    const __m128i mask = swap_mask_ssse3(4);
+    qint64 k = 0;
+    for(; k + 4 <= count; k += 4) {
+        __m128 v = _mm_castsi128_ps(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(source + 4*k)), mask));
+        _mm_storeu_pd(dest + k,     _mm_cvtps_pd(v));
+        _mm_storeu_pd(dest + k + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    }
+    return k;
+}
+
+
+//*************************************************************************************************************
+
+IOUTILS_TARGET("avx2")
+static qint64 be_float_to_double_avx2(const uchar *source, double *dest, qint64 count)
+{
+    const __m128i mask = swap_mask_ssse3(4);
+    qint64 k = 0;
+    for(; k + 4 <= count; k += 4) {
+        __m128 v = _mm_castsi128_ps(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(source + 4*k)), mask));
+        _mm256_storeu_pd(dest + k, _mm256_cvtps_pd(v));
+    }
+    return k;
+}
+
+
+//*************************************************************************************************************
+
+IOUTILS_TARGET("ssse3")
+static qint64 be_short_to_float_ssse3(const uchar *source, float *dest, qint64 count)
+{
+    const __m128i mask = swap_mask_ssse3(2);
+    qint64 k = 0;
+    for(; k + 8 <= count; k += 8) {
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(source + 2*k)), mask);
+        _mm_storeu_ps(dest + k,     _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16)));
+        _mm_storeu_ps(dest + k + 4, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16)));
+    }
+    return k;
+}
+
+
+//*************************************************************************************************************
+
+IOUTILS_TARGET("avx2")
+static qint64 be_short_to_float_avx2(const uchar *source, float *dest, qint64 count)
+{
+    const __m128i mask = swap_mask_ssse3(2);
+    qint64 k = 0;
+    for(; k + 8 <= count; k += 8) {
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(source + 2*k)), mask);
+        _mm256_storeu_ps(dest + k, _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(v)));
+    }
+    return k;
+}
+
+
+//*************************************************************************************************************
+
+IOUTILS_TARGET("ssse3")
+static qint64 be_int_to_float_ssse3(const uchar *source, float *dest, qint64 count)
+{
+    const __m128i mask = swap_mask_ssse3(4);
+    qint64 k = 0;
+    for(; k + 4 <= count; k += 4) {
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(source + 4*k)), mask);
+        _mm_storeu_ps(dest + k, _mm_cvtepi32_ps(v));
+    }
+    return k;
+}
+
+
+//*************************************************************************************************************
+
+IOUTILS_TARGET("avx2")
+static qint64 be_int_to_float_avx2(const uchar *source, float *dest, qint64 count)
+{
+    const __m256i mask = _mm256_broadcastsi128_si256(swap_mask_ssse3(4));
+    qint64 k = 0;
+    for(; k + 8 <= count; k += 8) {
+        __m256i v = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(source + 4*k)), mask);
+        _mm256_storeu_ps(dest + k, _mm256_cvtepi32_ps(v));
+    }
+    return k;
+}
+
+#endif // IOUTILS_SIMD_X86
+
+
+//*************************************************************************************************************
+
+static void swap_bytes(uchar *data, qint64 count, int width)
+{
+    qint64 done = 0;
+#ifdef IOUTILS_SIMD_X86
+    switch(active_swap_instruction_set()) {
+    case SwapAvx2:
+        done = swap_bytes_avx2(data, count*width, width);
+        break;
+    case SwapSsse3:
+        done = swap_bytes_ssse3(data, count*width, width);
+        break;
+    default:
+        break;
+    }
+#endif
+    swap_bytes_scalar(data + done, count - done/width, width);
+}
+
+
 //*************************************************************************************************************
 //=============================================================================================================
 // DEFINE MEMBER METHODS
@@ -253,6 +608,147 @@ void IOUtils::swap_doublep(double *source)
 }
 
 
+//*************************************************************************************************************
+
+void IOUtils::swap_short_array(qint16 *data, qint64 count)
+{
+    swap_bytes((uchar *)data, count, sizeof(qint16));
+}
+
+
+//*************************************************************************************************************
+
+void IOUtils::swap_int_array(qint32 *data, qint64 count)
+{
+    swap_bytes((uchar *)data, count, sizeof(qint32));
+}
+
+
+//*************************************************************************************************************
+
+void IOUtils::swap_long_array(qint64 *data, qint64 count)
+{
+    swap_bytes((uchar *)data, count, sizeof(qint64));
+}
+
+
+//*************************************************************************************************************
+
+void IOUtils::swap_float_array(float *data, qint64 count)
+{
+    swap_bytes((uchar *)data, count, sizeof(float));
+}
+
+
+//*************************************************************************************************************
+
+void IOUtils::swap_double_array(double *data, qint64 count)
+{
+    swap_bytes((uchar *)data, count, sizeof(double));
+}
+
+
+//*************************************************************************************************************
+
+void IOUtils::be_short_to_double(const uchar *source, double *dest, qint64 count)
+{
+    qint64 done = 0;
+#ifdef IOUTILS_SIMD_X86
+    if(active_swap_instruction_set() == SwapAvx2)
+        done = be_short_to_double_avx2(source, dest, count);
+    else if(active_swap_instruction_set() == SwapSsse3)
+        done = be_short_to_double_ssse3(source, dest, count);
+#endif
+    be_to_native_scalar<qint16>(source + done*sizeof(qint16), dest + done, count - done);
+}
+
+
+//*************************************************************************************************************
+
+void IOUtils::be_int_to_double(const uchar *source, double *dest, qint64 count)
+{
+    qint64 done = 0;
+#ifdef IOUTILS_SIMD_X86
+    if(active_swap_instruction_set() == SwapAvx2)
+        done = be_int_to_double_avx2(source, dest, count);
+    else if(active_swap_instruction_set() == SwapSsse3)
+        done = be_int_to_double_ssse3(source, dest, count);
+#endif
+    be_to_native_scalar<qint32>(source + done*sizeof(qint32), dest + done, count - done);
+}
+
+
+//*************************************************************************************************************
+
+void IOUtils::be_float_to_double(const uchar *source, double *dest, qint64 count)
+{
+    qint64 done = 0;
+#ifdef IOUTILS_SIMD_X86
+    if(active_swap_instruction_set() == SwapAvx2)
+        done = be_float_to_double_avx2(source, dest, count);
+    else if(active_swap_instruction_set() == SwapSsse3)
+        done = be_float_to_double_ssse3(source, dest, count);
+#endif
+    be_float_to_native_scalar(source + done*sizeof(float), dest + done, count - done);
+}
+
+
+//*************************************************************************************************************
+
+void IOUtils::be_short_to_float(const uchar *source, float *dest, qint64 count)
+{
+    qint64 done = 0;
+#ifdef IOUTILS_SIMD_X86
+    if(active_swap_instruction_set() == SwapAvx2)
+        done = be_short_to_float_avx2(source, dest, count);
+    else if(active_swap_instruction_set() == SwapSsse3)
+        done = be_short_to_float_ssse3(source, dest, count);
+#endif
+    be_to_native_scalar<qint16>(source + done*sizeof(qint16), dest + done, count - done);
+}
+
+
+//*************************************************************************************************************
+
+void IOUtils::be_int_to_float(const uchar *source, float *dest, qint64 count)
+{
+    qint64 done = 0;
+#ifdef IOUTILS_SIMD_X86
+    if(active_swap_instruction_set() == SwapAvx2)
+        done = be_int_to_float_avx2(source, dest, count);
+    else if(active_swap_instruction_set() == SwapSsse3)
+        done = be_int_to_float_ssse3(source, dest, count);
+#endif
+    be_to_native_scalar<qint32>(source + done*sizeof(qint32), dest + done, count - done);
+}
+
+
+//*************************************************************************************************************
+
+void IOUtils::be_float_to_float(const uchar *source, float *dest, qint64 count)
+{
+    memcpy(dest, source, count*sizeof(float));
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    swap_bytes((uchar *)dest, count, sizeof(float));
+#endif
+}
+
+
+//*************************************************************************************************************
+
+const char* IOUtils::swap_instruction_set()
+{
+    switch(active_swap_instruction_set()) {
+    case SwapAvx2:
+        return "AVX2";
+    case SwapSsse3:
+        return "SSSE3";
+    default:
+        return "scalar";
+    }
+}
+
+
 //*************************************************************************************************************
 
 QStringList IOUtils::get_new_chnames_conventions(const QStringList& chNames)
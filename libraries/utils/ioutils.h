@@ -201,6 +201,119 @@ public:
     */
     static void swap_doublep(double *source);
 
+    //=========================================================================================================
+    /**
+    * Swaps the byte order of an array of shorts in place. Uses SSSE3 or AVX2 if the cpu supports it.
+    *
+    * @param[in, out] data      shorts to swap
+    * @param[in] count          number of shorts
+    */
+    static void swap_short_array(qint16 *data, qint64 count);
+
+    //=========================================================================================================
+    /**
+    * Swaps the byte order of an array of integers in place. Uses SSSE3 or AVX2 if the cpu supports it.
+    *
+    * @param[in, out] data      integers to swap
+    * @param[in] count          number of integers
+    */
+    static void swap_int_array(qint32 *data, qint64 count);
+
+    //=========================================================================================================
+    /**
+    * Swaps the byte order of an array of longs in place. Uses SSSE3 or AVX2 if the cpu supports it.
+    *
+    * @param[in, out] data      longs to swap
+    * @param[in] count          number of longs
+    */
+    static void swap_long_array(qint64 *data, qint64 count);
+
+    //=========================================================================================================
+    /**
+    * Swaps the byte order of an array of floats in place, complex floats are swapped as 2*count floats.
+    *
+    * @param[in, out] data      floats to swap
+    * @param[in] count          number of floats
+    */
+    static void swap_float_array(float *data, qint64 count);
+
+    //=========================================================================================================
+    /**
+    * Swaps the byte order of an array of doubles in place, complex doubles are swapped as 2*count doubles.
+    *
+    * @param[in, out] data      doubles to swap
+    * @param[in] count          number of doubles
+    */
+    static void swap_double_array(double *data, qint64 count);
+
+    //=========================================================================================================
+    /**
+    * Converts big endian shorts to native doubles in one pass.
+    *
+    * @param[in] source     big endian shorts, no alignment required
+    * @param[out] dest      converted values
+    * @param[in] count      number of values
+    */
+    static void be_short_to_double(const uchar *source, double *dest, qint64 count);
+
+    //=========================================================================================================
+    /**
+    * Converts big endian integers to native doubles in one pass.
+    *
+    * @param[in] source     big endian integers, no alignment required
+    * @param[out] dest      converted values
+    * @param[in] count      number of values
+    */
+    static void be_int_to_double(const uchar *source, double *dest, qint64 count);
+
+    //=========================================================================================================
+    /**
+    * Converts big endian floats to native doubles in one pass.
+    *
+    * @param[in] source     big endian floats, no alignment required
+    * @param[out] dest      converted values
+    * @param[in] count      number of values
+    */
+    static void be_float_to_double(const uchar *source, double *dest, qint64 count);
+
+    //=========================================================================================================
+    /**
+    * Converts big endian shorts to native floats in one pass.
+    *
+    * @param[in] source     big endian shorts, no alignment required
+    * @param[out] dest      converted values
+    * @param[in] count      number of values
+    */
+    static void be_short_to_float(const uchar *source, float *dest, qint64 count);
+
+    //=========================================================================================================
+    /**
+    * Converts big endian integers to native floats in one pass.
+    *
+    * @param[in] source     big endian integers, no alignment required
+    * @param[out] dest      converted values
+    * @param[in] count      number of values
+    */
+    static void be_int_to_float(const uchar *source, float *dest, qint64 count);
+
+    //=========================================================================================================
+    /**
+    * Converts big endian floats to native floats in one pass.
+    *
+    * @param[in] source     big endian floats, no alignment required
+    * @param[out] dest      converted values
+    * @param[in] count      number of values
+    */
+    static void be_float_to_float(const uchar *source, float *dest, qint64 count);
+
+    //=========================================================================================================
+    /**
+    * Returns the instruction set the array swap and conversion routines use on this cpu.
+    *
+    * @return "AVX2", "SSSE3" or "scalar"
+    */
+    static const char* swap_instruction_set();
+
     //=========================================================================================================
     /**
     * Write Eigen Matrix to file
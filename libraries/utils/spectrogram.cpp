@@ -78,7 +78,7 @@ VectorXd Spectrogram::gauss_window (qint32 sample_count, qreal scale, quint32 tr
 
 //-----------------------------------------------------------------------------------------------------------------
 
-MatrixXd Spectrogram::make_spectrogram(VectorXd signal, qint32 window_size = 0)
+MatrixXd Spectrogram::make_spectrogram(const VectorXd &signal, qint32 window_size = 0)
 {
     if(window_size == 0)
         window_size = signal.rows()/4;
@@ -86,27 +86,17 @@ MatrixXd Spectrogram::make_spectrogram(VectorXd signal, qint32 window_size = 0)
     Eigen::FFT<double> fft;
     MatrixXd tf_matrix = MatrixXd::Zero(signal.rows()/2, signal.rows());
 
+    //buffers are reused for all translations, the fft object keeps its plan
+    VectorXd windowed_sig(signal.rows());
+    VectorXcd fft_win_sig(signal.rows());
+
     for(qint32 translate = 0; translate < signal.rows(); translate++)
     {
-        VectorXd envelope = gauss_window(signal.rows(), window_size, translate);
-
-        VectorXd windowed_sig = VectorXd::Zero(signal.rows());
-        VectorXcd fft_win_sig = VectorXcd::Zero(signal.rows());
-
-        VectorXd real_coeffs = VectorXd::Zero(signal.rows()/2);
-
-        for(qint32 sample = 0; sample < signal.rows(); sample++)
-            windowed_sig[sample] = signal[sample] * envelope[sample];
+        windowed_sig = signal.cwiseProduct(gauss_window(signal.rows(), window_size, translate));
 
         fft.fwd(fft_win_sig, windowed_sig);
 
-        for(qint32 i= 0; i<signal.rows()/2; i++)
-        {
-            qreal value = pow(std::abs(fft_win_sig[i]), 2.0);
-            real_coeffs[i] = value;
-        }
-
-        tf_matrix.col(translate) = real_coeffs;
+        tf_matrix.col(translate) = fft_win_sig.head(signal.rows()/2).cwiseAbs2();
     }
     return tf_matrix;
 }
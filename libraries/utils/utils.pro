@@ -88,12 +88,14 @@ SOURCES += \
     filterTools/filterio.cpp \
     detecttrigger.cpp \
     spectrogram.cpp \
+    welchpsd.cpp \
     warp.cpp \
     filterTools/sphara.cpp \
     sphere.cpp \
     generics/buffer.cpp \
     generics/circularbuffer.cpp \
     generics/circularmatrixbuffer.cpp \
+    generics/ringmatrixbuffer.cpp \
     generics/observerpattern.cpp
 
 
@@ -115,6 +117,7 @@ HEADERS += \
     filterTools/filterio.h \
     detecttrigger.h \
     spectrogram.h \
+    welchpsd.h \
     warp.h \
     filterTools/sphara.h \
     sphere.h \
@@ -124,6 +127,7 @@ HEADERS += \
     generics/circularbuffer_old.h \
     generics/circularmatrixbuffer.h \
     generics/circularmultichannelbuffer_old.h \
+    generics/ringmatrixbuffer.h \
     generics/commandpattern.h \
     generics/observerpattern.h \
     generics/typename_old.h
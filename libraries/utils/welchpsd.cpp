@@ -0,0 +1,254 @@
+//=============================================================================================================
+/**
+* @file     welchpsd.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    WelchPsd class definition
+*
+*/
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "welchpsd.h"
+
+#include <math.h>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace UTILSLIB;
+using namespace Eigen;
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+WelchPsd::WelchPsd()
+: m_iNumChannels(0)
+, m_iSegmentLength(0)
+, m_iStep(1)
+, m_dSFreq(1.0)
+, m_dScale(1.0)
+, m_iFill(0)
+, m_iNumSegments(0)
+, m_iNumSamples(0)
+{
+}
+
+
+//*************************************************************************************************************
+
+WelchPsd::WelchPsd(int iNumChannels, int iSegmentLength, int iOverlap, double dSFreq)
+: m_iNumChannels(0)
+, m_iSegmentLength(0)
+, m_iStep(1)
+, m_dSFreq(1.0)
+, m_dScale(1.0)
+, m_iFill(0)
+, m_iNumSegments(0)
+, m_iNumSamples(0)
+{
+    init(iNumChannels, iSegmentLength, iOverlap, dSFreq);
+}
+
+
+//*************************************************************************************************************
+
+void WelchPsd::init(int iNumChannels, int iSegmentLength, int iOverlap, double dSFreq)
+{
+    m_iNumChannels = iNumChannels;
+    m_iSegmentLength = iSegmentLength > 1 ? iSegmentLength : 2;
+    m_iStep = m_iSegmentLength - iOverlap;
+    if(m_iStep < 1 || m_iStep > m_iSegmentLength) {
+        m_iStep = m_iSegmentLength;
+    }
+    m_dSFreq = dSFreq;
+
+    m_vecWindow = hann(m_iSegmentLength).transpose();
+    m_dScale = 1.0 / (m_dSFreq * m_vecWindow.squaredNorm());
+
+    m_matSegment.resize(m_iNumChannels, m_iSegmentLength);
+    m_matWindowed.resize(m_iNumChannels, m_iSegmentLength);
+    m_vecTimePair.resize(m_iSegmentLength);
+    m_vecFreqPair.resize(m_iSegmentLength);
+    m_vecTimeSingle.resize(m_iSegmentLength);
+    m_vecFreqSingle.resize(m_iSegmentLength/2+1);
+    m_matPsdSum.resize(m_iNumChannels, m_iSegmentLength/2+1);
+
+    //Create the FFT plan now instead of with the first segment
+    m_vecTimePair.setZero();
+    m_fft.fwd(m_vecFreqPair, m_vecTimePair);
+
+    reset();
+}
+
+
+//*************************************************************************************************************
+
+void WelchPsd::reset()
+{
+    resetAverage();
+    m_iFill = 0;
+    m_iNumSamples = 0;
+}
+
+
+//*************************************************************************************************************
+
+void WelchPsd::resetAverage()
+{
+    m_matPsdSum.setZero();
+    m_iNumSegments = 0;
+}
+
+
+//*************************************************************************************************************
+
+int WelchPsd::append(const MatrixXd &data)
+{
+    if(data.rows() != m_iNumChannels) {
+        qWarning("WelchPsd::append - Number of channels does not match (%d instead of %d). Returning.", int(data.rows()), m_iNumChannels);
+        return m_iNumSegments;
+    }
+
+    int iPos = 0;
+
+    while(iPos < data.cols()) {
+        int iCount = qMin(int(data.cols()) - iPos, m_iSegmentLength - m_iFill);
+
+        m_matSegment.block(0, m_iFill, m_iNumChannels, iCount) = data.block(0, iPos, m_iNumChannels, iCount);
+        m_iFill += iCount;
+        iPos += iCount;
+
+        if(m_iFill == m_iSegmentLength) {
+            processSegment();
+
+            //Keep the overlapping samples for the next segment
+            int iOverlap = m_iSegmentLength - m_iStep;
+            if(iOverlap > 0) {
+                m_matSegment.leftCols(iOverlap) = m_matSegment.rightCols(iOverlap).eval();
+            }
+            m_iFill = iOverlap;
+        }
+    }
+
+    m_iNumSamples += data.cols();
+
+    return m_iNumSegments;
+}
+
+
+//*************************************************************************************************************
+
+MatrixXd WelchPsd::getPsd() const
+{
+    if(m_iNumSegments == 0) {
+        return MatrixXd::Zero(m_iNumChannels, m_iSegmentLength/2+1);
+    }
+
+    return m_matPsdSum / m_iNumSegments;
+}
+
+
+//*************************************************************************************************************
+
+VectorXd WelchPsd::getFrequencies() const
+{
+    return VectorXd::LinSpaced(m_iSegmentLength/2+1, 0, (m_iSegmentLength/2) * m_dSFreq / m_iSegmentLength);
+}
+
+
+//*************************************************************************************************************
+
+VectorXd WelchPsd::hann(int iLength)
+{
+    VectorXd vecWindow(iLength);
+
+    for(int i = 0; i < iLength; ++i) {
+        vecWindow(i) = 0.5 * (1.0 - cos(2.0 * M_PI * i / iLength));
+    }
+
+    return vecWindow;
+}
+
+
+//*************************************************************************************************************
+
+void WelchPsd::processSegment()
+{
+    const int N = m_iSegmentLength;
+    const int iNumBins = N/2+1;
+
+    m_matWindowed = m_matSegment.array().rowwise() * m_vecWindow.array();
+
+    //One-sided spectrum: all bins except DC and Nyquist are doubled
+    RowVectorXd vecBinScale = RowVectorXd::Constant(iNumBins, 2.0 * m_dScale);
+    vecBinScale(0) = m_dScale;
+    if(N % 2 == 0) {
+        vecBinScale(iNumBins-1) = m_dScale;
+    }
+
+    int iCh = 0;
+
+    //Transform two real channels x and y at once: z = x + iy, X_k = (Z_k + conj(Z_N-k))/2, Y_k = (Z_k - conj(Z_N-k))/2i
+    for(; iCh + 1 < m_iNumChannels; iCh += 2) {
+        m_vecTimePair.real() = m_matWindowed.row(iCh).transpose();
+        m_vecTimePair.imag() = m_matWindowed.row(iCh+1).transpose();
+
+        m_fft.fwd(m_vecFreqPair, m_vecTimePair);
+
+        for(int k = 0; k < iNumBins; ++k) {
+            std::complex<double> Zk = m_vecFreqPair(k);
+            std::complex<double> ZNk = std::conj(m_vecFreqPair(k == 0 ? 0 : N-k));
+
+            m_matPsdSum(iCh, k) += vecBinScale(k) * 0.25 * std::norm(Zk + ZNk);
+            m_matPsdSum(iCh+1, k) += vecBinScale(k) * 0.25 * std::norm(Zk - ZNk);
+        }
+    }
+
+    //Remaining odd channel
+    if(iCh < m_iNumChannels) {
+        m_vecTimeSingle = m_matWindowed.row(iCh).transpose();
+
+        m_fft.SetFlag(Eigen::FFT<double>::HalfSpectrum);
+        m_fft.fwd(m_vecFreqSingle, m_vecTimeSingle);
+        m_fft.ClearFlag(Eigen::FFT<double>::HalfSpectrum);
+
+        m_matPsdSum.row(iCh) += (m_vecFreqSingle.cwiseAbs2().transpose().array() * vecBinScale.array()).matrix();
+    }
+
+    m_iNumSegments++;
+}
@@ -0,0 +1,236 @@
+//=============================================================================================================
+/**
+* @file     welchpsd.h
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    WelchPsd class declaration
+*
+*/
+
+#ifndef WELCHPSD_H
+#define WELCHPSD_H
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "utils_global.h"
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QSharedPointer>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+#include <unsupported/Eigen/FFT>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// DEFINE NAMESPACE UTILSLIB
+//=============================================================================================================
+
+namespace UTILSLIB
+{
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace Eigen;
+
+
+//=============================================================================================================
+/**
+* Streaming power spectral density estimation after Welch. Data blocks of arbitrary length are appended, the
+* samples are cut into overlapping Hann windowed segments and the one-sided PSD of all channels is averaged
+* incrementally. The window and the FFT plan are set up once in init(). Two real channels are transformed with one
+* complex FFT, so a block of N channels needs N/2 FFTs.
+*
+* @brief Streaming Welch PSD
+*/
+class UTILSSHARED_EXPORT WelchPsd
+{
+public:
+    typedef QSharedPointer<WelchPsd> SPtr;              /**< Shared pointer type for WelchPsd. */
+    typedef QSharedPointer<const WelchPsd> ConstSPtr;   /**< Const shared pointer type for WelchPsd. */
+
+    //=========================================================================================================
+    /**
+    * Constructs a WelchPsd object. Call init before appending data.
+    */
+    WelchPsd();
+
+    //=========================================================================================================
+    /**
+    * Constructs a WelchPsd object and initializes it.
+    *
+    * @param[in] iNumChannels       Number of channels (rows) of the appended data.
+    * @param[in] iSegmentLength     Length of the segments, i.e. the FFT length.
+    * @param[in] iOverlap           Number of samples shared by two consecutive segments.
+    * @param[in] dSFreq             The sampling frequency.
+    */
+    WelchPsd(int iNumChannels, int iSegmentLength, int iOverlap, double dSFreq);
+
+    //=========================================================================================================
+    /**
+    * Sets up window, FFT plan and buffers and resets the estimation.
+    *
+    * @param[in] iNumChannels       Number of channels (rows) of the appended data.
+    * @param[in] iSegmentLength     Length of the segments, i.e. the FFT length.
+    * @param[in] iOverlap           Number of samples shared by two consecutive segments.
+    * @param[in] dSFreq             The sampling frequency.
+    */
+    void init(int iNumChannels, int iSegmentLength, int iOverlap, double dSFreq);
+
+    //=========================================================================================================
+    /**
+    * Discards the averaged spectra and the samples of the incomplete segment.
+    */
+    void reset();
+
+    //=========================================================================================================
+    /**
+    * Discards the averaged spectra but keeps the samples of the incomplete segment, so a new average can be
+    * started without losing the data which has already been appended.
+    */
+    void resetAverage();
+
+    //=========================================================================================================
+    /**
+    * Appends a data block. Each completed segment is added to the average.
+    *
+    * @param[in] data   The data block (channels x samples).
+    *
+    * @return the number of averaged segments.
+    */
+    int append(const MatrixXd &data);
+
+    //=========================================================================================================
+    /**
+    * Returns the averaged one-sided PSD in units^2/Hz.
+    *
+    * @return the PSD (channels x segment length/2+1). Zero if no segment was completed yet.
+    */
+    MatrixXd getPsd() const;
+
+    //=========================================================================================================
+    /**
+    * Returns the frequencies of the PSD bins.
+    *
+    * @return the frequencies in Hz.
+    */
+    VectorXd getFrequencies() const;
+
+    //=========================================================================================================
+    /**
+    * Returns the number of averaged segments.
+    *
+    * @return the number of averaged segments.
+    */
+    inline int getNumSegments() const;
+
+    //=========================================================================================================
+    /**
+    * Returns the number of samples appended since the last reset.
+    *
+    * @return the number of appended samples.
+    */
+    inline qint64 getNumSamples() const;
+
+    //=========================================================================================================
+    /**
+    * Creates a periodic Hann window.
+    *
+    * @param[in] iLength    The window length.
+    *
+    * @return the window.
+    */
+    static VectorXd hann(int iLength);
+
+private:
+    //=========================================================================================================
+    /**
+    * Windows the filled segment buffer and adds its spectrum to the PSD sum.
+    */
+    void processSegment();
+
+    int                         m_iNumChannels;     /**< Number of channels. */
+    int                         m_iSegmentLength;   /**< Segment and FFT length. */
+    int                         m_iStep;            /**< Number of new samples per segment. */
+    double                      m_dSFreq;           /**< The sampling frequency. */
+    double                      m_dScale;           /**< PSD scaling 1/(sfreq * sum(window^2)). */
+
+    RowVectorXd                 m_vecWindow;        /**< The cached window. */
+    Eigen::FFT<double>          m_fft;              /**< The FFT object, it caches the plan for m_iSegmentLength. */
+
+    MatrixXd                    m_matSegment;       /**< Samples of the current segment. */
+    int                         m_iFill;            /**< Number of samples in m_matSegment. */
+    MatrixXd                    m_matWindowed;      /**< Windowed segment. */
+    VectorXcd                   m_vecTimePair;      /**< Two channels packed as real and imaginary part. */
+    VectorXcd                   m_vecFreqPair;      /**< Spectrum of the packed channels. */
+    VectorXcd                   m_vecFreqSingle;    /**< Half spectrum of a single channel. */
+    VectorXd                    m_vecTimeSingle;    /**< Windowed single channel. */
+
+    MatrixXd                    m_matPsdSum;        /**< Sum of the segment spectra. */
+    int                         m_iNumSegments;     /**< Number of summed segments. */
+    qint64                      m_iNumSamples;      /**< Number of appended samples. */
+};
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline int WelchPsd::getNumSegments() const
+{
+    return m_iNumSegments;
+}
+
+
+//*************************************************************************************************************
+
+inline qint64 WelchPsd::getNumSamples() const
+{
+    return m_iNumSamples;
+}
+
+} // NAMESPACE
+
+#endif // WELCHPSD_H
@@ -0,0 +1,525 @@
+//=============================================================================================================
+/**
+* @file     test_detect_trigger.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    Test for the streaming trigger edge detection of DetectTrigger
+*
+*/
+
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/detecttrigger.h>
+
+#include <algorithm>
+#include <stdlib.h>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace UTILSLIB;
+using namespace Eigen;
+
+
+//=============================================================================================================
+/**
+* DECLARE CLASS TestDetectTrigger
+*
+* @brief The TestDetectTrigger class checks the block wise edge detection against a scan of the whole signal
+*
+*/
+class TestDetectTrigger: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestDetectTrigger();
+
+private slots:
+    void initTestCase();
+    void compareBlockBoundaries();
+    void compareBlockSizes();
+    void compareMinPulseLength();
+    void compareMask();
+    void compareReset();
+    void compareAnalogPulses();
+    void compareRemoveOffset();
+    void compareAnalogRamp();
+    void cleanupTestCase();
+
+private:
+    QVector<DetectTrigger::TriggerEvent> referenceEvents(const MatrixXd& matData, const QList<int>& lChannels, int iMask, DetectTrigger::EdgeType type, int iMinPulseSamples) const;
+    QVector<DetectTrigger::TriggerEvent> streamEvents(DetectTrigger& detector, const MatrixXd& matData, int iBlockSize);
+    bool compareEvents(QVector<DetectTrigger::TriggerEvent> vEvents, QVector<DetectTrigger::TriggerEvent> vRef) const;
+
+    double          threshold;
+    int             numSamples;
+    QList<int>      channels;
+
+    MatrixXd        data;
+    bool            blockOrderOk;
+};
+
+
+//*************************************************************************************************************
+
+TestDetectTrigger::TestDetectTrigger()
+: threshold(0.5)
+, numSamples(5000)
+, blockOrderOk(true)
+{
+}
+
+
+//*************************************************************************************************************
+
+static bool eventLess(const DetectTrigger::TriggerEvent& a, const DetectTrigger::TriggerEvent& b)
+{
+    if(a.iSample != b.iSample)
+        return a.iSample < b.iSample;
+    if(a.iChannelIdx != b.iChannelIdx)
+        return a.iChannelIdx < b.iChannelIdx;
+    return a.type < b.type;
+}
+
+
+//*************************************************************************************************************
+
+void TestDetectTrigger::initTestCase()
+{
+    //Two noisy pulse trains on rows 1 and 3 with random codes, lengths and gaps, the gaps may be empty
+    srand(42);
+    data = 0.2 * MatrixXd::Random(4, numSamples);
+    channels << 3 << 1;
+
+    for(int i = 0; i < channels.size(); ++i) {
+        int ch = channels.at(i);
+        int s = rand() % 10;
+
+        while(s < numSamples) {
+            int iLength = 1 + rand() % 12;
+            double dCode = 1 + rand() % 15;
+
+            for(int j = s; j < qMin(s + iLength, numSamples); ++j) {
+                data(ch,j) += dCode;
+            }
+
+            s += iLength + rand() % 10;
+        }
+    }
+}
+
+
+//*************************************************************************************************************
+
+QVector<DetectTrigger::TriggerEvent> TestDetectTrigger::referenceEvents(const MatrixXd& matData, const QList<int>& lChannels, int iMask, DetectTrigger::EdgeType type, int iMinPulseSamples) const
+{
+    //Split every channel of the whole signal into runs of the same code and report the runs which are long enough
+    QVector<DetectTrigger::TriggerEvent> vEvents;
+
+    for(int i = 0; i < lChannels.size(); ++i) {
+        int ch = lChannels.at(i);
+        int iStart = 0;
+        int iCode = 0;
+
+        for(int j = 0; j <= matData.cols(); ++j) {
+            int iNewCode = 0;
+            if(j < matData.cols()) {
+                iNewCode = matData(ch,j) >= threshold ? int(matData(ch,j) + 0.5) & iMask : 0;
+                if(iNewCode == iCode)
+                    continue;
+            }
+
+            //The last run is still open, it has no falling edge yet
+            bool bClosed = j < matData.cols();
+
+            if(iCode != 0 && j - iStart >= iMinPulseSamples) {
+                if(type & DetectTrigger::Rising) {
+                    DetectTrigger::TriggerEvent event = {iStart, 0, ch, iCode, DetectTrigger::Rising};
+                    vEvents.append(event);
+                }
+                if((type & DetectTrigger::Falling) && bClosed) {
+                    DetectTrigger::TriggerEvent event = {j, 0, ch, iCode, DetectTrigger::Falling};
+                    vEvents.append(event);
+                }
+            }
+
+            iStart = j;
+            iCode = iNewCode;
+        }
+    }
+
+    return vEvents;
+}
+
+
+//*************************************************************************************************************
+
+QVector<DetectTrigger::TriggerEvent> TestDetectTrigger::streamEvents(DetectTrigger& detector, const MatrixXd& matData, int iBlockSize)
+{
+    QVector<DetectTrigger::TriggerEvent> vEvents;
+
+    for(int i = 0; i < matData.cols(); i += iBlockSize) {
+        qint64 iBlockStart = detector.sampleCount();
+        const QVector<DetectTrigger::TriggerEvent>& vBlockEvents = detector.detectTriggerEvents(matData.middleCols(i, qMin(iBlockSize, (int)matData.cols() - i)));
+
+        //The events of a block are ordered and their block column matches the absolute sample
+        for(int k = 0; k < vBlockEvents.size(); ++k) {
+            if(vBlockEvents.at(k).iBlockSample != vBlockEvents.at(k).iSample - iBlockStart)
+                blockOrderOk = false;
+            if(k > 0 && vBlockEvents.at(k).iSample < vBlockEvents.at(k-1).iSample)
+                blockOrderOk = false;
+
+            vEvents.append(vBlockEvents.at(k));
+        }
+    }
+
+    return vEvents;
+}
+
+
+//*************************************************************************************************************
+
+bool TestDetectTrigger::compareEvents(QVector<DetectTrigger::TriggerEvent> vEvents, QVector<DetectTrigger::TriggerEvent> vRef) const
+{
+    //Delayed rising edges of one channel may be reported after edges of another one, so compare the sorted events
+    if(vEvents.size() != vRef.size())
+        return false;
+
+    std::sort(vEvents.begin(), vEvents.end(), eventLess);
+    std::sort(vRef.begin(), vRef.end(), eventLess);
+
+    for(int k = 0; k < vEvents.size(); ++k) {
+        if(vEvents.at(k).iSample != vRef.at(k).iSample
+                || vEvents.at(k).iChannelIdx != vRef.at(k).iChannelIdx
+                || vEvents.at(k).iValue != vRef.at(k).iValue
+                || vEvents.at(k).type != vRef.at(k).type)
+            return false;
+    }
+
+    return true;
+}
+
+
+//*************************************************************************************************************
+
+void TestDetectTrigger::compareBlockBoundaries()
+{
+    //Pulses which start and end right at the first and the last sample of 10 sample blocks
+    MatrixXd matData = MatrixXd::Zero(1, 100);
+    matData.block(0, 0, 1, 10).setConstant(1.0);
+    matData.block(0, 19, 1, 1).setConstant(2.0);
+    matData.block(0, 20, 1, 10).setConstant(3.0);
+    matData.block(0, 30, 1, 1).setConstant(4.0);
+    matData.block(0, 49, 1, 2).setConstant(5.0);
+    matData.block(0, 60, 1, 40).setConstant(6.0);
+
+    QList<int> lChannels;
+    lChannels << 0;
+
+    DetectTrigger detector;
+    detector.setTriggerChannels(lChannels, threshold, -1, DetectTrigger::RisingAndFalling);
+
+    QVector<DetectTrigger::TriggerEvent> vEvents = streamEvents(detector, matData, 10);
+    QVector<DetectTrigger::TriggerEvent> vRef = referenceEvents(matData, lChannels, -1, DetectTrigger::RisingAndFalling, 1);
+
+    //Every edge once: 6 rising, 5 falling, the last pulse is still on
+    QVERIFY( vRef.size() == 11 );
+    QVERIFY( compareEvents(vEvents, vRef) );
+    QVERIFY( blockOrderOk );
+
+    //The edges which fall on a block start
+    int iOnBoundary = 0;
+    for(int k = 0; k < vEvents.size(); ++k) {
+        if(vEvents.at(k).iSample % 10 == 0)
+            ++iOnBoundary;
+    }
+    QVERIFY( iOnBoundary == 7 );
+}
+
+
+//*************************************************************************************************************
+
+void TestDetectTrigger::compareBlockSizes()
+{
+    QVector<DetectTrigger::TriggerEvent> vRef = referenceEvents(data, channels, -1, DetectTrigger::RisingAndFalling, 1);
+    QVERIFY( vRef.size() > 500 );
+
+    int vecBlockSizes[] = {1, 2, 7, 10, 64, 999, 5000};
+
+    for(int i = 0; i < 7; ++i) {
+        DetectTrigger detector;
+        detector.setTriggerChannels(channels, threshold, -1, DetectTrigger::RisingAndFalling);
+
+        blockOrderOk = true;
+        QVERIFY( compareEvents(streamEvents(detector, data, vecBlockSizes[i]), vRef) );
+        QVERIFY( blockOrderOk );
+        QVERIFY( detector.sampleCount() == numSamples );
+    }
+
+    //Rising edges only
+    DetectTrigger detector;
+    detector.setTriggerChannels(channels, threshold);
+    QVERIFY( compareEvents(streamEvents(detector, data, 10), referenceEvents(data, channels, -1, DetectTrigger::Rising, 1)) );
+}
+
+
+//*************************************************************************************************************
+
+void TestDetectTrigger::compareMinPulseLength()
+{
+    //Pulses which are shorter than the minimal length and span a block boundary are dropped, longer ones are reported late
+    int vecMinPulse[] = {2, 5, 11};
+    int vecBlockSizes[] = {1, 3, 10, 64};
+
+    for(int m = 0; m < 3; ++m) {
+        QVector<DetectTrigger::TriggerEvent> vRef = referenceEvents(data, channels, -1, DetectTrigger::RisingAndFalling, vecMinPulse[m]);
+
+        for(int b = 0; b < 4; ++b) {
+            DetectTrigger detector;
+            detector.setTriggerChannels(channels, threshold, -1, DetectTrigger::RisingAndFalling, vecMinPulse[m]);
+
+            blockOrderOk = true;
+            QVERIFY( compareEvents(streamEvents(detector, data, vecBlockSizes[b]), vRef) );
+            QVERIFY( blockOrderOk );
+        }
+    }
+
+    //A pulse is reported by the block in which it reaches the minimal length
+    MatrixXd matData = MatrixXd::Zero(1, 30);
+    matData.block(0, 15, 1, 15).setConstant(1.0);
+
+    QList<int> lChannels;
+    lChannels << 0;
+
+    DetectTrigger detector;
+    detector.setTriggerChannels(lChannels, threshold, -1, DetectTrigger::Rising, 5);
+    QVERIFY( detector.detectTriggerEvents(matData.middleCols(0, 10)).size() == 0 );
+    QVERIFY( detector.detectTriggerEvents(matData.middleCols(10, 10)).size() == 1 );
+
+    detector.reset();
+    matData.block(0, 15, 1, 1).setZero();
+    QVERIFY( detector.detectTriggerEvents(matData.middleCols(0, 10)).size() == 0 );
+    QVERIFY( detector.detectTriggerEvents(matData.middleCols(10, 10)).size() == 0 );
+
+    const QVector<DetectTrigger::TriggerEvent>& vEvents = detector.detectTriggerEvents(matData.middleCols(20, 10));
+    QVERIFY( vEvents.size() == 1 );
+    QVERIFY( vEvents.at(0).iSample == 16 );
+    QVERIFY( vEvents.at(0).iBlockSample == -4 );
+}
+
+
+//*************************************************************************************************************
+
+void TestDetectTrigger::compareMask()
+{
+    //Only the changes of the masked bits are edges
+    int iMask = 0x5;
+    QVector<DetectTrigger::TriggerEvent> vRef = referenceEvents(data, channels, iMask, DetectTrigger::RisingAndFalling, 1);
+
+    for(int k = 0; k < vRef.size(); ++k) {
+        QVERIFY( (vRef.at(k).iValue & ~iMask) == 0 );
+    }
+
+    DetectTrigger detector;
+    detector.setTriggerChannels(channels, threshold, iMask, DetectTrigger::RisingAndFalling);
+
+    blockOrderOk = true;
+    QVERIFY( compareEvents(streamEvents(detector, data, 7), vRef) );
+    QVERIFY( blockOrderOk );
+}
+
+
+//*************************************************************************************************************
+
+void TestDetectTrigger::compareReset()
+{
+    DetectTrigger detector;
+    detector.setTriggerChannels(channels, threshold, -1, DetectTrigger::RisingAndFalling);
+    streamEvents(detector, data.leftCols(1234), 10);
+
+    //After a reset the detector starts from rest at the given sample
+    qint64 iFirstSample = 100000;
+    detector.reset(iFirstSample);
+
+    QVector<DetectTrigger::TriggerEvent> vRef = referenceEvents(data, channels, -1, DetectTrigger::RisingAndFalling, 1);
+    for(int k = 0; k < vRef.size(); ++k) {
+        vRef[k].iSample += iFirstSample;
+    }
+
+    blockOrderOk = true;
+    QVERIFY( compareEvents(streamEvents(detector, data, 10), vRef) );
+    QVERIFY( blockOrderOk );
+    QVERIFY( detector.sampleCount() == iFirstSample + numSamples );
+}
+
+
+//*************************************************************************************************************
+
+void TestDetectTrigger::compareAnalogPulses()
+{
+    //Analog stim channel scaled to 0-0.3: the pulses round to code 0 but are above the threshold
+    MatrixXd matData = MatrixXd::Zero(1, 40);
+    matData.block(0, 5, 1, 4).setConstant(0.3);
+    matData.block(0, 18, 1, 6).setConstant(0.25);
+    matData.block(0, 30, 1, 3).setConstant(0.05);
+
+    QList<int> lChannels;
+    lChannels << 0;
+
+    DetectTrigger detector;
+    detector.setTriggerChannels(lChannels, 0.1, -1, DetectTrigger::RisingAndFalling);
+
+    QVector<DetectTrigger::TriggerEvent> vEvents = streamEvents(detector, matData, 10);
+
+    QVERIFY( vEvents.size() == 4 );
+    QVERIFY( vEvents.at(0).iSample == 5 && vEvents.at(0).type == DetectTrigger::Rising );
+    QVERIFY( vEvents.at(1).iSample == 9 && vEvents.at(1).type == DetectTrigger::Falling );
+    QVERIFY( vEvents.at(2).iSample == 18 && vEvents.at(2).type == DetectTrigger::Rising );
+    QVERIFY( vEvents.at(3).iSample == 24 && vEvents.at(3).type == DetectTrigger::Falling );
+
+    //The raw value is kept next to the rounded code
+    QVERIFY( vEvents.at(0).iValue == 0 && vEvents.at(0).dValue == 0.3 );
+    QVERIFY( vEvents.at(2).iValue == 0 && vEvents.at(2).dValue == 0.25 );
+}
+
+
+//*************************************************************************************************************
+
+void TestDetectTrigger::compareRemoveOffset()
+{
+    //Pulses of height 1 on a resting level of 4.2, the threshold is applied relative to the first sample
+    MatrixXd matData = MatrixXd::Constant(1, 50, 4.2);
+    matData.block(0, 8, 1, 5).array() += 1.0;
+    matData.block(0, 29, 1, 3).array() += 1.0;
+
+    QList<int> lChannels;
+    lChannels << 0;
+
+    DetectTrigger detector;
+    detector.setTriggerChannels(lChannels, 0.5, -1, DetectTrigger::Rising, 1, true);
+
+    //A block which starts inside a pulse does not report it again
+    QVector<DetectTrigger::TriggerEvent> vEvents = streamEvents(detector, matData, 10);
+
+    QVERIFY( vEvents.size() == 2 );
+    QVERIFY( vEvents.at(0).iSample == 8 );
+    QVERIFY( vEvents.at(1).iSample == 29 );
+    QVERIFY( vEvents.at(0).dValue == matData(0,8) );
+
+    //Without offset removal the resting level is a single pulse from the start
+    detector.setTriggerChannels(lChannels, 0.5, -1, DetectTrigger::Rising);
+    vEvents = streamEvents(detector, matData, 10);
+
+    QVERIFY( vEvents.size() == 5 );
+    QVERIFY( vEvents.at(0).iSample == 0 );
+}
+
+
+//*************************************************************************************************************
+
+void TestDetectTrigger::compareAnalogRamp()
+{
+    //Two noisy analog pulses which ramp from 0 to 5 and back within 10 samples, hovering around the threshold at the start
+    srand(7);
+    MatrixXd matData = 0.15 * MatrixXd::Random(1, 300);
+    for(int k = 0; k < 2; ++k) {
+        int s = 20 + k * 150;
+        matData.block(0, s, 1, 4).array() += 0.5;
+        for(int j = 0; j < 10; ++j) {
+            matData(0, s + 4 + j) += 0.5 * (j + 1);
+        }
+        matData.block(0, s + 14, 1, 30).array() += 5.0;
+        for(int j = 0; j < 10; ++j) {
+            matData(0, s + 44 + j) += 5.0 - 0.5 * (j + 1);
+        }
+    }
+
+    QList<int> lChannels;
+    lChannels << 0;
+
+    //Every code of the ramp is a new edge
+    DetectTrigger detector;
+    detector.setTriggerChannels(lChannels, threshold, -1, DetectTrigger::Rising);
+    QVERIFY( streamEvents(detector, matData, 10).size() > 4 );
+
+    //Within the refractory period the pulse is reported once, for any block size
+    int vecBlockSizes[] = {1, 7, 10, 64, 300};
+
+    for(int b = 0; b < 5; ++b) {
+        detector.setTriggerChannels(lChannels, threshold, -1, DetectTrigger::Rising, 1, false, 100);
+
+        blockOrderOk = true;
+        QVector<DetectTrigger::TriggerEvent> vEvents = streamEvents(detector, matData, vecBlockSizes[b]);
+
+        QVERIFY( vEvents.size() == 2 );
+        QVERIFY( vEvents.at(0).iSample >= 20 && vEvents.at(0).iSample < 34 );
+        QVERIFY( vEvents.at(1).iSample >= 170 && vEvents.at(1).iSample < 184 );
+        QVERIFY( blockOrderOk );
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestDetectTrigger::cleanupTestCase()
+{
+}
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_APPLESS_MAIN(TestDetectTrigger)
+#include "test_detect_trigger.moc"
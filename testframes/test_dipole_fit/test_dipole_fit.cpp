@@ -77,10 +77,12 @@ private slots:
     void initTestCase();
     void dipoleFitSimple();
     void dipoleFitAdvanced();
+    void dipoleFitThreads();
     void cleanupTestCase();
 
 private:
     void compareFit();
+    ECDSet fitBem(int nthread);
 
     double epsilon;
 
@@ -273,6 +275,75 @@ void TestDipoleFit::dipoleFitAdvanced()
 }
 
 
+//*************************************************************************************************************
+
+void TestDipoleFit::dipoleFitThreads()
+{
+    //*********************************************************************************************************
+    // Compute Dipole Fit with several threads and with one thread
+    //*********************************************************************************************************
+
+    printf(">>>>>>>>>>>>>>>>>>>>>>>>> Compare Threaded Dipole Fit >>>>>>>>>>>>>>>>>>>>>>>>>\n");
+
+    ECDSet threadedSet = fitBem(4);
+    ECDSet serialSet = fitBem(1);
+
+    //The time points are fitted independently, the threads may only change the order in which they finish
+    QVERIFY( serialSet.size() > 1 );
+    QVERIFY( threadedSet.size() == serialSet.size() );
+
+    for (int i = 0; i < serialSet.size(); ++i)
+    {
+        if (i > 0)
+            QVERIFY( threadedSet[i].time > threadedSet[i-1].time );
+
+        QVERIFY( threadedSet[i].valid == serialSet[i].valid );
+        QVERIFY( threadedSet[i].time == serialSet[i].time );
+        QVERIFY( threadedSet[i].rd == serialSet[i].rd );
+        QVERIFY( threadedSet[i].Q == serialSet[i].Q );
+        QVERIFY( threadedSet[i].good == serialSet[i].good );
+        QVERIFY( threadedSet[i].khi2 == serialSet[i].khi2 );
+        QVERIFY( threadedSet[i].nfree == serialSet[i].nfree );
+        QVERIFY( threadedSet[i].neval == serialSet[i].neval );
+    }
+
+    printf("<<<<<<<<<<<<<<<<<<<<<<<<< Compare Threaded Dipole Fit Finished <<<<<<<<<<<<<<<<<<<<<<<<<\n");
+}
+
+
+//*************************************************************************************************************
+
+ECDSet TestDipoleFit::fitBem(int nthread)
+{
+    //Following is equivalent to: --meas ./mne-cpp-test-data/MEG/sample/sample_audvis-ave.fif --set 1 --noise ./mne-cpp-test-data/MEG/sample/sample_audvis-cov.fif --bem ./mne-cpp-test-data/subjects/sample/bem/sample-5120-bem.fif --mri ./mne-cpp-test-data/MEG/sample/all-trans.fif --meg --tmin 150 --tmax 250 --tstep 10 --dip ./mne-cpp-test-data/Result/dip-5120-bem_fit.dat --mindist 0 --guessrad 100 --threads nthread
+    DipoleFitSettings settings;
+
+    settings.measname = QDir::currentPath()+"/mne-cpp-test-data/MEG/sample/sample_audvis-ave.fif";
+    settings.is_raw = false;
+    settings.setno = 1;
+    settings.include_meg = true;
+    settings.include_eeg = false;
+    settings.tmin = 0.15f;
+    settings.tmax = 0.25f;
+    settings.tstep = 0.01f;
+    settings.bemname = QDir::currentPath()+"/mne-cpp-test-data/subjects/sample/bem/sample-5120-bem.fif";
+    settings.bmin = 1000000.0f;
+    settings.bmax = 1000000.0f;
+    settings.dipname = QDir::currentPath()+"/mne-cpp-test-data/Result/dip-5120-bem_fit.dat";
+    settings.guess_mindist = 0.0f;
+    settings.guess_rad = 0.1f;
+    settings.mriname = QDir::currentPath()+"/mne-cpp-test-data/MEG/sample/all-trans.fif";
+    settings.noisename = QDir::currentPath()+"/mne-cpp-test-data/MEG/sample/sample_audvis-cov.fif";
+    settings.projnames.append(QDir::currentPath()+"/mne-cpp-test-data/MEG/sample/sample_audvis-ave.fif");
+    settings.nthread = nthread;
+
+    settings.checkIntegrity();
+
+    DipoleFit dipFit(&settings);
+    return dipFit.calculateFit();
+}
+
+
 //*************************************************************************************************************
 
 void TestDipoleFit::compareFit()
@@ -0,0 +1,471 @@
+//=============================================================================================================
+/**
+* @file     test_fiff_raw_read.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    Test for the raw read plan, the raw buffer cache and the tag index sidecar
+*
+*/
+
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <fiff/fiff.h>
+#include <fiff/fiff_index.h>
+#include <fiff/fiff_raw_buffer_cache.h>
+#include <fiff/fiff_raw_reader.h>
+
+#include <Eigen/Dense>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace Eigen;
+
+
+//=============================================================================================================
+/**
+* DECLARE CLASS TestFiffRawRead
+*
+* @brief The TestFiffRawRead class checks plan based, parallel, cached and indexed raw reads against a baseline
+* decoded tag by tag, and that rewriting a file invalidates the buffer cache and the index sidecar
+*
+*/
+class TestFiffRawRead: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestFiffRawRead();
+
+private slots:
+    void initTestCase();
+    void compareReadPlan();
+    void compareProjectedReadPlan();
+    void compareParallelReader();
+    void compareCachedRead();
+    void compareIndexedRead();
+    void compareRewrittenFile();
+    void cleanupTestCase();
+
+private:
+    void writeTestFile(qint32 bufferSize, qint32 numSamples, double scale);
+    MatrixXd baselineSegment(FiffRawData& raw, fiff_int_t from, fiff_int_t to, const RowVectorXi& sel) const;
+    bool compareSegments(FiffRawData& raw, const QList<QPair<fiff_int_t, fiff_int_t> >& ranges, const RowVectorXi& sel);
+    double relativeDiff(const MatrixXd& data, const MatrixXd& ref) const;
+
+    double      epsilon;
+    QString     sourceFileName;
+    QString     testFileName;
+    RowVectorXi sel;
+};
+
+
+//*************************************************************************************************************
+
+TestFiffRawRead::TestFiffRawRead()
+: epsilon(0.000001)
+, sourceFileName("./mne-cpp-test-data/MEG/sample/sample_audvis_raw_short.fif")
+, testFileName("./mne-cpp-test-data/MEG/sample/sample_audvis_raw_short_test_raw_read_out.fif")
+{
+}
+
+
+//*************************************************************************************************************
+
+void TestFiffRawRead::initTestCase()
+{
+    qDebug() << "Epsilon" << epsilon;
+
+    FiffRawBufferCache::globalCache()->setMaxBytes(0);
+    FiffIndex::setEnabled(false);
+
+    QFile::remove(FiffIndex::indexFileName(testFileName));
+
+    //Short buffers, so the segments below start and end in the middle of buffers and span several of them
+    writeTestFile(250, 1500, 1.0);
+
+    QFile t_fileIn(testFileName);
+    FiffRawData raw(t_fileIn);
+    QVERIFY( raw.rawdir.size() == 6 );
+
+    //MEG and EEG channels, not in file order
+    RowVectorXi picks = raw.info.pick_types(true, true, false);
+    sel = RowVectorXi(picks.size());
+    for(int i = 0; i < picks.size(); ++i)
+        sel[i] = picks[picks.size() - 1 - i];
+}
+
+
+//*************************************************************************************************************
+
+void TestFiffRawRead::writeTestFile(qint32 bufferSize, qint32 numSamples, double scale)
+{
+    QFile t_fileIn(sourceFileName);
+    FiffRawData raw(t_fileIn);
+
+    QFile t_fileOut(testFileName);
+    RowVectorXd cals;
+    FiffStream::SPtr outfid = FiffStream::start_writing_raw(t_fileOut, raw.info, cals);
+
+    fiff_int_t first = raw.first_samp;
+    outfid->write_int(FIFF_FIRST_SAMPLE, &first);
+
+    MatrixXd data, times;
+    for(fiff_int_t from = raw.first_samp; from < raw.first_samp + numSamples; from += bufferSize) {
+        raw.read_raw_segment(data, times, from, from + bufferSize - 1);
+        outfid->write_raw_buffer(scale * data, cals);
+    }
+
+    outfid->finish_writing_raw();
+}
+
+
+//*************************************************************************************************************
+
+MatrixXd TestFiffRawRead::baselineSegment(FiffRawData& raw, fiff_int_t from, fiff_int_t to, const RowVectorXi& sel) const
+{
+    //Decode every buffer from its tag and apply calibration, projection and selection one after another
+    qint32 nchan = raw.info.nchan;
+    MatrixXd one = MatrixXd::Zero(nchan, to - from + 1);
+
+    if(!raw.file->device()->isOpen())
+        raw.file->device()->open(QIODevice::ReadOnly);
+
+    for(int k = 0; k < raw.rawdir.size(); ++k) {
+        const FiffRawDir& rawDir = raw.rawdir[k];
+        if(rawDir.last < from || rawDir.first > to || rawDir.ent->kind == -1)
+            continue;
+
+        FiffTag::SPtr t_pTag;
+        raw.file->read_tag(t_pTag, rawDir.ent->pos);
+
+        for(fiff_int_t s = qMax(from, rawDir.first); s <= qMin(to, rawDir.last); ++s) {
+            qint32 offset = (s - rawDir.first) * nchan;
+            for(qint32 ch = 0; ch < nchan; ++ch) {
+                double value = 0.0;
+                switch(t_pTag->getType()) {
+                case FIFFT_FLOAT:
+                    value = t_pTag->toFloat()[offset + ch];
+                    break;
+                case FIFFT_INT:
+                    value = t_pTag->toInt()[offset + ch];
+                    break;
+                case FIFFT_DAU_PACK16:
+                    value = t_pTag->toDauPack16()[offset + ch];
+                    break;
+                }
+                one(ch, s - from) = raw.cals[ch] * value;
+            }
+        }
+    }
+
+    if(raw.proj.size() > 0)
+        one = raw.proj * one;
+
+    if(sel.size() == 0)
+        return one;
+
+    MatrixXd picked(sel.size(), one.cols());
+    for(int i = 0; i < sel.size(); ++i)
+        picked.row(i) = one.row(sel[i]);
+
+    return picked;
+}
+
+
+//*************************************************************************************************************
+
+double TestFiffRawRead::relativeDiff(const MatrixXd& data, const MatrixXd& ref) const
+{
+    if(data.rows() != ref.rows() || data.cols() != ref.cols())
+        return 1.0;
+
+    return (data - ref).cwiseAbs().maxCoeff() / ref.cwiseAbs().maxCoeff();
+}
+
+
+//*************************************************************************************************************
+
+bool TestFiffRawRead::compareSegments(FiffRawData& raw, const QList<QPair<fiff_int_t, fiff_int_t> >& ranges, const RowVectorXi& sel)
+{
+    bool ok = true;
+
+    for(int i = 0; i < ranges.size(); ++i) {
+        fiff_int_t from = raw.first_samp + ranges[i].first;
+        fiff_int_t to = raw.first_samp + ranges[i].second;
+
+        MatrixXd data, times;
+        raw.read_raw_segment(data, times, from, to, sel);
+
+        if(relativeDiff(data, baselineSegment(raw, from, to, sel)) >= epsilon)
+            ok = false;
+    }
+
+    return ok;
+}
+
+
+//*************************************************************************************************************
+
+static QList<QPair<fiff_int_t, fiff_int_t> > testRanges()
+{
+    //Whole buffers, parts of one buffer, across boundaries, the last sample of a buffer and the whole file
+    QList<QPair<fiff_int_t, fiff_int_t> > ranges;
+    ranges << qMakePair(0, 249) << qMakePair(10, 20) << qMakePair(123, 877) << qMakePair(249, 250) << qMakePair(499, 499) << qMakePair(0, 1499);
+    return ranges;
+}
+
+
+//*************************************************************************************************************
+
+void TestFiffRawRead::compareReadPlan()
+{
+    QFile t_fileIn(testFileName);
+    FiffRawData raw(t_fileIn);
+
+    QVERIFY( compareSegments(raw, testRanges(), RowVectorXi()) );
+    QVERIFY( compareSegments(raw, testRanges(), sel) );
+
+    //The same again from the memory mapping
+    QVERIFY( raw.file->map_file() );
+    QVERIFY( compareSegments(raw, testRanges(), RowVectorXi()) );
+    QVERIFY( compareSegments(raw, testRanges(), sel) );
+}
+
+
+//*************************************************************************************************************
+
+void TestFiffRawRead::compareProjectedReadPlan()
+{
+    QFile t_fileIn(testFileName);
+    FiffRawData raw(t_fileIn);
+
+    //A dense projector, the plan has to be recompiled when it changes
+    srand(42);
+    raw.proj = MatrixXd::Identity(raw.info.nchan, raw.info.nchan) + 0.01 * MatrixXd::Random(raw.info.nchan, raw.info.nchan);
+    QVERIFY( compareSegments(raw, testRanges(), sel) );
+
+    raw.proj = 2.0 * raw.proj;
+    QVERIFY( compareSegments(raw, testRanges(), sel) );
+    QVERIFY( compareSegments(raw, testRanges(), RowVectorXi()) );
+}
+
+
+//*************************************************************************************************************
+
+void TestFiffRawRead::compareParallelReader()
+{
+    QFile t_fileIn(testFileName);
+    FiffRawData::SPtr pRaw(new FiffRawData(t_fileIn));
+
+    FiffRawReader reader(pRaw);
+
+    //The reader decodes in the background, so the baseline reads its own stream
+    QFile t_fileBaseline(testFileName);
+    FiffRawData rawBaseline(t_fileBaseline);
+
+    //Forward and backward, so prefetched segments are used as well
+    QList<QPair<fiff_int_t, fiff_int_t> > ranges = testRanges();
+    ranges << qMakePair(300, 599) << qMakePair(600, 899) << qMakePair(300, 599);
+
+    for(int i = 0; i < ranges.size(); ++i) {
+        fiff_int_t from = pRaw->first_samp + ranges[i].first;
+        fiff_int_t to = pRaw->first_samp + ranges[i].second;
+
+        MatrixXd data, times;
+        QVERIFY( reader.read_raw_segment(data, times, from, to, sel) );
+        QVERIFY( relativeDiff(data, baselineSegment(rawBaseline, from, to, sel)) < epsilon );
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestFiffRawRead::compareCachedRead()
+{
+    FiffRawBufferCache::SPtr cache = FiffRawBufferCache::globalCache();
+    cache->setMaxBytes(64*1024*1024);
+    cache->clear();
+    cache->resetStatistics();
+
+    QFile t_fileIn(testFileName);
+    FiffRawData raw(t_fileIn);
+
+    //The first pass fills the cache, the second one is served from it
+    QVERIFY( compareSegments(raw, testRanges(), sel) );
+    QVERIFY( cache->misses() > 0 );
+
+    qint64 iMisses = cache->misses();
+    QVERIFY( compareSegments(raw, testRanges(), sel) );
+    QVERIFY( cache->misses() == iMisses );
+    QVERIFY( cache->hits() > 0 );
+
+    //The cached buffers are calibrated with all channels, so a different selection hits as well
+    QVERIFY( compareSegments(raw, testRanges(), RowVectorXi()) );
+    QVERIFY( cache->misses() == iMisses );
+
+    //Other calibrations must not see the cached buffers
+    raw.cals *= 2.0;
+    QVERIFY( compareSegments(raw, testRanges(), sel) );
+    QVERIFY( cache->misses() > iMisses );
+
+    cache->setMaxBytes(0);
+}
+
+
+//*************************************************************************************************************
+
+void TestFiffRawRead::compareIndexedRead()
+{
+    QFile::remove(FiffIndex::indexFileName(testFileName));
+    FiffIndex::setEnabled(true);
+
+    //The first open creates the sidecar, the second one is set up from it
+    QFile t_fileFirst(testFileName);
+    FiffRawData rawFirst(t_fileFirst);
+    QVERIFY( QFile::exists(FiffIndex::indexFileName(testFileName)) );
+
+    QFile t_fileIndexed(testFileName);
+    FiffRawData rawIndexed(t_fileIndexed);
+
+    FiffIndex::setEnabled(false);
+
+    QFile t_fileIn(testFileName);
+    FiffRawData raw(t_fileIn);
+
+    QVERIFY( rawIndexed.info.nchan == raw.info.nchan );
+    QVERIFY( rawIndexed.info.ch_names == raw.info.ch_names );
+
+    //The measurement info is restored from the sidecar instead of being decoded from the tags
+    QVERIFY( rawIndexed.info.sfreq == raw.info.sfreq );
+    QVERIFY( rawIndexed.info.bads == raw.info.bads );
+    QVERIFY( rawIndexed.info.meas_id.time.secs == raw.info.meas_id.time.secs );
+    QVERIFY( rawIndexed.info.dig.size() == raw.info.dig.size() );
+    QVERIFY( rawIndexed.info.dev_head_t.trans == raw.info.dev_head_t.trans );
+    QVERIFY( rawIndexed.info.projs.size() == raw.info.projs.size() );
+    for(int i = 0; i < raw.info.projs.size(); ++i)
+        QVERIFY( rawIndexed.info.projs[i].data->data == raw.info.projs[i].data->data );
+    for(int c = 0; c < raw.info.nchan; ++c) {
+        QVERIFY( rawIndexed.info.chs[c].cal == raw.info.chs[c].cal );
+        QVERIFY( rawIndexed.info.chs[c].range == raw.info.chs[c].range );
+        QVERIFY( rawIndexed.info.chs[c].coil_trans == raw.info.chs[c].coil_trans );
+    }
+
+    QVERIFY( rawIndexed.first_samp == raw.first_samp );
+    QVERIFY( rawIndexed.last_samp == raw.last_samp );
+    QVERIFY( rawIndexed.rawdir.size() == raw.rawdir.size() );
+    QVERIFY( compareSegments(rawIndexed, testRanges(), sel) );
+}
+
+
+//*************************************************************************************************************
+
+void TestFiffRawRead::compareRewrittenFile()
+{
+    FiffRawBufferCache::SPtr cache = FiffRawBufferCache::globalCache();
+    cache->setMaxBytes(64*1024*1024);
+    cache->clear();
+
+    //Fill the cache and the sidecar with the current file
+    FiffIndex::setEnabled(true);
+    {
+        QFile t_fileIn(testFileName);
+        FiffRawData raw(t_fileIn);
+        QVERIFY( compareSegments(raw, testRanges(), sel) );
+    }
+
+    //Rewrite it with other buffers and other data
+    writeTestFile(200, 1000, 2.0);
+
+    QFile t_fileIndexed(testFileName);
+    FiffRawData rawIndexed(t_fileIndexed);
+
+    FiffIndex::setEnabled(false);
+    cache->setMaxBytes(0);
+
+    QFile t_fileIn(testFileName);
+    FiffRawData raw(t_fileIn);
+    QVERIFY( raw.rawdir.size() == 5 );
+
+    //The stale sidecar must not be used and the stale buffers must not be found
+    QVERIFY( rawIndexed.rawdir.size() == raw.rawdir.size() );
+    QVERIFY( rawIndexed.last_samp == raw.last_samp );
+
+    cache->setMaxBytes(64*1024*1024);
+
+    QList<QPair<fiff_int_t, fiff_int_t> > ranges;
+    ranges << qMakePair(0, 199) << qMakePair(123, 877) << qMakePair(0, 999);
+
+    for(int i = 0; i < ranges.size(); ++i) {
+        fiff_int_t from = raw.first_samp + ranges[i].first;
+        fiff_int_t to = raw.first_samp + ranges[i].second;
+
+        MatrixXd data, times;
+        rawIndexed.read_raw_segment(data, times, from, to, sel);
+        QVERIFY( relativeDiff(data, baselineSegment(raw, from, to, sel)) < epsilon );
+    }
+
+    cache->setMaxBytes(0);
+}
+
+
+//*************************************************************************************************************
+
+void TestFiffRawRead::cleanupTestCase()
+{
+    FiffRawBufferCache::globalCache()->setMaxBytes(0);
+    FiffIndex::setEnabled(false);
+
+    QFile::remove(FiffIndex::indexFileName(testFileName));
+}
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_APPLESS_MAIN(TestFiffRawRead)
+#include "test_fiff_raw_read.moc"
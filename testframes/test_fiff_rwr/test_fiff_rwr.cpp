@@ -41,6 +41,8 @@
 
 #include <fiff/fiff.h>
 
+#include <Eigen/Dense>
+
 #include <iostream>
 
 
@@ -78,6 +80,7 @@ private slots:
     void compareData();
     void compareTimes();
     void compareInfo();
+    void compareDoubleTag();
     void cleanupTestCase();
 
 private:
@@ -319,6 +322,35 @@ void TestFiffRWR::compareInfo()
     }
 }
 
+//*************************************************************************************************************
+
+void TestFiffRWR::compareDoubleTag()
+{
+    QFile t_fileOut("./mne-cpp-test-data/MEG/sample/test_rwr_double_out.fif");
+
+    VectorXd vals(7);
+    vals << 1.0, -2.5, 3.14159265358979, 1e-13, -4.2e12, 0.0, 7.0/3.0;
+
+    FiffStream::SPtr outfid = FiffStream::start_file(t_fileOut);
+    outfid->write_double(FIFF_MNE_COV_EIGENVALUES, vals.data(), vals.size());
+    outfid->end_file();
+    t_fileOut.close();
+
+    FiffStream::SPtr infid(new FiffStream(&t_fileOut));
+    QVERIFY( infid->open() );
+
+    FiffTag::SPtr t_pTag;
+    QVERIFY( infid->dirtree()->find_tag(infid, FIFF_MNE_COV_EIGENVALUES, t_pTag) );
+    QVERIFY( t_pTag->type == FIFFT_DOUBLE );
+    QVERIFY( t_pTag->size() == vals.size()*(qint32)sizeof(double) );
+
+    VectorXd vals_read = Map<VectorXd>(t_pTag->toDouble(), vals.size());
+    infid->close();
+
+    QVERIFY( vals == vals_read );
+}
+
+
 //*************************************************************************************************************
 
 void TestFiffRWR::cleanupTestCase()
@@ -41,6 +41,8 @@
 
 #include <fwd/computeFwd/compute_fwd_settings.h>
 #include <fwd/computeFwd/compute_fwd.h>
+#include <fwd/fwd_eeg_sphere_model.h>
+#include <fwd/fwd_eeg_sphere_model_set.h>
 #include <mne/mne.h>
 
 
@@ -59,6 +61,7 @@
 
 using namespace FWDLIB;
 using namespace MNELIB;
+using namespace Eigen;
 
 
 //=============================================================================================================
@@ -78,10 +81,13 @@ public:
 private slots:
     void initTestCase();
     void computeForward();
+    void compareThreadedForward();
+    void compareEegSphereTable();
     void cleanupTestCase();
 
 private:
     void compareForward();
+    MatrixXd computeForwardData(bool use_threads, const QString &solname);
 
     double epsilon;
 
@@ -209,6 +215,118 @@ void TestForwardSolution::compareForward()
 }
 
 
+//*************************************************************************************************************
+
+void TestForwardSolution::compareThreadedForward()
+{
+    //
+    //   The source chunks computed by the worker threads have to give the same solution as the serial loop
+    //
+    QString threadedName(QDir::currentPath()+"./mne-cpp-test-data/Result/sample_audvis-meeg-oct-6-threaded-fwd.fif");
+    QString serialName(QDir::currentPath()+"./mne-cpp-test-data/Result/sample_audvis-meeg-oct-6-serial-fwd.fif");
+
+    MatrixXd threadedData = computeForwardData(true, threadedName);
+    MatrixXd serialData = computeForwardData(false, serialName);
+
+    QFile::remove(threadedName);
+    QFile::remove(serialName);
+
+    QVERIFY( threadedData.size() > 0 );
+    QVERIFY( threadedData.rows() == serialData.rows() );
+    QVERIFY( threadedData.cols() == serialData.cols() );
+
+    double diff = (threadedData - serialData).cwiseAbs().maxCoeff() / serialData.cwiseAbs().maxCoeff();
+    printf("Largest relative difference of the threaded and the serial forward solution: %g\n", diff);
+
+    QVERIFY( diff < epsilon );
+}
+
+
+//*************************************************************************************************************
+
+MatrixXd TestForwardSolution::computeForwardData(bool use_threads, const QString &solname)
+{
+    //Following is equivalent to: --meg --eeg --src ./MNE-sample-data/subjects/sample/bem/sample-oct-6-src.fif
+    // --meas ./MNE-sample-data/MEG/sample/sample_audvis_raw.fif
+    // --mri ./MNE-sample-data/subjects/sample/mri/brain-neuromag/sets/COR.fif
+    // --bem ./MNE-sample-data/subjects/sample/bem/sample-5120-5120-5120-bem.fif
+    // --mindist 5 --fwd solname [--threads 1]
+    ComputeFwdSettings settings;
+
+    settings.include_meg = true;
+    settings.include_eeg = true;
+    settings.srcname = QDir::currentPath()+"./MNE-sample-data/subjects/sample/bem/sample-oct-6-src.fif";
+    settings.measname = QDir::currentPath()+"./MNE-sample-data/MEG/sample/sample_audvis_raw.fif";
+    settings.mriname = QDir::currentPath()+"./MNE-sample-data/subjects/sample/mri/brain-neuromag/sets/COR.fif";
+    settings.mri_head_ident = false;
+    settings.transname.clear();
+    settings.bemname = QDir::currentPath()+"./MNE-sample-data/subjects/sample/bem/sample-5120-5120-5120-bem.fif";
+    settings.mindist = 5.0f/1000.0f;
+    settings.solname = solname;
+    settings.use_threads = use_threads;
+
+    settings.checkIntegrity();
+
+    ComputeFwd cmpFwd(&settings);
+    cmpFwd.calculateFwd();
+
+    QFile t_fileForwardSolution(solname);
+    MNEForwardSolution t_Fwd(t_fileForwardSolution);
+
+    if(t_Fwd.isEmpty())
+        return MatrixXd();
+
+    return t_Fwd.sol->data;
+}
+
+
+//*************************************************************************************************************
+
+void TestForwardSolution::compareEegSphereTable()
+{
+    //
+    //   The interpolated series must match the exact one over the whole range of the table
+    //
+    FwdEegSphereModelSet* eeg_models = FwdEegSphereModelSet::fwd_add_default_eeg_sphere_model(NULL);
+    FwdEegSphereModel* eeg_model = eeg_models->fwd_select_eeg_sphere_model("Default");
+    QVERIFY( eeg_model != NULL );
+    QVERIFY( eeg_model->fwd_setup_eeg_sphere_model(0.09f, false, 3) );
+    QVERIFY( eeg_model->pot_table_beta > 0.0 );
+
+    qint32 nbeta = 50;
+    qint32 ngamma = 500;
+    double max_rel_err = 0.0;
+
+    for(qint32 i = 0; i <= nbeta; ++i) {
+        ArrayXd beta = ArrayXd::Constant(ngamma, i*eeg_model->pot_table_beta/nbeta);
+        ArrayXd cgamma = (M_PI*ArrayXd::Random(ngamma).abs()).cos();
+        ArrayXd Vr, Vt;
+
+        eeg_model->fwd_eeg_eval_pot_table(beta, cgamma, Vr, Vt);
+
+        double err_r = 0.0, err_t = 0.0, max_r = 0.0, max_t = 0.0;
+        for(qint32 k = 0; k < ngamma; ++k) {
+            double vr, vt;
+            FwdEegSphereModel::calc_pot_components(beta[k], cgamma[k], &vr, &vt, eeg_model->fn, eeg_model->nterms);
+            double sin_gamma = sqrt(qMax(0.0, 1.0 - cgamma[k]*cgamma[k]));
+            err_r = qMax(err_r, std::fabs(vr - Vr[k]));
+            err_t = qMax(err_t, std::fabs(vt - sin_gamma*Vt[k]));
+            max_r = qMax(max_r, std::fabs(vr));
+            max_t = qMax(max_t, std::fabs(vt));
+        }
+        max_rel_err = qMax(max_rel_err, err_r/max_r);
+        if(max_t > 0.0)
+            max_rel_err = qMax(max_rel_err, err_t/max_t);
+    }
+    printf("Largest relative error of the EEG sphere potential table: %g\n", max_rel_err);
+
+    delete eeg_model;
+    delete eeg_models;
+
+    QVERIFY( max_rel_err < 2e-7 );
+}
+
+
 //*************************************************************************************************************
 
 void TestForwardSolution::cleanupTestCase()
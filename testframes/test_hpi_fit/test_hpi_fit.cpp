@@ -0,0 +1,472 @@
+//=============================================================================================================
+/**
+* @file     test_hpi_fit.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    Test for the continuous HPI fit against the block fit on simulated coil signals
+*
+*/
+
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <inverse/hpiFit/hpifit.h>
+#include <fiff/fiff_info.h>
+#include <fiff/fiff_coord_trans.h>
+#include <fiff/fiff_dig_point_set.h>
+
+#include <math.h>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace INVERSELIB;
+using namespace FIFFLIB;
+using namespace Eigen;
+
+
+//=============================================================================================================
+/**
+* DECLARE CLASS TestHpiFit
+*
+* @brief The TestHpiFit class checks the continuous HPI fit against the block fit and the simulated coil positions
+*
+*/
+class TestHpiFit: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestHpiFit();
+
+private slots:
+    void initTestCase();
+    void compareDemodulation();
+    void compareContinuousWithBlock();
+    void compareSlidingWindow();
+    void compareSetupChange();
+    void cleanupTestCase();
+
+private:
+    VectorXd field(const Vector3d& vecPos, const Vector3d& vecMom, const QVector<int>& vChannels) const;
+    MatrixXd simulate(const MatrixXd& matCoilPos, qint64 iFirstSample, int iNumSamples) const;
+    bool demodulate(const MatrixXd& matCoilPos, HPIFitState& state, int iNumBlocks, FiffInfo::SPtr pInfo);
+    bool comparePattern(const MatrixXd& matAmp, const MatrixXd& matCoilPos, const QVector<int>& vChannels) const;
+    bool comparePoints(const FiffDigPointSet& pointSet, const MatrixXd& matCoilPos) const;
+    double relativeDiff(const VectorXd& vec, const VectorXd& vecRef) const;
+
+    double          epsilon;
+    double          posTol;
+    double          sfreq;
+    int             numCoils;
+    int             blockSize;
+    int             windowSize;
+
+    QVector<int>    freqs;
+    VectorXd        phases;
+    MatrixXd        sensorPos;
+    MatrixXd        sensorOri;
+    MatrixXd        coilPos;
+    MatrixXd        coilMom;
+    Matrix4d        devHead;
+    MatrixXd        projector;
+
+    FiffInfo::SPtr  info;
+};
+
+
+//*************************************************************************************************************
+
+TestHpiFit::TestHpiFit()
+: epsilon(0.000001)
+, posTol(0.001)
+, sfreq(1000.0)
+, numCoils(4)
+, blockSize(100)
+, windowSize(1000)
+{
+}
+
+
+//*************************************************************************************************************
+
+void TestHpiFit::initTestCase()
+{
+    qDebug() << "Epsilon" << epsilon;
+    qDebug() << "Position tolerance" << posTol;
+
+    freqs << 154 << 158 << 161 << 166;
+    phases = VectorXd::LinSpaced(numCoils, 0.3, 2.1);
+
+    //Radial magnetometers in rings on a spherical helmet, 12 cm radius
+    QList<Vector3d> lSensors;
+    lSensors.append(Vector3d(0.0, 0.0, 1.0));
+    for(int k = 1; k <= 6; ++k) {
+        double dTheta = k * 12.0 * M_PI / 180.0;
+        for(int j = 0; j < 6 * k; ++j) {
+            double dPhi = 2.0 * M_PI * j / (6 * k);
+            lSensors.append(Vector3d(sin(dTheta) * cos(dPhi), sin(dTheta) * sin(dPhi), cos(dTheta)));
+        }
+    }
+
+    int numChannels = lSensors.size();
+    sensorPos.resize(numChannels, 3);
+    sensorOri.resize(numChannels, 3);
+
+    info = FiffInfo::SPtr(new FiffInfo());
+    info->nchan = numChannels;
+    info->sfreq = sfreq;
+
+    for(int i = 0; i < numChannels; ++i) {
+        sensorOri.row(i) = lSensors.at(i).transpose();
+        sensorPos.row(i) = 0.12 * lSensors.at(i).transpose();
+
+        FiffChInfo ch;
+        ch.kind = FIFFV_MEG_CH;
+        ch.ch_name = QString("MEG %1").arg(i + 1);
+        ch.chpos.coil_type = FIFFV_COIL_BABY_MAG;
+        for(int k = 0; k < 3; ++k) {
+            ch.chpos.r0[k] = sensorPos(i,k);
+            ch.chpos.ez[k] = sensorOri(i,k);
+        }
+        info->chs.append(ch);
+        info->ch_names.append(ch.ch_name);
+    }
+
+    //Coils 3 cm below the helmet, with tilted moments
+    coilPos.resize(numCoils, 3);
+    coilMom.resize(numCoils, 3);
+    for(int i = 0; i < numCoils; ++i) {
+        double dTheta = (35.0 + 5.0 * i) * M_PI / 180.0;
+        double dPhi = (45.0 + 90.0 * i) * M_PI / 180.0;
+        Vector3d vecDir(sin(dTheta) * cos(dPhi), sin(dTheta) * sin(dPhi), cos(dTheta));
+
+        coilPos.row(i) = 0.09 * vecDir.transpose();
+        coilMom.row(i) = (vecDir + Vector3d(0.2, -0.1, 0.1)).normalized().transpose();
+    }
+
+    //Digitize the coils in head coordinates of a slightly rotated and shifted head
+    devHead.setIdentity();
+    devHead.topLeftCorner(3,3) = AngleAxisd(0.1, Vector3d::UnitZ()).toRotationMatrix();
+    devHead.block(0,3,3,1) = Vector3d(0.002, -0.01, 0.04);
+
+    for(int i = 0; i < numCoils; ++i) {
+        Vector3d vecHead = devHead.topLeftCorner(3,3) * coilPos.row(i).transpose() + devHead.block(0,3,3,1);
+
+        FiffDigPoint digPoint;
+        digPoint.kind = FIFFV_POINT_HPI;
+        digPoint.ident = i + 1;
+        digPoint.coord_frame = FIFFV_COORD_HEAD;
+        for(int k = 0; k < 3; ++k) {
+            digPoint.r[k] = vecHead(k);
+        }
+        info->dig.append(digPoint);
+    }
+
+    projector = MatrixXd::Identity(numChannels, numChannels);
+}
+
+
+//*************************************************************************************************************
+
+VectorXd TestHpiFit::field(const Vector3d& vecPos, const Vector3d& vecMom, const QVector<int>& vChannels) const
+{
+    //Magnetic dipole in infinite vacuum, the forward model of the fit
+    VectorXd vecField(vChannels.size());
+
+    for(int i = 0; i < vChannels.size(); ++i) {
+        Vector3d vecR = sensorPos.row(vChannels.at(i)).transpose() - vecPos;
+        Vector3d vecOri = sensorOri.row(vChannels.at(i)).transpose();
+        double dR2 = vecR.squaredNorm();
+
+        vecField(i) = 1e-7 * (3 * vecR.dot(vecMom) * vecR.dot(vecOri) - dR2 * vecMom.dot(vecOri)) / (4 * M_PI * dR2 * dR2 * sqrt(dR2));
+    }
+
+    return vecField;
+}
+
+
+//*************************************************************************************************************
+
+MatrixXd TestHpiFit::simulate(const MatrixXd& matCoilPos, qint64 iFirstSample, int iNumSamples) const
+{
+    QVector<int> vAll;
+    for(int i = 0; i < sensorPos.rows(); ++i) {
+        vAll.append(i);
+    }
+
+    MatrixXd matData = MatrixXd::Zero(sensorPos.rows(), iNumSamples);
+
+    for(int i = 0; i < numCoils; ++i) {
+        VectorXd vecField = field(matCoilPos.row(i).transpose(), coilMom.row(i).transpose(), vAll);
+
+        RowVectorXd vecSignal(iNumSamples);
+        for(int j = 0; j < iNumSamples; ++j) {
+            vecSignal(j) = sin(2 * M_PI * freqs.at(i) * (iFirstSample + j) / sfreq + phases(i));
+        }
+
+        matData += vecField * vecSignal;
+    }
+
+    return matData;
+}
+
+
+//*************************************************************************************************************
+
+bool TestHpiFit::demodulate(const MatrixXd& matCoilPos, HPIFitState& state, int iNumBlocks, FiffInfo::SPtr pInfo)
+{
+    bool bReady = false;
+
+    for(int b = 0; b < iNumBlocks; ++b) {
+        MatrixXd matBlock = simulate(matCoilPos, state.iSampleCount, blockSize);
+        bReady = HPIFit::demodulateContinuous(matBlock, projector, freqs, pInfo, state, windowSize);
+    }
+
+    return bReady;
+}
+
+
+//*************************************************************************************************************
+
+bool TestHpiFit::comparePattern(const MatrixXd& matAmp, const MatrixXd& matCoilPos, const QVector<int>& vChannels) const
+{
+    if(matAmp.rows() != vChannels.size() || matAmp.cols() != numCoils)
+        return false;
+
+    //The demodulated amplitude has the full field of the coil, its sign is arbitrary
+    for(int i = 0; i < numCoils; ++i) {
+        VectorXd vecRef = field(matCoilPos.row(i).transpose(), coilMom.row(i).transpose(), vChannels);
+        VectorXd vecAmp = matAmp.col(i).dot(vecRef) < 0 ? VectorXd(-matAmp.col(i)) : VectorXd(matAmp.col(i));
+
+        if(relativeDiff(vecAmp, vecRef) >= epsilon)
+            return false;
+    }
+
+    return true;
+}
+
+
+//*************************************************************************************************************
+
+bool TestHpiFit::comparePoints(const FiffDigPointSet& pointSet, const MatrixXd& matCoilPos) const
+{
+    if(pointSet.size() != numCoils)
+        return false;
+
+    for(int i = 0; i < numCoils; ++i) {
+        Vector3d vecFit(pointSet[i].r[0], pointSet[i].r[1], pointSet[i].r[2]);
+
+        if((vecFit - matCoilPos.row(i).transpose()).norm() >= posTol)
+            return false;
+    }
+
+    return true;
+}
+
+
+//*************************************************************************************************************
+
+double TestHpiFit::relativeDiff(const VectorXd& vec, const VectorXd& vecRef) const
+{
+    return (vec - vecRef).cwiseAbs().maxCoeff() / vecRef.cwiseAbs().maxCoeff();
+}
+
+
+//*************************************************************************************************************
+
+void TestHpiFit::compareDemodulation()
+{
+    QVector<int> vAll;
+    for(int i = 0; i < info->nchan; ++i) {
+        vAll.append(i);
+    }
+
+    //Blocks are only reported once the window is full
+    HPIFitState stateBlocks;
+    QVERIFY( !demodulate(coilPos, stateBlocks, windowSize / blockSize - 1, info) );
+    QVERIFY( demodulate(coilPos, stateBlocks, 1, info) );
+    QVERIFY( stateBlocks.iWindowSamples == windowSize );
+
+    //The block-wise lock-in gives the same amplitudes as one pass over the whole window
+    HPIFitState stateWhole;
+    QVERIFY( HPIFit::demodulateContinuous(simulate(coilPos, 0, windowSize), projector, freqs, info, stateWhole, windowSize) );
+
+    QVERIFY( comparePattern(stateBlocks.amp, coilPos, vAll) );
+    QVERIFY( comparePattern(stateWhole.amp, coilPos, vAll) );
+}
+
+
+//*************************************************************************************************************
+
+void TestHpiFit::compareContinuousWithBlock()
+{
+    FiffCoordTrans transBlock;
+    QVector<double> vGofBlock;
+    FiffDigPointSet pointsBlock;
+    HPIFit::fitHPI(simulate(coilPos, 0, windowSize), projector, transBlock, freqs, vGofBlock, pointsBlock, info);
+
+    HPIFitState state;
+    QVERIFY( demodulate(coilPos, state, windowSize / blockSize, info) );
+
+    FiffCoordTrans transCont;
+    QVector<double> vGofCont;
+    FiffDigPointSet pointsCont;
+    QVERIFY( HPIFit::fitHPIContinuous(transCont, vGofCont, pointsCont, info, state) );
+
+    //Both fits find the simulated coils and the simulated device to head transformation
+    QVERIFY( comparePoints(pointsBlock, coilPos) );
+    QVERIFY( comparePoints(pointsCont, coilPos) );
+
+    QVERIFY( vGofBlock.size() == numCoils && vGofCont.size() == numCoils );
+    for(int i = 0; i < numCoils; ++i) {
+        QVERIFY( vGofBlock.at(i) < posTol );
+        QVERIFY( vGofCont.at(i) < posTol );
+    }
+
+    Vector3d vecShift = devHead.block(0,3,3,1);
+    QVERIFY( (transBlock.trans.block(0,3,3,1).cast<double>() - vecShift).norm() < posTol );
+    QVERIFY( (transCont.trans.block(0,3,3,1).cast<double>() - vecShift).norm() < posTol );
+
+    //A good fit seeds the next one
+    QVERIFY( state.bPosValid );
+}
+
+
+//*************************************************************************************************************
+
+void TestHpiFit::compareSlidingWindow()
+{
+    QVector<int> vAll;
+    for(int i = 0; i < info->nchan; ++i) {
+        vAll.append(i);
+    }
+
+    HPIFitState state;
+    QVERIFY( demodulate(coilPos, state, windowSize / blockSize, info) );
+
+    FiffCoordTrans trans;
+    QVector<double> vGof;
+    FiffDigPointSet points;
+    QVERIFY( HPIFit::fitHPIContinuous(trans, vGof, points, info, state) );
+    QVERIFY( state.bPosValid );
+
+    //The head moves, once the window has slid past the old position only the new one is seen
+    Vector3d vecMove(0.004, -0.003, 0.002);
+    MatrixXd coilPosMoved = coilPos.rowwise() + vecMove.transpose();
+
+    QVERIFY( demodulate(coilPosMoved, state, windowSize / blockSize, info) );
+    QVERIFY( state.iWindowSamples == windowSize );
+    QVERIFY( state.lBlockSizes.size() == windowSize / blockSize );
+    QVERIFY( comparePattern(state.amp, coilPosMoved, vAll) );
+
+    FiffDigPointSet pointsMoved;
+    QVERIFY( HPIFit::fitHPIContinuous(trans, vGof, pointsMoved, info, state) );
+    QVERIFY( comparePoints(pointsMoved, coilPosMoved) );
+
+    Vector3d vecShift = devHead.block(0,3,3,1) - devHead.topLeftCorner(3,3) * vecMove;
+    QVERIFY( (trans.trans.block(0,3,3,1).cast<double>() - vecShift).norm() < posTol );
+}
+
+
+//*************************************************************************************************************
+
+void TestHpiFit::compareSetupChange()
+{
+    HPIFitState state;
+    QVERIFY( demodulate(coilPos, state, windowSize / blockSize, info) );
+
+    FiffCoordTrans trans;
+    QVector<double> vGof;
+    FiffDigPointSet points;
+    QVERIFY( HPIFit::fitHPIContinuous(trans, vGof, points, info, state) );
+    QVERIFY( state.bPosValid );
+
+    //A new bad channel restarts the demodulation without the channel but keeps the seed
+    FiffInfo::SPtr pInfoBad(new FiffInfo(*info));
+    pInfoBad->bads << pInfoBad->ch_names.at(0);
+
+    QVERIFY( !demodulate(coilPos, state, 1, pInfoBad) );
+    QVERIFY( state.innerind.size() == info->nchan - 1 );
+    QVERIFY( state.iWindowSamples == blockSize );
+    QVERIFY( state.bPosValid );
+
+    QVERIFY( demodulate(coilPos, state, windowSize / blockSize - 1, pInfoBad) );
+    QVERIFY( comparePattern(state.amp, coilPos, state.innerind) );
+
+    FiffDigPointSet pointsBad;
+    QVERIFY( HPIFit::fitHPIContinuous(trans, vGof, pointsBad, pInfoBad, state) );
+    QVERIFY( comparePoints(pointsBad, coilPos) );
+
+    //New coil frequencies change the coil order, the old positions must not seed the fit
+    QVector<int> vFreqsSwapped = freqs;
+    qSwap(vFreqsSwapped[0], vFreqsSwapped[1]);
+
+    QVERIFY( !HPIFit::demodulateContinuous(simulate(coilPos, state.iSampleCount, blockSize), projector, vFreqsSwapped, pInfoBad, state, windowSize) );
+    QVERIFY( !state.bPosValid );
+}
+
+
+//*************************************************************************************************************
+
+void TestHpiFit::cleanupTestCase()
+{
+}
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_APPLESS_MAIN(TestHpiFit)
+#include "test_hpi_fit.moc"
@@ -0,0 +1,232 @@
+//=============================================================================================================
+/**
+* @file     test_inverse_operator.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    Test for the assembly of inverse operators which reuse the noise covariance independent parts
+*
+*/
+
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <fiff/fiff_cov.h>
+#include <fiff/fiff_raw_data.h>
+#include <mne/mne_forwardsolution.h>
+#include <mne/mne_inverse_operator.h>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace MNELIB;
+using namespace Eigen;
+
+
+//=============================================================================================================
+/**
+* DECLARE CLASS TestInverseOperator
+*
+* @brief The TestInverseOperator class checks that inverse operators built from cached parts equal freshly built ones
+*
+*/
+class TestInverseOperator: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestInverseOperator();
+
+private slots:
+    void initTestCase();
+    void compareCachedOperator();
+    void compareChangedSelection();
+    void cleanupTestCase();
+
+private:
+    bool compareOperators(const MNEInverseOperator& invOp, const MNEInverseOperator& invOpRef) const;
+    double relativeDiff(const MatrixXd& mat, const MatrixXd& matRef) const;
+
+    double              epsilon;
+
+    FiffInfo            info;
+    MNEForwardSolution  forwardMeg;
+    FiffCov             noiseCov;
+};
+
+
+//*************************************************************************************************************
+
+TestInverseOperator::TestInverseOperator()
+: epsilon(0.000001)
+{
+}
+
+
+//*************************************************************************************************************
+
+void TestInverseOperator::initTestCase()
+{
+    qDebug() << "Epsilon" << epsilon;
+
+    QFile t_fileRaw(QDir::currentPath()+"/mne-cpp-test-data/MEG/sample/sample_audvis_raw_short.fif");
+    FiffRawData raw(t_fileRaw);
+    info = raw.info;
+
+    QFile t_fileFwd(QDir::currentPath()+"/mne-cpp-test-data/MEG/sample/sample_audvis-meg-eeg-oct-6-fwd.fif");
+    MNEForwardSolution forward(t_fileFwd, false, true);
+    forwardMeg = forward.pick_types(true, false);
+
+    QFile t_fileCov(QDir::currentPath()+"/mne-cpp-test-data/MEG/sample/sample_audvis-cov.fif");
+    noiseCov = FiffCov(t_fileCov);
+
+    QVERIFY( !forwardMeg.isEmpty() );
+    QVERIFY( noiseCov.dim > 0 );
+}
+
+
+//*************************************************************************************************************
+
+void TestInverseOperator::compareCachedOperator()
+{
+    PreparedForward prepared;
+
+    //The first call fills the cache and has to match the plain assembly
+    MNEInverseOperator invOpCached = MNEInverseOperator::make_inverse_operator(info, forwardMeg, noiseCov, prepared, 0.2f, 0.8f);
+    MNEInverseOperator invOpRef = MNEInverseOperator::make_inverse_operator(info, forwardMeg, noiseCov, 0.2f, 0.8f);
+
+    QVERIFY( prepared.gain.rows() > 0 );
+    QVERIFY( prepared.depth_prior.constData() != NULL );
+    QVERIFY( compareOperators(invOpCached, invOpRef) );
+
+    //A new covariance with the same bad channels reuses gain and depth prior
+    FiffCov noiseCovNew = noiseCov;
+    noiseCovNew.data.diagonal() *= 1.5;
+
+    const FiffCov* pDepthPrior = prepared.depth_prior.constData();
+    const double* pGain = prepared.gain.data();
+
+    invOpCached = MNEInverseOperator::make_inverse_operator(info, forwardMeg, noiseCovNew, prepared, 0.2f, 0.8f);
+    invOpRef = MNEInverseOperator::make_inverse_operator(info, forwardMeg, noiseCovNew, 0.2f, 0.8f);
+
+    QVERIFY( prepared.depth_prior.constData() == pDepthPrior );
+    QVERIFY( prepared.gain.data() == pGain );
+    QVERIFY( compareOperators(invOpCached, invOpRef) );
+}
+
+
+//*************************************************************************************************************
+
+void TestInverseOperator::compareChangedSelection()
+{
+    PreparedForward prepared;
+    MNEInverseOperator::make_inverse_operator(info, forwardMeg, noiseCov, prepared, 0.2f, 0.8f);
+    int iNumChannels = prepared.gain_info.ch_names.size();
+
+    //An additional bad channel changes the selection, the cached parts have to be recomputed
+    FiffCov noiseCovBad = noiseCov;
+    noiseCovBad.bads << prepared.gain_info.ch_names.first();
+
+    MNEInverseOperator invOpCached = MNEInverseOperator::make_inverse_operator(info, forwardMeg, noiseCovBad, prepared, 0.2f, 0.8f);
+    MNEInverseOperator invOpRef = MNEInverseOperator::make_inverse_operator(info, forwardMeg, noiseCovBad, 0.2f, 0.8f);
+
+    QVERIFY( prepared.gain_info.ch_names.size() == iNumChannels - 1 );
+    QVERIFY( prepared.gain.rows() == iNumChannels - 1 );
+    QVERIFY( compareOperators(invOpCached, invOpRef) );
+
+    //A different depth weighting recomputes the depth prior only
+    invOpCached = MNEInverseOperator::make_inverse_operator(info, forwardMeg, noiseCovBad, prepared, 0.2f, 0.5f);
+    invOpRef = MNEInverseOperator::make_inverse_operator(info, forwardMeg, noiseCovBad, 0.2f, 0.5f);
+
+    QVERIFY( compareOperators(invOpCached, invOpRef) );
+}
+
+
+//*************************************************************************************************************
+
+void TestInverseOperator::cleanupTestCase()
+{
+}
+
+
+//*************************************************************************************************************
+
+bool TestInverseOperator::compareOperators(const MNEInverseOperator& invOp, const MNEInverseOperator& invOpRef) const
+{
+    if(invOp.sing.size() != invOpRef.sing.size()
+            || invOp.eigen_fields->data.rows() != invOpRef.eigen_fields->data.rows()
+            || invOp.eigen_leads->data.cols() != invOpRef.eigen_leads->data.cols()) {
+        return false;
+    }
+
+    return relativeDiff(invOp.sing, invOpRef.sing) < epsilon
+            && relativeDiff(invOp.eigen_fields->data, invOpRef.eigen_fields->data) < epsilon
+            && relativeDiff(invOp.eigen_leads->data, invOpRef.eigen_leads->data) < epsilon
+            && relativeDiff(invOp.source_cov->data, invOpRef.source_cov->data) < epsilon
+            && relativeDiff(invOp.noise_cov->data, invOpRef.noise_cov->data) < epsilon;
+}
+
+
+//*************************************************************************************************************
+
+double TestInverseOperator::relativeDiff(const MatrixXd& mat, const MatrixXd& matRef) const
+{
+    return (mat - matRef).norm() / matRef.norm();
+}
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_APPLESS_MAIN(TestInverseOperator)
+#include "test_inverse_operator.moc"
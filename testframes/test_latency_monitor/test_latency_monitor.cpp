@@ -0,0 +1,270 @@
+//=============================================================================================================
+/**
+* @file     test_latency_monitor.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    Test for the latency histograms of the LatencyMonitor
+*
+*/
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <scMeas/latencymonitor.h>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <cmath>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace SCMEASLIB;
+
+
+//=============================================================================================================
+/**
+* DECLARE CLASS TestLatencyMonitor
+*
+* @brief The TestLatencyMonitor class checks the percentiles of the LatencyHistogram and the per instance
+*        bookkeeping of the LatencyMonitor
+*
+*/
+class TestLatencyMonitor: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestLatencyMonitor();
+
+private slots:
+    void initTestCase();
+    void compareUniformPercentiles();
+    void compareSkewedPercentiles();
+    void compareClear();
+    void compareInstances();
+    void compareRemoveInstance();
+    void cleanupTestCase();
+
+private:
+    double relativeError(qint64 iValue, qint64 iExact) const;
+
+    double  epsilon;
+};
+
+
+//*************************************************************************************************************
+
+TestLatencyMonitor::TestLatencyMonitor()
+: epsilon(std::pow(2.0, 1.0 / 8.0) - 1.0 + 0.001)
+{
+}
+
+
+//*************************************************************************************************************
+
+void TestLatencyMonitor::initTestCase()
+{
+    qDebug() << "Allowed relative percentile error" << epsilon;
+}
+
+
+//*************************************************************************************************************
+
+double TestLatencyMonitor::relativeError(qint64 iValue, qint64 iExact) const
+{
+    return std::fabs((double)(iValue - iExact)) / (double)iExact;
+}
+
+
+//*************************************************************************************************************
+
+void TestLatencyMonitor::compareUniformPercentiles()
+{
+    //1 us to 10 ms in steps of 1 us
+    LatencyHistogram histogram;
+    for(qint64 i = 1; i <= 10000; ++i)
+        histogram.record(i * 1000);
+
+    QVERIFY(histogram.count() == 10000);
+    QVERIFY(histogram.max() == 10000 * 1000);
+    QVERIFY(histogram.mean() == 5000500);
+
+    QVERIFY(relativeError(histogram.percentile(0.5), 5000 * 1000) <= epsilon);
+    QVERIFY(relativeError(histogram.percentile(0.9), 9000 * 1000) <= epsilon);
+    QVERIFY(relativeError(histogram.percentile(0.99), 9900 * 1000) <= epsilon);
+
+    //The upper bin edge must never exceed the exact maximum
+    QVERIFY(histogram.percentile(1.0) == histogram.max());
+}
+
+
+//*************************************************************************************************************
+
+void TestLatencyMonitor::compareSkewedPercentiles()
+{
+    //99% fast blocks and a tail of slow ones, the tail must not move the median but define the maximum
+    LatencyHistogram histogram;
+    for(int i = 0; i < 990; ++i)
+        histogram.record(1000000);
+    for(int i = 0; i < 10; ++i)
+        histogram.record(100000000);
+
+    QVERIFY(relativeError(histogram.percentile(0.5), 1000000) <= epsilon);
+    QVERIFY(relativeError(histogram.percentile(0.99), 1000000) <= epsilon);
+    QVERIFY(histogram.percentile(0.995) == 100000000);
+    QVERIFY(histogram.max() == 100000000);
+    QVERIFY(histogram.mean() == (990LL * 1000000 + 10LL * 100000000) / 1000);
+
+    //Non-positive latencies end up in the lowest bin instead of corrupting the histogram
+    LatencyHistogram histogramZero;
+    histogramZero.record(0);
+    histogramZero.record(-5);
+    QVERIFY(histogramZero.count() == 2);
+    QVERIFY(histogramZero.percentile(0.5) <= 1);
+}
+
+
+//*************************************************************************************************************
+
+void TestLatencyMonitor::compareClear()
+{
+    LatencyHistogram histogram;
+    for(int i = 1; i <= 100; ++i)
+        histogram.record(i * 1000);
+
+    histogram.clear();
+
+    QVERIFY(histogram.count() == 0);
+    QVERIFY(histogram.max() == 0);
+    QVERIFY(histogram.mean() == 0);
+    QVERIFY(histogram.percentile(0.5) == 0);
+
+    histogram.record(2000);
+    QVERIFY(histogram.count() == 1);
+    QVERIFY(histogram.max() == 2000);
+    QVERIFY(relativeError(histogram.percentile(0.5), 2000) <= epsilon);
+}
+
+
+//*************************************************************************************************************
+
+void TestLatencyMonitor::compareInstances()
+{
+    LatencyMonitor* pMonitor = LatencyMonitor::instance();
+    pMonitor->setEnabled(true);
+
+    int iSensor = 0, iFilter = 0;
+
+    //A plugin without inputs starts a new block
+    qint64 iBefore = LatencyMonitor::now();
+    qint64 iOrigin = pMonitor->outputEmitted(&iSensor, "TestSensor");
+    QVERIFY(iOrigin >= iBefore);
+    QVERIFY(pMonitor->histogram("TestSensor: compute")->count() == 0);
+
+    //A processing plugin passes the origin on and records compute and end-to-end latency
+    pMonitor->inputArrived(&iFilter, iOrigin);
+    QVERIFY(pMonitor->outputEmitted(&iFilter, "TestFilter") == iOrigin);
+
+    LatencyHistogram* pCompute = pMonitor->histogram("TestFilter: compute");
+    LatencyHistogram* pEndToEnd = pMonitor->histogram("TestFilter: end-to-end");
+    QVERIFY(pCompute->count() == 1);
+    QVERIFY(pEndToEnd->count() == 1);
+    QVERIFY(pEndToEnd->max() >= pCompute->max());
+
+    //The handle is stable and records through the monitor
+    QVERIFY(pMonitor->histogram("TestFilter: compute") == pCompute);
+    pMonitor->record(pCompute, 1000);
+    QVERIFY(pCompute->count() == 2);
+
+    //Disabled monitoring records nothing
+    pMonitor->setEnabled(false);
+    pMonitor->record(pCompute, 1000);
+    pMonitor->inputArrived(&iFilter, iOrigin);
+    pMonitor->outputEmitted(&iFilter, "TestFilter");
+    QVERIFY(pCompute->count() == 2);
+    pMonitor->setEnabled(true);
+
+    pMonitor->removeInstance(&iSensor);
+    pMonitor->removeInstance(&iFilter);
+}
+
+
+//*************************************************************************************************************
+
+void TestLatencyMonitor::compareRemoveInstance()
+{
+    LatencyMonitor* pMonitor = LatencyMonitor::instance();
+
+    int iPlugin = 0;
+
+    pMonitor->inputArrived(&iPlugin, LatencyMonitor::now());
+    pMonitor->outputEmitted(&iPlugin, "TestRemoved");
+    QVERIFY(pMonitor->histogram("TestRemoved: compute")->count() == 1);
+
+    //A removed instance is treated like a new plugin without inputs, it must not inherit the old origin
+    pMonitor->removeInstance(&iPlugin);
+
+    qint64 iBefore = LatencyMonitor::now();
+    QVERIFY(pMonitor->outputEmitted(&iPlugin, "TestRemoved") >= iBefore);
+    QVERIFY(pMonitor->histogram("TestRemoved: compute")->count() == 1);
+}
+
+
+//*************************************************************************************************************
+
+void TestLatencyMonitor::cleanupTestCase()
+{
+}
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_APPLESS_MAIN(TestLatencyMonitor)
+#include "test_latency_monitor.moc"
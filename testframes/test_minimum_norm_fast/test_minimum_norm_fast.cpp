@@ -0,0 +1,273 @@
+//=============================================================================================================
+/**
+* @file     test_minimum_norm_fast.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    Test for the single precision fast apply mode of MinimumNorm
+*
+*/
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <fiff/fiff_cov.h>
+#include <fiff/fiff_raw_data.h>
+#include <mne/mne_forwardsolution.h>
+#include <mne/mne_inverse_operator.h>
+#include <mne/mne_sourceestimate.h>
+#include <inverse/minimumNorm/minimumnorm.h>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace MNELIB;
+using namespace INVERSELIB;
+using namespace Eigen;
+
+
+//=============================================================================================================
+/**
+* DECLARE CLASS TestMinimumNormFast
+*
+* @brief The TestMinimumNormFast class checks that the single precision kernel gives the double precision result
+*
+*/
+class TestMinimumNormFast: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestMinimumNormFast();
+
+private slots:
+    void initTestCase();
+    void compareMNE();
+    void compareDSPM();
+    void compareSLORETA();
+    void compareFixedOrientation();
+    void compareSourceSelection();
+    void cleanupTestCase();
+
+private:
+    bool compareMethod(const MNEInverseOperator& invOp, const QString& sMethod) const;
+    double relativeDiff(const MatrixXd& mat, const MatrixXd& matRef) const;
+
+    double              epsilon;
+    float               lambda2;
+    int                 numSamples;
+
+    MNEInverseOperator  invOpFree;
+    MNEInverseOperator  invOpFixed;
+};
+
+
+//*************************************************************************************************************
+
+TestMinimumNormFast::TestMinimumNormFast()
+: epsilon(0.0001)
+, lambda2(1.0f / 9.0f)
+, numSamples(50)
+{
+}
+
+
+//*************************************************************************************************************
+
+void TestMinimumNormFast::initTestCase()
+{
+    //Single precision, the relative error is bound by the float epsilon times the kernel width
+    qDebug() << "Epsilon" << epsilon;
+
+    QFile t_fileRaw(QDir::currentPath()+"/mne-cpp-test-data/MEG/sample/sample_audvis_raw_short.fif");
+    FiffRawData raw(t_fileRaw);
+
+    QFile t_fileFwd(QDir::currentPath()+"/mne-cpp-test-data/MEG/sample/sample_audvis-meg-eeg-oct-6-fwd.fif");
+    MNEForwardSolution forward(t_fileFwd, false, true);
+    MNEForwardSolution forwardMeg = forward.pick_types(true, false);
+
+    QFile t_fileCov(QDir::currentPath()+"/mne-cpp-test-data/MEG/sample/sample_audvis-cov.fif");
+    FiffCov noiseCov(t_fileCov);
+
+    QVERIFY( !forwardMeg.isEmpty() );
+    QVERIFY( noiseCov.dim > 0 );
+
+    invOpFree = MNEInverseOperator::make_inverse_operator(raw.info, forwardMeg, noiseCov, 0.2f, 0.8f, false);
+    invOpFixed = MNEInverseOperator::make_inverse_operator(raw.info, forwardMeg, noiseCov, 0.2f, 0.8f, true);
+}
+
+
+//*************************************************************************************************************
+
+double TestMinimumNormFast::relativeDiff(const MatrixXd& mat, const MatrixXd& matRef) const
+{
+    if(mat.rows() != matRef.rows() || mat.cols() != matRef.cols())
+        return 1.0;
+
+    double norm = matRef.norm();
+    return norm > 0.0 ? (mat - matRef).norm() / norm : (mat - matRef).norm();
+}
+
+
+//*************************************************************************************************************
+
+bool TestMinimumNormFast::compareMethod(const MNEInverseOperator& invOp, const QString& sMethod) const
+{
+    MinimumNorm minimumNorm(invOp, lambda2, sMethod);
+    minimumNorm.doInverseSetup(1, false);
+
+    MinimumNorm minimumNormFast(invOp, lambda2, sMethod);
+    minimumNormFast.setFastApply(true);
+    minimumNormFast.doInverseSetup(1, false);
+
+    //MEG amplitudes
+    srand(42);
+    MatrixXd data = 1e-12 * MatrixXd::Random(minimumNorm.getKernel().cols(), numSamples);
+
+    MNESourceEstimate stc = minimumNorm.calculateInverse(data, 0.0f, 0.001f);
+    MNESourceEstimate stcFast = minimumNormFast.calculateInverse(data, 0.0f, 0.001f);
+
+    return stc.vertices == stcFast.vertices
+            && stc.tmin == stcFast.tmin
+            && relativeDiff(stcFast.data, stc.data) < epsilon;
+}
+
+
+//*************************************************************************************************************
+
+void TestMinimumNormFast::compareMNE()
+{
+    QVERIFY( compareMethod(invOpFree, "MNE") );
+}
+
+
+//*************************************************************************************************************
+
+void TestMinimumNormFast::compareDSPM()
+{
+    //The noise normalization is folded into the kernel rows before the orientations are combined
+    QVERIFY( compareMethod(invOpFree, "dSPM") );
+}
+
+
+//*************************************************************************************************************
+
+void TestMinimumNormFast::compareSLORETA()
+{
+    QVERIFY( compareMethod(invOpFree, "sLORETA") );
+}
+
+
+//*************************************************************************************************************
+
+void TestMinimumNormFast::compareFixedOrientation()
+{
+    //One kernel row per source, nothing to combine
+    QVERIFY( compareMethod(invOpFixed, "MNE") );
+    QVERIFY( compareMethod(invOpFixed, "dSPM") );
+}
+
+
+//*************************************************************************************************************
+
+void TestMinimumNormFast::compareSourceSelection()
+{
+    MinimumNorm minimumNorm(invOpFree, lambda2, QString("dSPM"));
+    minimumNorm.doInverseSetup(1, false);
+
+    MinimumNorm minimumNormFast(invOpFree, lambda2, QString("dSPM"));
+    minimumNormFast.setFastApply(true);
+    minimumNormFast.doInverseSetup(1, false);
+
+    srand(42);
+    MatrixXd data = 1e-12 * MatrixXd::Random(minimumNorm.getKernel().cols(), numSamples);
+    MNESourceEstimate stc = minimumNorm.calculateInverse(data, 0.0f, 0.001f);
+
+    //Every tenth source of both hemispheres, the fast kernel is rebuilt when the selection changes
+    int iNumSources = stc.vertices.size();
+    int iNumSel = (iNumSources + 9) / 10;
+    VectorXi vecSel(iNumSel);
+    MatrixXd matRef(iNumSel, numSamples);
+    VectorXi vecVerticesRef(iNumSel);
+    for(int i = 0; i < iNumSel; ++i) {
+        vecSel[i] = 10 * i;
+        matRef.row(i) = stc.data.row(10 * i);
+        vecVerticesRef[i] = stc.vertices[10 * i];
+    }
+
+    minimumNormFast.setSourceSelection(vecSel);
+    MNESourceEstimate stcSel = minimumNormFast.calculateInverse(data, 0.0f, 0.001f);
+
+    QVERIFY( stcSel.vertices == vecVerticesRef );
+    QVERIFY( relativeDiff(stcSel.data, matRef) < epsilon );
+
+    //An empty selection restores all sources
+    minimumNormFast.setSourceSelection(VectorXi());
+    MNESourceEstimate stcAll = minimumNormFast.calculateInverse(data, 0.0f, 0.001f);
+
+    QVERIFY( stcAll.vertices == stc.vertices );
+    QVERIFY( relativeDiff(stcAll.data, stc.data) < epsilon );
+}
+
+
+//*************************************************************************************************************
+
+void TestMinimumNormFast::cleanupTestCase()
+{
+}
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_APPLESS_MAIN(TestMinimumNormFast)
+#include "test_minimum_norm_fast.moc"
@@ -0,0 +1,347 @@
+//=============================================================================================================
+/**
+* @file     test_plugin_connector_queue.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    Test for the back-pressure policies of the PluginConnectorQueue
+*
+*/
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <scShared/Management/pluginconnectorqueue.h>
+#include <scMeas/newrealtimemultisamplearray.h>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+#include <QThread>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace SCSHAREDLIB;
+using namespace SCMEASLIB;
+
+
+//=============================================================================================================
+/**
+* Enqueues a list of blocks from its own thread.
+*/
+class Producer : public QThread
+{
+public:
+    Producer(PluginConnectorQueue* pQueue, const QList<NewMeasurement::SPtr>& lBlocks)
+    : m_pQueue(pQueue)
+    , m_lBlocks(lBlocks)
+    {
+    }
+
+protected:
+    virtual void run()
+    {
+        for(int i = 0; i < m_lBlocks.size(); ++i) {
+            m_pQueue->enqueue(m_lBlocks.at(i));
+        }
+    }
+
+private:
+    PluginConnectorQueue*           m_pQueue;
+    QList<NewMeasurement::SPtr>     m_lBlocks;
+};
+
+
+//=============================================================================================================
+/**
+* DECLARE CLASS TestPluginConnectorQueue
+*
+* @brief The TestPluginConnectorQueue class checks which blocks each back-pressure policy delivers and whether the
+*        producer waits
+*
+*/
+class TestPluginConnectorQueue: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestPluginConnectorQueue();
+
+public slots:
+    void onDelivered(SCMEASLIB::NewMeasurement::SPtr pMeasurement);
+
+private slots:
+    void initTestCase();
+    void compareDropOldest();
+    void compareBlock();
+    void compareCoalesce();
+    void compareSetQueuePolicy();
+    void compareStop();
+    void compareReceiverThread();
+    void cleanupTestCase();
+
+private:
+    QList<NewMeasurement::SPtr> createBlocks(int iNumBlocks) const;
+    bool waitForDelivery(int iNumBlocks, Producer* pProducer = 0);
+
+    int                             maxQueueSize;
+    int                             numBlocks;
+
+    QList<NewMeasurement::SPtr>     received;
+};
+
+
+//*************************************************************************************************************
+
+TestPluginConnectorQueue::TestPluginConnectorQueue()
+: maxQueueSize(4)
+, numBlocks(10)
+{
+}
+
+
+//*************************************************************************************************************
+
+void TestPluginConnectorQueue::initTestCase()
+{
+    qDebug() << "Queue size" << maxQueueSize;
+    qDebug() << "Number of blocks" << numBlocks;
+}
+
+
+//*************************************************************************************************************
+
+void TestPluginConnectorQueue::onDelivered(NewMeasurement::SPtr pMeasurement)
+{
+    received.append(pMeasurement);
+}
+
+
+//*************************************************************************************************************
+
+QList<NewMeasurement::SPtr> TestPluginConnectorQueue::createBlocks(int iNumBlocks) const
+{
+    QList<NewMeasurement::SPtr> lBlocks;
+    for(int i = 0; i < iNumBlocks; ++i) {
+        lBlocks.append(NewMeasurement::SPtr(new NewRealTimeMultiSampleArray()));
+    }
+
+    return lBlocks;
+}
+
+
+//*************************************************************************************************************
+
+bool TestPluginConnectorQueue::waitForDelivery(int iNumBlocks, Producer* pProducer)
+{
+    //The queue delivers in this thread, i.e. while events are processed
+    for(int i = 0; i < 1000; ++i) {
+        if(received.size() >= iNumBlocks && (!pProducer || pProducer->isFinished()))
+            return true;
+
+        QTest::qWait(10);
+    }
+
+    return false;
+}
+
+
+//*************************************************************************************************************
+
+void TestPluginConnectorQueue::compareDropOldest()
+{
+    received.clear();
+
+    PluginConnectorQueue queue("Test", "Receiver", this, PluginConnectorQueue::DropOldest, maxQueueSize);
+    connect(&queue, &PluginConnectorQueue::delivered, this, &TestPluginConnectorQueue::onDelivered);
+
+    //The producer never waits, the oldest blocks make room for the new ones
+    QList<NewMeasurement::SPtr> lBlocks = createBlocks(numBlocks);
+    Producer producer(&queue, lBlocks);
+    producer.start();
+    QVERIFY( producer.wait(5000) );
+
+    QVERIFY( queue.getQueueSize() == maxQueueSize );
+    QVERIFY( queue.getDroppedBlocks() == numBlocks - maxQueueSize );
+
+    QVERIFY( waitForDelivery(maxQueueSize) );
+    QVERIFY( received == lBlocks.mid(numBlocks - maxQueueSize) );
+    QVERIFY( queue.getQueueSize() == 0 );
+}
+
+
+//*************************************************************************************************************
+
+void TestPluginConnectorQueue::compareBlock()
+{
+    received.clear();
+
+    PluginConnectorQueue queue("Test", "Receiver", this, PluginConnectorQueue::Block, maxQueueSize);
+    connect(&queue, &PluginConnectorQueue::delivered, this, &TestPluginConnectorQueue::onDelivered);
+
+    QList<NewMeasurement::SPtr> lBlocks = createBlocks(numBlocks);
+    Producer producer(&queue, lBlocks);
+    producer.start();
+
+    //Without delivery the producer waits at a full queue
+    QVERIFY( !producer.wait(200) );
+    QVERIFY( queue.getQueueSize() == maxQueueSize );
+
+    //Every block arrives, in order
+    QVERIFY( waitForDelivery(numBlocks, &producer) );
+    QVERIFY( received == lBlocks );
+    QVERIFY( queue.getDroppedBlocks() == 0 );
+}
+
+
+//*************************************************************************************************************
+
+void TestPluginConnectorQueue::compareCoalesce()
+{
+    received.clear();
+
+    PluginConnectorQueue queue("Test", "Receiver", this, PluginConnectorQueue::Coalesce, maxQueueSize);
+    connect(&queue, &PluginConnectorQueue::delivered, this, &TestPluginConnectorQueue::onDelivered);
+
+    //Only the newest block is kept
+    QList<NewMeasurement::SPtr> lBlocks = createBlocks(numBlocks);
+    Producer producer(&queue, lBlocks);
+    producer.start();
+    QVERIFY( producer.wait(5000) );
+
+    QVERIFY( queue.getQueueSize() == 1 );
+    QVERIFY( queue.getDroppedBlocks() == numBlocks - 1 );
+
+    QVERIFY( waitForDelivery(1) );
+    QVERIFY( received.size() == 1 );
+    QVERIFY( received.first() == lBlocks.last() );
+}
+
+
+//*************************************************************************************************************
+
+void TestPluginConnectorQueue::compareSetQueuePolicy()
+{
+    received.clear();
+
+    PluginConnectorQueue queue("Test", "Receiver", this, PluginConnectorQueue::Block, maxQueueSize);
+    connect(&queue, &PluginConnectorQueue::delivered, this, &TestPluginConnectorQueue::onDelivered);
+
+    QList<NewMeasurement::SPtr> lBlocks = createBlocks(numBlocks);
+    Producer producer(&queue, lBlocks);
+    producer.start();
+    QVERIFY( !producer.wait(200) );
+
+    //Switching to DropOldest releases the waiting producer
+    queue.setQueuePolicy(PluginConnectorQueue::DropOldest, maxQueueSize);
+    QVERIFY( producer.wait(5000) );
+
+    QVERIFY( queue.getQueuePolicy() == PluginConnectorQueue::DropOldest );
+    QVERIFY( queue.getQueueSize() == maxQueueSize );
+    QVERIFY( queue.getDroppedBlocks() == numBlocks - maxQueueSize );
+
+    QVERIFY( waitForDelivery(maxQueueSize) );
+    QVERIFY( received == lBlocks.mid(numBlocks - maxQueueSize) );
+}
+
+
+//*************************************************************************************************************
+
+void TestPluginConnectorQueue::compareStop()
+{
+    received.clear();
+
+    PluginConnectorQueue queue("Test", "Receiver", this, PluginConnectorQueue::Block, maxQueueSize);
+    connect(&queue, &PluginConnectorQueue::delivered, this, &TestPluginConnectorQueue::onDelivered);
+
+    QList<NewMeasurement::SPtr> lBlocks = createBlocks(numBlocks);
+    Producer producer(&queue, lBlocks);
+    producer.start();
+    QVERIFY( !producer.wait(200) );
+
+    //Stopping releases the waiting producer and drops the queued blocks
+    queue.stop();
+    QVERIFY( producer.wait(5000) );
+    QVERIFY( queue.getQueueSize() == 0 );
+
+    //Later blocks are not accepted
+    Producer producerLate(&queue, createBlocks(1));
+    producerLate.start();
+    QVERIFY( producerLate.wait(5000) );
+    QVERIFY( queue.getQueueSize() == 0 );
+
+    QTest::qWait(50);
+    QVERIFY( received.isEmpty() );
+}
+
+
+//*************************************************************************************************************
+
+void TestPluginConnectorQueue::compareReceiverThread()
+{
+    received.clear();
+
+    PluginConnectorQueue queue("Test", "Receiver", this, PluginConnectorQueue::Block, maxQueueSize);
+    connect(&queue, &PluginConnectorQueue::delivered, this, &TestPluginConnectorQueue::onDelivered);
+
+    //A producer in the receiving thread would wait for itself, its blocks are delivered right away
+    QList<NewMeasurement::SPtr> lBlocks = createBlocks(numBlocks);
+    for(int i = 0; i < lBlocks.size(); ++i) {
+        queue.enqueue(lBlocks.at(i));
+    }
+
+    QVERIFY( received == lBlocks );
+    QVERIFY( queue.getQueueSize() == 0 );
+}
+
+
+//*************************************************************************************************************
+
+void TestPluginConnectorQueue::cleanupTestCase()
+{
+}
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+//The queue delivers through the event loop of the receiving thread
+QTEST_GUILESS_MAIN(TestPluginConnectorQueue)
+#include "test_plugin_connector_queue.moc"
@@ -0,0 +1,382 @@
+//=============================================================================================================
+/**
+* @file     test_ring_matrix_buffer.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    Test for the single producer / single consumer RingMatrixBuffer
+*
+*/
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/ringmatrixbuffer.h>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+#include <QThread>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace IOBUFFER;
+using namespace Eigen;
+
+
+//=============================================================================================================
+/**
+* Pushes numbered blocks into a RingMatrixBuffer from its own thread.
+*/
+class RingProducer : public QThread
+{
+public:
+    RingProducer(RingMatrixBuffer<double>* pBuffer, int iNumBlocks, bool bSwap)
+    : m_pBuffer(pBuffer)
+    , m_iNumBlocks(iNumBlocks)
+    , m_bSwap(bSwap)
+    , m_iPushed(0)
+    {
+    }
+
+    int pushed() const
+    {
+        return m_iPushed;
+    }
+
+protected:
+    void run()
+    {
+        MatrixXd block(m_pBuffer->rows(), m_pBuffer->cols());
+        for(int i = 0; i < m_iNumBlocks; ++i) {
+            //Every entry carries the block number, so torn or reordered blocks are detected
+            for(int c = 0; c < block.cols(); ++c)
+                for(int r = 0; r < block.rows(); ++r)
+                    block(r,c) = i + 0.001 * (r + c * block.rows());
+
+            bool bPushed = m_bSwap ? m_pBuffer->pushSwap(block) : m_pBuffer->push(&block);
+            if(!bPushed)
+                return;
+            ++m_iPushed;
+
+            //The swapped back slot may have to be reshaped
+            if(block.rows() != (int)m_pBuffer->rows() || block.cols() != (int)m_pBuffer->cols())
+                block.resize(m_pBuffer->rows(), m_pBuffer->cols());
+
+            //Change the pace once in a while, so the consumer finds the ring both full and empty
+            if(i % 1000 == 999)
+                QThread::msleep(5);
+        }
+    }
+
+private:
+    RingMatrixBuffer<double>*   m_pBuffer;
+    int                         m_iNumBlocks;
+    bool                        m_bSwap;
+    int                         m_iPushed;
+};
+
+
+//=============================================================================================================
+/**
+* Pops one block from a RingMatrixBuffer in its own thread and remembers whether it got one.
+*/
+class RingConsumer : public QThread
+{
+public:
+    RingConsumer(RingMatrixBuffer<double>* pBuffer)
+    : m_pBuffer(pBuffer)
+    , m_bPopped(false)
+    {
+    }
+
+    bool popped() const
+    {
+        return m_bPopped;
+    }
+
+protected:
+    void run()
+    {
+        MatrixXd block;
+        m_bPopped = m_pBuffer->pop(block);
+    }
+
+private:
+    RingMatrixBuffer<double>*   m_pBuffer;
+    bool                        m_bPopped;
+};
+
+
+//=============================================================================================================
+/**
+* DECLARE CLASS TestRingMatrixBuffer
+*
+* @brief The TestRingMatrixBuffer class checks order, wrap-around, full and empty behaviour of the RingMatrixBuffer
+*
+*/
+class TestRingMatrixBuffer: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestRingMatrixBuffer();
+
+private slots:
+    void initTestCase();
+    void compareFullEmpty();
+    void compareWrapAround();
+    void compareRelease();
+    void compareProducerConsumer();
+    void compareProducerConsumerSwap();
+    void cleanupTestCase();
+
+private:
+    bool checkBlock(const MatrixXd &block, int iNumber) const;
+    void runProducerConsumer(bool bSwap);
+
+    int     rows;
+    int     cols;
+    int     numBlocks;
+};
+
+
+//*************************************************************************************************************
+
+TestRingMatrixBuffer::TestRingMatrixBuffer()
+: rows(4)
+, cols(8)
+, numBlocks(20000)
+{
+}
+
+
+//*************************************************************************************************************
+
+void TestRingMatrixBuffer::initTestCase()
+{
+    qDebug() << "Blocks" << numBlocks << "of" << rows << "x" << cols;
+}
+
+
+//*************************************************************************************************************
+
+bool TestRingMatrixBuffer::checkBlock(const MatrixXd &block, int iNumber) const
+{
+    if(block.rows() != rows || block.cols() != cols)
+        return false;
+
+    for(int c = 0; c < cols; ++c)
+        for(int r = 0; r < rows; ++r)
+            if(block(r,c) != iNumber + 0.001 * (r + c * rows))
+                return false;
+
+    return true;
+}
+
+
+//*************************************************************************************************************
+
+void TestRingMatrixBuffer::compareFullEmpty()
+{
+    RingMatrixBuffer<double> buffer(4, rows, cols);
+    MatrixXd block = MatrixXd::Ones(rows, cols);
+
+    //Empty: a pop times out
+    MatrixXd popped;
+    QVERIFY( !buffer.pop(popped, 0) );
+    QVERIFY( !buffer.pop(popped, 20) );
+
+    //Exactly size() matrices fit, then a push times out
+    for(int i = 0; i < 4; ++i)
+        QVERIFY( buffer.push(&block, 0) );
+    QVERIFY( !buffer.push(&block, 0) );
+    QVERIFY( !buffer.push(&block, 20) );
+
+    //Popping one frees one slot
+    QVERIFY( buffer.pop(popped, 0) );
+    QVERIFY( buffer.push(&block, 0) );
+    QVERIFY( !buffer.push(&block, 0) );
+
+    //Wrong dimensions are rejected
+    MatrixXd wrong = MatrixXd::Ones(rows + 1, cols);
+    buffer.clear();
+    QVERIFY( !buffer.push(&wrong, 0) );
+    QVERIFY( !buffer.pop(popped, 0) );
+}
+
+
+//*************************************************************************************************************
+
+void TestRingMatrixBuffer::compareWrapAround()
+{
+    //Walk the indices around the ring several times with every fill level
+    RingMatrixBuffer<double> buffer(3, rows, cols);
+    MatrixXd block(rows, cols);
+    MatrixXd popped;
+
+    int iPushed = 0;
+    int iPopped = 0;
+    for(int round = 0; round < 50; ++round) {
+        int iFill = 1 + round % 3;
+        for(int i = 0; i < iFill; ++i) {
+            block.resize(rows, cols);
+            for(int c = 0; c < cols; ++c)
+                for(int r = 0; r < rows; ++r)
+                    block(r,c) = iPushed + 0.001 * (r + c * rows);
+            QVERIFY( (round % 2 == 0) ? buffer.push(&block, 0) : buffer.pushSwap(block, 0) );
+            ++iPushed;
+        }
+
+        for(int i = 0; i < iFill; ++i) {
+            if(round % 2 == 0) {
+                popped = buffer.pop();
+            } else {
+                QVERIFY( buffer.pop(popped, 0) );
+            }
+            QVERIFY( checkBlock(popped, iPopped) );
+            ++iPopped;
+        }
+
+        QVERIFY( !buffer.pop(popped, 0) );
+    }
+
+    QVERIFY( iPushed == iPopped );
+}
+
+
+//*************************************************************************************************************
+
+void TestRingMatrixBuffer::compareRelease()
+{
+    //A consumer waiting on the empty ring is released
+    RingMatrixBuffer<double> buffer(2, rows, cols);
+
+    RingConsumer consumer(&buffer);
+    consumer.start();
+    QThread::msleep(50);
+
+    QVERIFY( buffer.releaseFromPop() );
+    QVERIFY( consumer.wait(5000) );
+    QVERIFY( !consumer.popped() );
+
+    //A producer waiting on the full ring is released
+    RingProducer producer(&buffer, 3, false);
+    producer.start();
+    QThread::msleep(50);
+
+    QVERIFY( buffer.releaseFromPush() );
+    QVERIFY( producer.wait(5000) );
+    QVERIFY( producer.pushed() == 2 );
+}
+
+
+//*************************************************************************************************************
+
+void TestRingMatrixBuffer::runProducerConsumer(bool bSwap)
+{
+    //A small ring, so both sides have to wait for each other
+    RingMatrixBuffer<double> buffer(4, rows, cols);
+
+    RingProducer producer(&buffer, numBlocks, bSwap);
+    producer.start();
+
+    MatrixXd block;
+    int iReceived = 0;
+    bool bInOrder = true;
+    for(int i = 0; i < numBlocks; ++i) {
+        if(!buffer.pop(block, 5000))
+            break;
+
+        if(!checkBlock(block, i))
+            bInOrder = false;
+        ++iReceived;
+
+        //Consume slowly for a while, so the producer finds the ring full
+        if(i % 1000 == 499)
+            QThread::msleep(5);
+    }
+
+    QVERIFY( producer.wait(5000) );
+
+    //Nothing was lost, reordered or torn and nothing is left over
+    QVERIFY( bInOrder );
+    QVERIFY( iReceived == numBlocks );
+    QVERIFY( producer.pushed() == numBlocks );
+    QVERIFY( !buffer.pop(block, 0) );
+}
+
+
+//*************************************************************************************************************
+
+void TestRingMatrixBuffer::compareProducerConsumer()
+{
+    runProducerConsumer(false);
+}
+
+
+//*************************************************************************************************************
+
+void TestRingMatrixBuffer::compareProducerConsumerSwap()
+{
+    runProducerConsumer(true);
+}
+
+
+//*************************************************************************************************************
+
+void TestRingMatrixBuffer::cleanupTestCase()
+{
+}
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_APPLESS_MAIN(TestRingMatrixBuffer)
+#include "test_ring_matrix_buffer.moc"
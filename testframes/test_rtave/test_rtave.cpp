@@ -0,0 +1,367 @@
+//=============================================================================================================
+/**
+* @file     test_rtave.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    Test for the running and cumulative averages of RtAve
+*
+*/
+
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <realtime/rtProcessing/rtave.h>
+#include <fiff/fiff_evoked_set.h>
+#include <fiff/fiff_info.h>
+
+#include <stdlib.h>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+#include <QMutex>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace REALTIMELIB;
+using namespace FIFFLIB;
+using namespace Eigen;
+
+
+//=============================================================================================================
+/**
+* DECLARE CLASS TestRtAve
+*
+* @brief The TestRtAve class checks every average published by RtAve against a batch mean over the same epochs, and its variance against the batch variance
+*
+*/
+class TestRtAve: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestRtAve();
+
+public slots:
+    void onEvokedStim(FIFFLIB::FiffEvokedSet::SPtr pEvokedSet);
+
+private slots:
+    void initTestCase();
+    void compareRunningAverage();
+    void compareSingleEpoch();
+    void compareCumulativeAverage();
+    void compareVariance();
+    void cleanupTestCase();
+
+private:
+    QList<FiffEvoked> average(int iNumAverages, int iMode);
+    MatrixXd batchMean(int iFirst, int iLast) const;
+    MatrixXd batchVariance(int iFirst, int iLast) const;
+    double relativeDiff(const MatrixXd& mat, const MatrixXd& matRef) const;
+
+    double          epsilon;
+    int             numChannels;
+    int             preStim;
+    int             postStim;
+    int             blockSize;
+    int             triggerSpacing;
+    int             numTriggers;
+
+    MatrixXd        data;
+    QList<int>      triggers;
+    FiffInfo::SPtr  info;
+
+    QMutex              mutex;
+    QList<FiffEvoked>   evoked;
+    QList<MatrixXd>     variances;
+    QList<VectorXd>     snrs;
+    RtAve*              rtAve;
+};
+
+
+//*************************************************************************************************************
+
+TestRtAve::TestRtAve()
+: epsilon(0.0000000001)
+, numChannels(5)
+, preStim(20)
+, postStim(30)
+, blockSize(50)
+, triggerSpacing(200)
+, numTriggers(15)
+, rtAve(0)
+{
+}
+
+
+//*************************************************************************************************************
+
+void TestRtAve::initTestCase()
+{
+    qDebug() << "Epsilon" << epsilon;
+
+    //EEG channels followed by the stimulus channel
+    info = FiffInfo::SPtr(new FiffInfo());
+    info->nchan = numChannels + 1;
+    info->sfreq = 1000.0;
+    for(int i = 0; i <= numChannels; ++i) {
+        FiffChInfo ch;
+        ch.kind = i < numChannels ? FIFFV_EEG_CH : FIFFV_STIM_CH;
+        ch.ch_name = i < numChannels ? QString("EEG %1").arg(i + 1) : QString("STI 014");
+        info->chs.append(ch);
+        info->ch_names.append(ch.ch_name);
+    }
+
+    //The triggers lie within a block, so each epoch is completed by the block after the next one
+    int iNumBlocks = (blockSize + preStim + numTriggers * triggerSpacing) / blockSize + 4;
+
+    srand(42);
+    data = MatrixXd::Zero(numChannels + 1, iNumBlocks * blockSize);
+    data.topRows(numChannels) = MatrixXd::Random(numChannels, data.cols()) * 1e-5;
+    data.topRows(numChannels).colwise() += VectorXd::LinSpaced(numChannels, 1e-3, 5e-3);
+
+    for(int j = 0; j < numTriggers; ++j) {
+        int iTrigger = (j + 1) * triggerSpacing + blockSize / 2;
+        triggers.append(iTrigger);
+        data.block(numChannels, iTrigger, 1, 5).setOnes();
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestRtAve::onEvokedStim(FiffEvokedSet::SPtr pEvokedSet)
+{
+    QMutexLocker locker(&mutex);
+    if(!pEvokedSet->evoked.isEmpty()) {
+        evoked.append(pEvokedSet->evoked.at(0));
+
+        //The slot is called from the averaging thread, so the ring still holds the epochs of this average
+        double dTriggerType = pEvokedSet->evoked.at(0).comment.toDouble();
+        variances.append(rtAve->variance(dTriggerType));
+        snrs.append(rtAve->snr(dTriggerType));
+    }
+}
+
+
+//*************************************************************************************************************
+
+QList<FiffEvoked> TestRtAve::average(int iNumAverages, int iMode)
+{
+    evoked.clear();
+    variances.clear();
+    snrs.clear();
+
+    RtAve rtAveObj(iNumAverages, preStim, postStim, 0, 0, numChannels, info);
+    rtAve = &rtAveObj;
+    rtAveObj.setAverageMode(iMode);
+    connect(&rtAveObj, &RtAve::evokedStim, this, &TestRtAve::onEvokedStim, Qt::DirectConnection);
+
+    //The first block creates the buffer the averaging thread waits on
+    rtAveObj.append(data.middleCols(0, blockSize));
+    rtAveObj.start();
+
+    for(int i = 1; i < data.cols() / blockSize; ++i) {
+        rtAveObj.append(data.middleCols(i * blockSize, blockSize));
+    }
+
+    for(int i = 0; i < 1000; ++i) {
+        mutex.lock();
+        int iCount = evoked.size();
+        mutex.unlock();
+
+        if(iCount >= numTriggers)
+            break;
+
+        QTest::qWait(10);
+    }
+
+    rtAveObj.stop();
+    rtAveObj.wait();
+    rtAve = 0;
+
+    QMutexLocker locker(&mutex);
+    return evoked;
+}
+
+
+//*************************************************************************************************************
+
+MatrixXd TestRtAve::batchMean(int iFirst, int iLast) const
+{
+    MatrixXd matSum = MatrixXd::Zero(data.rows(), preStim + postStim);
+
+    for(int j = iFirst; j <= iLast; ++j) {
+        matSum += data.middleCols(triggers.at(j) - preStim, preStim + postStim);
+    }
+
+    return matSum / (iLast - iFirst + 1);
+}
+
+
+//*************************************************************************************************************
+
+MatrixXd TestRtAve::batchVariance(int iFirst, int iLast) const
+{
+    MatrixXd matMean = batchMean(iFirst, iLast);
+    MatrixXd matSumSq = MatrixXd::Zero(data.rows(), preStim + postStim);
+
+    for(int j = iFirst; j <= iLast; ++j) {
+        matSumSq += (data.middleCols(triggers.at(j) - preStim, preStim + postStim) - matMean).cwiseAbs2();
+    }
+
+    return matSumSq / (iLast - iFirst);
+}
+
+
+//*************************************************************************************************************
+
+double TestRtAve::relativeDiff(const MatrixXd& mat, const MatrixXd& matRef) const
+{
+    if(mat.rows() != matRef.rows() || mat.cols() != matRef.cols())
+        return 1.0;
+
+    return (mat - matRef).cwiseAbs().maxCoeff() / matRef.cwiseAbs().maxCoeff();
+}
+
+
+//*************************************************************************************************************
+
+void TestRtAve::compareRunningAverage()
+{
+    //The ring wraps several times
+    int iNumAverages = 4;
+
+    QList<FiffEvoked> lEvoked = average(iNumAverages, 0);
+    QVERIFY( lEvoked.size() == numTriggers );
+
+    for(int k = 0; k < lEvoked.size(); ++k) {
+        int iFirst = qMax(0, k - iNumAverages + 1);
+
+        QVERIFY( relativeDiff(lEvoked.at(k).data, batchMean(iFirst, k)) < epsilon );
+        QVERIFY( lEvoked.at(k).nave == k - iFirst + 1 );
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestRtAve::compareSingleEpoch()
+{
+    //A ring of one epoch always holds the latest epoch
+    QList<FiffEvoked> lEvoked = average(1, 0);
+    QVERIFY( lEvoked.size() == numTriggers );
+
+    for(int k = 0; k < lEvoked.size(); ++k) {
+        QVERIFY( relativeDiff(lEvoked.at(k).data, batchMean(k, k)) < epsilon );
+        QVERIFY( lEvoked.at(k).nave == 1 );
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestRtAve::compareCumulativeAverage()
+{
+    //The cumulative average covers all epochs, also the ones which already left the ring
+    QList<FiffEvoked> lEvoked = average(4, 1);
+    QVERIFY( lEvoked.size() == numTriggers );
+
+    for(int k = 0; k < lEvoked.size(); ++k) {
+        QVERIFY( relativeDiff(lEvoked.at(k).data, batchMean(0, k)) < epsilon );
+        QVERIFY( lEvoked.at(k).nave == k + 1 );
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestRtAve::compareVariance()
+{
+    //The variance is the small difference of two running sums, so it is compared with a looser tolerance
+    int iNumAverages = 4;
+    double dEpsilon = 0.000001;
+
+    QList<FiffEvoked> lEvoked = average(iNumAverages, 0);
+    QVERIFY( lEvoked.size() == numTriggers );
+    QVERIFY( variances.size() == numTriggers && snrs.size() == numTriggers );
+
+    //A single epoch has no variance
+    QVERIFY( variances.at(0).rows() == numChannels + 1 && variances.at(0).isZero() );
+    QVERIFY( snrs.at(0).isZero() );
+
+    for(int k = 1; k < lEvoked.size(); ++k) {
+        int iFirst = qMax(0, k - iNumAverages + 1);
+        MatrixXd matVar = batchVariance(iFirst, k);
+
+        //The stimulus channel is the same in every epoch
+        QVERIFY( relativeDiff(variances.at(k).topRows(numChannels), matVar.topRows(numChannels)) < dEpsilon );
+        QVERIFY( variances.at(k).row(numChannels).cwiseAbs().maxCoeff() < dEpsilon );
+
+        //Power of the mean over the power of its noise
+        int iCount = k - iFirst + 1;
+        VectorXd vecSnr = batchMean(iFirst, k).topRows(numChannels).cwiseAbs2().rowwise().sum().cwiseQuotient(matVar.topRows(numChannels).rowwise().sum() / iCount);
+        QVERIFY( relativeDiff(snrs.at(k).head(numChannels), vecSnr) < dEpsilon );
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestRtAve::cleanupTestCase()
+{
+}
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_APPLESS_MAIN(TestRtAve)
+#include "test_rtave.moc"
@@ -0,0 +1,325 @@
+//=============================================================================================================
+/**
+* @file     test_rtcov.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    Test for the block, exponential forgetting and sliding window covariance estimation of RtCov
+*
+*/
+
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <realtime/rtProcessing/rtcov.h>
+#include <fiff/fiff_cov.h>
+#include <fiff/fiff_info.h>
+
+#include <math.h>
+#include <stdlib.h>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+#include <QMutex>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace REALTIMELIB;
+using namespace FIFFLIB;
+using namespace Eigen;
+
+
+//=============================================================================================================
+/**
+* DECLARE CLASS TestRtCov
+*
+* @brief The TestRtCov class checks every covariance published by RtCov against a batch estimate over the same samples
+*
+*/
+class TestRtCov: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestRtCov();
+
+public slots:
+    void onCovCalculated(FIFFLIB::FiffCov::SPtr pCov);
+
+private slots:
+    void initTestCase();
+    void compareBlock();
+    void compareExponentialForgetting();
+    void compareSlidingWindow();
+    void cleanupTestCase();
+
+private:
+    QList<FiffCov> estimate(RtCov::EstimationMode mode, int iExpected);
+    MatrixXd batchCovariance(const MatrixXd& matData, const VectorXd& vecWeights) const;
+    MatrixXd regularize(const MatrixXd& matCov) const;
+    double relativeDiff(const MatrixXd& matCov, const MatrixXd& matRef) const;
+
+    double          epsilon;
+    int             numChannels;
+    int             maxSamples;
+    int             blockSize;
+    int             numBlocks;
+
+    MatrixXd        data;
+    FiffInfo::SPtr  info;
+
+    QMutex          mutex;
+    QList<FiffCov>  covs;
+};
+
+
+//*************************************************************************************************************
+
+TestRtCov::TestRtCov()
+: epsilon(0.00000001)
+, numChannels(6)
+, maxSamples(500)
+, blockSize(50)
+, numBlocks(400)
+{
+}
+
+
+//*************************************************************************************************************
+
+void TestRtCov::initTestCase()
+{
+    qDebug() << "Epsilon" << epsilon;
+
+    //EEG channels, so the published estimates are regularized by a known amount
+    info = FiffInfo::SPtr(new FiffInfo());
+    info->nchan = numChannels;
+    for(int i = 0; i < numChannels; ++i) {
+        FiffChInfo ch;
+        ch.kind = FIFFV_EEG_CH;
+        ch.ch_name = QString("EEG %1").arg(i + 1);
+        info->chs.append(ch);
+        info->ch_names.append(ch.ch_name);
+    }
+
+    //Correlated channels with an offset, so a wrong mean shows up in the estimate
+    srand(42);
+    MatrixXd matMixing = MatrixXd::Random(numChannels, numChannels);
+    data = matMixing * MatrixXd::Random(numChannels, numBlocks * blockSize);
+    data.colwise() += VectorXd::LinSpaced(numChannels, 1.0, 10.0);
+}
+
+
+//*************************************************************************************************************
+
+void TestRtCov::onCovCalculated(FiffCov::SPtr pCov)
+{
+    QMutexLocker locker(&mutex);
+    covs.append(*pCov);
+}
+
+
+//*************************************************************************************************************
+
+QList<FiffCov> TestRtCov::estimate(RtCov::EstimationMode mode, int iExpected)
+{
+    covs.clear();
+
+    RtCov rtCov(maxSamples, info);
+    rtCov.setEstimationMode(mode);
+    connect(&rtCov, &RtCov::covCalculated, this, &TestRtCov::onCovCalculated, Qt::DirectConnection);
+
+    //The first block creates the buffer the estimation thread waits on
+    rtCov.append(data.middleCols(0, blockSize));
+    rtCov.start();
+
+    for(int i = 1; i < numBlocks; ++i) {
+        rtCov.append(data.middleCols(i * blockSize, blockSize));
+    }
+
+    for(int i = 0; i < 1000; ++i) {
+        mutex.lock();
+        int iCount = covs.size();
+        mutex.unlock();
+
+        if(iCount >= iExpected)
+            break;
+
+        QTest::qWait(10);
+    }
+
+    rtCov.stop();
+    rtCov.wait();
+
+    QMutexLocker locker(&mutex);
+    return covs;
+}
+
+
+//*************************************************************************************************************
+
+MatrixXd TestRtCov::batchCovariance(const MatrixXd& matData, const VectorXd& vecWeights) const
+{
+    //Unbiased weighted estimate around the weighted mean
+    double dWeightSum = vecWeights.sum();
+    VectorXd vecMean = matData * vecWeights / dWeightSum;
+    MatrixXd matCentered = matData.colwise() - vecMean;
+
+    return matCentered * vecWeights.asDiagonal() * matCentered.transpose() / (dWeightSum - vecWeights.squaredNorm() / dWeightSum);
+}
+
+
+//*************************************************************************************************************
+
+MatrixXd TestRtCov::regularize(const MatrixXd& matCov) const
+{
+    //RtCov regularizes EEG by 10 % of the mean variance
+    MatrixXd matReg = matCov;
+    matReg.diagonal().array() += 0.1 * matCov.diagonal().mean();
+    return matReg;
+}
+
+
+//*************************************************************************************************************
+
+double TestRtCov::relativeDiff(const MatrixXd& matCov, const MatrixXd& matRef) const
+{
+    if(matCov.rows() != matRef.rows() || matCov.cols() != matRef.cols())
+        return 1.0;
+
+    return (matCov - matRef).cwiseAbs().maxCoeff() / matRef.cwiseAbs().maxCoeff();
+}
+
+
+//*************************************************************************************************************
+
+void TestRtCov::compareBlock()
+{
+    //A chunk is published as soon as it holds more than maxSamples samples
+    int iChunkBlocks = maxSamples / blockSize + 1;
+    int iExpected = numBlocks / iChunkBlocks;
+
+    QList<FiffCov> lCovs = estimate(RtCov::Block, iExpected);
+    QVERIFY( lCovs.size() == iExpected );
+
+    for(int k = 0; k < lCovs.size(); ++k) {
+        MatrixXd matChunk = data.middleCols(k * iChunkBlocks * blockSize, iChunkBlocks * blockSize);
+        MatrixXd matRef = regularize(batchCovariance(matChunk, VectorXd::Ones(matChunk.cols())));
+
+        QVERIFY( relativeDiff(lCovs.at(k).data, matRef) < epsilon );
+        QVERIFY( lCovs.at(k).nfree == matChunk.cols() );
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestRtCov::compareExponentialForgetting()
+{
+    //Published after every block once maxSamples samples were seen
+    int iFirstBlock = maxSamples / blockSize - 1;
+    int iExpected = numBlocks - iFirstBlock;
+
+    QList<FiffCov> lCovs = estimate(RtCov::ExponentialForgetting, iExpected);
+    QVERIFY( lCovs.size() == iExpected );
+
+    //The newest sample has weight one, every older one lambda times the weight of its successor
+    double dLambda = 1.0 - 1.0 / maxSamples;
+
+    for(int k = 0; k < lCovs.size(); ++k) {
+        int iSamples = (iFirstBlock + k + 1) * blockSize;
+
+        VectorXd vecWeights(iSamples);
+        double w = 1.0;
+        for(int j = iSamples - 1; j >= 0; --j) {
+            vecWeights[j] = w;
+            w *= dLambda;
+        }
+
+        MatrixXd matRef = regularize(batchCovariance(data.leftCols(iSamples), vecWeights));
+        QVERIFY( relativeDiff(lCovs.at(k).data, matRef) < epsilon );
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestRtCov::compareSlidingWindow()
+{
+    //Long enough for the window to be rebuilt from its blocks several times
+    int iFirstBlock = maxSamples / blockSize - 1;
+    int iExpected = numBlocks - iFirstBlock;
+
+    QList<FiffCov> lCovs = estimate(RtCov::SlidingWindow, iExpected);
+    QVERIFY( lCovs.size() == iExpected );
+
+    for(int k = 0; k < lCovs.size(); ++k) {
+        int iLast = (iFirstBlock + k + 1) * blockSize;
+        MatrixXd matWindow = data.middleCols(iLast - maxSamples, maxSamples);
+        MatrixXd matRef = regularize(batchCovariance(matWindow, VectorXd::Ones(maxSamples)));
+
+        QVERIFY( relativeDiff(lCovs.at(k).data, matRef) < epsilon );
+        QVERIFY( lCovs.at(k).nfree == maxSamples );
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestRtCov::cleanupTestCase()
+{
+}
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_APPLESS_MAIN(TestRtCov)
+#include "test_rtcov.moc"
@@ -0,0 +1,451 @@
+//=============================================================================================================
+/**
+* @file     test_rtfilter.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    Test for the overlap-save FIR and the streaming IIR filtering of RtFilter
+*
+*/
+
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <realtime/rtProcessing/rtfilter.h>
+#include <utils/filterTools/filterdata.h>
+
+#include <complex>
+#include <math.h>
+#include <stdlib.h>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace REALTIMELIB;
+using namespace UTILSLIB;
+using namespace Eigen;
+
+
+//=============================================================================================================
+/**
+* DECLARE CLASS TestRtFilter
+*
+* @brief The TestRtFilter class checks the block wise filtering of RtFilter against a direct filtering of the whole signal
+* and the IIR sections against their analytic frequency response
+*
+*/
+class TestRtFilter: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestRtFilter();
+
+private slots:
+    void initTestCase();
+    void compareOverlapSave();
+    void compareCascadedOverlapSave();
+    void compareDelayedChannels();
+    void compareReset();
+    void compareButterworthResponse();
+    void compareNotchResponse();
+    void compareIIRStreaming();
+    void cleanupTestCase();
+
+private:
+    MatrixXd filterBlockWise(RtFilter& rtFilter, const QList<FilterData>& lFilterData, bool bDelayUnfiltered, int iBlockSize) const;
+    RowVectorXd convolve(const RowVectorXd& vecData, const RowVectorXd& vecCoeffs) const;
+    FilterData firFilter(int iLength) const;
+    double magnitude(const MatrixXd& matSOS, double dFreq) const;
+
+    double          epsilon;
+    int             numChannels;
+    int             numSamples;
+    int             blockSize;
+    double          sfreq;
+
+    MatrixXd        data;
+    QVector<int>    filterChannels;
+};
+
+
+//*************************************************************************************************************
+
+TestRtFilter::TestRtFilter()
+: epsilon(0.000001)
+, numChannels(40)
+, numSamples(3072)
+, blockSize(64)
+, sfreq(1000.0)
+{
+}
+
+
+//*************************************************************************************************************
+
+void TestRtFilter::initTestCase()
+{
+    qDebug() << "Epsilon" << epsilon;
+
+    srand(42);
+    data = MatrixXd::Random(numChannels, numSamples);
+
+    //Every second channel is filtered, the others are only delayed
+    for(int i = 0; i < numChannels; i += 2) {
+        filterChannels.append(i);
+    }
+}
+
+
+//*************************************************************************************************************
+
+FilterData TestRtFilter::firFilter(int iLength) const
+{
+    FilterData filter;
+    filter.m_dCoeffA = RowVectorXd::Random(iLength) / iLength;
+    return filter;
+}
+
+
+//*************************************************************************************************************
+
+RowVectorXd TestRtFilter::convolve(const RowVectorXd& vecData, const RowVectorXd& vecCoeffs) const
+{
+    //Causal direct convolution starting from rest, cut to the length of the data
+    RowVectorXd vecResult = RowVectorXd::Zero(vecData.cols());
+
+    for(int n = 0; n < vecData.cols(); ++n) {
+        for(int k = 0; k < vecCoeffs.cols() && k <= n; ++k) {
+            vecResult(n) += vecCoeffs(k) * vecData(n - k);
+        }
+    }
+
+    return vecResult;
+}
+
+
+//*************************************************************************************************************
+
+MatrixXd TestRtFilter::filterBlockWise(RtFilter& rtFilter, const QList<FilterData>& lFilterData, bool bDelayUnfiltered, int iBlockSize) const
+{
+    MatrixXd result(numChannels, numSamples);
+    MatrixXd block;
+
+    for(int i = 0; i < numSamples; i += iBlockSize) {
+        block = data.middleCols(i, iBlockSize);
+        rtFilter.filterChannelsInPlace(block, bDelayUnfiltered, filterChannels, lFilterData);
+        result.middleCols(i, iBlockSize) = block;
+    }
+
+    return result;
+}
+
+
+//*************************************************************************************************************
+
+void TestRtFilter::compareOverlapSave()
+{
+    //The filter is longer than a block, so the history spans more than one previous block
+    QList<FilterData> lFilterData;
+    lFilterData << firFilter(101);
+
+    RtFilter rtFilter;
+    MatrixXd result = filterBlockWise(rtFilter, lFilterData, false, blockSize);
+
+    for(int i = 0; i < filterChannels.size(); ++i) {
+        int ch = filterChannels.at(i);
+        RowVectorXd ref = convolve(data.row(ch), lFilterData.at(0).m_dCoeffA);
+        QVERIFY( (result.row(ch) - ref).cwiseAbs().maxCoeff() < epsilon );
+    }
+
+    //A short filter and blocks which are longer than it
+    lFilterData.clear();
+    lFilterData << firFilter(9);
+
+    RtFilter rtFilterShort;
+    result = filterBlockWise(rtFilterShort, lFilterData, false, 4 * blockSize);
+
+    for(int i = 0; i < filterChannels.size(); ++i) {
+        int ch = filterChannels.at(i);
+        RowVectorXd ref = convolve(data.row(ch), lFilterData.at(0).m_dCoeffA);
+        QVERIFY( (result.row(ch) - ref).cwiseAbs().maxCoeff() < epsilon );
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestRtFilter::compareCascadedOverlapSave()
+{
+    //The filters are applied one after another
+    QList<FilterData> lFilterData;
+    lFilterData << firFilter(101) << firFilter(30);
+
+    RtFilter rtFilter;
+    MatrixXd result = filterBlockWise(rtFilter, lFilterData, false, blockSize);
+
+    for(int i = 0; i < filterChannels.size(); ++i) {
+        int ch = filterChannels.at(i);
+        RowVectorXd ref = convolve(convolve(data.row(ch), lFilterData.at(0).m_dCoeffA), lFilterData.at(1).m_dCoeffA);
+        QVERIFY( (result.row(ch) - ref).cwiseAbs().maxCoeff() < epsilon );
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestRtFilter::compareDelayedChannels()
+{
+    QList<FilterData> lFilterData;
+    lFilterData << firFilter(101);
+
+    //The channels which are not filtered are delayed by the group delay of the filter across the block boundaries
+    int iDelay = 50;
+    QVERIFY( RtFilter::getGroupDelay(lFilterData) == iDelay );
+
+    RtFilter rtFilter;
+    MatrixXd result = filterBlockWise(rtFilter, lFilterData, true, blockSize);
+
+    for(int ch = 1; ch < numChannels; ch += 2) {
+        QVERIFY( result.row(ch).head(iDelay).cwiseAbs().maxCoeff() == 0.0 );
+        QVERIFY( result.row(ch).tail(numSamples - iDelay) == data.row(ch).head(numSamples - iDelay) );
+    }
+
+    //The filtered ones are not touched by the delay
+    for(int i = 0; i < filterChannels.size(); ++i) {
+        int ch = filterChannels.at(i);
+        RowVectorXd ref = convolve(data.row(ch), lFilterData.at(0).m_dCoeffA);
+        QVERIFY( (result.row(ch) - ref).cwiseAbs().maxCoeff() < epsilon );
+    }
+
+    //The delays of cascaded filters add up
+    lFilterData << firFilter(31);
+    iDelay = 50 + 15;
+    QVERIFY( RtFilter::getGroupDelay(lFilterData) == iDelay );
+
+    RtFilter rtFilterCascade;
+    result = filterBlockWise(rtFilterCascade, lFilterData, true, blockSize);
+
+    for(int ch = 1; ch < numChannels; ch += 2) {
+        QVERIFY( result.row(ch).head(iDelay).cwiseAbs().maxCoeff() == 0.0 );
+        QVERIFY( result.row(ch).tail(numSamples - iDelay) == data.row(ch).head(numSamples - iDelay) );
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestRtFilter::compareReset()
+{
+    QList<FilterData> lFilterData;
+    lFilterData << firFilter(101);
+
+    RtFilter rtFilter;
+    MatrixXd first = filterBlockWise(rtFilter, lFilterData, true, blockSize);
+
+    //Without a reset the history of the last run leaks into the first blocks
+    MatrixXd second = filterBlockWise(rtFilter, lFilterData, true, blockSize);
+    QVERIFY( (first.leftCols(blockSize) - second.leftCols(blockSize)).cwiseAbs().maxCoeff() > epsilon );
+
+    //After a reset the data is filtered as if the filter was new
+    rtFilter.reset();
+    MatrixXd third = filterBlockWise(rtFilter, lFilterData, true, blockSize);
+    QVERIFY( (first - third).cwiseAbs().maxCoeff() < epsilon );
+}
+
+
+//*************************************************************************************************************
+
+double TestRtFilter::magnitude(const MatrixXd& matSOS, double dFreq) const
+{
+    //Evaluate the sections on the unit circle
+    std::complex<double> z1 = std::polar(1.0, -2.0 * M_PI * dFreq / sfreq);
+    std::complex<double> z2 = z1 * z1;
+    std::complex<double> H = 1.0;
+
+    for(int s = 0; s < matSOS.rows(); ++s) {
+        H *= (matSOS(s,0) + matSOS(s,1) * z1 + matSOS(s,2) * z2) / (matSOS(s,3) + matSOS(s,4) * z1 + matSOS(s,5) * z2);
+    }
+
+    return std::abs(H);
+}
+
+
+//*************************************************************************************************************
+
+void TestRtFilter::compareButterworthResponse()
+{
+    //The bilinear transform with prewarping maps the analog Butterworth response onto tan(pi*f/sfreq)
+    double dCutOff = 40.0;
+    double wc = tan(M_PI * dCutOff / sfreq);
+
+    for(int iOrder = 1; iOrder <= 6; ++iOrder) {
+        MatrixXd matLowpass = FilterData::butterworthSections(iOrder, dCutOff, sfreq, false);
+        MatrixXd matHighpass = FilterData::butterworthSections(iOrder, dCutOff, sfreq, true);
+
+        QVERIFY( matLowpass.rows() == (iOrder + 1)/2 );
+        QVERIFY( matHighpass.rows() == (iOrder + 1)/2 );
+
+        for(double f = 1.0; f < sfreq/2; f += 7.0) {
+            double w = tan(M_PI * f / sfreq);
+            double lowpass = 1.0 / sqrt(1.0 + pow(w / wc, 2 * iOrder));
+            double highpass = 1.0 / sqrt(1.0 + pow(wc / w, 2 * iOrder));
+
+            QVERIFY( std::fabs(magnitude(matLowpass, f) - lowpass) < epsilon );
+            QVERIFY( std::fabs(magnitude(matHighpass, f) - highpass) < epsilon );
+        }
+
+        //-3 dB at the cut off, unit gain in the pass band and nothing at the other end
+        QVERIFY( std::fabs(magnitude(matLowpass, dCutOff) - M_SQRT1_2) < epsilon );
+        QVERIFY( std::fabs(magnitude(matHighpass, dCutOff) - M_SQRT1_2) < epsilon );
+        QVERIFY( std::fabs(magnitude(matLowpass, 0.0) - 1.0) < epsilon );
+        QVERIFY( std::fabs(magnitude(matHighpass, sfreq/2) - 1.0) < epsilon );
+        QVERIFY( magnitude(matLowpass, sfreq/2) < epsilon );
+        QVERIFY( magnitude(matHighpass, 0.0) < epsilon );
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestRtFilter::compareNotchResponse()
+{
+    double dCenterFreq = 50.0;
+    double dBandwidth = 4.0;
+    MatrixXd matNotch = FilterData::notchSection(dCenterFreq, dBandwidth, sfreq);
+
+    //|H|^2 = (cos(w) - cos(w0))^2 / ((cos(w) - cos(w0))^2 + alpha^2 sin(w)^2), alpha = tan(dw/2) of the -3 dB bandwidth dw
+    double w0 = 2.0 * M_PI * dCenterFreq / sfreq;
+    double alpha = sin(w0) * dBandwidth / (2.0 * dCenterFreq);
+
+    for(double f = 0.5; f < sfreq/2; f += 0.5) {
+        double w = 2.0 * M_PI * f / sfreq;
+        double num = (cos(w) - cos(w0)) * (cos(w) - cos(w0));
+        double notch = sqrt(num / (num + alpha * alpha * sin(w) * sin(w)));
+
+        QVERIFY( std::fabs(magnitude(matNotch, f) - notch) < epsilon );
+    }
+
+    //Zero at the center, unit gain at DC and Nyquist and a -3 dB bandwidth close to the requested one
+    double dw = 2.0 * atan(alpha) * sfreq / (2.0 * M_PI);
+    QVERIFY( std::fabs(dw - dBandwidth) < 0.02 * dBandwidth );
+    QVERIFY( magnitude(matNotch, dCenterFreq) < epsilon );
+    QVERIFY( std::fabs(magnitude(matNotch, 0.0) - 1.0) < epsilon );
+    QVERIFY( std::fabs(magnitude(matNotch, sfreq/2) - 1.0) < epsilon );
+    QVERIFY( std::fabs(magnitude(matNotch, dCenterFreq - 5.0 * dBandwidth) - 1.0) < 0.01 );
+    QVERIFY( std::fabs(magnitude(matNotch, dCenterFreq + 5.0 * dBandwidth) - 1.0) < 0.01 );
+
+    //A sinusoid at the center frequency dies out once the filter settled
+    RowVectorXd vecSine(numSamples);
+    for(int i = 0; i < numSamples; ++i) {
+        vecSine(i) = sin(2.0 * M_PI * dCenterFreq * i / sfreq);
+    }
+
+    RowVectorXd vecFiltered = FilterData::applySOS(matNotch, vecSine);
+    QVERIFY( vecFiltered.tail(numSamples/4).cwiseAbs().maxCoeff() < 0.001 );
+}
+
+
+//*************************************************************************************************************
+
+void TestRtFilter::compareIIRStreaming()
+{
+    //A band pass followed by a notch, the state of the sections is carried across the block boundaries
+    FilterData bandpass;
+    bandpass.m_matSOS.resize(4, 6);
+    bandpass.m_matSOS << FilterData::butterworthSections(4, 1.0, sfreq, true), FilterData::butterworthSections(4, 40.0, sfreq, false);
+
+    FilterData notch;
+    notch.m_matSOS = FilterData::notchSection(50.0, 4.0, sfreq);
+
+    QList<FilterData> lFilterData;
+    lFilterData << bandpass << notch;
+
+    //Blocks which are shorter than any time constant of the filters
+    RtFilter rtFilter;
+    MatrixXd result = filterBlockWise(rtFilter, lFilterData, 0, 16);
+
+    for(int i = 0; i < filterChannels.size(); ++i) {
+        int ch = filterChannels.at(i);
+        RowVectorXd ref = FilterData::applySOS(notch.m_matSOS, FilterData::applySOS(bandpass.m_matSOS, data.row(ch)));
+        QVERIFY( (result.row(ch) - ref).cwiseAbs().maxCoeff() < epsilon );
+    }
+
+    //The channels which are not filtered stay untouched
+    for(int ch = 1; ch < numChannels; ch += 2) {
+        QVERIFY( result.row(ch) == data.row(ch) );
+    }
+
+    //Other filters start from rest again
+    lFilterData.removeLast();
+    result = filterBlockWise(rtFilter, lFilterData, 0, 16);
+
+    for(int i = 0; i < filterChannels.size(); ++i) {
+        int ch = filterChannels.at(i);
+        RowVectorXd ref = FilterData::applySOS(bandpass.m_matSOS, data.row(ch));
+        QVERIFY( (result.row(ch) - ref).cwiseAbs().maxCoeff() < epsilon );
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestRtFilter::cleanupTestCase()
+{
+}
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_APPLESS_MAIN(TestRtFilter)
+#include "test_rtfilter.moc"
@@ -0,0 +1,321 @@
+//=============================================================================================================
+/**
+* @file     test_rtsss_operator_cache.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    Test for the head position keyed SSS operator cache of the RtSss plugin
+*
+*/
+
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <rtsssoperatorcache.h>
+#include <fiff/fiff_raw_data.h>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace RtSssPlugin;
+using namespace FIFFLIB;
+using namespace Eigen;
+
+
+//=============================================================================================================
+/**
+* DECLARE CLASS TestRtSssOperatorCache
+*
+* @brief The TestRtSssOperatorCache class checks the operators handed out by the cache against freshly built ones
+*
+*/
+class TestRtSssOperatorCache: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestRtSssOperatorCache();
+
+private slots:
+    void initTestCase();
+    void compareInitialOperator();
+    void compareSmallMovement();
+    void compareBackgroundOperator();
+    void compareCachedOperator();
+    void compareCacheLimit();
+    void cleanupTestCase();
+
+private:
+    MatrixXd freshOperator(const Vector3d& vecOrigin);
+    void moveTo(RtSssOperatorCache& cache, const Vector3d& vecOrigin);
+    double relativeDiff(const MatrixXd& mat, const MatrixXd& matRef) const;
+
+    double          epsilon;
+    double          threshold;
+
+    RtSssAlgo       algo;
+    Vector3d        origin;
+    MatrixXd        initialOperator;
+};
+
+
+//*************************************************************************************************************
+
+TestRtSssOperatorCache::TestRtSssOperatorCache()
+: epsilon(0.0000000001)
+, threshold(0.002)
+{
+}
+
+
+//*************************************************************************************************************
+
+void TestRtSssOperatorCache::initTestCase()
+{
+    qDebug() << "Epsilon" << epsilon;
+    qDebug() << "Movement threshold" << threshold;
+
+    QFile t_fileRaw(QDir::currentPath()+"/mne-cpp-test-data/MEG/sample/sample_audvis_raw_short.fif");
+    FiffRawData raw(t_fileRaw);
+    FiffInfo::SPtr pInfo(new FiffInfo(raw.info));
+
+    //The good magnetometers, orders small enough for their number
+    QList<int> lPicks;
+    for(int i = 0; i < pInfo->nchan; ++i) {
+        if(pInfo->chs[i].chpos.coil_type == FIFFV_COIL_VV_MAG_T3 && !pInfo->bads.contains(pInfo->ch_names[i])) {
+            lPicks.append(i);
+        }
+    }
+
+    RowVectorXi vecPicks(lPicks.size());
+    for(int i = 0; i < lPicks.size(); ++i) {
+        vecPicks(i) = lPicks.at(i);
+    }
+
+    QList<int> lExpansionOrder;
+    lExpansionOrder << 4 << 3 << 6 << 3;
+
+    algo.setMEGInfo(pInfo, vecPicks);
+    algo.setSSSParameter(lExpansionOrder);
+
+    origin = algo.getOrigin();
+    initialOperator = algo.getSSSOperator();
+
+    QVERIFY( initialOperator.rows() == lPicks.size() && initialOperator.cols() == lPicks.size() );
+}
+
+
+//*************************************************************************************************************
+
+MatrixXd TestRtSssOperatorCache::freshOperator(const Vector3d& vecOrigin)
+{
+    RtSssAlgo algoFresh = algo;
+    algoFresh.setOrigin(vecOrigin);
+    return algoFresh.getSSSOperator();
+}
+
+
+//*************************************************************************************************************
+
+void TestRtSssOperatorCache::moveTo(RtSssOperatorCache& cache, const Vector3d& vecOrigin)
+{
+    //Start the background operator, wait for it and switch to it
+    cache.update(vecOrigin);
+    cache.waitForPending();
+    cache.update(vecOrigin);
+}
+
+
+//*************************************************************************************************************
+
+double TestRtSssOperatorCache::relativeDiff(const MatrixXd& mat, const MatrixXd& matRef) const
+{
+    if(mat.rows() != matRef.rows() || mat.cols() != matRef.cols())
+        return 1.0;
+
+    return (mat - matRef).cwiseAbs().maxCoeff() / matRef.cwiseAbs().maxCoeff();
+}
+
+
+//*************************************************************************************************************
+
+void TestRtSssOperatorCache::compareInitialOperator()
+{
+    RtSssOperatorCache cache(threshold);
+    cache.reset(algo);
+
+    QVERIFY( cache.size() == 1 );
+    QVERIFY( !cache.isPending() );
+    QVERIFY( cache.currentOrigin() == origin );
+    QVERIFY( relativeDiff(cache.currentOperator(), initialOperator) < epsilon );
+}
+
+
+//*************************************************************************************************************
+
+void TestRtSssOperatorCache::compareSmallMovement()
+{
+    RtSssOperatorCache cache(threshold);
+    cache.reset(algo);
+
+    //Movements within the threshold keep the operator
+    Vector3d vecOrigin = origin + Vector3d(0.001, 0.0, -0.001);
+    const MatrixXd& matOperator = cache.update(vecOrigin);
+
+    QVERIFY( !cache.isPending() );
+    QVERIFY( cache.size() == 1 );
+    QVERIFY( cache.currentOrigin() == origin );
+    QVERIFY( relativeDiff(matOperator, initialOperator) < epsilon );
+}
+
+
+//*************************************************************************************************************
+
+void TestRtSssOperatorCache::compareBackgroundOperator()
+{
+    RtSssOperatorCache cache(threshold);
+    cache.reset(algo);
+
+    //The old operator stays in use while the new one is built
+    Vector3d vecOrigin = origin + Vector3d(0.0, 0.005, 0.0);
+    cache.update(vecOrigin);
+
+    QVERIFY( cache.isPending() );
+    QVERIFY( cache.currentOrigin() == origin );
+    QVERIFY( relativeDiff(cache.currentOperator(), initialOperator) < epsilon );
+
+    cache.waitForPending();
+    QVERIFY( !cache.isPending() );
+    QVERIFY( cache.size() == 2 );
+
+    //The operator built in the background equals a fresh one at its origin
+    cache.update(vecOrigin);
+    QVERIFY( cache.currentOrigin() == vecOrigin );
+    QVERIFY( relativeDiff(cache.currentOperator(), freshOperator(vecOrigin)) < epsilon );
+    QVERIFY( relativeDiff(cache.currentOperator(), initialOperator) > epsilon );
+}
+
+
+//*************************************************************************************************************
+
+void TestRtSssOperatorCache::compareCachedOperator()
+{
+    RtSssOperatorCache cache(threshold);
+    cache.reset(algo);
+
+    Vector3d vecOrigin = origin + Vector3d(0.004, 0.0, 0.003);
+    moveTo(cache, vecOrigin);
+    QVERIFY( cache.currentOrigin() == vecOrigin );
+
+    //Returning close to a known position reuses its operator without a new build
+    cache.update(origin + Vector3d(0.0005, 0.0, 0.0));
+
+    QVERIFY( !cache.isPending() );
+    QVERIFY( cache.size() == 2 );
+    QVERIFY( cache.currentOrigin() == origin );
+    QVERIFY( relativeDiff(cache.currentOperator(), initialOperator) < epsilon );
+
+    cache.update(vecOrigin + Vector3d(0.0, -0.001, 0.0));
+
+    QVERIFY( !cache.isPending() );
+    QVERIFY( cache.currentOrigin() == vecOrigin );
+    QVERIFY( relativeDiff(cache.currentOperator(), freshOperator(vecOrigin)) < epsilon );
+}
+
+
+//*************************************************************************************************************
+
+void TestRtSssOperatorCache::compareCacheLimit()
+{
+    RtSssOperatorCache cache(threshold, 2);
+    cache.reset(algo);
+
+    Vector3d vecFirst = origin + Vector3d(0.005, 0.0, 0.0);
+    Vector3d vecSecond = origin + Vector3d(0.0, 0.005, 0.0);
+
+    moveTo(cache, vecFirst);
+    moveTo(cache, vecSecond);
+
+    //The oldest operator was dropped, returning to its position builds it again
+    QVERIFY( cache.size() == 2 );
+    QVERIFY( cache.currentOrigin() == vecSecond );
+
+    cache.update(origin);
+    QVERIFY( cache.isPending() );
+    QVERIFY( cache.currentOrigin() == vecSecond );
+
+    cache.waitForPending();
+    cache.update(origin);
+
+    QVERIFY( cache.size() == 2 );
+    QVERIFY( cache.currentOrigin() == origin );
+    QVERIFY( relativeDiff(cache.currentOperator(), initialOperator) < epsilon );
+
+    //The most recent operators are kept
+    cache.update(vecSecond);
+    QVERIFY( !cache.isPending() );
+    QVERIFY( cache.currentOrigin() == vecSecond );
+}
+
+
+//*************************************************************************************************************
+
+void TestRtSssOperatorCache::cleanupTestCase()
+{
+}
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_APPLESS_MAIN(TestRtSssOperatorCache)
+#include "test_rtsss_operator_cache.moc"
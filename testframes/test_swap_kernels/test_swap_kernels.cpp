@@ -0,0 +1,344 @@
+//=============================================================================================================
+/**
+* @file     test_swap_kernels.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    Test for the vectorized byte swap and conversion kernels
+*
+*/
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/ioutils.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+#include <QtEndian>
+#include <QVector>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace UTILSLIB;
+
+
+//=============================================================================================================
+/**
+* DECLARE CLASS TestSwapKernels
+*
+* @brief The TestSwapKernels class checks the array byte swaps and big endian conversions against the scalar swaps
+*
+*/
+class TestSwapKernels: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestSwapKernels();
+
+private slots:
+    void initTestCase();
+    void compareShortSwap();
+    void compareIntSwap();
+    void compareLongSwap();
+    void compareFloatSwap();
+    void compareDoubleSwap();
+    void compareShortConversion();
+    void compareIntConversion();
+    void compareFloatConversion();
+    void cleanupTestCase();
+
+private:
+    QVector<int>    lengths;
+    QVector<uchar>  bytes;
+};
+
+
+//*************************************************************************************************************
+
+TestSwapKernels::TestSwapKernels()
+{
+}
+
+
+//*************************************************************************************************************
+
+void TestSwapKernels::initTestCase()
+{
+    qDebug() << "Instruction set" << IOUtils::swap_instruction_set();
+
+    //Every length up to a few AVX2 registers, so each kernel leaves every possible scalar tail, and a long one
+    for(int i = 0; i <= 70; ++i)
+        lengths.append(i);
+    lengths.append(1027);
+
+    srand(42);
+    bytes.resize(8 * 1027 + 8);
+    for(int i = 0; i < bytes.size(); ++i)
+        bytes[i] = (uchar)(rand() & 0xFF);
+}
+
+
+//*************************************************************************************************************
+
+void TestSwapKernels::compareShortSwap()
+{
+    for(int l = 0; l < lengths.size(); ++l) {
+        int n = lengths[l];
+
+        //One element of padding in front, so the array does not start on a vector boundary
+        QVector<qint16> data(n + 1);
+        memcpy(data.data(), bytes.constData(), (n + 1) * sizeof(qint16));
+        QVector<qint16> original = data;
+
+        IOUtils::swap_short_array(data.data() + 1, n);
+
+        QVERIFY( data[0] == original[0] );
+        for(int i = 0; i < n; ++i)
+            QVERIFY( data[i+1] == IOUtils::swap_short(original[i+1]) );
+
+        IOUtils::swap_short_array(data.data() + 1, n);
+        QVERIFY( data == original );
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestSwapKernels::compareIntSwap()
+{
+    for(int l = 0; l < lengths.size(); ++l) {
+        int n = lengths[l];
+
+        QVector<qint32> data(n + 1);
+        memcpy(data.data(), bytes.constData(), (n + 1) * sizeof(qint32));
+        QVector<qint32> original = data;
+
+        IOUtils::swap_int_array(data.data() + 1, n);
+
+        QVERIFY( data[0] == original[0] );
+        for(int i = 0; i < n; ++i)
+            QVERIFY( data[i+1] == IOUtils::swap_int(original[i+1]) );
+
+        IOUtils::swap_int_array(data.data() + 1, n);
+        QVERIFY( data == original );
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestSwapKernels::compareLongSwap()
+{
+    for(int l = 0; l < lengths.size(); ++l) {
+        int n = lengths[l];
+
+        QVector<qint64> data(n + 1);
+        memcpy(data.data(), bytes.constData(), (n + 1) * sizeof(qint64));
+        QVector<qint64> original = data;
+
+        IOUtils::swap_long_array(data.data() + 1, n);
+
+        QVERIFY( data[0] == original[0] );
+        for(int i = 0; i < n; ++i)
+            QVERIFY( data[i+1] == IOUtils::swap_long(original[i+1]) );
+
+        IOUtils::swap_long_array(data.data() + 1, n);
+        QVERIFY( data == original );
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestSwapKernels::compareFloatSwap()
+{
+    for(int l = 0; l < lengths.size(); ++l) {
+        int n = lengths[l];
+
+        //Random bit patterns include NaNs, so the results are compared bitwise
+        QVector<float> data(n + 1);
+        memcpy(data.data(), bytes.constData(), (n + 1) * sizeof(float));
+        QVector<float> original = data;
+
+        IOUtils::swap_float_array(data.data() + 1, n);
+
+        QVERIFY( memcmp(&data[0], &original[0], sizeof(float)) == 0 );
+        for(int i = 0; i < n; ++i) {
+            float expected = original[i+1];
+            IOUtils::swap_floatp(&expected);
+            QVERIFY( memcmp(&data[i+1], &expected, sizeof(float)) == 0 );
+        }
+
+        IOUtils::swap_float_array(data.data() + 1, n);
+        QVERIFY( memcmp(data.constData(), original.constData(), (n + 1) * sizeof(float)) == 0 );
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestSwapKernels::compareDoubleSwap()
+{
+    for(int l = 0; l < lengths.size(); ++l) {
+        int n = lengths[l];
+
+        QVector<double> data(n + 1);
+        memcpy(data.data(), bytes.constData(), (n + 1) * sizeof(double));
+        QVector<double> original = data;
+
+        IOUtils::swap_double_array(data.data() + 1, n);
+
+        QVERIFY( memcmp(&data[0], &original[0], sizeof(double)) == 0 );
+        for(int i = 0; i < n; ++i) {
+            double expected = original[i+1];
+            IOUtils::swap_doublep(&expected);
+            QVERIFY( memcmp(&data[i+1], &expected, sizeof(double)) == 0 );
+        }
+
+        IOUtils::swap_double_array(data.data() + 1, n);
+        QVERIFY( memcmp(data.constData(), original.constData(), (n + 1) * sizeof(double)) == 0 );
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestSwapKernels::compareShortConversion()
+{
+    for(int l = 0; l < lengths.size(); ++l) {
+        int n = lengths[l];
+
+        //The big endian source starts at an odd address
+        const uchar* source = bytes.constData() + 1;
+
+        QVector<double> dataDouble(n);
+        QVector<float> dataFloat(n);
+        IOUtils::be_short_to_double(source, dataDouble.data(), n);
+        IOUtils::be_short_to_float(source, dataFloat.data(), n);
+
+        for(int i = 0; i < n; ++i) {
+            qint16 value;
+            memcpy(&value, source + i * sizeof(qint16), sizeof(qint16));
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+            value = IOUtils::swap_short(value);
+#endif
+            QVERIFY( dataDouble[i] == (double)value );
+            QVERIFY( dataFloat[i] == (float)value );
+        }
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestSwapKernels::compareIntConversion()
+{
+    for(int l = 0; l < lengths.size(); ++l) {
+        int n = lengths[l];
+
+        const uchar* source = bytes.constData() + 1;
+
+        QVector<double> dataDouble(n);
+        QVector<float> dataFloat(n);
+        IOUtils::be_int_to_double(source, dataDouble.data(), n);
+        IOUtils::be_int_to_float(source, dataFloat.data(), n);
+
+        for(int i = 0; i < n; ++i) {
+            qint32 value;
+            memcpy(&value, source + i * sizeof(qint32), sizeof(qint32));
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+            value = IOUtils::swap_int(value);
+#endif
+            QVERIFY( dataDouble[i] == (double)value );
+            QVERIFY( dataFloat[i] == (float)value );
+        }
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestSwapKernels::compareFloatConversion()
+{
+    for(int l = 0; l < lengths.size(); ++l) {
+        int n = lengths[l];
+
+        //Finite values with varying exponents and signs
+        QVector<uchar> source(n * sizeof(float) + 1);
+        QVector<float> values(n);
+        for(int i = 0; i < n; ++i) {
+            values[i] = (float)((rand() - RAND_MAX/2) * pow(2.0, (rand() % 60) - 30));
+            quint32 bits;
+            memcpy(&bits, &values[i], sizeof(float));
+            qToBigEndian<quint32>(bits, source.data() + 1 + i * sizeof(float));
+        }
+
+        QVector<double> dataDouble(n);
+        QVector<float> dataFloat(n);
+        IOUtils::be_float_to_double(source.constData() + 1, dataDouble.data(), n);
+        IOUtils::be_float_to_float(source.constData() + 1, dataFloat.data(), n);
+
+        for(int i = 0; i < n; ++i) {
+            QVERIFY( dataDouble[i] == (double)values[i] );
+            QVERIFY( dataFloat[i] == values[i] );
+        }
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestSwapKernels::cleanupTestCase()
+{
+}
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_APPLESS_MAIN(TestSwapKernels)
+#include "test_swap_kernels.moc"
@@ -0,0 +1,292 @@
+//=============================================================================================================
+/**
+* @file     test_welch_psd.cpp
+* @author   agent <agent@local>
+* @version  1.0
+* @date     October, 2026
+*
+* @section  LICENSE
+*
+* Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+* the following conditions are met:
+*     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+*       following disclaimer.
+*     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+*       the following disclaimer in the documentation and/or other materials provided with the distribution.
+*     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+*       to endorse or promote products derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+* WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+* INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+* PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+* HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+*
+*
+* @brief    Test for the streaming Welch PSD
+*
+*/
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/welchpsd.h>
+
+#include <math.h>
+#include <stdlib.h>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+#include <unsupported/Eigen/FFT>
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace UTILSLIB;
+using namespace Eigen;
+
+
+//=============================================================================================================
+/**
+* DECLARE CLASS TestWelchPsd
+*
+* @brief The TestWelchPsd class checks the streaming Welch PSD against a direct per channel evaluation and known spectra
+*
+*/
+class TestWelchPsd: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestWelchPsd();
+
+private slots:
+    void initTestCase();
+    void compareNumSegments();
+    void compareReference();
+    void compareSinusoid();
+    void compareWhiteNoise();
+    void compareResetAverage();
+    void cleanupTestCase();
+
+private:
+    MatrixXd referencePsd(const MatrixXd &matData) const;
+
+    double      epsilon;
+    double      sfreq;
+    int         segmentLength;
+    int         overlap;
+    int         numSegments;
+
+    MatrixXd    data;
+    MatrixXd    psd;
+    VectorXd    freqs;
+};
+
+
+//*************************************************************************************************************
+
+TestWelchPsd::TestWelchPsd()
+: epsilon(0.000001)
+, sfreq(1000.0)
+, segmentLength(256)
+, overlap(128)
+, numSegments(200)
+{
+}
+
+
+//*************************************************************************************************************
+
+void TestWelchPsd::initTestCase()
+{
+    qDebug() << "Epsilon" << epsilon;
+
+    //Three channels: the first two are packed into one complex FFT, the third one is the odd leftover
+    int step = segmentLength - overlap;
+    int nsamp = overlap + numSegments * step;
+
+    srand(42);
+    data = MatrixXd::Zero(3, nsamp);
+    for(int i = 0; i < nsamp; ++i) {
+        double t = i / sfreq;
+        data(0,i) = 2.0 * sin(2.0 * M_PI * 125.0 * t);      //Bin 32
+        data(2,i) = 3.0 * sin(2.0 * M_PI * 250.0 * t);      //Bin 64
+    }
+    data.row(1) = MatrixXd::Random(1, nsamp);               //Uniform in [-1,1], variance 1/3
+
+    //Append in blocks which do not line up with the segments
+    WelchPsd welch(3, segmentLength, overlap, sfreq);
+    int block = 77;
+    for(int i = 0; i < nsamp; i += block) {
+        welch.append(data.middleCols(i, qMin(block, nsamp - i)));
+    }
+
+    psd = welch.getPsd();
+    freqs = welch.getFrequencies();
+
+    QVERIFY( welch.getNumSegments() == numSegments );
+}
+
+
+//*************************************************************************************************************
+
+MatrixXd TestWelchPsd::referencePsd(const MatrixXd &matData) const
+{
+    int step = segmentLength - overlap;
+    int nbins = segmentLength/2+1;
+    VectorXd window = WelchPsd::hann(segmentLength);
+    double scale = 1.0 / (sfreq * window.squaredNorm());
+
+    FFT<double> fft;
+    MatrixXd result = MatrixXd::Zero(matData.rows(), nbins);
+    int count = 0;
+
+    for(int start = 0; start + segmentLength <= matData.cols(); start += step, ++count) {
+        for(int ch = 0; ch < matData.rows(); ++ch) {
+            VectorXd x = matData.row(ch).segment(start, segmentLength).transpose().cwiseProduct(window);
+            VectorXcd X;
+            fft.fwd(X, x);
+
+            for(int k = 0; k < nbins; ++k) {
+                double factor = (k == 0 || k == segmentLength/2) ? 1.0 : 2.0;
+                result(ch,k) += factor * scale * std::norm(X(k));
+            }
+        }
+    }
+
+    return result / count;
+}
+
+
+//*************************************************************************************************************
+
+void TestWelchPsd::compareNumSegments()
+{
+    QVERIFY( psd.rows() == 3 );
+    QVERIFY( psd.cols() == segmentLength/2+1 );
+    QVERIFY( freqs.size() == segmentLength/2+1 );
+    QVERIFY( std::fabs(freqs(32) - 125.0) < epsilon );
+}
+
+
+//*************************************************************************************************************
+
+void TestWelchPsd::compareReference()
+{
+    //Every channel, packed or not, has to match the one FFT per channel evaluation
+    MatrixXd ref = referencePsd(data);
+
+    for(int ch = 0; ch < 3; ++ch) {
+        double diff = (psd.row(ch) - ref.row(ch)).cwiseAbs().maxCoeff() / ref.row(ch).cwiseAbs().maxCoeff();
+        QVERIFY( diff < epsilon );
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestWelchPsd::compareSinusoid()
+{
+    double df = freqs(1) - freqs(0);
+
+    //The peak sits in the bin of the sinusoid and the PSD integrates to its power A^2/2
+    int peak;
+    psd.row(0).maxCoeff(&peak);
+    QVERIFY( peak == 32 );
+    QVERIFY( std::fabs(psd.row(0).sum() * df - 2.0) < epsilon );
+
+    psd.row(2).maxCoeff(&peak);
+    QVERIFY( peak == 64 );
+    QVERIFY( std::fabs(psd.row(2).sum() * df - 4.5) < epsilon );
+}
+
+
+//*************************************************************************************************************
+
+void TestWelchPsd::compareWhiteNoise()
+{
+    //The one-sided PSD of white noise with variance 1/3 is 2/3/sfreq, leave out DC and Nyquist
+    double expected = 2.0 / 3.0 / sfreq;
+    double level = psd.row(1).segment(1, segmentLength/2-1).mean();
+
+    QVERIFY( std::fabs(level - expected) < 0.05 * expected );
+}
+
+
+//*************************************************************************************************************
+
+void TestWelchPsd::compareResetAverage()
+{
+    //Restarting the average in the middle of a segment must not drop samples: both averages together are the
+    //average of the whole data
+    int nsamp = data.cols();
+    int block = 77;
+
+    WelchPsd welch(3, segmentLength, overlap, sfreq);
+    MatrixXd psdFirst;
+    int numFirst = 0;
+
+    for(int i = 0; i < nsamp; i += block) {
+        welch.append(data.middleCols(i, qMin(block, nsamp - i)));
+
+        if(numFirst == 0 && i >= nsamp/2) {
+            psdFirst = welch.getPsd();
+            numFirst = welch.getNumSegments();
+            welch.resetAverage();
+            QVERIFY( welch.getNumSegments() == 0 );
+        }
+    }
+
+    MatrixXd psdSecond = welch.getPsd();
+    int numSecond = welch.getNumSegments();
+
+    QVERIFY( numFirst + numSecond == numSegments );
+    QVERIFY( welch.getNumSamples() == nsamp );
+
+    MatrixXd combined = (numFirst * psdFirst + numSecond * psdSecond) / numSegments;
+    for(int ch = 0; ch < 3; ++ch) {
+        double diff = (combined.row(ch) - psd.row(ch)).cwiseAbs().maxCoeff() / psd.row(ch).cwiseAbs().maxCoeff();
+        QVERIFY( diff < epsilon );
+    }
+}
+
+
+//*************************************************************************************************************
+
+void TestWelchPsd::cleanupTestCase()
+{
+}
+
+
+//*************************************************************************************************************
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_APPLESS_MAIN(TestWelchPsd)
+#include "test_welch_psd.moc"
@@ -46,11 +46,25 @@ SUBDIRS += \
     test_fiff_cov \
     test_fiff_digitizer \
     test_mne_msh_display_surface_set \
+    test_welch_psd \
+    test_swap_kernels \
+    test_ring_matrix_buffer \
+    test_fiff_raw_read \
+    test_rtfilter \
+    test_rtcov \
+    test_rtave \
+    test_detect_trigger \
+    test_inverse_operator \
+    test_minimum_norm_fast \
+    test_hpi_fit \
+    test_rtsss_operator_cache \
 
 !contains(MNECPP_CONFIG, minimalVersion) {
     qtHaveModule(charts) {
         SUBDIRS += \
             test_interpolation \
             test_geometryinfo \
+            test_latency_monitor \
+            test_plugin_connector_queue \
     }
 }
@@ -10,7 +10,7 @@ export LD_LIBRARY_PATH=$(pwd)/lib:$LD_LIBRARY_PATH
 MNECPP_ROOT=$(pwd)
 
 # Tests to run - TODO: find required tests automatically with grep
-tests=( test_codecov test_fiff_rwr test_dipole_fit test_fiff_mne_types_io test_fiff_cov test_fiff_digitizer test_mne_msh_display_surface_set test_geometryinfo test_interpolation )
+tests=( test_codecov test_fiff_rwr test_dipole_fit test_fiff_mne_types_io test_fiff_cov test_fiff_digitizer test_mne_msh_display_surface_set test_welch_psd test_swap_kernels test_ring_matrix_buffer test_fiff_raw_read test_rtfilter test_rtcov test_rtave test_detect_trigger test_inverse_operator test_minimum_norm_fast test_hpi_fit test_rtsss_operator_cache test_geometryinfo test_interpolation test_latency_monitor test_plugin_connector_queue )
 
 for test in ${tests[*]};
 do